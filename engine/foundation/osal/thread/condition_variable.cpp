@@ -100,6 +100,23 @@ bool ConditionVariable::WaitFor(ScopedLock& lock, int timeoutMs)
     return pthread_cond_timedwait(&cond_, &(lock.mutex_->nativeHandle_),
         &timeout) == 0;
 }
+
+bool ConditionVariable::WaitUntil(ScopedLock& lock, int64_t deadlineNs)
+{
+    struct timespec deadline = NsToTm(deadlineNs);
+    return pthread_cond_timedwait(&cond_, &(lock.mutex_->nativeHandle_), &deadline) == 0;
+}
+
+int64_t ConditionVariable::GetClockTimeNs()
+{
+    struct timespec now = {0, 0};
+#ifdef USING_CLOCK_REALTIME
+    clock_gettime(CLOCK_REALTIME, &now);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &now);
+#endif
+    return TmToNs(now);
+}
 } // namespace OSAL
 } // namespace Media
 } // namespace OHOS
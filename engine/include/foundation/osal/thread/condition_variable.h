@@ -17,6 +17,7 @@
 #define HISTREAMER_FOUNDATION_OSAL_CONDITION_VARIABLE_H
 
 #include <cerrno>
+#include <cstdint>
 #include <ctime>
 #include "foundation/osal/thread/scoped_lock.h"
 
@@ -74,6 +75,18 @@ public:
         return status == 0;
     }
 
+    /**
+     * Wait until an absolute deadline of the clock this condition variable is bound to
+     * (CLOCK_MONOTONIC unless USING_CLOCK_REALTIME is defined).
+     *
+     * @param lock locked scoped lock
+     * @param deadlineNs absolute deadline in nanoseconds
+     * @return false if the deadline was reached, true if woken up before it
+     */
+    bool WaitUntil(ScopedLock& lock, int64_t deadlineNs);
+
+    static int64_t GetClockTimeNs();
+
 private:
     bool condInited_;
     pthread_cond_t cond_{};
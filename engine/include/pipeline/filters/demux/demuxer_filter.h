@@ -24,6 +24,7 @@
 #include "pipeline/core/type_define.h"
 #include "pipeline/filters/demux/data_packer.h"
 #include "pipeline/filters/demux/type_finder.h"
+#include "plugin/common/plugin_time.h"
 #include "plugin/common/plugin_types.h"
 #include "plugin/core/demuxer.h"
 
@@ -149,6 +150,7 @@ private:
     std::string pluginName_;
     std::shared_ptr<Plugin::Demuxer> plugin_;
     std::atomic<DemuxerState> pluginState_;
+    std::atomic<int64_t> prerollEnd_ {HST_TIME_NONE}; // frames before this time are marked BUFFER_FLAG_PREROLL
     std::shared_ptr<Plugin::Allocator> pluginAllocator_;
     std::shared_ptr<DataSourceImpl> dataSource_;
     MediaMetaData mediaMetaData_;
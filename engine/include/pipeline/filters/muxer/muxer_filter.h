@@ -16,6 +16,10 @@
 #ifndef HISTREAMER_PIPELINE_MUXER_FILTER_H
 #define HISTREAMER_PIPELINE_MUXER_FILTER_H
 #ifdef RECORDER_SUPPORT
+#include <deque>
+#include "foundation/osal/thread/condition_variable.h"
+#include "foundation/osal/thread/mutex.h"
+#include "foundation/osal/thread/task.h"
 #include "pipeline/core/filter_base.h"
 #include "plugin/core/muxer.h"
 #include "plugin/core/plugin_info.h"
@@ -24,6 +28,7 @@ namespace OHOS {
 namespace Media {
 namespace Pipeline {
 class DataSpliter;
+class InterleaveQueue;
 class MuxerFilter : public FilterBase {
 public:
     explicit MuxerFilter(std::string name);
@@ -44,15 +49,48 @@ public:
     ErrorCode AddTrack(std::shared_ptr<InPort>& trackPort);
     ErrorCode SetMaxDuration(uint64_t maxDuration);
     ErrorCode SetMaxSize(uint64_t maxSize);
+
+    /**
+     * Write a fragmented output, a fragment is cut at the first key frame once it lasts fragmentDuration or holds
+     * keyFrames key frames. 0 for both writes a regular output.
+     */
+    ErrorCode SetFragmentParameters(int64_t fragmentDuration, uint32_t keyFrames);
     ErrorCode StartNextSegment();
+
+    /**
+     * An output for one more segment has been prepared by the output sink.
+     */
+    ErrorCode AddNextOutput();
     ErrorCode SendEos();
     ErrorCode PushData(const std::string& inPort, const AVBufferPtr& buffer, int64_t offset) override;
     ErrorCode Start() override;
+    ErrorCode Stop() override;
+    void FlushStart() override;
+    void FlushEnd() override;
 private:
     class MuxerDataSink : public Plugin::DataSinkHelper {
     public:
         Plugin::Status WriteAt(int64_t offset, const std::shared_ptr<Plugin::Buffer>& buffer) override;
+
+        // keep the writes until Release(), the output of the segment before is not closed yet
+        void Hold();
+        void Release();
+
+        // the trailer of a closed segment does not count for the size of the current one
+        void SetClosing();
+
         MuxerFilter* muxerFilter_;
+
+    private:
+        OSAL::Mutex mutex_ {};
+        bool held_ {false};
+        bool closing_ {false};
+        std::vector<std::pair<int64_t, std::shared_ptr<Plugin::Buffer>>> heldWrites_ {};
+    };
+
+    struct ClosingOutput {
+        std::shared_ptr<Plugin::Muxer> plugin;
+        std::shared_ptr<MuxerDataSink> nextSink;
     };
 
     struct TrackInfo {
@@ -61,13 +99,21 @@ private:
         bool eos;
     };
 
-    int32_t GetTrackIdByInPort(const std::shared_ptr<InPort>& inPort);
+    int32_t GetTrackIdByInPort(const std::string& inPort);
     int32_t UpdateTrackIdOfInPort(const std::shared_ptr<InPort>& inPort, int32_t trackId);
 
     bool UpdateAndInitPluginByInfo(const std::shared_ptr<Plugin::PluginInfo>& selectedPluginInfo);
 
     ErrorCode ConfigureToStart();
     ErrorCode AddTrackThenConfigure(const std::pair<std::string, Plugin::Meta>& metaPair);
+    ErrorCode AddPluginTrack(const std::shared_ptr<Plugin::Muxer>& plugin, const Plugin::Meta& meta,
+                             uint32_t& trackId);
+    ErrorCode StartNextOutput();
+    ErrorCode StartSegmentPlugin(const std::shared_ptr<Plugin::Muxer>& plugin,
+                                 const std::shared_ptr<MuxerDataSink>& sink);
+    void CloseOutput();
+    void WaitOutputsClosed();
+    void SetPluginParameters(const std::shared_ptr<Plugin::Muxer>& plugin);
 
     bool AllTracksEos();
     void UpdateEosState(const std::string& inPort);
@@ -77,11 +123,19 @@ private:
     std::shared_ptr<Plugin::Muxer> plugin_ {};
     std::shared_ptr<Plugin::PluginInfo> targetPluginInfo_ {nullptr};
     std::shared_ptr<DataSpliter> dataSpliter_{};
+    std::shared_ptr<InterleaveQueue> interleaveQueue_ {};
     std::vector<std::pair<std::string, Capability>> capabilityCache_ {};
     std::vector<std::pair<std::string, Plugin::Meta>> metaCache_ {};
+    Plugin::Meta pluginParameters_ {};
     bool hasWriteHeader_ {false};
     std::shared_ptr<MuxerDataSink> muxerDataSink_;
 
+    // finishes the outputs of closed segments, so the encoders do not wait for the trailers
+    std::shared_ptr<OSAL::Task> closeTask_ {};
+    OSAL::Mutex closeMutex_ {};
+    OSAL::ConditionVariable closeCond_ {};
+    std::deque<ClosingOutput> closingOutputs_ {};
+
     OSAL::Mutex pushDataMutex_;
     bool eos_ {false};
     std::atomic<int> eosTrackCnt {0};
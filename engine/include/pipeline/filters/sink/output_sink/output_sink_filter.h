@@ -16,6 +16,8 @@
 #ifndef HISTREAMER_PIPELINE_OUTPUT_SINK_FILTER_H
 #define HISTREAMER_PIPELINE_OUTPUT_SINK_FILTER_H
 #ifdef RECORDER_SUPPORT
+#include <deque>
+#include "foundation/osal/thread/mutex.h"
 #include "pipeline/core/filter_base.h"
 #include "plugin/common/media_sink.h"
 #include "plugin/common/plugin_tags.h"
@@ -45,16 +47,26 @@ public:
     ErrorCode Start() override;
     ErrorCode Stop() override;
     ErrorCode SetSink(const MediaSink& sink);
+
+    /**
+     * Prepare the output of the next segment, which is switched to when a buffer with BUFFER_FLAG_SEGMENT_END is
+     * received. Outputs are used in the order they are set.
+     */
+    ErrorCode SetNextSink(const MediaSink& sink);
     ErrorCode PushData(const std::string &inPort, const AVBufferPtr& buffer, int64_t offset) override;
 
 private:
     ErrorCode ConfigureToPreparePlugin();
+    ErrorCode SwitchToNextSink();
+    void ClearNextSinks();
 
     std::shared_ptr<Plugin::OutputSink> plugin_;
     Plugin::ProtocolType protocolType_ {Plugin::ProtocolType::UNKNOWN};
     int64_t currentPos_ {0};
     MediaSink sink_ {Plugin::ProtocolType::UNKNOWN};
     bool bufferEos_ {true};
+    OSAL::Mutex nextSinkMutex_ {};
+    std::deque<std::shared_ptr<Plugin::OutputSink>> nextPlugins_ {};
 };
 } // Pipeline
 } // Media
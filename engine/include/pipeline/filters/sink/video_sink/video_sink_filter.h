@@ -30,6 +30,7 @@
 #include "pipeline/core/error_code.h"
 #include "pipeline/core/filter_base.h"
 #include "pipeline/filters/sink/media_synchronous_sink.h"
+#include "pipeline/filters/sink/video_sink/frame_presentation_scheduler.h"
 #include "plugin/core/plugin_info.h"
 #include "plugin/core/video_sink.h"
 
@@ -106,8 +107,9 @@ private:
     bool forceRenderNextFrame_ {false};
     Plugin::VideoScaleType videoScaleType_ {Plugin::VideoScaleType::VIDEO_SCALE_TYPE_FIT};
 
-    void CalcFrameRate();
-    std::shared_ptr<OHOS::Media::OSAL::Task> frameRateTask_ {nullptr};
+    void ReportFrameRate();
+    FramePresentationScheduler scheduler_ {};
+    int64_t lastFrameRateReportNs_ {0};
     std::atomic<uint64_t> renderFrameCnt_ {0};
     std::atomic<uint64_t> discardFrameCnt_ {0};
 };
@@ -17,8 +17,10 @@
 
 #ifdef RECORDER_SUPPORT
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "foundation/osal/thread/task.h"
 #include "foundation/osal/utils/util.h"
@@ -58,6 +60,8 @@ private:
     ErrorCode InitAndConfigWithMeta(const std::shared_ptr<Plugin::Meta>& audioMeta);
 
     void ReadLoop();
+    AVBufferPtr AllocateBuffer(uint64_t bufferSize);
+    static void ResetBuffer(AVBuffer& buffer);
     ErrorCode CreatePlugin(const std::shared_ptr<Plugin::PluginInfo>& info, const std::string& name,
                            Plugin::PluginManager& manager);
     ErrorCode FindPlugin();
@@ -104,6 +108,12 @@ private:
     int64_t totalPausedTime_ {0};
     std::atomic<bool> eos_ {false};
     OSAL::Mutex pushDataMutex_ {};
+    // a fixed set of capture buffers, a buffer is free again when only the pool refers to it
+    std::vector<AVBufferPtr> bufferPool_ {};
+    AVBufferPtr dropBuffer_ {nullptr};
+    uint64_t pooledBufferSize_ {0};
+    uint64_t droppedFrames_ {0};
+    bool dropping_ {false};
 };
 } // namespace Pipeline
 } // namespace Media
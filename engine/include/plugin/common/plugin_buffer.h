@@ -34,6 +34,10 @@ namespace Plugin {
 #define BUFFER_FLAG_EOS 0x00000001
 /// Video Key Frame Flag
 #define BUFFER_FLAG_KEY_FRAME 0x00000002
+/// Last Buffer of an Output Segment Flag, the following data belongs to the next output
+#define BUFFER_FLAG_SEGMENT_END 0x00000004
+/// Decode Only Buffer Flag, the data is needed to decode the following buffers but its output is not presented
+#define BUFFER_FLAG_PREROLL 0x00000008
 
 // Align value template
 template <typename T>
@@ -83,6 +87,9 @@ public:
 
     virtual std::shared_ptr<BufferMeta> Clone() = 0;
 
+    /// Remove all the tags and reset the fields to their defaults, e.g. when the buffer is reused.
+    virtual void Clear();
+
 protected:
     /// Constructor
     explicit BufferMeta(BufferMetaType type);
@@ -109,6 +116,8 @@ public:
 
     std::shared_ptr<BufferMeta> Clone() override;
 
+    void Clear() override;
+
     /// the number of valid samples in the buffer
     size_t samples {0};
 
@@ -152,6 +161,8 @@ public:
 
     std::shared_ptr<BufferMeta> Clone() override;
 
+    void Clear() override;
+
     /// describing video formats.
     VideoPixelFormat videoPixelFormat {VideoPixelFormat::UNKNOWN};
 
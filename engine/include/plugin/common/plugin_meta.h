@@ -90,11 +90,15 @@ public:
         tag == Tag::VIDEO_MAX_SURFACE_NUM or
         tag == Tag::VIDEO_H264_LEVEL or
         tag == Tag::BITS_PER_CODED_SAMPLE or
+        tag == Tag::MEDIA_FRAGMENT_KEY_FRAMES or
+        tag == Tag::MEDIA_SYNC_INTERVAL or
         tag == Tag::USER_FRAME_NUMBER, uint32_t);
     DEFINE_INSERT_GET_FUNC(
         tag == Tag::MEDIA_DURATION or
         tag == Tag::MEDIA_BITRATE or
         tag == Tag::MEDIA_START_TIME or
+        tag == Tag::MEDIA_FRAGMENT_DURATION or
+        tag == Tag::MEDIA_READ_DURATION or
         tag == Tag::USER_FRAME_PTS or
         tag == Tag::USER_PUSH_DATA_TIME or
         tag == Tag::USER_PUSH_DATA_TIME or
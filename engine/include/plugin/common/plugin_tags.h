@@ -138,6 +138,10 @@ enum struct Tag : uint32_t {
     MEDIA_EDITLIST,                        ///< int32_t, use edit list
     MEDIA_AIGC,                            ///< string, AIGC info
     MEDIA_ENCODER,                         ///< string, encoder info
+    MEDIA_FRAGMENT_DURATION,               ///< int64_t, fragment duration of a fragmented output, 0 for none
+    MEDIA_FRAGMENT_KEY_FRAMES,             ///< uint32_t, key frames per fragment of a fragmented output, 0 for none
+    MEDIA_SYNC_INTERVAL,                   ///< uint32_t, ms between background syncs of a file output, 0 for none
+    MEDIA_READ_DURATION,                   ///< int64_t, duration a demuxer reads into one buffer, {@link HST_TIME_BASE}
 
     /* -------------------- audio universal tag -------------------- */
     AUDIO_CHANNELS = SECTION_AUDIO_UNIVERSAL_START + 1, ///< uint32_t, stream channel num
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISTREAMER_PLUGIN_CONVERT_AUDIO_RESAMPLER_H
+#define HISTREAMER_PLUGIN_CONVERT_AUDIO_RESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "plugin/common/plugin_audio_tags.h"
+#include "plugin/common/plugin_types.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+struct AudioResamplerPara {
+    uint32_t channels {2}; // 2: STEREO
+    uint32_t srcSampleRate {0};
+    uint32_t destSampleRate {0};
+    AudioSampleFormat srcFmt {AudioSampleFormat::S16};
+    AudioSampleFormat destFmt {AudioSampleFormat::S16};
+};
+
+enum struct AudioResampleMode : uint8_t {
+    PASSTHROUGH,
+    FORMAT_ONLY,
+    INTEGER_UPSAMPLE,
+    INTEGER_DOWNSAMPLE,
+};
+
+/**
+ * Native resampler for the sink path. Handles passthrough, sample format conversion and integer ratio rate
+ * conversion (e.g. 48k <-> 96k, 44.1k <-> 88.2k) with a polyphase windowed-sinc filter. Filter history is kept
+ * across Convert() calls, so buffers can be fed one by one as they arrive.
+ *
+ * Supported source formats: U8, S16, S16P, S24 (packed), S32, S32P, F32, F32P.
+ * Supported destination formats: S16, S32, F32 (interleaved).
+ */
+class AudioResampler {
+public:
+    AudioResampler() = default;
+    ~AudioResampler() = default;
+
+    Status Init(const AudioResamplerPara& para);
+
+    /**
+     * Convert one buffer. destBuffer points to internal memory valid until the next call, or to srcBuffer in
+     * passthrough mode.
+     */
+    Status Convert(const uint8_t* srcBuffer, size_t srcLength, uint8_t*& destBuffer, size_t& destLength);
+
+    /**
+     * Drop the filter history, call it on flush or seek.
+     */
+    void Reset();
+
+    AudioResampleMode GetMode() const
+    {
+        return mode_;
+    }
+
+    /**
+     * @return filter group delay in destination frames
+     */
+    double GetDelayFrames() const;
+
+    static bool IsFormatSupported(AudioSampleFormat fmt, bool isDest);
+
+    static bool IsIntegerRatio(uint32_t srcSampleRate, uint32_t destSampleRate);
+
+    static constexpr uint32_t MAX_INTEGER_RATIO = 8;
+    static constexpr uint32_t TAPS_PER_PHASE = 32;
+
+private:
+    void DesignFilter(uint32_t ratio);
+    size_t DecodeToFloat(const uint8_t* src, size_t srcLength);
+    size_t Upsample(size_t frames);
+    size_t Downsample(size_t frames);
+    void EncodeFromFloat(const float* src, size_t samples, uint8_t* dest);
+
+    AudioResamplerPara para_ {};
+    AudioResampleMode mode_ {AudioResampleMode::PASSTHROUGH};
+    uint32_t ratio_ {1};
+    size_t srcBytesPerSample_ {0};
+    size_t destBytesPerSample_ {0};
+
+    // per phase reversed coefficients, phase-major, TAPS_PER_PHASE each
+    std::vector<float> phaseTaps_ {};
+    // full prototype filter reversed, used by downsampling
+    std::vector<float> taps_ {};
+    size_t historyFrames_ {0};
+    size_t nextInputPos_ {0};
+
+    // planar working buffers: history followed by the new input of each channel
+    std::vector<std::vector<float>> channelBuf_ {};
+    std::vector<float> interleaved_ {};
+    std::vector<uint8_t> destCache_ {};
+};
+} // namespace Plugin
+} // namespace Media
+} // namespace OHOS
+#endif // HISTREAMER_PLUGIN_CONVERT_AUDIO_RESAMPLER_H
@@ -202,7 +202,7 @@ ErrorCode DemuxerFilter::SetParameter(int32_t key, const Plugin::Any& value)
 ErrorCode DemuxerFilter::GetParameter(int32_t key, Plugin::Any& value)
 {
     FALSE_RETURN_V_MSG(plugin_ != nullptr, ErrorCode::ERROR_INVALID_OPERATION, "plugin is nullptr");
-    return TranslatePluginStatus(plugin_->SetParameter(static_cast<Plugin::Tag>(key), value));
+    return TranslatePluginStatus(plugin_->GetParameter(static_cast<Plugin::Tag>(key), value));
 }
 
 ErrorCode DemuxerFilter::Prepare()
@@ -265,9 +265,17 @@ ErrorCode DemuxerFilter::SeekTo(int64_t seekTime, Plugin::SeekMode mode, int64_t
         MEDIA_LOG_E("SeekTo failed due to no valid plugin");
         return ErrorCode::ERROR_INVALID_OPERATION;
     }
+    prerollEnd_ = HST_TIME_NONE;
     auto rtv = TranslatePluginStatus(plugin_->SeekTo(-1, seekTime, mode, realSeekTime));
     if (rtv != ErrorCode::SUCCESS) {
         MEDIA_LOG_E("SeekTo failed with return value: " PUBLIC_LOG_D32, static_cast<int>(rtv));
+        return rtv;
+    }
+    if (mode == Plugin::SeekMode::SEEK_CLOSEST && realSeekTime < seekTime) {
+        // the plugin stopped at the sync sample before the target, the frames in between only feed the decoders
+        MEDIA_LOG_I("preroll from " PUBLIC_LOG_D64 " to " PUBLIC_LOG_D64, realSeekTime, seekTime);
+        prerollEnd_ = seekTime;
+        realSeekTime = seekTime;
     }
     return rtv;
 }
@@ -335,6 +343,8 @@ bool DemuxerFilter::InitPlugin(std::string pluginName)
     }
     MEDIA_LOG_I("InitPlugin, " PUBLIC_LOG_S " used.", pluginName_.c_str());
     (void)plugin_->SetDataSource(std::reinterpret_pointer_cast<Plugin::DataSourceHelper>(dataSource_));
+    // tells a local file from a network source, plugins not interested in it ignore it
+    (void)plugin_->SetParameter(Plugin::Tag::MEDIA_FILE_URI, uri_);
     pluginState_ = DemuxerState::DEMUXER_STATE_PARSE_HEADER;
     return plugin_->Prepare() == Plugin::Status::OK;
 }
@@ -530,6 +540,9 @@ void DemuxerFilter::HandleFrame(const AVBufferPtr& bufferPtr, uint32_t trackId)
         if (stream.trackId != trackId) {
             continue;
         }
+        if (bufferPtr->pts < prerollEnd_.load()) {
+            bufferPtr->flag |= BUFFER_FLAG_PREROLL;
+        }
         stream.port->PushData(bufferPtr, -1);
         break;
     }
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define HST_LOG_TAG "DataSpliter"
+
+#include "pipeline/filters/muxer/data_spliter.h"
+#include <algorithm>
+#include "foundation/log.h"
+#include "foundation/osal/thread/scoped_lock.h"
+#include "plugin/common/plugin_time.h"
+
+namespace OHOS {
+namespace Media {
+namespace Pipeline {
+void DataSpliter::SetMaxOutputSize(size_t size)
+{
+    OSAL::ScopedLock lock(mutex_);
+    maxOutputSize_ = size;
+}
+
+void DataSpliter::SetMaxDurationUs(size_t duration)
+{
+    OSAL::ScopedLock lock(mutex_);
+    maxDurationUs_ = duration;
+}
+
+void DataSpliter::AddTrack(int32_t trackId, bool isVideo)
+{
+    OSAL::ScopedLock lock(mutex_);
+    videoTracks_[trackId] = isVideo;
+    hasVideo_ = hasVideo_ || isVideo;
+}
+
+void DataSpliter::ClearTracks()
+{
+    OSAL::ScopedLock lock(mutex_);
+    videoTracks_.clear();
+    hasVideo_ = false;
+}
+
+void DataSpliter::AddNextOutput()
+{
+    OSAL::ScopedLock lock(mutex_);
+    nextOutputs_++;
+    waitOutputLogged_ = false;
+}
+
+void DataSpliter::RequestNextSegment()
+{
+    OSAL::ScopedLock lock(mutex_);
+    nextRequested_ = true;
+}
+
+void DataSpliter::OnOutputWritten(int64_t offset, size_t size)
+{
+    OSAL::ScopedLock lock(mutex_);
+    // rewriting the header in place does not grow the output
+    segmentSize_ = offset >= 0 ? std::max(segmentSize_, static_cast<size_t>(offset) + size) : segmentSize_ + size;
+}
+
+void DataSpliter::OnOutputSwitched()
+{
+    OSAL::ScopedLock lock(mutex_);
+    segmentSize_ = 0;
+}
+
+ErrorCode DataSpliter::SplitIfNeeded(int32_t trackId, const AVBufferPtr& buffer)
+{
+    int64_t time = buffer->pts;
+    SplitFunc splitFunc;
+    {
+        OSAL::ScopedLock lock(mutex_);
+        if (!started_) {
+            started_ = true;
+            segmentStartTime_ = time;
+            segmentCount_ = 1;
+            return ErrorCode::SUCCESS;
+        }
+        if (!(nextRequested_ || IsLimitReached(time)) || !IsSplitPoint(trackId, buffer)) {
+            return ErrorCode::SUCCESS;
+        }
+        if (nextOutputs_ == 0 || !splitFunc_) {
+            if (!waitOutputLogged_) {
+                MEDIA_LOG_W("segment " PUBLIC_LOG_U32 " reached its end, but no next output is set, keep writing",
+                            segmentCount_);
+                waitOutputLogged_ = true;
+            }
+            return ErrorCode::SUCCESS;
+        }
+        splitFunc = splitFunc_;
+    }
+    // the split function writes through OnOutputWritten(), so it must not run under mutex_
+    auto ret = splitFunc();
+    OSAL::ScopedLock lock(mutex_);
+    if (ret != ErrorCode::SUCCESS) {
+        MEDIA_LOG_E("start segment " PUBLIC_LOG_U32 " failed", segmentCount_ + 1);
+        return ret;
+    }
+    nextOutputs_--;
+    nextRequested_ = false;
+    segmentCount_++;
+    segmentStartTime_ = time;
+    MEDIA_LOG_I("segment " PUBLIC_LOG_U32 " starts at " PUBLIC_LOG_D64 " ms", segmentCount_, Plugin::HstTime2Ms(time));
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode DataSpliter::PushData(int32_t trackId, std::shared_ptr<AVBuffer> buffer)
+{
+    FAIL_RETURN(SplitIfNeeded(trackId, buffer));
+    RebaseTime(buffer);
+    FALSE_RETURN_V(muxer_ != nullptr, ErrorCode::ERROR_INVALID_STATE);
+    return muxer_->WriteFrame(buffer) == Plugin::Status::OK ? ErrorCode::SUCCESS : ErrorCode::ERROR_UNKNOWN;
+}
+
+ErrorCode DataSpliter::Start()
+{
+    OSAL::ScopedLock lock(mutex_);
+    started_ = false;
+    nextRequested_ = false;
+    waitOutputLogged_ = false;
+    nextOutputs_ = 0;
+    segmentCount_ = 0;
+    segmentSize_ = 0;
+    return ErrorCode::SUCCESS;
+}
+
+void DataSpliter::RebaseTime(const AVBufferPtr& buffer)
+{
+    int64_t startTime = 0;
+    {
+        OSAL::ScopedLock lock(mutex_);
+        startTime = segmentStartTime_;
+    }
+    // the same offset for all tracks keeps them in sync, a sample a little older than the split point starts at 0
+    if (buffer->pts != HST_TIME_NONE) {
+        buffer->pts = std::max<int64_t>(buffer->pts - startTime, 0);
+    }
+    if (buffer->dts != HST_TIME_NONE) {
+        buffer->dts = std::max<int64_t>(buffer->dts - startTime, 0);
+    }
+}
+
+uint32_t DataSpliter::GetSegmentCount()
+{
+    OSAL::ScopedLock lock(mutex_);
+    return segmentCount_;
+}
+
+bool DataSpliter::IsSplitPoint(int32_t trackId, const AVBufferPtr& buffer)
+{
+    if (!hasVideo_) {
+        return true;
+    }
+    auto iter = videoTracks_.find(trackId);
+    return iter != videoTracks_.end() && iter->second && (buffer->flag & BUFFER_FLAG_KEY_FRAME);
+}
+
+bool DataSpliter::IsLimitReached(int64_t time)
+{
+    if (maxDurationUs_ > 0 && time - segmentStartTime_ >= static_cast<int64_t>(maxDurationUs_) * HST_USECOND) {
+        return true;
+    }
+    return maxOutputSize_ > 0 && segmentSize_ >= maxOutputSize_;
+}
+} // Pipeline
+} // Media
+} // OHOS
@@ -16,17 +16,35 @@
 #ifndef HISTREAMER_PIPELINE_DATA_SPLITER_H
 #define HISTREAMER_PIPELINE_DATA_SPLITER_H
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <utility>
+#include "foundation/osal/thread/mutex.h"
 #include "pipeline/core/error_code.h"
 #include "pipeline/core/type_define.h"
+#include "plugin/core/muxer.h"
 
 namespace OHOS {
 namespace Media {
 namespace Pipeline {
+class Filter;
+
+/**
+ * Splits the muxer output into segments. Samples arrive in decoding order, and a new segment is started in front of
+ * a key frame of the video track (or any sample when there is no video track) once the max duration or size of the
+ * current segment is reached, or once the next segment is requested explicitly. The split itself (finishing the
+ * current output and starting the next one) is done by the split function, a segment is only started when an output
+ * for it has been announced by AddNextOutput(). The samples written by PushData() are timed from the start of their
+ * segment.
+ */
 class DataSpliter {
 public:
+    using SplitFunc = std::function<ErrorCode()>;
+
     DataSpliter() = default;
+    virtual ~DataSpliter() = default;
+
     void SetNextFilter(std::shared_ptr<Filter> output)
     {
         nextFilter_ = std::move(output);
@@ -37,37 +55,89 @@ public:
         muxer_ = std::move(muxer);
     }
 
-    ErrorCode FinishWithoutDrain()
-    {
-        return ErrorCode::SUCCESS;
-    }
-
-    void SetMaxOutputSize(size_t size)
-    {
-        maxOutputSize_ = size;
-    }
-    void SetMaxDurationUs(size_t duration)
+    void SetSplitFunc(SplitFunc splitFunc)
     {
-        maxDurationUs_ = duration;
+        splitFunc_ = std::move(splitFunc);
     }
-    virtual ErrorCode PushData(int32_t trackId, std::shared_ptr<AVBuffer> buffer) = 0;
 
-    virtual ErrorCode Start()
+    ErrorCode FinishWithoutDrain()
     {
         return ErrorCode::SUCCESS;
     }
+
+    void SetMaxOutputSize(size_t size);
+
+    void SetMaxDurationUs(size_t duration);
+
+    void AddTrack(int32_t trackId, bool isVideo);
+
+    void ClearTracks();
+
+    /**
+     * One more output is ready to take a segment.
+     */
+    void AddNextOutput();
+
+    /**
+     * Start the next segment at the next split point, regardless of the limits.
+     */
+    void RequestNextSegment();
+
+    /**
+     * @param offset write position in the current output, negative for appending
+     */
+    void OnOutputWritten(int64_t offset, size_t size);
+
+    /**
+     * The output of the next segment is in use, bytes written from now on count for the new segment.
+     */
+    void OnOutputSwitched();
+
+    /**
+     * Start a new segment in front of this sample if needed.
+     */
+    ErrorCode SplitIfNeeded(int32_t trackId, const AVBufferPtr& buffer);
+
+    /**
+     * Make the time of a sample relative to the start of its segment, so that every output starts at 0.
+     */
+    void RebaseTime(const AVBufferPtr& buffer);
+
+    virtual ErrorCode PushData(int32_t trackId, std::shared_ptr<AVBuffer> buffer);
+
+    virtual ErrorCode Start();
+
     virtual ErrorCode Stop()
     {
         return ErrorCode::SUCCESS;
     }
 
+    uint32_t GetSegmentCount();
+
 protected:
-    static const size_t DEFAULT_MAX_DURATION_US = 60 * 1000 * 1000;
+    // 0 means no limit
+    static const size_t DEFAULT_MAX_DURATION_US = 0;
     static const size_t DEFAULT_MAX_OUTPUT_SIZE = 0;
     std::shared_ptr<Filter> nextFilter_ {};
     std::shared_ptr<Plugin::Muxer> muxer_ {};
     size_t maxOutputSize_{DEFAULT_MAX_OUTPUT_SIZE};
     size_t maxDurationUs_{DEFAULT_MAX_DURATION_US};
+
+private:
+    bool IsSplitPoint(int32_t trackId, const AVBufferPtr& buffer);
+    bool IsLimitReached(int64_t time);
+
+    OSAL::Mutex mutex_ {};
+    SplitFunc splitFunc_ {};
+    std::map<int32_t, bool> videoTracks_ {};
+    bool hasVideo_ {false};
+    bool started_ {false};
+    bool nextRequested_ {false};
+    bool waitOutputLogged_ {false};
+    uint32_t nextOutputs_ {0};
+    uint32_t segmentCount_ {0};
+    int64_t segmentStartTime_ {0};
+    size_t segmentSize_ {0};
 };
 } // Pipeline
 } // Media
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define HST_LOG_TAG "InterleaveQueue"
+
+#include "pipeline/filters/muxer/interleave_queue.h"
+#include <algorithm>
+#include "foundation/log.h"
+#include "foundation/osal/thread/scoped_lock.h"
+
+namespace OHOS {
+namespace Media {
+namespace Pipeline {
+namespace {
+constexpr int64_t NS_PER_MS = 1000000;
+
+inline int64_t SampleTime(const AVBufferPtr& buffer)
+{
+    return buffer->pts;
+}
+}
+
+InterleaveQueue::InterleaveQueue(WriteFunc writer) : writer_(std::move(writer))
+{
+}
+
+void InterleaveQueue::SetMaxInterleaveDelta(int64_t maxDelta)
+{
+    OSAL::ScopedLock lock(mutex_);
+    maxDelta_ = maxDelta > 0 ? maxDelta : DEFAULT_MAX_INTERLEAVE_DELTA;
+}
+
+void InterleaveQueue::SetMaxQueuedPerTrack(size_t maxQueued)
+{
+    OSAL::ScopedLock lock(mutex_);
+    maxQueued_ = maxQueued > 0 ? maxQueued : DEFAULT_MAX_QUEUED_PER_TRACK;
+}
+
+void InterleaveQueue::SetMaxWaitMs(int32_t maxWaitMs)
+{
+    OSAL::ScopedLock lock(mutex_);
+    maxWaitMs_ = maxWaitMs >= 0 ? maxWaitMs : DEFAULT_MAX_WAIT_MS;
+}
+
+void InterleaveQueue::AddTrack(int32_t trackId)
+{
+    OSAL::ScopedLock lock(mutex_);
+    tracks_[trackId] = TrackQueue {};
+}
+
+ErrorCode InterleaveQueue::Push(int32_t trackId, const AVBufferPtr& buffer)
+{
+    FALSE_RETURN_V(buffer != nullptr, ErrorCode::ERROR_NULL_POINTER);
+    OSAL::ScopedLock lock(mutex_);
+    if (tracks_.find(trackId) == tracks_.end()) {
+        MEDIA_LOG_E("push data to unknown track " PUBLIC_LOG_D32, trackId);
+        return ErrorCode::ERROR_INVALID_PARAMETER_VALUE;
+    }
+    int64_t time = SampleTime(buffer);
+    if (!interrupted_ && IsTooFarAhead(trackId, time)) {
+        // the slower tracks wake us up when they push, the timeout avoids stalling on a track that stopped
+        stats_.backPressureCount++;
+        int64_t deadline = OSAL::ConditionVariable::GetClockTimeNs() + maxWaitMs_ * NS_PER_MS;
+        while (!interrupted_ && IsTooFarAhead(trackId, time)) {
+            if (!cond_.WaitUntil(lock, deadline) && OSAL::ConditionVariable::GetClockTimeNs() >= deadline) {
+                stats_.backPressureTimeoutCount++;
+                break;
+            }
+        }
+    }
+    auto iter = tracks_.find(trackId);
+    if (interrupted_ || iter == tracks_.end()) {
+        MEDIA_LOG_D("interleave queue is interrupted, drop data of track " PUBLIC_LOG_D32, trackId);
+        return ErrorCode::ERROR_INVALID_OPERATION;
+    }
+    auto& track = iter->second;
+    track.samples.emplace_back(buffer);
+    track.lastTime = time;
+    track.started = true;
+    DrainLocked(false);
+    cond_.NotifyAll();
+    WriteReady(lock);
+    return ErrorCode::SUCCESS;
+}
+
+void InterleaveQueue::SetTrackEos(int32_t trackId)
+{
+    OSAL::ScopedLock lock(mutex_);
+    auto iter = tracks_.find(trackId);
+    if (iter == tracks_.end()) {
+        return;
+    }
+    iter->second.eos = true;
+    bool allEos = std::all_of(tracks_.begin(), tracks_.end(), [](const auto& item) { return item.second.eos; });
+    DrainLocked(allEos);
+    cond_.NotifyAll();
+    WriteReady(lock);
+}
+
+bool InterleaveQueue::AllTracksEos()
+{
+    OSAL::ScopedLock lock(mutex_);
+    return !tracks_.empty() &&
+        std::all_of(tracks_.begin(), tracks_.end(), [](const auto& item) { return item.second.eos; });
+}
+
+void InterleaveQueue::Flush()
+{
+    OSAL::ScopedLock lock(mutex_);
+    DrainLocked(true);
+    cond_.NotifyAll();
+    WriteReady(lock);
+    // another pusher may still be writing the samples in front of ours
+    cond_.Wait(lock, [this] { return !writing_ || interrupted_; });
+}
+
+void InterleaveQueue::Interrupt()
+{
+    OSAL::ScopedLock lock(mutex_);
+    interrupted_ = true;
+    ready_.clear();
+    cond_.NotifyAll();
+}
+
+void InterleaveQueue::Resume()
+{
+    OSAL::ScopedLock lock(mutex_);
+    if (!interrupted_) {
+        return;
+    }
+    for (auto& item : tracks_) {
+        item.second = TrackQueue {};
+    }
+    ready_.clear();
+    interrupted_ = false;
+}
+
+void InterleaveQueue::Reset()
+{
+    OSAL::ScopedLock lock(mutex_);
+    MEDIA_LOG_I("written " PUBLIC_LOG_U64 ", forced " PUBLIC_LOG_U64 ", back pressure " PUBLIC_LOG_U64
+                ", back pressure timeout " PUBLIC_LOG_U64, stats_.writtenCount, stats_.forcedCount,
+                stats_.backPressureCount, stats_.backPressureTimeoutCount);
+    tracks_.clear();
+    ready_.clear();
+    stats_ = InterleaveStats {};
+    interrupted_ = false;
+    cond_.NotifyAll();
+}
+
+InterleaveStats InterleaveQueue::GetStats()
+{
+    OSAL::ScopedLock lock(mutex_);
+    return stats_;
+}
+
+bool InterleaveQueue::IsTooFarAhead(int32_t trackId, int64_t time)
+{
+    for (const auto& item : tracks_) {
+        const auto& track = item.second;
+        if (item.first == trackId || track.eos || !track.started) {
+            continue;
+        }
+        if (time - track.lastTime > maxDelta_) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void InterleaveQueue::DrainLocked(bool force)
+{
+    while (true) {
+        TrackQueue* head = nullptr;
+        bool allHaveData = true;
+        bool anyFull = false;
+        int64_t maxTime = INT64_MIN;
+        for (auto& item : tracks_) {
+            auto& track = item.second;
+            if (track.samples.empty()) {
+                allHaveData = allHaveData && track.eos;
+                continue;
+            }
+            if (head == nullptr || SampleTime(track.samples.front()) < SampleTime(head->samples.front())) {
+                head = &track;
+            }
+            maxTime = std::max(maxTime, SampleTime(track.samples.back()));
+            anyFull = anyFull || track.samples.size() >= maxQueued_;
+        }
+        if (head == nullptr) {
+            return;
+        }
+        bool deltaExceeded = maxTime - SampleTime(head->samples.front()) > maxDelta_;
+        if (!force && !allHaveData && !deltaExceeded && !anyFull) {
+            return;
+        }
+        if (!allHaveData) {
+            stats_.forcedCount++;
+        }
+        ready_.emplace_back(head->samples.front());
+        head->samples.pop_front();
+        stats_.writtenCount++;
+    }
+}
+
+void InterleaveQueue::WriteReady(OSAL::ScopedLock& lock)
+{
+    if (writing_) {
+        // the thread writing now also takes the samples we added, in order
+        return;
+    }
+    writing_ = true;
+    while (!ready_.empty() && !interrupted_) {
+        auto buffer = ready_.front();
+        ready_.pop_front();
+        lock.Unlock();
+        writer_(buffer);
+        lock.Lock();
+    }
+    writing_ = false;
+    cond_.NotifyAll();
+}
+} // Pipeline
+} // Media
+} // OHOS
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISTREAMER_PIPELINE_INTERLEAVE_QUEUE_H
+#define HISTREAMER_PIPELINE_INTERLEAVE_QUEUE_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include "foundation/osal/thread/condition_variable.h"
+#include "foundation/osal/thread/mutex.h"
+#include "pipeline/core/error_code.h"
+#include "pipeline/core/type_define.h"
+#include "plugin/common/plugin_time.h"
+
+namespace OHOS {
+namespace Media {
+namespace Pipeline {
+struct InterleaveStats {
+    uint64_t writtenCount {0};
+    uint64_t forcedCount {0}; // written before every track had data, because the delta or queue size was exceeded
+    uint64_t backPressureCount {0};
+    uint64_t backPressureTimeoutCount {0};
+};
+
+/**
+ * Orders samples of several tracks by decoding time before they reach the muxer plugin, so that the file is written
+ * in one sequential pass. The decoding time is the pts, which the muxer plugin also writes as dts since the encoders
+ * do not reorder frames. A sample is written once every track that has not reached eos has queued data, or once the
+ * queued time range exceeds the max interleave delta. A track running more than the delta ahead of a slower track
+ * is blocked in Push() until the slower one catches up, or until the max wait elapses.
+ *
+ * The write function is called without the internal lock, so a slow write (like the split of a segment) does not
+ * block the other pushers. It is called by one thread at a time in dts order, from whichever thread pushed the data.
+ */
+class InterleaveQueue {
+public:
+    using WriteFunc = std::function<void(const AVBufferPtr& buffer)>;
+
+    explicit InterleaveQueue(WriteFunc writer);
+    ~InterleaveQueue() = default;
+
+    /**
+     * @param maxDelta max time distance between the queued samples, based on {@link HST_TIME_BASE}
+     */
+    void SetMaxInterleaveDelta(int64_t maxDelta);
+
+    void SetMaxQueuedPerTrack(size_t maxQueued);
+
+    void SetMaxWaitMs(int32_t maxWaitMs);
+
+    void AddTrack(int32_t trackId);
+
+    /**
+     * Queue one sample, may block the caller to apply back pressure.
+     */
+    ErrorCode Push(int32_t trackId, const AVBufferPtr& buffer);
+
+    /**
+     * The track will not deliver any more samples, the others are no longer held back by it.
+     */
+    void SetTrackEos(int32_t trackId);
+
+    bool AllTracksEos();
+
+    /**
+     * Write out everything still queued in dts order, returns once it is written.
+     */
+    void Flush();
+
+    /**
+     * Wake up blocked pushers and drop samples until Reset().
+     */
+    void Interrupt();
+
+    /**
+     * Accept samples again after Interrupt(), keeps the tracks but drops what was queued before.
+     */
+    void Resume();
+
+    /**
+     * Drop queued samples and tracks.
+     */
+    void Reset();
+
+    InterleaveStats GetStats();
+
+    static constexpr int64_t DEFAULT_MAX_INTERLEAVE_DELTA = HST_SECOND;
+    static constexpr size_t DEFAULT_MAX_QUEUED_PER_TRACK = 256;
+    static constexpr int32_t DEFAULT_MAX_WAIT_MS = 50;
+
+private:
+    struct TrackQueue {
+        std::deque<AVBufferPtr> samples {};
+        int64_t lastTime {0};
+        bool started {false};
+        bool eos {false};
+    };
+
+    bool IsTooFarAhead(int32_t trackId, int64_t time);
+    void DrainLocked(bool force);
+    void WriteReady(OSAL::ScopedLock& lock);
+
+    OSAL::Mutex mutex_ {};
+    OSAL::ConditionVariable cond_ {};
+    WriteFunc writer_;
+    std::map<int32_t, TrackQueue> tracks_ {};
+    std::deque<AVBufferPtr> ready_ {}; // taken out of the track queues in dts order, not written yet
+    bool writing_ {false};
+    int64_t maxDelta_ {DEFAULT_MAX_INTERLEAVE_DELTA};
+    size_t maxQueued_ {DEFAULT_MAX_QUEUED_PER_TRACK};
+    int32_t maxWaitMs_ {DEFAULT_MAX_WAIT_MS};
+    bool interrupted_ {false};
+    InterleaveStats stats_ {};
+};
+} // Pipeline
+} // Media
+} // OHOS
+#endif // HISTREAMER_PIPELINE_INTERLEAVE_QUEUE_H
@@ -18,11 +18,14 @@
 
 #include "pipeline/filters/muxer/muxer_filter.h"
 #include "foundation/log.h"
+#include "foundation/osal/thread/scoped_lock.h"
 #include "pipeline/factory/filter_factory.h"
 #include "pipeline/filters/common/plugin_settings.h"
 #include "pipeline/filters/common/plugin_utils.h"
 #include "pipeline/filters/muxer/data_spliter.h"
+#include "pipeline/filters/muxer/interleave_queue.h"
 #include "plugin/common/plugin_attr_desc.h"
+#include "plugin/common/plugin_time.h"
 
 namespace OHOS {
 namespace Media {
@@ -49,6 +52,12 @@ MuxerFilter::MuxerFilter(std::string name) : FilterBase(std::move(name)),
     muxerDataSink_(std::make_shared<MuxerDataSink>())
 {
     filterType_ = FilterType::MUXER;
+    dataSpliter_ = std::make_shared<DataSpliter>();
+    dataSpliter_->SetSplitFunc([this]() { return StartNextOutput(); });
+    interleaveQueue_ = std::make_shared<InterleaveQueue>([this](const AVBufferPtr& buffer) {
+        dataSpliter_->PushData(static_cast<int32_t>(buffer->trackID), buffer);
+    });
+    closeTask_ = std::make_shared<OSAL::Task>("MuxerCloseOutput", [this] { CloseOutput(); });
 }
 
 MuxerFilter::~MuxerFilter() {}
@@ -91,6 +100,7 @@ bool MuxerFilter::UpdateAndInitPluginByInfo(const std::shared_ptr<Plugin::Plugin
     }
     plugin_->SetCallback(this);
     targetPluginInfo_ = selectedPluginInfo;
+    dataSpliter_->SetMuxerPlugin(plugin_);
     return true;
 }
 
@@ -134,20 +144,34 @@ bool MuxerFilter::Negotiate(const std::string& inPort,
 ErrorCode MuxerFilter::AddTrackThenConfigure(const std::pair<std::string, Plugin::Meta>& metaPair)
 {
     uint32_t trackId = 0;
-    ErrorCode isTranSuccess = TranslatePluginStatus(plugin_->AddTrack(trackId));
+    auto ret = AddPluginTrack(plugin_, metaPair.second, trackId);
+    if (ret != ErrorCode::SUCCESS) {
+        return ret;
+    }
+    trackInfos_.emplace_back(TrackInfo{static_cast<int32_t>(trackId), metaPair.first, false});
+    interleaveQueue_->AddTrack(static_cast<int32_t>(trackId));
+    std::string mime;
+    dataSpliter_->AddTrack(static_cast<int32_t>(trackId),
+        metaPair.second.Get<Plugin::Tag::MIME>(mime) && mime.compare(0, 6, "video/") == 0); // 6: length of video/
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode MuxerFilter::AddPluginTrack(const std::shared_ptr<Plugin::Muxer>& plugin, const Plugin::Meta& meta,
+                                      uint32_t& trackId)
+{
+    ErrorCode isTranSuccess = TranslatePluginStatus(plugin->AddTrack(trackId));
     if (isTranSuccess != ErrorCode::SUCCESS) {
         MEDIA_LOG_E("muxer plugin add track failed");
         return isTranSuccess;
     }
-    trackInfos_.emplace_back(TrackInfo{static_cast<int32_t>(trackId), metaPair.first, false});
     auto parameterMap = PluginParameterTable::GetInstance().FindAllowedParameterMap(filterType_);
     for (const auto& keyPair : parameterMap) {
         Plugin::ValueType outValue;
-        auto isGetSuccess = metaPair.second.GetData(static_cast<Plugin::Tag>(keyPair.first), outValue);
+        auto isGetSuccess = meta.GetData(static_cast<Plugin::Tag>(keyPair.first), outValue);
         if (isGetSuccess &&
             (keyPair.second.second & PARAM_SET) &&
             keyPair.second.first(keyPair.first, outValue)) {
-            plugin_->SetTrackParameter(trackId, keyPair.first, outValue);
+            plugin->SetTrackParameter(trackId, keyPair.first, outValue);
         } else {
             if (!Plugin::HasTagInfo(keyPair.first)) {
                 MEDIA_LOG_W("tag " PUBLIC_LOG_D32 " is not in map, may be update it?", keyPair.first);
@@ -163,6 +187,10 @@ ErrorCode MuxerFilter::AddTrackThenConfigure(const std::pair<std::string, Plugin
 ErrorCode MuxerFilter::ConfigureToStart()
 {
     ErrorCode ret;
+    trackInfos_.clear();
+    eosTrackCnt = 0;
+    interleaveQueue_->Reset();
+    dataSpliter_->ClearTracks();
     for (const auto& cache: metaCache_) {
         ret = AddTrackThenConfigure(cache);
         if (ret != ErrorCode::SUCCESS) {
@@ -170,8 +198,7 @@ ErrorCode MuxerFilter::ConfigureToStart()
             return ret;
         }
     }
-    // todo add other global meta
-
+    SetPluginParameters(plugin_);
     ret = TranslatePluginStatus(plugin_->Prepare());
     if (ret != ErrorCode::SUCCESS) {
         MEDIA_LOG_E("muxer plugin prepare failed");
@@ -238,25 +265,132 @@ ErrorCode MuxerFilter::AddTrack(std::shared_ptr<InPort> &trackPort)
 
 ErrorCode MuxerFilter::SetMaxDuration(uint64_t maxDuration)
 {
+    dataSpliter_->SetMaxDurationUs(static_cast<size_t>(maxDuration / HST_USECOND));
     return ErrorCode::SUCCESS;
 }
 
+ErrorCode MuxerFilter::SetFragmentParameters(int64_t fragmentDuration, uint32_t keyFrames)
+{
+    FALSE_LOG(pluginParameters_.Set<Plugin::Tag::MEDIA_FRAGMENT_DURATION>(fragmentDuration > 0 ? fragmentDuration : 0));
+    FALSE_LOG(pluginParameters_.Set<Plugin::Tag::MEDIA_FRAGMENT_KEY_FRAMES>(keyFrames));
+    return ErrorCode::SUCCESS;
+}
+
+void MuxerFilter::SetPluginParameters(const std::shared_ptr<Plugin::Muxer>& plugin)
+{
+    // the plugin drops its parameters on reset, they are set again for each output
+    for (const auto& pair : pluginParameters_) {
+        if (plugin->SetParameter(pair.first, pair.second) != Plugin::Status::OK) {
+            MEDIA_LOG_W("muxer plugin does not take parameter " PUBLIC_LOG_S, Plugin::GetTagStrName(pair.first));
+        }
+    }
+}
+
 ErrorCode MuxerFilter::SetMaxSize(uint64_t maxSize)
 {
+    dataSpliter_->SetMaxOutputSize(static_cast<size_t>(maxSize));
     return ErrorCode::SUCCESS;
 }
 
 ErrorCode MuxerFilter::StartNextSegment()
 {
+    dataSpliter_->RequestNextSegment();
     return ErrorCode::SUCCESS;
 }
 
+ErrorCode MuxerFilter::AddNextOutput()
+{
+    dataSpliter_->AddNextOutput();
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode MuxerFilter::StartNextOutput()
+{
+    // the next file is written by a new plugin with the same tracks, so the next frame is the first one of the new
+    // segment. The current file is finished by closeTask_: its trailer can take long when the sample table is written
+    // at the end, the encoders pushing the next frames do not wait for it. The writes of the new file are held back
+    // until the trailer and the segment end marker are out, the output sink gets the files one after another.
+    FALSE_RETURN_V(plugin_ != nullptr && targetPluginInfo_ != nullptr, ErrorCode::ERROR_INVALID_STATE);
+    auto plugin = Plugin::PluginManager::Instance().CreateMuxerPlugin(targetPluginInfo_->name);
+    FALSE_RETURN_V_MSG_E(plugin != nullptr, ErrorCode::ERROR_UNKNOWN, "cannot create plugin " PUBLIC_LOG_S,
+                         targetPluginInfo_->name.c_str());
+    auto sink = std::make_shared<MuxerDataSink>();
+    sink->muxerFilter_ = this;
+    sink->Hold();
+    auto ret = StartSegmentPlugin(plugin, sink);
+    if (ret != ErrorCode::SUCCESS) {
+        MEDIA_LOG_E("start plugin of the next segment failed");
+        plugin->Deinit();
+        return ret;
+    }
+    muxerDataSink_->SetClosing();
+    {
+        OSAL::ScopedLock lock(closeMutex_);
+        closingOutputs_.push_back({plugin_, sink});
+        closeTask_->Start();
+    }
+    dataSpliter_->OnOutputSwitched();
+    plugin_ = plugin;
+    muxerDataSink_ = sink;
+    dataSpliter_->SetMuxerPlugin(plugin_);
+    return TranslatePluginStatus(plugin_->WriteHeader());
+}
+
+ErrorCode MuxerFilter::StartSegmentPlugin(const std::shared_ptr<Plugin::Muxer>& plugin,
+                                          const std::shared_ptr<MuxerDataSink>& sink)
+{
+    FAIL_RETURN(TranslatePluginStatus(plugin->Init()));
+    plugin->SetCallback(this);
+    plugin->SetDataSink(sink);
+    SetPluginParameters(plugin);
+    for (size_t i = 0; i < metaCache_.size(); ++i) {
+        uint32_t trackId = 0;
+        FAIL_RETURN(AddPluginTrack(plugin, metaCache_[i].second, trackId));
+        FALSE_RETURN_V_MSG_E(i < trackInfos_.size() && static_cast<int32_t>(trackId) == trackInfos_[i].trackId,
+                             ErrorCode::ERROR_UNKNOWN, "track id changed in the new segment");
+    }
+    FAIL_RETURN(TranslatePluginStatus(plugin->Prepare()));
+    return TranslatePluginStatus(plugin->Start());
+}
+
+void MuxerFilter::CloseOutput()
+{
+    ClosingOutput output;
+    {
+        OSAL::ScopedLock lock(closeMutex_);
+        if (closingOutputs_.empty()) {
+            closeTask_->PauseAsync();
+            return;
+        }
+        // stays queued until it is closed, WaitOutputsClosed() waits for it
+        output = closingOutputs_.front();
+    }
+    output.plugin->WriteTrailer();
+    auto buf = std::make_shared<AVBuffer>();
+    buf->flag |= BUFFER_FLAG_SEGMENT_END;
+    outPorts_[0]->PushData(buf, -1);
+    output.plugin->Deinit();
+    output.nextSink->Release();
+    OSAL::ScopedLock lock(closeMutex_);
+    closingOutputs_.pop_front();
+    closeCond_.NotifyAll();
+}
+
+void MuxerFilter::WaitOutputsClosed()
+{
+    OSAL::ScopedLock lock(closeMutex_);
+    closeCond_.Wait(lock, [this] { return closingOutputs_.empty(); });
+}
+
 ErrorCode MuxerFilter::SendEos()
 {
     OSAL::ScopedLock lock(pushDataMutex_);
     MEDIA_LOG_I("SendEos entered.");
     eos_ = true;
     if (hasWriteHeader_ && plugin_) {
+        interleaveQueue_->Flush();
+        // the last segment goes to the output after the ones before it
+        WaitOutputsClosed();
         plugin_->WriteTrailer();
     }
     hasWriteHeader_ = false;
@@ -271,12 +405,23 @@ bool MuxerFilter::AllTracksEos()
 {
     return static_cast<size_t>(eosTrackCnt.load()) == trackInfos_.size();
 }
+int32_t MuxerFilter::GetTrackIdByInPort(const std::string& inPort)
+{
+    for (const auto& item : trackInfos_) {
+        if (item.inPort == inPort) {
+            return item.trackId;
+        }
+    }
+    return -1;
+}
+
 void MuxerFilter::UpdateEosState(const std::string& inPort)
 {
     int32_t eosCnt = 0;
     for (auto& item : trackInfos_) {
         if (item.inPort == inPort) {
             item.eos = true;
+            interleaveQueue_->SetTrackEos(item.trackId);
         }
         if (item.eos) {
             eosCnt++;
@@ -287,6 +432,7 @@ void MuxerFilter::UpdateEosState(const std::string& inPort)
 
 ErrorCode MuxerFilter::PushData(const std::string& inPort, const AVBufferPtr& buffer, int64_t offset)
 {
+    int32_t trackId = -1;
     {
         OSAL::ScopedLock lock(pushDataMutex_);
         if (state_ != FilterState::READY && state_ != FilterState::PAUSED && state_ != FilterState::RUNNING) {
@@ -297,19 +443,23 @@ ErrorCode MuxerFilter::PushData(const std::string& inPort, const AVBufferPtr& bu
             MEDIA_LOG_D("SendEos exit");
             return ErrorCode::SUCCESS;
         }
-        // todo we should consider more tracks
         if (!hasWriteHeader_) {
             plugin_->WriteHeader();
             hasWriteHeader_ = true;
         }
-        if (buffer->GetMemory()->GetSize() != 0) {
-            plugin_->WriteFrame(buffer);
-        }
-
-        if (buffer->flag & BUFFER_FLAG_EOS) {
-            MEDIA_LOG_I("It is EOS buffer");
-            UpdateEosState(inPort);
-        }
+        trackId = GetTrackIdByInPort(inPort);
+    }
+    FALSE_RETURN_V_MSG_E(trackId >= 0, ErrorCode::ERROR_INVALID_PARAMETER_VALUE,
+                         "no track for inPort " PUBLIC_LOG_S, inPort.c_str());
+    if (buffer->GetMemory()->GetSize() != 0) {
+        // queue outside of pushDataMutex_, Push() may hold this track back until the others catch up
+        buffer->trackID = static_cast<uint32_t>(trackId);
+        interleaveQueue_->Push(trackId, buffer);
+    }
+    if (buffer->flag & BUFFER_FLAG_EOS) {
+        MEDIA_LOG_I("It is EOS buffer");
+        OSAL::ScopedLock lock(pushDataMutex_);
+        UpdateEosState(inPort);
     }
     if (AllTracksEos()) {
         SendEos();
@@ -319,17 +469,75 @@ ErrorCode MuxerFilter::PushData(const std::string& inPort, const AVBufferPtr& bu
 
 Plugin::Status MuxerFilter::MuxerDataSink::WriteAt(int64_t offset, const std::shared_ptr<Plugin::Buffer> &buffer)
 {
-    if (muxerFilter_ != nullptr) {
+    if (muxerFilter_ == nullptr) {
+        return Plugin::Status::OK;
+    }
+    OSAL::ScopedLock lock(mutex_);
+    if (!closing_) {
+        muxerFilter_->dataSpliter_->OnOutputWritten(offset, buffer->GetMemory()->GetSize());
+    }
+    if (held_) {
+        heldWrites_.emplace_back(offset, buffer);
+    } else {
         muxerFilter_->outPorts_[0]->PushData(buffer, offset);
     }
     return Plugin::Status::OK;
 }
 
+void MuxerFilter::MuxerDataSink::Hold()
+{
+    OSAL::ScopedLock lock(mutex_);
+    held_ = true;
+}
+
+void MuxerFilter::MuxerDataSink::Release()
+{
+    OSAL::ScopedLock lock(mutex_);
+    held_ = false;
+    if (muxerFilter_ != nullptr) {
+        for (const auto& write : heldWrites_) {
+            muxerFilter_->outPorts_[0]->PushData(write.second, write.first);
+        }
+    }
+    heldWrites_.clear();
+}
+
+void MuxerFilter::MuxerDataSink::SetClosing()
+{
+    OSAL::ScopedLock lock(mutex_);
+    closing_ = true;
+}
+
 ErrorCode MuxerFilter::Start()
 {
     eos_ = false;
+    interleaveQueue_->Resume();
+    dataSpliter_->Start();
     return FilterBase::Start();
 }
+
+ErrorCode MuxerFilter::Stop()
+{
+    MEDIA_LOG_I("Stop entered.");
+    // a track held back in Push() must not keep the pipeline from stopping
+    interleaveQueue_->Interrupt();
+    // the segments closed so far still get their trailer
+    WaitOutputsClosed();
+    closeTask_->Stop();
+    return FilterBase::Stop();
+}
+
+void MuxerFilter::FlushStart()
+{
+    MEDIA_LOG_I("FlushStart entered.");
+    interleaveQueue_->Interrupt();
+}
+
+void MuxerFilter::FlushEnd()
+{
+    MEDIA_LOG_I("FlushEnd entered.");
+    interleaveQueue_->Resume();
+}
 } // Pipeline
 } // Media
 } // OHOS
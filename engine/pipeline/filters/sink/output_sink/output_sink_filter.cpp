@@ -20,6 +20,7 @@
 #include <cstdio>
 #include "foundation/cpp_ext/type_traits_ext.h"
 #include "foundation/log.h"
+#include "foundation/osal/thread/scoped_lock.h"
 #include "foundation/utils/steady_clock.h"
 #include "pipeline/factory/filter_factory.h"
 #include "pipeline/filters/common/plugin_settings.h"
@@ -115,8 +116,62 @@ ErrorCode OutputSinkFilter::SetSink(const MediaSink& sink)
     return ErrorCode::SUCCESS;
 }
 
+ErrorCode OutputSinkFilter::SetNextSink(const MediaSink& sink)
+{
+    FALSE_RETURN_V_MSG_E(pluginInfo_ != nullptr, ErrorCode::ERROR_INVALID_STATE, "no output sink plugin in use");
+    FALSE_RETURN_V_MSG_E(sink.GetProtocolType() == protocolType_, ErrorCode::ERROR_INVALID_PARAMETER_VALUE,
+                         "next output must use protocol " PUBLIC_LOG_D32, static_cast<int32_t>(protocolType_));
+    // create and prepare the plugin here, out of the data path, so that switching to it only has to start it
+    auto plugin = Plugin::PluginManager::Instance().CreateOutputSinkPlugin(pluginInfo_->name);
+    FALSE_RETURN_V_MSG_E(plugin != nullptr, ErrorCode::ERROR_UNKNOWN, "cannot create plugin " PUBLIC_LOG_S,
+                         pluginInfo_->name.c_str());
+    FAIL_RETURN(TranslatePluginStatus(plugin->Init()));
+    auto ret = TranslatePluginStatus(plugin->SetSink(sink));
+    if (ret == ErrorCode::SUCCESS) {
+        ret = TranslatePluginStatus(plugin->Prepare());
+    }
+    if (ret != ErrorCode::SUCCESS) {
+        MEDIA_LOG_E("prepare next output failed");
+        plugin->Deinit();
+        return ret;
+    }
+    OSAL::ScopedLock lock(nextSinkMutex_);
+    nextPlugins_.emplace_back(plugin);
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode OutputSinkFilter::SwitchToNextSink()
+{
+    std::shared_ptr<Plugin::OutputSink> next;
+    {
+        OSAL::ScopedLock lock(nextSinkMutex_);
+        FALSE_RETURN_V_MSG_E(!nextPlugins_.empty(), ErrorCode::ERROR_INVALID_OPERATION, "no next output prepared");
+        next = nextPlugins_.front();
+        nextPlugins_.pop_front();
+    }
+    plugin_->Flush();
+    plugin_->Stop();
+    plugin_->Deinit();
+    plugin_ = next;
+    currentPos_ = 0;
+    MEDIA_LOG_I("switch to next output");
+    return TranslatePluginStatus(plugin_->Start());
+}
+
+void OutputSinkFilter::ClearNextSinks()
+{
+    OSAL::ScopedLock lock(nextSinkMutex_);
+    for (const auto& plugin : nextPlugins_) {
+        plugin->Deinit();
+    }
+    nextPlugins_.clear();
+}
+
 ErrorCode OutputSinkFilter::PushData(const std::string &inPort, const AVBufferPtr& buffer, int64_t offset)
 {
+    if (buffer->flag & BUFFER_FLAG_SEGMENT_END) {
+        return SwitchToNextSink();
+    }
     auto ret = ErrorCode::SUCCESS;
     if (offset >= 0 && offset != currentPos_) {
         auto seekable = plugin_->GetSeekable();
@@ -180,6 +235,7 @@ ErrorCode OutputSinkFilter::Stop()
 {
     FilterBase::Stop();
     currentPos_ = 0;
+    ClearNextSinks();
     if (plugin_) {
         if (bufferEos_) {
             plugin_->Stop();
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define HST_LOG_TAG "FramePresentationScheduler"
+
+#include "frame_presentation_scheduler.h"
+#include <cmath>
+#include <cstdlib>
+#include "foundation/log.h"
+#include "foundation/osal/thread/scoped_lock.h"
+
+namespace OHOS {
+namespace Media {
+namespace Pipeline {
+namespace {
+constexpr double NS_PER_SECOND = 1000000000.0;
+}
+
+int64_t MonotonicPresentationClock::NowNs()
+{
+    return OSAL::ConditionVariable::GetClockTimeNs();
+}
+
+bool MonotonicPresentationClock::WaitUntil(int64_t deadlineNs)
+{
+    OSAL::ScopedLock lock(mutex_);
+    while (!interrupted_) {
+        if (NowNs() >= deadlineNs) {
+            return true;
+        }
+        cond_.WaitUntil(lock, deadlineNs);
+    }
+    return false;
+}
+
+void MonotonicPresentationClock::Interrupt()
+{
+    OSAL::ScopedLock lock(mutex_);
+    interrupted_ = true;
+    cond_.NotifyAll();
+}
+
+void MonotonicPresentationClock::ClearInterrupt()
+{
+    OSAL::ScopedLock lock(mutex_);
+    interrupted_ = false;
+}
+
+FramePresentationScheduler::FramePresentationScheduler(std::shared_ptr<PresentationClock> clock, size_t windowSize)
+    : clock_(std::move(clock)), window_(windowSize < 2 ? 2 : windowSize, 0) // 2: at least two points for a rate
+{
+    if (clock_ == nullptr) {
+        clock_ = std::make_shared<MonotonicPresentationClock>();
+    }
+}
+
+int64_t FramePresentationScheduler::NowNs()
+{
+    return clock_->NowNs();
+}
+
+bool FramePresentationScheduler::WaitUntil(int64_t deadlineNs)
+{
+    if (!clock_->WaitUntil(deadlineNs)) {
+        MEDIA_LOG_DD("presentation wait interrupted");
+        return false;
+    }
+    RecordJitter(clock_->NowNs() - deadlineNs);
+    return true;
+}
+
+void FramePresentationScheduler::Interrupt()
+{
+    clock_->Interrupt();
+}
+
+void FramePresentationScheduler::Resume()
+{
+    clock_->ClearInterrupt();
+}
+
+void FramePresentationScheduler::UpdateAnchor(int64_t clockTimeNs, int64_t nowNs)
+{
+    if (hasAnchor_ && std::llabs(anchorNowNs_ + (clockTimeNs - anchorClockTimeNs_) - nowNs) <= MAX_ANCHOR_DRIFT_NS) {
+        return;
+    }
+    MEDIA_LOG_DD("presentation anchor moved to " PUBLIC_LOG_D64, clockTimeNs);
+    hasAnchor_ = true;
+    anchorClockTimeNs_ = clockTimeNs;
+    anchorNowNs_ = nowNs;
+}
+
+int64_t FramePresentationScheduler::GetDeadline(int64_t clockTimeNs)
+{
+    if (!hasAnchor_) {
+        UpdateAnchor(clockTimeNs, clock_->NowNs());
+    }
+    return anchorNowNs_ + (clockTimeNs - anchorClockTimeNs_);
+}
+
+void FramePresentationScheduler::OnFramePresented(int64_t presentNs)
+{
+    OSAL::ScopedLock lock(statMutex_);
+    window_[windowHead_] = presentNs;
+    windowHead_ = (windowHead_ + 1) % window_.size();
+    if (windowCount_ < window_.size()) {
+        windowCount_++;
+    }
+}
+
+void FramePresentationScheduler::OnFramePresented()
+{
+    OnFramePresented(clock_->NowNs());
+}
+
+void FramePresentationScheduler::OnFrameDropped()
+{
+    droppedFrames_++;
+}
+
+double FramePresentationScheduler::GetFrameRate()
+{
+    OSAL::ScopedLock lock(statMutex_);
+    if (windowCount_ < 2) { // 2: at least two points for a rate
+        return 0.0;
+    }
+    size_t newest = (windowHead_ + window_.size() - 1) % window_.size();
+    size_t oldest = (windowHead_ + window_.size() - windowCount_) % window_.size();
+    int64_t span = window_[newest] - window_[oldest];
+    if (span <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(windowCount_ - 1) * NS_PER_SECOND / static_cast<double>(span);
+}
+
+uint64_t FramePresentationScheduler::GetDroppedFrameCount() const
+{
+    return droppedFrames_.load();
+}
+
+PresentationJitterStats FramePresentationScheduler::GetJitterStats()
+{
+    OSAL::ScopedLock lock(statMutex_);
+    PresentationJitterStats stats;
+    stats.frameCount = jitterCount_;
+    if (jitterCount_ == 0) {
+        return stats;
+    }
+    auto count = static_cast<double>(jitterCount_);
+    double mean = sumJitter_ / count;
+    double variance = sumSquareJitter_ / count - mean * mean;
+    stats.meanAbsJitterNs = static_cast<int64_t>(sumAbsJitter_ / count);
+    stats.maxAbsJitterNs = maxAbsJitter_;
+    stats.stdDevJitterNs = variance > 0 ? static_cast<int64_t>(std::sqrt(variance)) : 0;
+    return stats;
+}
+
+void FramePresentationScheduler::Reset()
+{
+    hasAnchor_ = false;
+    OSAL::ScopedLock lock(statMutex_);
+    windowHead_ = 0;
+    windowCount_ = 0;
+    jitterCount_ = 0;
+    maxAbsJitter_ = 0;
+    sumAbsJitter_ = 0.0;
+    sumJitter_ = 0.0;
+    sumSquareJitter_ = 0.0;
+    droppedFrames_ = 0;
+}
+
+void FramePresentationScheduler::RecordJitter(int64_t jitterNs)
+{
+    OSAL::ScopedLock lock(statMutex_);
+    int64_t absJitter = std::llabs(jitterNs);
+    jitterCount_++;
+    if (absJitter > maxAbsJitter_) {
+        maxAbsJitter_ = absJitter;
+    }
+    sumAbsJitter_ += static_cast<double>(absJitter);
+    sumJitter_ += static_cast<double>(jitterNs);
+    sumSquareJitter_ += static_cast<double>(jitterNs) * static_cast<double>(jitterNs);
+}
+} // namespace Pipeline
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISTREAMER_PIPELINE_FRAME_PRESENTATION_SCHEDULER_H
+#define HISTREAMER_PIPELINE_FRAME_PRESENTATION_SCHEDULER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "foundation/osal/thread/condition_variable.h"
+#include "foundation/osal/thread/mutex.h"
+
+namespace OHOS {
+namespace Media {
+namespace Pipeline {
+/**
+ * Time source used by FramePresentationScheduler, all values are nanoseconds.
+ */
+class PresentationClock {
+public:
+    virtual ~PresentationClock() = default;
+
+    virtual int64_t NowNs() = 0;
+
+    /**
+     * Block until the absolute deadline is reached or Interrupt() is called.
+     *
+     * @param deadlineNs absolute deadline, same time base as NowNs()
+     * @return true if the deadline was reached, false if interrupted
+     */
+    virtual bool WaitUntil(int64_t deadlineNs) = 0;
+
+    virtual void Interrupt() = 0;
+
+    virtual void ClearInterrupt() = 0;
+};
+
+/**
+ * Monotonic clock, waits with an absolute timeout on a condition variable so that flush/seek can wake it up.
+ */
+class MonotonicPresentationClock : public PresentationClock {
+public:
+    int64_t NowNs() override;
+    bool WaitUntil(int64_t deadlineNs) override;
+    void Interrupt() override;
+    void ClearInterrupt() override;
+
+private:
+    OSAL::Mutex mutex_ {};
+    OSAL::ConditionVariable cond_ {};
+    bool interrupted_ {false};
+};
+
+struct PresentationJitterStats {
+    uint64_t frameCount {0};
+    int64_t meanAbsJitterNs {0};
+    int64_t maxAbsJitterNs {0};
+    int64_t stdDevJitterNs {0};
+};
+
+/**
+ * Schedules frame presentation on absolute deadlines, computes the frame rate from a rolling window of
+ * presentation timestamps and keeps statistics of the difference between deadline and actual wake up time.
+ */
+class FramePresentationScheduler {
+public:
+    explicit FramePresentationScheduler(std::shared_ptr<PresentationClock> clock = nullptr,
+                                        size_t windowSize = DEFAULT_WINDOW_SIZE);
+    ~FramePresentationScheduler() = default;
+
+    int64_t NowNs();
+
+    /**
+     * Wait until deadlineNs and record the wake up jitter.
+     *
+     * @return true if deadline reached, false if the wait was interrupted by Interrupt()
+     */
+    bool WaitUntil(int64_t deadlineNs);
+
+    /**
+     * Wake up the waiting render thread, all waits return false until Resume() is called.
+     */
+    void Interrupt();
+
+    void Resume();
+
+    /**
+     * Tie the media clock to the monotonic clock. Called with the media clock time read at nowNs, the anchor only
+     * moves when the media clock is more than MAX_ANCHOR_DRIFT_NS away from it, e.g. after a pause or a seek.
+     *
+     * @param clockTimeNs media clock time in nanoseconds
+     * @param nowNs NowNs() at which clockTimeNs was read
+     */
+    void UpdateAnchor(int64_t clockTimeNs, int64_t nowNs);
+
+    /**
+     * @return the absolute deadline, in NowNs() time base, at which the media clock reaches clockTimeNs.
+     * Consecutive frames get deadlines at the distance of their timestamps, wake up latency does not add up.
+     * Without an anchor the media clock time is taken as now.
+     */
+    int64_t GetDeadline(int64_t clockTimeNs);
+
+    void OnFramePresented(int64_t presentNs);
+
+    void OnFramePresented();
+
+    void OnFrameDropped();
+
+    /**
+     * @return frames per second over the rolling window, 0 if less than two frames are presented
+     */
+    double GetFrameRate();
+
+    uint64_t GetDroppedFrameCount() const;
+
+    PresentationJitterStats GetJitterStats();
+
+    void Reset();
+
+    static constexpr size_t DEFAULT_WINDOW_SIZE = 60;
+    static constexpr int64_t MAX_ANCHOR_DRIFT_NS = 5000000; // 5ms: less than a frame, more than a wake up latency
+
+private:
+    void RecordJitter(int64_t jitterNs);
+
+    std::shared_ptr<PresentationClock> clock_;
+    std::atomic<bool> hasAnchor_ {false};
+    int64_t anchorClockTimeNs_ {0};
+    int64_t anchorNowNs_ {0};
+    OSAL::Mutex statMutex_ {};
+    std::vector<int64_t> window_;
+    size_t windowHead_ {0};
+    size_t windowCount_ {0};
+    uint64_t jitterCount_ {0};
+    int64_t maxAbsJitter_ {0};
+    double sumAbsJitter_ {0.0};
+    double sumJitter_ {0.0};
+    double sumSquareJitter_ {0.0};
+    std::atomic<uint64_t> droppedFrames_ {0};
+};
+} // namespace Pipeline
+} // namespace Media
+} // namespace OHOS
+#endif // HISTREAMER_PIPELINE_FRAME_PRESENTATION_SCHEDULER_H
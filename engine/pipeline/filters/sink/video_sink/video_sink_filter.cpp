@@ -19,7 +19,6 @@
 
 #include "pipeline/filters/sink/video_sink/video_sink_filter.h"
 #include "foundation/log.h"
-#include "foundation/osal/utils/util.h"
 #include "foundation/utils/steady_clock.h"
 #include "pipeline/factory/filter_factory.h"
 #include "pipeline/filters/common/plugin_settings.h"
@@ -48,12 +47,10 @@ VideoSinkFilter::VideoSinkFilter(const std::string& name) : MediaSynchronousSink
 VideoSinkFilter::~VideoSinkFilter()
 {
     MEDIA_LOG_D("VideoSinkFilter deCtor.");
+    scheduler_.Interrupt();
     if (renderTask_) {
         renderTask_->Stop();
     }
-    if (frameRateTask_) {
-        frameRateTask_->Stop();
-    }
     if (plugin_) {
         plugin_->Stop();
         plugin_->Deinit();
@@ -75,12 +72,6 @@ void VideoSinkFilter::Init(EventReceiver* receiver, FilterCallback* callback)
         renderTask_ = std::make_shared<OHOS::Media::OSAL::Task>("VideoSinkRenderThread");
         renderTask_->RegisterHandler([this] { RenderFrame(); });
     }
-#if(SHOW_FRAME_RATE)
-    if (frameRateTask_ == nullptr) {
-        frameRateTask_ = std::make_shared<OHOS::Media::OSAL::Task>("CalcFrameRateThread");
-        frameRateTask_->RegisterHandler([this] { CalcFrameRate(); });
-    }
-#endif
 }
 
 ErrorCode VideoSinkFilter::SetParameter(int32_t key, const Plugin::Any& value)
@@ -340,6 +331,7 @@ ErrorCode VideoSinkFilter::Start()
         return ErrorCode::ERROR_INVALID_OPERATION;
     }
     inBufQueue_->SetActive(true);
+    scheduler_.Resume();
     renderTask_->Start();
     auto err = FilterBase::Start();
     if (err != ErrorCode::SUCCESS) {
@@ -362,10 +354,8 @@ ErrorCode VideoSinkFilter::Stop()
         startWorkingCondition_.NotifyOne();
     }
     inBufQueue_->SetActive(false);
+    scheduler_.Interrupt();
     renderTask_->Stop();
-    if (frameRateTask_) {
-        frameRateTask_->Stop();
-    }
     return ErrorCode::SUCCESS;
 }
 
@@ -380,9 +370,6 @@ ErrorCode VideoSinkFilter::Pause()
     FAIL_RETURN_MSG(TranslatePluginStatus(plugin_->Pause()), "Pause plugin fail");
     inBufQueue_->SetActive(false);
     renderTask_->Pause();
-    if (frameRateTask_) {
-        frameRateTask_->Pause();
-    }
     MEDIA_LOG_D("Video sink filter pause end");
     return ErrorCode::SUCCESS;
 }
@@ -403,11 +390,9 @@ ErrorCode VideoSinkFilter::Resume()
         }
         inBufQueue_->SetActive(true);
         renderTask_->Start();
-        if (frameRateTask_) {
-            frameRateTask_->Start();
-        }
         renderFrameCnt_ = 0;
         discardFrameCnt_ = 0;
+        scheduler_.Reset();
     }
     return ErrorCode::SUCCESS;
 }
@@ -422,6 +407,7 @@ void VideoSinkFilter::FlushStart()
     if (inBufQueue_) {
         inBufQueue_->SetActive(false);
     }
+    scheduler_.Interrupt();
     renderTask_->Pause();
     auto err = TranslatePluginStatus(plugin_->Flush());
     if (err != ErrorCode::SUCCESS) {
@@ -436,10 +422,12 @@ void VideoSinkFilter::FlushEnd()
     if (inBufQueue_) {
         inBufQueue_->SetActive(true);
     }
+    scheduler_.Resume();
     renderTask_->Start();
     ResetSyncInfo();
     renderFrameCnt_ = 0;
     discardFrameCnt_ = 0;
+    scheduler_.Reset();
 }
 
 #ifndef OHOS_LITE
@@ -476,12 +464,16 @@ bool VideoSinkFilter::CheckBufferLatenessMayWait(AVBufferPtr buffer)
         uint64_t latency = 0;
         plugin_->GetLatency(latency);
         auto diff = nowCt + (int64_t) latency - ct4Buffer;
+        scheduler_.UpdateAnchor(Plugin::HstTime2Ns(nowCt + (int64_t) latency), scheduler_.NowNs());
         // diff < 0 or 0 < diff < 40ms(25Hz) render it
         if (diff < 0) {
-            // buffer is early
-            auto waitTimeMs = Plugin::HstTime2Ms(0 - diff);
-            MEDIA_LOG_DD("buffer is eary, sleep for " PUBLIC_LOG_D64 " ms", waitTimeMs);
-            OSAL::SleepFor(waitTimeMs);
+            // buffer is early, its deadline comes from the anchor so that wake up latency does not accumulate
+            auto deadlineNs = scheduler_.GetDeadline(Plugin::HstTime2Ns(ct4Buffer));
+            MEDIA_LOG_DD("buffer is early, wait until " PUBLIC_LOG_D64 " ns", deadlineNs);
+            if (!scheduler_.WaitUntil(deadlineNs)) {
+                MEDIA_LOG_DD("wait for render time interrupted, drop buffer");
+                return true;
+            }
         } else if (diff > 0 && Plugin::HstTime2Ms(diff) > 40) { // > 40ms
             // buffer is late
             tooLate = true;
@@ -515,9 +507,7 @@ ErrorCode VideoSinkFilter::DoSyncWrite(const AVBufferPtr& buffer)
             }
             isFirstFrame_ = false;
             OnEvent(Event{name_, EventType::EVENT_VIDEO_RENDERING_START, {}});
-            if (frameRateTask_) {
-                frameRateTask_->Start();
-            }
+            lastFrameRateReportNs_ = scheduler_.NowNs();
         } else {
             shouldDrop = CheckBufferLatenessMayWait(buffer);
         }
@@ -528,15 +518,22 @@ ErrorCode VideoSinkFilter::DoSyncWrite(const AVBufferPtr& buffer)
     }
     if (shouldDrop) {
         discardFrameCnt_++;
+        scheduler_.OnFrameDropped();
         MEDIA_LOG_DD("drop buffer with pts " PUBLIC_LOG_D64 " due to too late", buffer->pts);
         return ErrorCode::SUCCESS;
     } else if (!render) {
         discardFrameCnt_++;
+        scheduler_.OnFrameDropped();
         MEDIA_LOG_DD("drop buffer with pts " PUBLIC_LOG_D64 " due to seek not need to render", buffer->pts);
         return ErrorCode::SUCCESS;
     } else {
         renderFrameCnt_++;
-        return TranslatePluginStatus(plugin_->Write(buffer));
+        auto err = TranslatePluginStatus(plugin_->Write(buffer));
+        scheduler_.OnFramePresented();
+#if (SHOW_FRAME_RATE)
+        ReportFrameRate();
+#endif
+        return err;
     }
 }
 
@@ -546,11 +543,18 @@ void VideoSinkFilter::ResetSyncInfo()
     isFirstFrame_ = true;
 }
 
-void VideoSinkFilter::CalcFrameRate()
+void VideoSinkFilter::ReportFrameRate()
 {
-    OSAL::SleepFor(1000); // 1000ms
-    MEDIA_LOG_I("Render fps: " PUBLIC_LOG_U64 ", discard frame count: " PUBLIC_LOG_U64,
-                renderFrameCnt_.load(), discardFrameCnt_.load());
+    auto now = scheduler_.NowNs();
+    if (now - lastFrameRateReportNs_ < HST_SECOND) {
+        return;
+    }
+    lastFrameRateReportNs_ = now;
+    auto jitter = scheduler_.GetJitterStats();
+    MEDIA_LOG_I("Render fps: " PUBLIC_LOG_F ", render frame count: " PUBLIC_LOG_U64 ", discard frame count: "
+                PUBLIC_LOG_U64 ", mean jitter(ns): " PUBLIC_LOG_D64 ", max jitter(ns): " PUBLIC_LOG_D64,
+                scheduler_.GetFrameRate(), renderFrameCnt_.load(), discardFrameCnt_.load(),
+                jitter.meanAbsJitterNs, jitter.maxAbsJitterNs);
     renderFrameCnt_ = 0;
     discardFrameCnt_ = 0;
 }
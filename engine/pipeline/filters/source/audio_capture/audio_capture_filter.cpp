@@ -30,6 +30,10 @@ namespace Media {
 namespace Pipeline {
 using namespace Plugin;
 
+namespace {
+constexpr size_t CAPTURE_BUFFER_POOL_SIZE = 8; // 8: capture periods queued downstream before frames are dropped
+}
+
 static AutoRegisterFilter<AudioCaptureFilter> g_registerFilterHelper("builtin.recorder.audiocapture");
 
 AudioCaptureFilter::AudioCaptureFilter(const std::string& name)
@@ -321,6 +325,15 @@ ErrorCode AudioCaptureFilter::Stop()
     latestPausedTime_ = HST_TIME_NONE;
     totalPausedTime_ = 0;
     refreshTotalPauseTime_ = false;
+    // the buffers still held downstream are freed when released
+    bufferPool_.clear();
+    dropBuffer_.reset();
+    pooledBufferSize_ = 0;
+    if (droppedFrames_ > 0) {
+        MEDIA_LOG_W("dropped " PUBLIC_LOG_U64 " capture frames, downstream was too slow", droppedFrames_);
+    }
+    droppedFrames_ = 0;
+    dropping_ = false;
     // stop plugin secondly
     ErrorCode ret = ErrorCode::SUCCESS;
     if (plugin_) {
@@ -385,7 +398,13 @@ void AudioCaptureFilter::ReadLoop()
         MEDIA_LOG_E("Get plugin buffer size fail");
         return;
     }
-    AVBufferPtr bufferPtr = std::make_shared<AVBuffer>(BufferMetaType::AUDIO);
+    // when downstream holds all the buffers the period is still read, so that the capturer keeps up, and dropped
+    AVBufferPtr bufferPtr = AllocateBuffer(bufferSize);
+    bool drop = bufferPtr == nullptr;
+    if (drop) {
+        bufferPtr = dropBuffer_;
+        ResetBuffer(*bufferPtr);
+    }
     ret = plugin_->Read(bufferPtr, bufferSize);
     if (ret == Status::ERROR_AGAIN) {
         MEDIA_LOG_D("plugin read return again");
@@ -403,9 +422,65 @@ void AudioCaptureFilter::ReadLoop()
         refreshTotalPauseTime_ = false;
     }
     bufferPtr->pts -= totalPausedTime_;
+    if (drop) {
+        droppedFrames_++;
+        if (!dropping_) {
+            MEDIA_LOG_W("downstream holds all capture buffers, dropping frames");
+            dropping_ = true;
+        }
+        return;
+    }
+    if (dropping_) {
+        MEDIA_LOG_W("capture buffers are back, " PUBLIC_LOG_U64 " frames dropped so far", droppedFrames_);
+        dropping_ = false;
+    }
     SendBuffer(bufferPtr);
 }
 
+AVBufferPtr AudioCaptureFilter::AllocateBuffer(uint64_t bufferSize)
+{
+    // the read size follows the capture period and the channel layout, the pool is rebuilt when they change
+    if (bufferPool_.empty() || pooledBufferSize_ != bufferSize) {
+        MEDIA_LOG_I("capture buffer pool of " PUBLIC_LOG_ZU " buffers, " PUBLIC_LOG_U64 " bytes each",
+                    CAPTURE_BUFFER_POOL_SIZE, bufferSize);
+        bufferPool_.clear();
+        for (size_t i = 0; i <= CAPTURE_BUFFER_POOL_SIZE; ++i) {
+            auto buffer = std::make_shared<AVBuffer>(BufferMetaType::AUDIO);
+            if (buffer->AllocMemory(nullptr, static_cast<size_t>(bufferSize)) == nullptr) {
+                bufferPool_.clear();
+                return nullptr;
+            }
+            bufferPool_.push_back(buffer);
+        }
+        // the last one never goes downstream, dropped periods are read into it
+        dropBuffer_ = bufferPool_.back();
+        bufferPool_.pop_back();
+        pooledBufferSize_ = bufferSize;
+    }
+    // the first free buffer, only as many buffers as downstream holds keep cycling and stay in the cache
+    for (const auto& buffer : bufferPool_) {
+        if (buffer.use_count() == 1) {
+            // pairs with the release of the last reference downstream, its writes to the buffer are done
+            std::atomic_thread_fence(std::memory_order_acquire);
+            ResetBuffer(*buffer);
+            return buffer;
+        }
+    }
+    return nullptr;
+}
+
+// Buffer::Reset() allocates a new meta, the reused buffer clears its own instead
+void AudioCaptureFilter::ResetBuffer(AVBuffer& buffer)
+{
+    buffer.GetMemory()->Reset();
+    buffer.trackID = 0;
+    buffer.pts = 0;
+    buffer.dts = 0;
+    buffer.duration = 0;
+    buffer.flag = 0;
+    buffer.GetBufferMeta()->Clear();
+}
+
 ErrorCode AudioCaptureFilter::CreatePlugin(const std::shared_ptr<PluginInfo>& info, const std::string& name,
                                            PluginManager& manager)
 {
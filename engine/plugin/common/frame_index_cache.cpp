@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define HST_LOG_TAG "FrameIndexCache"
+
+#include "plugin/common/frame_index_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <dirent.h>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <utility>
+#include <utime.h>
+
+#include "foundation/log.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+namespace {
+const std::string INDEX_MAGIC = "histreamer_frame_index";
+const std::string INDEX_SUFFIX = ".idx";
+constexpr uint32_t INDEX_FORMAT_VERSION = 1;
+constexpr size_t HEAD_HASH_SIZE = 16 * 1024; // 16K: covers the headers of the usual containers
+constexpr size_t TAIL_HASH_SIZE = 4 * 1024; // 4K: tells apart files sharing the head, e.g. rewritten tags
+constexpr uint64_t MAX_ENTRY_COUNT = 1024 * 1024;
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+uint64_t HashBytes(uint64_t hash, const uint8_t* data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+bool HashRange(const std::shared_ptr<DataSource>& source, uint64_t offset, size_t size, uint64_t& hash)
+{
+    auto buffer = std::make_shared<Buffer>();
+    auto memory = buffer->AllocMemory(nullptr, size);
+    if (memory == nullptr || source->ReadAt(static_cast<int64_t>(offset), buffer, size) != Status::OK ||
+        memory->GetSize() != size) {
+        return false;
+    }
+    hash = HashBytes(FNV_OFFSET_BASIS, memory->GetReadOnlyData(), size);
+    return true;
+}
+}
+
+FrameIndexCache::FrameIndexCache(std::string kind, uint32_t interval, std::string cacheDir, uint64_t cacheLimit)
+    : kind_(std::move(kind)), interval_(std::max(interval, 1u)), cacheDir_(std::move(cacheDir)),
+      cacheLimit_(cacheLimit)
+{
+}
+
+std::string FrameIndexCache::GetDefaultCacheDir()
+{
+#ifdef HST_FRAME_INDEX_CACHE_DIR
+    return HST_FRAME_INDEX_CACHE_DIR;
+#else
+    return "";
+#endif
+}
+
+bool FrameIndexCache::IsLocalUri(const std::string& uri)
+{
+    auto pos = uri.find("://");
+    if (pos == std::string::npos) {
+        return !uri.empty();
+    }
+    std::string scheme = uri.substr(0, pos);
+    return scheme == "file" || scheme == "fd";
+}
+
+bool FrameIndexCache::Open(const std::shared_ptr<DataSource>& source, uint64_t fileSize)
+{
+    Clear();
+    identified_ = false;
+    fileSize_ = fileSize;
+    if (cacheDir_.empty() || source == nullptr || fileSize == 0) {
+        return false;
+    }
+    size_t headSize = static_cast<size_t>(std::min<uint64_t>(fileSize, HEAD_HASH_SIZE));
+    size_t tailSize = static_cast<size_t>(std::min<uint64_t>(fileSize, TAIL_HASH_SIZE));
+    if (!HashRange(source, 0, headSize, headHash_) || !HashRange(source, fileSize - tailSize, tailSize, tailHash_)) {
+        MEDIA_LOG_D("can not identify the file, the index is not persisted");
+        return false;
+    }
+    identified_ = true;
+    if (!Load()) {
+        Clear();
+        return false;
+    }
+    MEDIA_LOG_I(PUBLIC_LOG_S " index loaded, entries " PUBLIC_LOG_ZU " complete " PUBLIC_LOG_D32, kind_.c_str(),
+                entries_.size(), complete_);
+    return true;
+}
+
+void FrameIndexCache::Clear()
+{
+    entries_.clear();
+    complete_ = false;
+    dirty_ = false;
+    frameCount_ = 0;
+    duration_ = 0;
+}
+
+void FrameIndexCache::Add(uint64_t frame, int64_t pts, uint64_t offset)
+{
+    if (complete_ || frame != GetNextFrame() || entries_.size() >= MAX_ENTRY_COUNT) {
+        return;
+    }
+    if (!entries_.empty() && (pts < entries_.back().pts || offset <= entries_.back().offset)) {
+        return;
+    }
+    entries_.push_back({frame, pts, offset});
+    dirty_ = true;
+}
+
+void FrameIndexCache::SetComplete(uint64_t frameCount, int64_t duration)
+{
+    if (complete_ || (!entries_.empty() && frameCount <= entries_.back().frame)) {
+        return;
+    }
+    complete_ = true;
+    frameCount_ = frameCount;
+    duration_ = duration;
+    dirty_ = true;
+}
+
+bool FrameIndexCache::Lookup(int64_t pts, Entry& entry) const
+{
+    auto iter = std::upper_bound(entries_.begin(), entries_.end(), pts,
+                                 [](int64_t value, const Entry& item) { return value < item.pts; });
+    if (iter == entries_.begin()) {
+        return false;
+    }
+    entry = *(--iter);
+    return true;
+}
+
+bool FrameIndexCache::GetLast(Entry& entry) const
+{
+    if (entries_.empty()) {
+        return false;
+    }
+    entry = entries_.back();
+    return true;
+}
+
+std::string FrameIndexCache::GetCacheFile() const
+{
+    uint64_t name = HashBytes(FNV_OFFSET_BASIS, reinterpret_cast<const uint8_t*>(kind_.data()), kind_.size());
+    name = HashBytes(name, reinterpret_cast<const uint8_t*>(&fileSize_), sizeof(fileSize_));
+    name = HashBytes(name, reinterpret_cast<const uint8_t*>(&headHash_), sizeof(headHash_));
+    name = HashBytes(name, reinterpret_cast<const uint8_t*>(&tailHash_), sizeof(tailHash_));
+    char fileName[32] = {0}; // 32: 16 hex digits and the suffix
+    (void)snprintf(fileName, sizeof(fileName), "%016llx", static_cast<unsigned long long>(name));
+    return cacheDir_ + "/" + fileName + INDEX_SUFFIX;
+}
+
+bool FrameIndexCache::Load()
+{
+    std::string cacheFile = GetCacheFile();
+    std::ifstream file(cacheFile, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string magic;
+    std::string kind;
+    uint32_t version = 0;
+    uint64_t fileSize = 0;
+    uint64_t headHash = 0;
+    uint64_t tailHash = 0;
+    uint32_t interval = 0;
+    uint64_t count = 0;
+    if (!(file >> magic >> version >> kind >> fileSize >> headHash >> tailHash >> interval >> complete_ >>
+          frameCount_ >> duration_ >> count) || magic != INDEX_MAGIC || version != INDEX_FORMAT_VERSION ||
+        kind != kind_ || fileSize != fileSize_ || headHash != headHash_ || tailHash != tailHash_ ||
+        interval != interval_ || count > MAX_ENTRY_COUNT) {
+        MEDIA_LOG_W("frame index of " PUBLIC_LOG_S " is outdated or corrupted", kind_.c_str());
+        return false;
+    }
+    entries_.resize(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        auto& entry = entries_[i];
+        entry.frame = i * interval_;
+        if (!(file >> entry.pts >> entry.offset) || entry.offset >= fileSize_ ||
+            (i > 0 && (entry.pts < entries_[i - 1].pts || entry.offset <= entries_[i - 1].offset))) {
+            MEDIA_LOG_W("frame index of " PUBLIC_LOG_S " is corrupted", kind_.c_str());
+            return false;
+        }
+    }
+    dirty_ = false;
+    // the modification time is the last use, TrimCacheDir() removes the oldest indexes first
+    (void)utime(cacheFile.c_str(), nullptr);
+    return true;
+}
+
+bool FrameIndexCache::Save()
+{
+    if (!dirty_ || !identified_ || cacheDir_.empty()) {
+        return true;
+    }
+    std::ostringstream os;
+    os << INDEX_MAGIC << ' ' << INDEX_FORMAT_VERSION << ' ' << kind_ << ' ' << fileSize_ << ' ' << headHash_ <<
+        ' ' << tailHash_ << ' ' << interval_ << ' ' << complete_ << ' ' << frameCount_ << ' ' << duration_ << ' ' <<
+        entries_.size() << '\n';
+    for (const auto& entry : entries_) {
+        os << entry.pts << ' ' << entry.offset << '\n';
+    }
+    if (os.str().size() > cacheLimit_) {
+        MEDIA_LOG_D(PUBLIC_LOG_S " index is larger than the cache, it is not persisted", kind_.c_str());
+        return true;
+    }
+    (void)mkdir(cacheDir_.c_str(), 0750); // 0750: the directory is private to the media service
+    // write a temporary file first, a reader never sees a partially written index
+    std::string cacheFile = GetCacheFile();
+    std::string tmpFile = cacheFile + ".tmp";
+    {
+        std::ofstream file(tmpFile, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() || !(file << os.str()).flush()) {
+            MEDIA_LOG_W("write frame index " PUBLIC_LOG_S " failed", tmpFile.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmpFile.c_str(), cacheFile.c_str()) != 0) {
+        MEDIA_LOG_W("replace frame index " PUBLIC_LOG_S " failed", cacheFile.c_str());
+        (void)std::remove(tmpFile.c_str());
+        return false;
+    }
+    dirty_ = false;
+    TrimCacheDir(cacheFile);
+    return true;
+}
+
+void FrameIndexCache::TrimCacheDir(const std::string& keepFile) const
+{
+    struct CacheFile {
+        std::string path;
+        uint64_t size;
+        timespec mtime;
+    };
+    std::vector<CacheFile> files;
+    uint64_t totalSize = 0;
+    DIR* dir = opendir(cacheDir_.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+    for (dirent* item = readdir(dir); item != nullptr; item = readdir(dir)) {
+        std::string name = item->d_name;
+        if (name.size() <= INDEX_SUFFIX.size() ||
+            name.compare(name.size() - INDEX_SUFFIX.size(), INDEX_SUFFIX.size(), INDEX_SUFFIX) != 0) {
+            continue;
+        }
+        std::string path = cacheDir_ + "/" + name;
+        struct stat fileStat {};
+        if (stat(path.c_str(), &fileStat) == 0) {
+            files.push_back({path, static_cast<uint64_t>(fileStat.st_size), fileStat.st_mtim});
+            totalSize += static_cast<uint64_t>(fileStat.st_size);
+        }
+    }
+    (void)closedir(dir);
+    if (totalSize <= cacheLimit_) {
+        return;
+    }
+    std::sort(files.begin(), files.end(), [](const CacheFile& lhs, const CacheFile& rhs) {
+        return lhs.mtime.tv_sec != rhs.mtime.tv_sec ? lhs.mtime.tv_sec < rhs.mtime.tv_sec :
+            lhs.mtime.tv_nsec < rhs.mtime.tv_nsec;
+    });
+    for (const auto& file : files) {
+        if (totalSize <= cacheLimit_) {
+            break;
+        }
+        if (file.path != keepFile && std::remove(file.path.c_str()) == 0) {
+            totalSize -= file.size;
+        }
+    }
+    MEDIA_LOG_D("frame index cache trimmed to " PUBLIC_LOG_U64 " bytes", totalSize);
+}
+} // namespace Plugin
+} // namespace Media
+} // namespace OHOS
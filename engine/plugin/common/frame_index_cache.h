@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISTREAMER_PLUGIN_FRAME_INDEX_CACHE_H
+#define HISTREAMER_PLUGIN_FRAME_INDEX_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "plugin/interface/demuxer_plugin.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+/**
+ * Sparse index of the frames of a media file, one entry every interval frames, used by the demuxers to seek
+ * without estimating positions from the bitrate. The index can be persisted in a cache directory, the file is
+ * identified by its size and by hashes of its first and last bytes, so that a later open of the same content
+ * finds the index whatever path or source it comes from.
+ * Times are in the unit chosen by the demuxer, e.g. samples or track time scale, which keeps them exact.
+ * The cache directory is kept below a size limit, the indexes used least recently are removed first.
+ */
+class FrameIndexCache {
+public:
+    static constexpr uint64_t DEFAULT_CACHE_LIMIT = 16 * 1024 * 1024; // 16M
+
+    struct Entry {
+        uint64_t frame {0};
+        int64_t pts {0};
+        uint64_t offset {0};
+    };
+
+    /**
+     * @param kind name of the index owner, the indexes of different demuxers never mix
+     * @param interval frames between two entries
+     * @param cacheDir directory where the index is persisted, empty to keep it in memory only
+     * @param cacheLimit bytes all the indexes in the cache directory may take
+     */
+    FrameIndexCache(std::string kind, uint32_t interval, std::string cacheDir = GetDefaultCacheDir(),
+                    uint64_t cacheLimit = DEFAULT_CACHE_LIMIT);
+    ~FrameIndexCache() = default;
+
+    /**
+     * Identify the file of the source and load its persisted index if any, the index is empty otherwise.
+     *
+     * @return whether a persisted index is loaded
+     */
+    bool Open(const std::shared_ptr<DataSource>& source, uint64_t fileSize);
+
+    /**
+     * Add the frame to the index. Only the next expected entry is taken, i.e. frames have to be added in order
+     * from the last entry, other frames are ignored.
+     */
+    void Add(uint64_t frame, int64_t pts, uint64_t offset);
+
+    /**
+     * Mark the index as covering the whole file.
+     */
+    void SetComplete(uint64_t frameCount, int64_t duration);
+
+    /**
+     * Find the last entry at or before pts, O(log n).
+     */
+    bool Lookup(int64_t pts, Entry& entry) const;
+
+    /**
+     * Get the last entry of the index.
+     */
+    bool GetLast(Entry& entry) const;
+
+    /**
+     * Write the index if anything was added since Open(), partial indexes are written too.
+     */
+    bool Save();
+
+    void Clear();
+
+    uint64_t GetNextFrame() const
+    {
+        return static_cast<uint64_t>(entries_.size()) * interval_;
+    }
+
+    bool IsComplete() const
+    {
+        return complete_;
+    }
+
+    uint64_t GetFrameCount() const
+    {
+        return frameCount_;
+    }
+
+    int64_t GetDuration() const
+    {
+        return duration_;
+    }
+
+    size_t GetEntryCount() const
+    {
+        return entries_.size();
+    }
+
+    static std::string GetDefaultCacheDir();
+
+    /**
+     * Whether the index of the uri is worth persisting. Only local files are, a network source would pay
+     * round trips for the identifying reads and its content can change behind the same size.
+     */
+    static bool IsLocalUri(const std::string& uri);
+
+private:
+    std::string GetCacheFile() const;
+    bool Load();
+    void TrimCacheDir(const std::string& keepFile) const;
+
+    std::string kind_;
+    uint32_t interval_;
+    std::string cacheDir_;
+    uint64_t cacheLimit_;
+    uint64_t fileSize_ {0};
+    uint64_t headHash_ {0};
+    uint64_t tailHash_ {0};
+    bool identified_ {false};
+    bool complete_ {false};
+    bool dirty_ {false};
+    uint64_t frameCount_ {0};
+    int64_t duration_ {0};
+    std::vector<Entry> entries_ {};
+};
+} // namespace Plugin
+} // namespace Media
+} // namespace OHOS
+#endif // HISTREAMER_PLUGIN_FRAME_INDEX_CACHE_H
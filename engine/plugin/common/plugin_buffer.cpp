@@ -159,6 +159,11 @@ void BufferMeta::Update(const BufferMeta& bufferMeta)
     *tags_ = *bufferMeta.tags_;
 }
 
+void BufferMeta::Clear()
+{
+    tags_->Clear();
+}
+
 std::shared_ptr<BufferMeta> AudioBufferMeta::Clone()
 {
     auto bufferMeta = std::shared_ptr<AudioBufferMeta>(new AudioBufferMeta());
@@ -187,6 +192,30 @@ std::shared_ptr<BufferMeta> VideoBufferMeta::Clone()
     return bufferMeta;
 }
 
+void AudioBufferMeta::Clear()
+{
+    BufferMeta::Clear();
+    samples = 0;
+    sampleFormat = AudioSampleFormat::S8;
+    sampleRate = 0;
+    channels = 0;
+    bytesPreFrame = 0;
+    channelLayout = AudioChannelLayout::MONO;
+    offsets.clear();
+}
+
+void VideoBufferMeta::Clear()
+{
+    BufferMeta::Clear();
+    videoPixelFormat = VideoPixelFormat::UNKNOWN;
+    id = 0;
+    width = 0;
+    height = 0;
+    planes = 0;
+    stride.clear();
+    offset.clear();
+}
+
 Buffer::Buffer(BufferMetaType type) : trackID(0), pts(0), dts(0), duration(0), flag (0), meta()
 {
     if (type == BufferMetaType::AUDIO) {
@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define HST_LOG_TAG "AudioResampler"
+
+#include "plugin/convert/audio_resampler.h"
+#include <algorithm>
+#include <cmath>
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+#include "foundation/log.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+namespace {
+constexpr double PI = 3.14159265358979323846;
+constexpr float S8_SCALE = 128.0f;
+constexpr float S16_SCALE = 32768.0f;
+constexpr float S24_SCALE = 8388608.0f;
+constexpr double S32_SCALE = 2147483648.0;
+constexpr double CUTOFF_MARGIN = 0.92; // keep the transition band below the nyquist of the lower rate
+constexpr size_t S24_BYTES = 3;
+
+size_t BytesPerSample(AudioSampleFormat fmt)
+{
+    switch (fmt) {
+        case AudioSampleFormat::U8:
+            return 1;
+        case AudioSampleFormat::S16:
+        case AudioSampleFormat::S16P:
+            return sizeof(int16_t);
+        case AudioSampleFormat::S24:
+            return S24_BYTES;
+        case AudioSampleFormat::S32:
+        case AudioSampleFormat::S32P:
+            return sizeof(int32_t);
+        case AudioSampleFormat::F32:
+        case AudioSampleFormat::F32P:
+            return sizeof(float);
+        default:
+            return 0;
+    }
+}
+
+bool IsPlanar(AudioSampleFormat fmt)
+{
+    return fmt == AudioSampleFormat::S16P || fmt == AudioSampleFormat::S32P || fmt == AudioSampleFormat::F32P;
+}
+
+/**
+ * Inner loop of the polyphase filter, four lanes at a time where the target supports it.
+ */
+inline float DotProduct(const float* a, const float* b, size_t n)
+{
+    size_t i = 0;
+    float sum = 0.0f;
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (; i + 4 <= n; i += 4) { // 4 lanes
+        acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    sum = vaddvq_f32(acc);
+#elif defined(__SSE__)
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) { // 4 lanes
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    float lanes[4]; // 4 lanes
+    _mm_storeu_ps(lanes, acc);
+    sum = lanes[0] + lanes[1] + lanes[2] + lanes[3]; // 2 3 lane index
+#endif
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+template <typename T>
+inline T ClampRound(double value, double min, double max)
+{
+    return static_cast<T>(std::lrint(std::min(std::max(value, min), max)));
+}
+} // namespace
+
+bool AudioResampler::IsFormatSupported(AudioSampleFormat fmt, bool isDest)
+{
+    if (isDest) {
+        return fmt == AudioSampleFormat::S16 || fmt == AudioSampleFormat::S32 || fmt == AudioSampleFormat::F32;
+    }
+    return BytesPerSample(fmt) != 0;
+}
+
+bool AudioResampler::IsIntegerRatio(uint32_t srcSampleRate, uint32_t destSampleRate)
+{
+    if (srcSampleRate == 0 || destSampleRate == 0) {
+        return false;
+    }
+    uint32_t high = std::max(srcSampleRate, destSampleRate);
+    uint32_t low = std::min(srcSampleRate, destSampleRate);
+    return high % low == 0 && high / low <= MAX_INTEGER_RATIO;
+}
+
+Status AudioResampler::Init(const AudioResamplerPara& para)
+{
+    FALSE_RETURN_V_MSG_E(para.channels > 0 && para.srcSampleRate > 0 && para.destSampleRate > 0,
+                         Status::ERROR_INVALID_PARAMETER, "invalid channels or sample rate");
+    FALSE_RETURN_V_MSG_E(IsFormatSupported(para.srcFmt, false) && IsFormatSupported(para.destFmt, true),
+                         Status::ERROR_UNSUPPORTED_FORMAT, "unsupported sample format");
+    para_ = para;
+    srcBytesPerSample_ = BytesPerSample(para.srcFmt);
+    destBytesPerSample_ = BytesPerSample(para.destFmt);
+    ratio_ = 1;
+    if (para.srcSampleRate == para.destSampleRate) {
+        mode_ = para.srcFmt == para.destFmt ? AudioResampleMode::PASSTHROUGH : AudioResampleMode::FORMAT_ONLY;
+        historyFrames_ = 0;
+    } else {
+        FALSE_RETURN_V_MSG_E(IsIntegerRatio(para.srcSampleRate, para.destSampleRate), Status::ERROR_UNIMPLEMENTED,
+                             "only integer ratio rate conversion is supported, src " PUBLIC_LOG_U32 " dest "
+                             PUBLIC_LOG_U32, para.srcSampleRate, para.destSampleRate);
+        if (para.destSampleRate > para.srcSampleRate) {
+            mode_ = AudioResampleMode::INTEGER_UPSAMPLE;
+            ratio_ = para.destSampleRate / para.srcSampleRate;
+            historyFrames_ = TAPS_PER_PHASE - 1;
+        } else {
+            mode_ = AudioResampleMode::INTEGER_DOWNSAMPLE;
+            ratio_ = para.srcSampleRate / para.destSampleRate;
+            historyFrames_ = ratio_ * TAPS_PER_PHASE - 1;
+        }
+        DesignFilter(ratio_);
+    }
+    channelBuf_.resize(para.channels);
+    Reset();
+    MEDIA_LOG_I("resampler mode " PUBLIC_LOG_U32 ", ratio " PUBLIC_LOG_U32, static_cast<uint32_t>(mode_), ratio_);
+    return Status::OK;
+}
+
+void AudioResampler::DesignFilter(uint32_t ratio)
+{
+    // windowed sinc low pass at the nyquist of the lower rate, normalized to unity dc gain
+    size_t length = static_cast<size_t>(ratio) * TAPS_PER_PHASE;
+    std::vector<double> proto(length);
+    double cutoff = 0.5 / ratio * CUTOFF_MARGIN; // 0.5: nyquist
+    double center = (static_cast<double>(length) - 1.0) / 2.0; // 2.0: symmetric center
+    double sum = 0.0;
+    for (size_t j = 0; j < length; ++j) {
+        double t = static_cast<double>(j) - center;
+        double sinc = (t == 0.0) ? 2.0 * cutoff : std::sin(2.0 * PI * cutoff * t) / (PI * t); // 2.0: 2 * fc
+        double phase = 2.0 * PI * static_cast<double>(j) / (static_cast<double>(length) - 1.0); // 2.0: 2 * pi
+        double blackman = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase); // 0.42 0.5 0.08 2.0
+        proto[j] = sinc * blackman;
+        sum += proto[j];
+    }
+    for (auto& coef : proto) {
+        coef /= sum;
+    }
+    taps_.resize(length);
+    for (size_t i = 0; i < length; ++i) {
+        taps_[i] = static_cast<float>(proto[length - 1 - i]);
+    }
+    phaseTaps_.resize(length);
+    for (uint32_t p = 0; p < ratio; ++p) {
+        for (size_t i = 0; i < TAPS_PER_PHASE; ++i) {
+            phaseTaps_[p * TAPS_PER_PHASE + i] =
+                static_cast<float>(proto[p + (TAPS_PER_PHASE - 1 - i) * ratio] * ratio);
+        }
+    }
+}
+
+void AudioResampler::Reset()
+{
+    for (auto& buf : channelBuf_) {
+        buf.assign(historyFrames_, 0.0f);
+    }
+    nextInputPos_ = historyFrames_;
+}
+
+double AudioResampler::GetDelayFrames() const
+{
+    double length = static_cast<double>(ratio_) * TAPS_PER_PHASE;
+    switch (mode_) {
+        case AudioResampleMode::INTEGER_UPSAMPLE:
+            return (length - 1.0) / 2.0; // 2.0: symmetric filter
+        case AudioResampleMode::INTEGER_DOWNSAMPLE:
+            return (length - 1.0) / (2.0 * ratio_); // 2.0: symmetric filter
+        default:
+            return 0.0;
+    }
+}
+
+size_t AudioResampler::DecodeToFloat(const uint8_t* src, size_t srcLength)
+{
+    size_t channels = para_.channels;
+    size_t frames = srcLength / srcBytesPerSample_ / channels;
+    for (auto& buf : channelBuf_) {
+        buf.resize(historyFrames_ + frames);
+    }
+    bool planar = IsPlanar(para_.srcFmt);
+    for (size_t c = 0; c < channels; ++c) {
+        float* out = channelBuf_[c].data() + historyFrames_;
+        // sample index of frame i is base + i * step
+        size_t base = planar ? c * frames : c;
+        size_t step = planar ? 1 : channels;
+        switch (para_.srcFmt) {
+            case AudioSampleFormat::U8:
+                for (size_t i = 0; i < frames; ++i) {
+                    out[i] = (static_cast<float>(src[base + i * step]) - S8_SCALE) / S8_SCALE;
+                }
+                break;
+            case AudioSampleFormat::S16:
+            case AudioSampleFormat::S16P: {
+                auto in = reinterpret_cast<const int16_t*>(src);
+                for (size_t i = 0; i < frames; ++i) {
+                    out[i] = static_cast<float>(in[base + i * step]) / S16_SCALE;
+                }
+                break;
+            }
+            case AudioSampleFormat::S24:
+                for (size_t i = 0; i < frames; ++i) {
+                    const uint8_t* p = src + (base + i * step) * S24_BYTES;
+                    // 8 16 24: little endian bytes shifted into the top of an int32, then sign-preserving shift
+                    int32_t value = static_cast<int32_t>((static_cast<uint32_t>(p[0]) << 8) | // 8
+                        (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 24)) >> 8; // 2 16 24 8
+                    out[i] = static_cast<float>(value) / S24_SCALE;
+                }
+                break;
+            case AudioSampleFormat::S32:
+            case AudioSampleFormat::S32P: {
+                auto in = reinterpret_cast<const int32_t*>(src);
+                for (size_t i = 0; i < frames; ++i) {
+                    out[i] = static_cast<float>(in[base + i * step] / S32_SCALE);
+                }
+                break;
+            }
+            case AudioSampleFormat::F32:
+            case AudioSampleFormat::F32P: {
+                auto in = reinterpret_cast<const float*>(src);
+                for (size_t i = 0; i < frames; ++i) {
+                    out[i] = in[base + i * step];
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return frames;
+}
+
+size_t AudioResampler::Upsample(size_t frames)
+{
+    size_t channels = para_.channels;
+    size_t outFrames = frames * ratio_;
+    interleaved_.resize(outFrames * channels);
+    for (size_t c = 0; c < channels; ++c) {
+        const float* in = channelBuf_[c].data();
+        for (size_t n = 0; n < frames; ++n) {
+            // window of TAPS_PER_PHASE input frames ending at input frame n
+            const float* window = in + n;
+            float* out = interleaved_.data() + (n * ratio_) * channels + c;
+            for (uint32_t p = 0; p < ratio_; ++p) {
+                out[p * channels] = DotProduct(phaseTaps_.data() + p * TAPS_PER_PHASE, window, TAPS_PER_PHASE);
+            }
+        }
+    }
+    return outFrames;
+}
+
+size_t AudioResampler::Downsample(size_t frames)
+{
+    size_t channels = para_.channels;
+    size_t total = historyFrames_ + frames;
+    size_t length = taps_.size();
+    size_t outFrames = nextInputPos_ < total ? (total - nextInputPos_ + ratio_ - 1) / ratio_ : 0;
+    interleaved_.resize(outFrames * channels);
+    for (size_t c = 0; c < channels; ++c) {
+        const float* in = channelBuf_[c].data();
+        size_t pos = nextInputPos_;
+        for (size_t m = 0; m < outFrames; ++m, pos += ratio_) {
+            interleaved_[m * channels + c] = DotProduct(taps_.data(), in + pos + 1 - length, length);
+        }
+    }
+    nextInputPos_ = nextInputPos_ + outFrames * ratio_ - frames;
+    return outFrames;
+}
+
+void AudioResampler::EncodeFromFloat(const float* src, size_t samples, uint8_t* dest)
+{
+    switch (para_.destFmt) {
+        case AudioSampleFormat::S16: {
+            auto out = reinterpret_cast<int16_t*>(dest);
+            for (size_t i = 0; i < samples; ++i) {
+                out[i] = ClampRound<int16_t>(static_cast<double>(src[i]) * S16_SCALE, INT16_MIN, INT16_MAX);
+            }
+            break;
+        }
+        case AudioSampleFormat::S32: {
+            auto out = reinterpret_cast<int32_t*>(dest);
+            for (size_t i = 0; i < samples; ++i) {
+                out[i] = ClampRound<int32_t>(static_cast<double>(src[i]) * S32_SCALE, INT32_MIN, INT32_MAX);
+            }
+            break;
+        }
+        case AudioSampleFormat::F32:
+            (void)memcpy_s(dest, samples * sizeof(float), src, samples * sizeof(float));
+            break;
+        default:
+            break;
+    }
+}
+
+Status AudioResampler::Convert(const uint8_t* srcBuffer, size_t srcLength, uint8_t*& destBuffer, size_t& destLength)
+{
+    if (mode_ == AudioResampleMode::PASSTHROUGH) {
+        destBuffer = const_cast<uint8_t*>(srcBuffer);
+        destLength = srcLength;
+        return Status::OK;
+    }
+    FALSE_RETURN_V_MSG_E(srcBuffer != nullptr && srcBytesPerSample_ != 0, Status::ERROR_WRONG_STATE,
+                         "resampler is not initialized");
+    size_t frames = DecodeToFloat(srcBuffer, srcLength);
+    size_t channels = para_.channels;
+    size_t outFrames = 0;
+    switch (mode_) {
+        case AudioResampleMode::FORMAT_ONLY:
+            outFrames = frames;
+            interleaved_.resize(frames * channels);
+            for (size_t c = 0; c < channels; ++c) {
+                const float* in = channelBuf_[c].data();
+                for (size_t i = 0; i < frames; ++i) {
+                    interleaved_[i * channels + c] = in[i];
+                }
+            }
+            break;
+        case AudioResampleMode::INTEGER_UPSAMPLE:
+            outFrames = Upsample(frames);
+            break;
+        case AudioResampleMode::INTEGER_DOWNSAMPLE:
+            outFrames = Downsample(frames);
+            break;
+        default:
+            break;
+    }
+    // keep the tail as filter history for the next buffer
+    if (historyFrames_ > 0) {
+        for (auto& buf : channelBuf_) {
+            std::copy(buf.end() - historyFrames_, buf.end(), buf.begin());
+            buf.resize(historyFrames_);
+        }
+    }
+    destLength = outFrames * channels * destBytesPerSample_;
+    if (destCache_.size() < destLength) {
+        destCache_.resize(destLength);
+    }
+    EncodeFromFloat(interleaved_.data(), outFrames * channels, destCache_.data());
+    destBuffer = destCache_.data();
+    return Status::OK;
+}
+} // namespace Plugin
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define HST_LOG_TAG "PluginCache"
+
+#include "plugin/core/plugin_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <type_traits>
+#include <utility>
+
+#include "foundation/log.h"
+#include "plugin/common/plugin_audio_tags.h"
+#include "plugin/common/plugin_source_tags.h"
+#include "plugin/common/plugin_video_tags.h"
+#include "plugin/interface/audio_sink_plugin.h"
+#include "plugin/interface/codec_plugin.h"
+#include "plugin/interface/demuxer_plugin.h"
+#include "plugin/interface/muxer_plugin.h"
+#include "plugin/interface/output_sink_plugin.h"
+#include "plugin/interface/source_plugin.h"
+#include "plugin/interface/video_sink_plugin.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+namespace {
+const std::string CACHE_MAGIC = "histreamer_plugin_cache";
+constexpr uint32_t CACHE_FORMAT_VERSION = 2; // 2: nanosecond modification times
+constexpr uint32_t MAX_STRING_LEN = 4096;
+constexpr uint32_t MAX_ITEM_COUNT = 1024;
+
+enum struct ValueForm : uint32_t {
+    FIXED = 0,
+    INTERVAL,
+    DISCRETE,
+};
+
+// integers are stored widened, enums as their underlying integer
+template <typename T, bool = std::is_enum<T>::value>
+struct StoredInt {
+    using Type = typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type;
+};
+
+template <typename T>
+struct StoredInt<T, true> {
+    using Type = typename StoredInt<typename std::underlying_type<T>::type>::Type;
+};
+
+void WriteString(std::ostream& os, const std::string& str)
+{
+    os << ' ' << str.size() << ':' << str;
+}
+
+bool ReadString(std::istream& is, std::string& str)
+{
+    uint32_t len = 0;
+    if (!(is >> len) || len > MAX_STRING_LEN || is.get() != ':') {
+        return false;
+    }
+    str.assign(len, '\0');
+    return len == 0 || static_cast<bool>(is.read(&str[0], len));
+}
+
+bool ReadCount(std::istream& is, uint32_t& count)
+{
+    return (is >> count) && count <= MAX_ITEM_COUNT;
+}
+
+template <typename T>
+void WriteScalar(std::ostream& os, const T& val)
+{
+    os << ' ' << static_cast<typename StoredInt<T>::Type>(val);
+}
+
+template <>
+void WriteScalar<std::string>(std::ostream& os, const std::string& val)
+{
+    WriteString(os, val);
+}
+
+template <typename T>
+bool ReadScalar(std::istream& is, T& val)
+{
+    typename StoredInt<T>::Type stored {};
+    if (!(is >> stored)) {
+        return false;
+    }
+    val = static_cast<T>(stored);
+    return true;
+}
+
+template <>
+bool ReadScalar<std::string>(std::istream& is, std::string& val)
+{
+    return ReadString(is, val);
+}
+
+template <typename T>
+bool EncodeValue(const ValueType& value, std::ostream& os)
+{
+    if (auto fixed = AnyCast<FixedCapability<T>>(&value)) {
+        os << ' ' << static_cast<uint32_t>(ValueForm::FIXED);
+        WriteScalar(os, *fixed);
+        return true;
+    }
+    if (auto interval = AnyCast<IntervalCapability<T>>(&value)) {
+        os << ' ' << static_cast<uint32_t>(ValueForm::INTERVAL);
+        WriteScalar(os, interval->first);
+        WriteScalar(os, interval->second);
+        return true;
+    }
+    if (auto discrete = AnyCast<DiscreteCapability<T>>(&value)) {
+        os << ' ' << static_cast<uint32_t>(ValueForm::DISCRETE) << ' ' << discrete->size();
+        for (const T& item : *discrete) {
+            WriteScalar(os, item);
+        }
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+bool DecodeValue(ValueForm form, std::istream& is, ValueType& value)
+{
+    switch (form) {
+        case ValueForm::FIXED: {
+            FixedCapability<T> fixed {};
+            FALSE_RETURN_V(ReadScalar(is, fixed), false);
+            value = fixed;
+            return true;
+        }
+        case ValueForm::INTERVAL: {
+            IntervalCapability<T> interval {};
+            FALSE_RETURN_V(ReadScalar(is, interval.first) && ReadScalar(is, interval.second), false);
+            value = interval;
+            return true;
+        }
+        case ValueForm::DISCRETE: {
+            uint32_t count = 0;
+            FALSE_RETURN_V(ReadCount(is, count), false);
+            DiscreteCapability<T> discrete(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                T item {};
+                FALSE_RETURN_V(ReadScalar(is, item), false);
+                discrete[i] = item;
+            }
+            value = discrete;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+struct ValueCodec {
+    bool (*encode)(const ValueType& value, std::ostream& os);
+    bool (*decode)(ValueForm form, std::istream& is, ValueType& value);
+};
+
+#define VALUE_CODEC(T) ValueCodec {EncodeValue<T>, DecodeValue<T>}
+
+/**
+ * The value types used by plugin capabilities and extra information, the index in this table is stored in the cache
+ * file, so new types must be appended and the cache format version must be increased if the table is reordered.
+ */
+const std::vector<ValueCodec>& GetValueCodecs()
+{
+    static const std::vector<ValueCodec> codecs = {
+        VALUE_CODEC(bool),
+        VALUE_CODEC(uint8_t),
+        VALUE_CODEC(int32_t),
+        VALUE_CODEC(uint32_t),
+        VALUE_CODEC(int64_t),
+        VALUE_CODEC(uint64_t),
+        VALUE_CODEC(std::string),
+        VALUE_CODEC(AudioChannelLayout),
+        VALUE_CODEC(AudioSampleFormat),
+        VALUE_CODEC(AudioAacProfile),
+        VALUE_CODEC(AudioAacStreamFormat),
+        VALUE_CODEC(VideoPixelFormat),
+        VALUE_CODEC(VideoBitStreamFormat),
+        VALUE_CODEC(CodecMode),
+        VALUE_CODEC(ProtocolType),
+        VALUE_CODEC(SrcInputType),
+    };
+    return codecs;
+}
+
+#undef VALUE_CODEC
+
+bool WriteValue(std::ostream& os, const ValueType& value)
+{
+    const auto& codecs = GetValueCodecs();
+    for (size_t index = 0; index < codecs.size(); ++index) {
+        std::ostringstream encoded;
+        if (codecs[index].encode(value, encoded)) {
+            os << ' ' << index << encoded.str();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ReadValue(std::istream& is, ValueType& value)
+{
+    const auto& codecs = GetValueCodecs();
+    uint32_t index = 0;
+    uint32_t form = 0;
+    if (!(is >> index >> form) || index >= codecs.size()) {
+        return false;
+    }
+    return codecs[index].decode(static_cast<ValueForm>(form), is, value);
+}
+
+bool WriteCapabilitySet(std::ostream& os, const CapabilitySet& caps)
+{
+    os << ' ' << caps.size();
+    for (const auto& cap : caps) {
+        WriteString(os, cap.mime);
+        os << ' ' << cap.keys.size();
+        for (const auto& key : cap.keys) {
+            os << ' ' << static_cast<uint32_t>(key.first);
+            FALSE_RETURN_V(WriteValue(os, key.second), false);
+        }
+    }
+    return true;
+}
+
+bool ReadCapabilitySet(std::istream& is, CapabilitySet& caps)
+{
+    uint32_t capCount = 0;
+    FALSE_RETURN_V(ReadCount(is, capCount), false);
+    caps.resize(capCount);
+    for (auto& cap : caps) {
+        uint32_t keyCount = 0;
+        FALSE_RETURN_V(ReadString(is, cap.mime) && ReadCount(is, keyCount), false);
+        for (uint32_t i = 0; i < keyCount; ++i) {
+            uint32_t key = 0;
+            ValueType value;
+            FALSE_RETURN_V((is >> key) && ReadValue(is, value), false);
+            cap.keys[static_cast<Capability::Key>(key)] = value;
+        }
+    }
+    return true;
+}
+
+bool WritePluginInfo(std::ostream& os, const PluginInfo& info)
+{
+    os << "\nplugin " << static_cast<int32_t>(info.pluginType) << ' ' << info.apiVersion << ' ' << info.rank;
+    WriteString(os, info.name);
+    WriteString(os, info.description);
+    FALSE_RETURN_V(WriteCapabilitySet(os, info.inCaps) && WriteCapabilitySet(os, info.outCaps), false);
+    os << ' ' << info.extra.size();
+    for (const auto& extra : info.extra) {
+        WriteString(os, extra.first);
+        FALSE_RETURN_V(WriteValue(os, extra.second), false);
+    }
+    return true;
+}
+
+bool ReadPluginInfo(std::istream& is, PluginInfo& info)
+{
+    std::string tag;
+    int32_t type = 0;
+    if (!(is >> tag >> type >> info.apiVersion >> info.rank) || tag != "plugin") {
+        return false;
+    }
+    info.pluginType = static_cast<PluginType>(type);
+    FALSE_RETURN_V(ReadString(is, info.name) && ReadString(is, info.description), false);
+    FALSE_RETURN_V(ReadCapabilitySet(is, info.inCaps) && ReadCapabilitySet(is, info.outCaps), false);
+    uint32_t extraCount = 0;
+    FALSE_RETURN_V(ReadCount(is, extraCount), false);
+    for (uint32_t i = 0; i < extraCount; ++i) {
+        std::string key;
+        ValueType value;
+        FALSE_RETURN_V(ReadString(is, key) && ReadValue(is, value), false);
+        info.extra[key] = value;
+    }
+    return true;
+}
+
+// the cached descriptions were accepted by the register of this core, they are invalid for other api versions
+std::string GetCoreVersions()
+{
+    std::ostringstream os;
+    os << SOURCE_API_VERSION << ',' << DEMUXER_API_VERSION << ',' << CODEC_API_VERSION << ','
+       << AUDIO_SINK_API_VERSION << ',' << VIDEO_SINK_API_VERSION << ',' << MUXER_API_VERSION << ','
+       << OUTPUT_SINK_API_VERSION;
+    return os.str();
+}
+} // namespace
+
+PluginCache::PluginCache(std::string cacheFile) : cacheFile_(std::move(cacheFile))
+{
+}
+
+bool PluginCache::Load()
+{
+    libs_.clear();
+    dirty_ = false;
+    std::ifstream file(cacheFile_, std::ios::binary);
+    if (!file.is_open()) {
+        MEDIA_LOG_I("no plugin cache " PUBLIC_LOG_S, cacheFile_.c_str());
+        return false;
+    }
+    std::string magic;
+    uint32_t formatVersion = 0;
+    std::string coreVersions;
+    uint32_t libCount = 0;
+    if (!(file >> magic >> formatVersion) || magic != CACHE_MAGIC || formatVersion != CACHE_FORMAT_VERSION ||
+        !ReadString(file, coreVersions) || coreVersions != GetCoreVersions() || !(file >> libCount)) {
+        MEDIA_LOG_W("plugin cache " PUBLIC_LOG_S " is outdated", cacheFile_.c_str());
+        dirty_ = true;
+        return false;
+    }
+    std::map<std::string, LibEntry> libs;
+    for (uint32_t i = 0; i < libCount; ++i) {
+        std::string tag;
+        std::string libPath;
+        LibEntry entry;
+        uint32_t pluginCount = 0;
+        bool ok = (file >> tag) && tag == "lib" && ReadString(file, libPath) &&
+            (file >> entry.stamp.mtime >> entry.stamp.size) && ReadCount(file, pluginCount);
+        for (uint32_t j = 0; ok && j < pluginCount; ++j) {
+            auto info = std::make_shared<PluginInfo>();
+            ok = ReadPluginInfo(file, *info);
+            entry.infos.emplace_back(info);
+        }
+        if (!ok) {
+            MEDIA_LOG_W("plugin cache " PUBLIC_LOG_S " is corrupted", cacheFile_.c_str());
+            dirty_ = true;
+            return false;
+        }
+        libs[libPath] = std::move(entry);
+    }
+    libs_.swap(libs);
+    MEDIA_LOG_I("plugin cache loaded with " PUBLIC_LOG_ZU " libs", libs_.size());
+    return true;
+}
+
+bool PluginCache::Save()
+{
+    if (!dirty_) {
+        return true;
+    }
+    std::ostringstream os;
+    os << CACHE_MAGIC << ' ' << CACHE_FORMAT_VERSION;
+    WriteString(os, GetCoreVersions());
+    os << ' ' << libs_.size();
+    for (const auto& lib : libs_) {
+        os << "\nlib";
+        WriteString(os, lib.first);
+        os << ' ' << lib.second.stamp.mtime << ' ' << lib.second.stamp.size << ' ' << lib.second.infos.size();
+        for (const auto& info : lib.second.infos) {
+            WritePluginInfo(os, *info);
+        }
+    }
+    os << '\n';
+    // write a temporary file first, a reader never sees a partially written cache
+    std::string tmpFile = cacheFile_ + ".tmp";
+    {
+        std::ofstream file(tmpFile, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() || !(file << os.str()).flush()) {
+            MEDIA_LOG_W("write plugin cache " PUBLIC_LOG_S " failed", tmpFile.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmpFile.c_str(), cacheFile_.c_str()) != 0) {
+        MEDIA_LOG_W("replace plugin cache " PUBLIC_LOG_S " failed", cacheFile_.c_str());
+        (void)std::remove(tmpFile.c_str());
+        return false;
+    }
+    dirty_ = false;
+    return true;
+}
+
+bool PluginCache::Lookup(const std::string& libPath, std::vector<std::shared_ptr<PluginInfo>>& infos) const
+{
+    auto iter = libs_.find(libPath);
+    LibStamp stamp;
+    if (iter == libs_.end() || !GetLibStamp(libPath, stamp) || !(stamp == iter->second.stamp)) {
+        return false;
+    }
+    infos = iter->second.infos;
+    return true;
+}
+
+void PluginCache::Update(const std::string& libPath, const std::vector<std::shared_ptr<PluginInfo>>& infos)
+{
+    // a library which cannot be cached is not in the cache either, the file is not rewritten for it on every start
+    if (libs_.erase(libPath) > 0) {
+        dirty_ = true;
+    }
+    LibEntry entry;
+    if (!GetLibStamp(libPath, entry.stamp)) {
+        return;
+    }
+    std::ostringstream os;
+    for (const auto& info : infos) {
+        if (!WritePluginInfo(os, *info)) {
+            MEDIA_LOG_W("plugin " PUBLIC_LOG_S " has description which cannot be cached, " PUBLIC_LOG_S
+                        " will be loaded on every start", info->name.c_str(), libPath.c_str());
+            return;
+        }
+    }
+    entry.infos = infos;
+    libs_[libPath] = std::move(entry);
+    dirty_ = true;
+}
+
+void PluginCache::Retain(const std::set<std::string>& libPaths)
+{
+    for (auto iter = libs_.begin(); iter != libs_.end();) {
+        if (libPaths.count(iter->first) == 0) {
+            iter = libs_.erase(iter);
+            dirty_ = true;
+        } else {
+            ++iter;
+        }
+    }
+}
+
+bool PluginCache::GetLibStamp(const std::string& libPath, LibStamp& stamp)
+{
+    struct stat fileStat {};
+    if (stat(libPath.c_str(), &fileStat) != 0) {
+        return false;
+    }
+    // nanoseconds, a library replaced within the same second still gets another stamp
+    stamp.mtime = static_cast<int64_t>(fileStat.st_mtim.tv_sec) * 1000000000 + // 1000000000: ns per second
+        static_cast<int64_t>(fileStat.st_mtim.tv_nsec);
+    stamp.size = static_cast<int64_t>(fileStat.st_size);
+    return true;
+}
+} // namespace Plugin
+} // namespace Media
+} // namespace OHOS
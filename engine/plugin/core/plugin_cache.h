@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISTREAMER_PLUGIN_CACHE_H
+#define HISTREAMER_PLUGIN_CACHE_H
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "plugin/core/plugin_info.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+/**
+ * Persisted descriptions of the plugins found in dynamic plugin libraries, so that a library needs to be loaded only
+ * when one of its plugins is created. Entries are keyed on the library path and are valid as long as the
+ * modification time and size of the library are unchanged.
+ */
+class PluginCache {
+public:
+    struct LibStamp {
+        int64_t mtime {0}; // ns
+        int64_t size {0};
+        bool operator==(const LibStamp& other) const
+        {
+            return mtime == other.mtime && size == other.size;
+        }
+    };
+
+    explicit PluginCache(std::string cacheFile);
+    ~PluginCache() = default;
+
+    /**
+     * Read the cache file. A missing, corrupted or outdated file leaves the cache empty.
+     *
+     * @return whether the cache file is loaded
+     */
+    bool Load();
+
+    /**
+     * Write the cache file if anything changed since Load().
+     */
+    bool Save();
+
+    /**
+     * Get the cached descriptions of the library, fails if the library changed since it was cached.
+     */
+    bool Lookup(const std::string& libPath, std::vector<std::shared_ptr<PluginInfo>>& infos) const;
+
+    /**
+     * Replace the cached descriptions of the library. Libraries with descriptions which cannot be stored are not
+     * cached, they are loaded on every start.
+     */
+    void Update(const std::string& libPath, const std::vector<std::shared_ptr<PluginInfo>>& infos);
+
+    /**
+     * Drop the libraries which are not installed any more.
+     */
+    void Retain(const std::set<std::string>& libPaths);
+
+    size_t GetLibCount() const
+    {
+        return libs_.size();
+    }
+
+    static bool GetLibStamp(const std::string& libPath, LibStamp& stamp);
+
+private:
+    struct LibEntry {
+        LibStamp stamp;
+        std::vector<std::shared_ptr<PluginInfo>> infos;
+    };
+
+    std::string cacheFile_;
+    std::map<std::string, LibEntry> libs_ {};
+    bool dirty_ {false};
+};
+} // namespace Plugin
+} // namespace Media
+} // namespace OHOS
+#endif // HISTREAMER_PLUGIN_CACHE_H
@@ -32,9 +32,9 @@ std::vector<std::string> PluginManager::ListPlugins(PluginType pluginType, Codec
 
 std::shared_ptr<PluginInfo> PluginManager::GetPluginInfo(PluginType type, const std::string& name)
 {
-    auto regInfo = pluginRegister_->GetPluginRegInfo(type, name);
-    if (regInfo && regInfo->info && regInfo->info->pluginType == type) {
-        return regInfo->info;
+    auto info = pluginRegister_->GetPluginInfo(type, name);
+    if (info && info->pluginType == type) {
+        return info;
     }
     return {};
 }
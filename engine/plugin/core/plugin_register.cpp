@@ -19,6 +19,8 @@
 
 #include "all_plugin_static.h"
 #include "foundation/log.h"
+#include "foundation/osal/thread/scoped_lock.h"
+#include "plugin/core/plugin_cache.h"
 #include "plugin/interface/audio_sink_plugin.h"
 #include "plugin/interface/codec_plugin.h"
 #include "plugin/interface/demuxer_plugin.h"
@@ -30,6 +32,21 @@
 
 using namespace OHOS::Media::Plugin;
 
+namespace {
+#ifdef DYNAMIC_PLUGINS
+std::shared_ptr<PluginCache> CreatePluginCache()
+{
+#ifdef HST_PLUGIN_CACHE_FILE
+    auto cache = std::make_shared<PluginCache>(HST_PLUGIN_CACHE_FILE);
+    (void)cache->Load();
+    return cache;
+#else
+    return nullptr;
+#endif
+}
+#endif
+} // namespace
+
 PluginRegister::~PluginRegister()
 {
     UnregisterAllPlugins();
@@ -105,18 +122,9 @@ void PluginRegister::RegisterImpl::UpdateRegisterTableAndRegisterNames(const Plu
         default:
             return;
     }
-    regInfo->loader = std::move(pluginLoader);
-    registerData->registerTable[def.pluginType][def.name] = regInfo;
-    auto extra = regInfo->info->extra[PLUGIN_INFO_EXTRA_CODEC_MODE];
-    if ((def.pluginType == PluginType::AUDIO_DECODER || def.pluginType == PluginType::VIDEO_DECODER
-        || def.pluginType == PluginType::AUDIO_ENCODER || def.pluginType == PluginType::VIDEO_ENCODER)
-        && regInfo->info->extra.count(PLUGIN_INFO_EXTRA_CODEC_MODE) != 0
-        && (Plugin::Any::IsSameTypeWith<CodecMode>(extra) && AnyCast<CodecMode>(extra) == CodecMode::HARDWARE)) {
-        registerData->registerNames[def.pluginType].insert(registerData->registerNames[def.pluginType].begin(),
-            def.name);
-    } else {
-        registerData->registerNames[def.pluginType].push_back(def.name);
-    }
+    regInfo->loader = pluginLoader;
+    registerData->AddRegInfo(regInfo);
+    addedPlugins.emplace_back(regInfo);
 }
 
 bool PluginRegister::RegisterImpl::Verification(const PluginDefBase& definition)
@@ -152,7 +160,6 @@ bool PluginRegister::RegisterImpl::VersionMatched(const PluginDefBase& definitio
     return (major == coreMajor) && (minor <= coreMinor);
 }
 
-// NOLINTNEXTLINE: should be static or anonymous namespace
 bool PluginRegister::RegisterImpl::MoreAcceptable(std::shared_ptr<PluginRegInfo>& regInfo, const PluginDefBase& def)
 {
     return false;
@@ -326,8 +333,22 @@ int PluginRegister::GetAllRegisteredPluginCount()
 
 std::shared_ptr<PluginRegInfo> PluginRegister::GetPluginRegInfo(PluginType type, const std::string& name)
 {
+    OSAL::ScopedLock lock(loadMutex_);
+    if (!registerData_->IsPluginExist(type, name)) {
+        return {};
+    }
+    auto regInfo = registerData_->registerTable[type][name];
+    if (regInfo->creator == nullptr && !regInfo->libPath.empty() && !LoadCachedPlugin(regInfo)) {
+        return {};
+    }
+    return regInfo;
+}
+
+std::shared_ptr<PluginInfo> PluginRegister::GetPluginInfo(PluginType type, const std::string& name)
+{
+    // the description is available without loading the library of the plugin
     if (registerData_->IsPluginExist(type, name)) {
-        return registerData_->registerTable[type][name];
+        return registerData_->registerTable[type][name]->info;
     }
     return {};
 }
@@ -374,6 +395,8 @@ void PluginRegister::RegisterPluginsFromPath(const char* libDirPath)
     static std::string fileSeparator = "/";
     #endif
     static std::string libFileTail = HST_PLUGIN_FILE_TAIL;
+    std::shared_ptr<PluginCache> cache = CreatePluginCache();
+    std::set<std::string> libPaths;
     DIR* libDir = opendir(libDirPath);
     if (libDir) {
         struct dirent* lib = nullptr;
@@ -390,14 +413,107 @@ void PluginRegister::RegisterPluginsFromPath(const char* libDirPath)
             std::string pluginName =
                 libName.substr(libFileHead.size(), libName.size() - libFileHead.size() - libFileTail.size());
             std::string libPath = libDirPath + fileSeparator + lib->d_name;
+            libPaths.insert(libPath);
+            std::vector<std::shared_ptr<PluginInfo>> infos;
+            if (cache && cache->Lookup(libPath, infos)) {
+                RegisterCachedPlugins(pluginName, libPath, infos);
+                continue;
+            }
             loader = PluginLoader::Create(pluginName, libPath);
             if (loader) {
-                loader->FetchRegisterFunction()(std::make_shared<RegisterImpl>(registerData_, loader));
+                auto regInfos = RegisterLibPlugins(loader);
                 registeredLoaders_.push_back(loader);
+                if (cache) {
+                    for (const auto& regInfo : regInfos) {
+                        infos.emplace_back(regInfo->info);
+                    }
+                    cache->Update(libPath, infos);
+                }
             }
         }
         closedir(libDir);
     }
+    if (cache) {
+        cache->Retain(libPaths);
+        (void)cache->Save();
+    }
+#endif
+}
+
+std::vector<std::shared_ptr<PluginRegInfo>> PluginRegister::RegisterLibPlugins(
+    const std::shared_ptr<PluginLoader>& loader)
+{
+    // register into an own table first to get all plugins of the library, including those which are already
+    // registered by other libraries, so that the cached library is complete regardless of the registration order
+    auto libRegister = std::make_shared<RegisterImpl>(std::make_shared<RegisterData>(), loader);
+    loader->FetchRegisterFunction()(libRegister);
+    for (const auto& regInfo : libRegister->addedPlugins) {
+        AddLibRegInfo(regInfo);
+    }
+    return libRegister->addedPlugins;
+}
+
+void PluginRegister::RegisterCachedPlugins(const std::string& libName, const std::string& libPath,
+                                           const std::vector<std::shared_ptr<PluginInfo>>& infos)
+{
+    for (const auto& info : infos) {
+        auto regInfo = std::make_shared<PluginRegInfo>();
+        regInfo->info = info;
+        regInfo->libName = libName;
+        regInfo->libPath = libPath;
+        AddLibRegInfo(regInfo);
+    }
+}
+
+// same rule as RegisterImpl::AddPlugin for a plugin registered again by another library
+void PluginRegister::AddLibRegInfo(const std::shared_ptr<PluginRegInfo>& regInfo)
+{
+    const auto& info = regInfo->info;
+    if (registerData_->IsPluginExist(info->pluginType, info->name)) {
+        PluginDefBase def;
+        def.apiVersion = info->apiVersion;
+        def.pluginType = info->pluginType;
+        def.name = info->name;
+        def.description = info->description;
+        def.rank = info->rank;
+        if (!RegisterImpl::MoreAcceptable(registerData_->registerTable[info->pluginType][info->name], def)) {
+            return;
+        }
+        registerData_->registerTable[info->pluginType].erase(info->name);
+    }
+    registerData_->AddRegInfo(regInfo);
+}
+
+bool PluginRegister::LoadCachedPlugin(const std::shared_ptr<PluginRegInfo>& regInfo)
+{
+#ifdef DYNAMIC_PLUGINS
+    auto loader = PluginLoader::Create(regInfo->libName, regInfo->libPath);
+    FALSE_RETURN_V_MSG_E(loader != nullptr, false, "load " PUBLIC_LOG_S " failed", regInfo->libPath.c_str());
+    auto libRegister = std::make_shared<RegisterImpl>(std::make_shared<RegisterData>(), loader);
+    loader->FetchRegisterFunction()(libRegister);
+    registeredLoaders_.push_back(loader);
+    // all cached plugins of the library become usable at once
+    for (const auto& loaded : libRegister->addedPlugins) {
+        auto type = loaded->info->pluginType;
+        const auto& name = loaded->info->name;
+        if (!registerData_->IsPluginExist(type, name)) {
+            continue;
+        }
+        auto& cached = registerData_->registerTable[type][name];
+        if (cached->creator == nullptr && cached->libPath == regInfo->libPath) {
+            cached->packageDef = loaded->packageDef;
+            cached->creator = loaded->creator;
+            cached->sniffer = loaded->sniffer;
+            cached->loader = loader;
+        }
+    }
+    FALSE_RETURN_V_MSG_E(regInfo->creator != nullptr, false, "plugin " PUBLIC_LOG_S " is not found in "
+        PUBLIC_LOG_S, regInfo->info->name.c_str(), regInfo->libPath.c_str());
+    MEDIA_LOG_I("loaded " PUBLIC_LOG_S " for plugin " PUBLIC_LOG_S, regInfo->libPath.c_str(),
+                regInfo->info->name.c_str());
+    return true;
+#else
+    return false;
 #endif
 }
 
@@ -443,6 +559,23 @@ void PluginRegister::EraseRegisteredPluginsByLoader(const std::shared_ptr<Plugin
     }
 }
 
+void PluginRegister::RegisterData::AddRegInfo(const std::shared_ptr<PluginRegInfo>& regInfo)
+{
+    auto type = regInfo->info->pluginType;
+    const auto& name = regInfo->info->name;
+    registerTable[type][name] = regInfo;
+    auto extra = regInfo->info->extra.find(PLUGIN_INFO_EXTRA_CODEC_MODE);
+    if ((type == PluginType::AUDIO_DECODER || type == PluginType::VIDEO_DECODER
+        || type == PluginType::AUDIO_ENCODER || type == PluginType::VIDEO_ENCODER)
+        && extra != regInfo->info->extra.end()
+        && (Plugin::Any::IsSameTypeWith<CodecMode>(extra->second)
+        && AnyCast<CodecMode>(extra->second) == CodecMode::HARDWARE)) {
+        registerNames[type].insert(registerNames[type].begin(), name);
+    } else {
+        registerNames[type].push_back(name);
+    }
+}
+
 bool PluginRegister::RegisterData::IsPluginExist(PluginType type, const std::string& name)
 {
     return (registerTable.find(type) != registerTable.end() &&
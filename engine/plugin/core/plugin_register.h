@@ -20,6 +20,7 @@
 #include <map>
 #include <set>
 #include <utility>
+#include "foundation/osal/thread/mutex.h"
 #include "plugin/common/any.h"
 #include "plugin/core/plugin_loader.h"
 #include "plugin/core/plugin_info.h"
@@ -36,6 +37,9 @@ struct PluginRegInfo {
     PluginCreatorFunc<PluginBase> creator;
     DemuxerPluginSnifferFunc sniffer;
     std::shared_ptr<PluginLoader> loader;
+    // dynamic library of a plugin registered from the plugin cache, loaded when the plugin is used the first time
+    std::string libName;
+    std::string libPath;
 };
 
 class PluginRegister {
@@ -50,6 +54,8 @@ public:
 
     std::shared_ptr<PluginRegInfo> GetPluginRegInfo(PluginType type, const std::string& name);
 
+    std::shared_ptr<PluginInfo> GetPluginInfo(PluginType type, const std::string& name);
+
     void RegisterPlugins();
 
     void RegisterGenericPlugin(const GenericPluginDef& pluginDef);
@@ -59,6 +65,11 @@ private:
     void RegisterStaticPlugins();
     void RegisterDynamicPlugins();
     void RegisterPluginsFromPath(const char* libDirPath);
+    std::vector<std::shared_ptr<PluginRegInfo>> RegisterLibPlugins(const std::shared_ptr<PluginLoader>& loader);
+    void RegisterCachedPlugins(const std::string& libName, const std::string& libPath,
+                               const std::vector<std::shared_ptr<PluginInfo>>& infos);
+    void AddLibRegInfo(const std::shared_ptr<PluginRegInfo>& regInfo);
+    bool LoadCachedPlugin(const std::shared_ptr<PluginRegInfo>& regInfo);
     void UnregisterAllPlugins();
     void EraseRegisteredPluginsByLoader(const std::shared_ptr<PluginLoader>& loader);
 
@@ -69,6 +80,7 @@ private:
         std::map<PluginType, std::vector<std::string>> registerNames;
         REGISTERED_TABLE registerTable;
         bool IsPluginExist(PluginType type, const std::string& name);
+        void AddRegInfo(const std::shared_ptr<PluginRegInfo>& regInfo);
     };
 
     struct RegisterImpl : PackageRegister {
@@ -117,16 +129,18 @@ private:
 
         bool VersionMatched(const PluginDefBase& definition);
 
-        bool MoreAcceptable(std::shared_ptr<PluginRegInfo>& regInfo, const PluginDefBase& def);
+        static bool MoreAcceptable(std::shared_ptr<PluginRegInfo>& regInfo, const PluginDefBase& def);
 
         std::shared_ptr<PluginLoader> pluginLoader;
         std::shared_ptr<RegisterData> registerData;
         std::shared_ptr<PackageDef> packageDef {nullptr};
+        std::vector<std::shared_ptr<PluginRegInfo>> addedPlugins {};
     };
     void DeletePlugin(std::map<std::string, std::shared_ptr<PluginRegInfo>>& plugins,
         std::map<std::string, std::shared_ptr<PluginRegInfo>>::iterator& info);
     std::shared_ptr<RegisterData> registerData_ = std::make_shared<RegisterData>();
     std::vector<std::shared_ptr<PluginLoader>> registeredLoaders_;
+    OSAL::Mutex loadMutex_ {};
     std::shared_ptr<RegisterImpl> staticPluginRegister_ = std::make_shared<RegisterImpl>(registerData_);
 };
 } // namespace Plugin
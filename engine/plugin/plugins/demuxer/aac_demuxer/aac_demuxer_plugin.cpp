@@ -25,6 +25,7 @@
 #include "foundation/osal/thread/scoped_lock.h"
 #include "foundation/osal/utils/util.h"
 #include "foundation/utils/constants.h"
+#include "plugin/common/plugin_time.h"
 
 namespace OHOS {
 namespace Media {
@@ -35,9 +36,14 @@ namespace {
     constexpr uint32_t GET_INFO_READ_LEN = 7;
     constexpr uint32_t MEDIA_IO_SIZE = 2048;
     constexpr uint32_t MAX_RANK = 100;
+    constexpr uint32_t ADTS_HEADER_SIZE = 7;
+    constexpr uint32_t ADTS_SAMPLES_PER_BLOCK = 1024;
+    constexpr uint64_t FRAME_INDEX_INTERVAL = 32; // 32: about 0.7s at 48kHz, bounds the headers read by a seek
+    constexpr uint64_t DURATION_PROBE_FRAMES = 64; // 64: frames whose average length estimates the duration
     uint32_t usedDataSize_ = 0;
     int samplingRateMap[] = {96000, 88200, 64000, 48000, 44100, 32000, 24000, 22050, 16000, 12000, 11025, 8000, 7350};
     int IsAACPattern(const uint8_t *data);
+    uint32_t GetFrameSamples(const uint8_t *data);
     int Sniff(const std::string& name, std::shared_ptr<DataSource> dataSource);
     Status RegisterPlugin(const std::shared_ptr<Register>& reg);
 }
@@ -68,6 +74,7 @@ Status AACDemuxerPlugin::SetDataSource(const std::shared_ptr<DataSource>& source
     }
     MEDIA_LOG_I("FileSize_ " PUBLIC_LOG_U64, fileSize_);
     isSeekable_ = fileSize_ > 0 ? true : false;
+    ResetFrameIndex();
     return Status::OK;
 }
 
@@ -176,6 +183,14 @@ Status AACDemuxerPlugin::GetMediaInfo(MediaInfo& mediaInfo)
         mediaInfo.tracks[0].Set<Tag::AUDIO_SAMPLE_PER_FRAME>(1024);   // 1024
         mediaInfo.tracks[0].Set<Tag::AUDIO_AAC_PROFILE>(AudioAacProfile::LC);
         mediaInfo.tracks[0].Set<Tag::AUDIO_AAC_STREAM_FORMAT>(AudioAacStreamFormat::MP4ADTS);
+        if (isSeekable_ && ioContext_.dataSource->GetSeekable() == Seekable::SEEKABLE) {
+            // only the first frames are scanned here, the rest of the index is built by seeks and reads
+            ScanFrameIndex(DURATION_PROBE_FRAMES * ADTS_SAMPLES_PER_BLOCK);
+            int64_t duration = EstimateDuration();
+            if (duration > 0) {
+                mediaInfo.tracks[0].Set<Tag::MEDIA_DURATION>(duration);
+            }
+        }
         return Status::OK;
     } else {
         return Status::ERROR_UNSUPPORTED_FORMAT;
@@ -190,6 +205,7 @@ Status AACDemuxerPlugin::ReadFrame(Buffer& outBuffer, int32_t timeOutMs)
     if (retStatus != Status::OK) {
         return retStatus;
     }
+    int64_t frameOffset = ioContext_.offset - static_cast<int64_t>(ioDataRemainSize_);
     status = AudioDemuxerAACProcess(inIoBuffer_, ioDataRemainSize_, &aacDemuxerRst_);
 
     if (outBuffer.IsEmpty()) {
@@ -200,6 +216,15 @@ Status AACDemuxerPlugin::ReadFrame(Buffer& outBuffer, int32_t timeOutMs)
     switch (status) {
         case 0:
             aacFrameData->Write(aacDemuxerRst_.frameBuffer, aacDemuxerRst_.frameLength);
+            if (aacDemuxerRst_.frameLength > 0) {
+                uint32_t frameSamples = GetFrameSamples(aacDemuxerRst_.frameBuffer);
+                if (isSeekable_) {
+                    IndexFrame(frameOffset, aacDemuxerRst_.frameLength, frameSamples);
+                }
+                outBuffer.pts = SamplesToHstTime(curSamples_);
+                outBuffer.duration = SamplesToHstTime(curSamples_ + frameSamples) - outBuffer.pts;
+                curSamples_ += frameSamples;
+            }
             if (aacDemuxerRst_.frameBuffer) {
                 free(aacDemuxerRst_.frameBuffer);
                 aacDemuxerRst_.frameBuffer = nullptr;
@@ -221,9 +246,150 @@ Status AACDemuxerPlugin::ReadFrame(Buffer& outBuffer, int32_t timeOutMs)
 
 Status AACDemuxerPlugin::SeekTo(int32_t trackId, int64_t seekTime, SeekMode mode, int64_t& realSeekTime)
 {
+    FALSE_RETURN_V_MSG_E(isSeekable_ && ioContext_.dataSource != nullptr &&
+                         ioContext_.dataSource->GetSeekable() == Seekable::SEEKABLE &&
+                         aacDemuxerRst_.frameSampleRate > 0,
+                         Status::ERROR_INVALID_OPERATION, "source is not seekable or media info is not parsed");
+    uint64_t targetSamples = HstTimeToSamples(std::max(seekTime, static_cast<int64_t>(0)));
+    ScanFrameIndex(targetSamples);
+    FALSE_RETURN_V_MSG_E(!frameIndex_.empty(), Status::ERROR_INVALID_OPERATION, "no frame is indexed");
+    if (targetSamples >= indexedSamples_) {
+        targetSamples = indexedSamples_ - 1; // past the indexed frames, seek to the last one
+    }
+
+    // walk the headers from the nearest entry to the frame containing the target
+    auto entry = std::upper_bound(frameIndex_.begin(), frameIndex_.end(), targetSamples,
+        [](uint64_t samples, const FrameIndexEntry& item) { return samples < item.samples; });
+    --entry;
+    int64_t offset = entry->offset;
+    uint64_t samples = entry->samples;
+    uint32_t frameLength = 0;
+    uint32_t frameSamples = 0;
+    while (ReadAdtsHeader(offset, frameLength, frameSamples) == Status::OK) {
+        bool isTargetFrame = samples + frameSamples > targetSamples;
+        if (isTargetFrame && (mode != SeekMode::SEEK_NEXT_SYNC || samples == targetSamples)) {
+            break;
+        }
+        offset += frameLength;
+        samples += frameSamples;
+        if (isTargetFrame || offset >= static_cast<int64_t>(fileSize_)) {
+            break;
+        }
+    }
+    MEDIA_LOG_D("seek to " PUBLIC_LOG_D64 " land on samples " PUBLIC_LOG_U64 " offset " PUBLIC_LOG_D64,
+                seekTime, samples, offset);
+    ioContext_.offset = offset;
+    ioContext_.eos = false;
+    ioDataRemainSize_ = 0;
+    usedDataSize_ = 0;
+    curSamples_ = samples;
+    realSeekTime = SamplesToHstTime(samples);
     return Status::OK;
 }
 
+Status AACDemuxerPlugin::ReadAdtsHeader(int64_t offset, uint32_t& frameLength, uint32_t& frameSamples)
+{
+    if (headerBuffer_ == nullptr) {
+        headerBuffer_ = std::make_shared<Buffer>();
+        headerBuffer_->AllocMemory(nullptr, ADTS_HEADER_SIZE);
+    }
+    auto memory = headerBuffer_->GetMemory();
+    memory->Reset();
+    auto ret = ioContext_.dataSource->ReadAt(offset, headerBuffer_, ADTS_HEADER_SIZE);
+    FALSE_RETURN_V(ret == Status::OK, ret);
+    FALSE_RETURN_V(memory->GetSize() >= ADTS_HEADER_SIZE, Status::END_OF_STREAM);
+    const uint8_t *header = memory->GetReadOnlyData();
+    FALSE_RETURN_V(IsAACPattern(header), Status::ERROR_UNSUPPORTED_FORMAT);
+    frameLength = static_cast<uint32_t>(GetFrameLength(header));
+    FALSE_RETURN_V(frameLength >= ADTS_HEADER_SIZE, Status::ERROR_UNSUPPORTED_FORMAT);
+    frameSamples = GetFrameSamples(header);
+    return Status::OK;
+}
+
+void AACDemuxerPlugin::IndexFrame(int64_t offset, uint32_t frameLength, uint32_t frameSamples)
+{
+    if (indexComplete_ || offset < indexedOffset_) {
+        return;
+    }
+    if (indexedFrames_ % FRAME_INDEX_INTERVAL == 0) {
+        frameIndex_.push_back({indexedSamples_, offset});
+    }
+    indexedFrames_++;
+    indexedSamples_ += frameSamples;
+    indexedOffset_ = offset + frameLength;
+    if (static_cast<uint64_t>(indexedOffset_) + ADTS_HEADER_SIZE > fileSize_) {
+        indexComplete_ = true; // the reads reached the last frame, the duration is exact from now on
+    }
+}
+
+void AACDemuxerPlugin::ScanFrameIndex(uint64_t targetSamples)
+{
+    uint32_t frameLength = 0;
+    uint32_t frameSamples = 0;
+    while (!indexComplete_ && indexedSamples_ <= targetSamples) {
+        if (static_cast<uint64_t>(indexedOffset_) + ADTS_HEADER_SIZE > fileSize_) {
+            indexComplete_ = true;
+            break;
+        }
+        // stop at a damaged header, the frames after it are indexed when playback resyncs past it
+        if (ReadAdtsHeader(indexedOffset_, frameLength, frameSamples) != Status::OK) {
+            MEDIA_LOG_W("scan stopped at offset " PUBLIC_LOG_D64, indexedOffset_);
+            break;
+        }
+        if (static_cast<uint64_t>(indexedOffset_) + frameLength > fileSize_) {
+            indexComplete_ = true; // truncated last frame
+            break;
+        }
+        IndexFrame(indexedOffset_, frameLength, frameSamples);
+    }
+}
+
+int64_t AACDemuxerPlugin::EstimateDuration() const
+{
+    if (indexComplete_) {
+        return SamplesToHstTime(indexedSamples_);
+    }
+    if (indexedOffset_ <= 0 || frameIndex_.empty()) {
+        return 0;
+    }
+    // scale the samples of the scanned frames by the bytes of the whole stream, ADTS carries no duration
+    uint64_t scannedBytes = static_cast<uint64_t>(indexedOffset_ - frameIndex_.front().offset);
+    uint64_t streamBytes = fileSize_ - static_cast<uint64_t>(frameIndex_.front().offset);
+    if (scannedBytes == 0) {
+        return 0;
+    }
+    double samples = static_cast<double>(indexedSamples_) * static_cast<double>(streamBytes) / scannedBytes;
+    return SamplesToHstTime(static_cast<uint64_t>(samples));
+}
+
+void AACDemuxerPlugin::ResetFrameIndex()
+{
+    frameIndex_.clear();
+    indexedFrames_ = 0;
+    indexedSamples_ = 0;
+    indexedOffset_ = 0;
+    indexComplete_ = false;
+    curSamples_ = 0;
+}
+
+int64_t AACDemuxerPlugin::SamplesToHstTime(uint64_t samples) const
+{
+    uint32_t sampleRate = aacDemuxerRst_.frameSampleRate;
+    if (sampleRate == 0) {
+        return 0;
+    }
+    // split to avoid the overflow of samples * HST_SECOND
+    return static_cast<int64_t>(samples / sampleRate) * HST_SECOND +
+        static_cast<int64_t>(samples % sampleRate) * HST_SECOND / sampleRate;
+}
+
+uint64_t AACDemuxerPlugin::HstTimeToSamples(int64_t hstTime) const
+{
+    uint64_t sampleRate = aacDemuxerRst_.frameSampleRate;
+    return static_cast<uint64_t>(hstTime / HST_SECOND) * sampleRate +
+        static_cast<uint64_t>(hstTime % HST_SECOND) * sampleRate / HST_SECOND;
+}
+
 Status AACDemuxerPlugin::Init()
 {
     inIoBuffer_ = static_cast<uint8_t *>(malloc(inIoBufferSize_));
@@ -256,6 +422,8 @@ Status AACDemuxerPlugin::Reset()
     ioContext_.dataSource.reset();
     ioDataRemainSize_ = 0;
     (void)memset_s(inIoBuffer_, inIoBufferSize_, 0x00, inIoBufferSize_);
+    ResetFrameIndex();
+    headerBuffer_.reset();
     return Status::OK;
 }
 
@@ -271,7 +439,15 @@ Status AACDemuxerPlugin::Stop()
 
 Status AACDemuxerPlugin::GetParameter(Tag tag, ValueType &value)
 {
-    return Status::ERROR_UNIMPLEMENTED;
+    if (tag != Tag::MEDIA_DURATION) {
+        return Status::ERROR_UNIMPLEMENTED;
+    }
+    // the media info only carries an estimate, the exact duration exists once the index reaches the end of the file
+    FALSE_RETURN_V(indexComplete_, Status::ERROR_NOT_EXISTED);
+    int64_t duration = SamplesToHstTime(indexedSamples_);
+    FALSE_RETURN_V(duration > 0, Status::ERROR_NOT_EXISTED);
+    value = duration;
+    return Status::OK;
 }
 
 Status AACDemuxerPlugin::SetParameter(Tag tag, const ValueType &value)
@@ -371,7 +547,7 @@ int AACDemuxerPlugin::AudioDemuxerAACProcess(const uint8_t *buffer, uint32_t buf
         }
 
         auto length = static_cast<unsigned int>(GetFrameLength(buffer));
-        if (length + 2 > bufferLen) { // 2
+        if (length > bufferLen) {
             rst->usedInputLength = bufferLen;
             return 0;
         }
@@ -381,7 +557,8 @@ int AACDemuxerPlugin::AudioDemuxerAACProcess(const uint8_t *buffer, uint32_t buf
             return -1;
         }
 
-        if (IsAACPattern(buffer + length)) {
+        // the last frame of the file has no next sync word to check
+        if (length + 2 > bufferLen || IsAACPattern(buffer + length)) { // 2: sync word of the next frame
             rst->frameBuffer = static_cast<uint8_t *>(malloc(length));
             if (rst->frameBuffer) {
                 FALSE_LOG(memcpy_s(rst->frameBuffer, length, buffer, length) == 0);
@@ -416,6 +593,11 @@ namespace {
         return data[0] == 0xff && (data[1] & 0xf0) == 0xf0 && (data[1] & 0x06) == 0x00; // 根据协议判断是否为AAC帧
     }
 
+    uint32_t GetFrameSamples(const uint8_t *data)
+    {
+        return ((data[6] & 0x03) + 1) * ADTS_SAMPLES_PER_BLOCK; // 6: number_of_raw_data_blocks_in_frame
+    }
+
     int Sniff(const std::string& name, std::shared_ptr<DataSource> dataSource)
     {
         auto buffer = std::make_shared<Buffer>();
@@ -16,6 +16,7 @@
 #ifndef AAC_DEMUXER_PLUGIN_H
 #define AAC_DEMUXER_PLUGIN_H
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -75,7 +76,18 @@ private:
         int64_t offset {0};
         bool eos {false};
     };
+    struct FrameIndexEntry {
+        uint64_t samples; // samples before the frame
+        int64_t offset;   // file offset of the frame header
+    };
     Status DoReadFromSource(uint32_t readSize);
+    Status ReadAdtsHeader(int64_t offset, uint32_t& frameLength, uint32_t& frameSamples);
+    void IndexFrame(int64_t offset, uint32_t frameLength, uint32_t frameSamples);
+    void ScanFrameIndex(uint64_t targetSamples);
+    void ResetFrameIndex();
+    int64_t EstimateDuration() const;
+    int64_t SamplesToHstTime(uint64_t samples) const;
+    uint64_t HstTimeToSamples(int64_t hstTime) const;
     Status GetDataFromSource();
     int GetFrameLength(const uint8_t *data);
     int AudioDemuxerAACOpen(AudioDemuxerUserArg *userArg);
@@ -91,6 +103,17 @@ private:
     unsigned char *inIoBuffer_;
     int inIoBufferSize_;
     unsigned int ioDataRemainSize_;
+
+    // Sparse ADTS frame index, one entry every FRAME_INDEX_INTERVAL frames. It grows while frames are read and on
+    // demand by a scan which reads only the frame headers, so a seek reads at most FRAME_INDEX_INTERVAL headers
+    // after the nearest entry.
+    std::vector<FrameIndexEntry> frameIndex_ {};
+    uint64_t indexedFrames_ {0};
+    uint64_t indexedSamples_ {0};
+    int64_t indexedOffset_ {0}; // file offset after the last indexed frame
+    std::atomic<bool> indexComplete_ {false}; // set after the last frame, read by GetParameter on other threads
+    uint64_t curSamples_ {0}; // samples before the next frame returned by ReadFrame
+    std::shared_ptr<Buffer> headerBuffer_ {nullptr};
 };
 } // namespace AacDemuxer
 } // namespace Plugin
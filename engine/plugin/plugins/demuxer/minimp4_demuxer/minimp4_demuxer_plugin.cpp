@@ -40,6 +40,7 @@ constexpr int8_t MP4_HEADER_OFFSET = 4;
 constexpr int8_t RANK_MAX = 100;
 constexpr unsigned int DEFAULT_AUDIO_SAMPLE_PER_FRAME = 1024;
 constexpr unsigned int MEDIA_IO_SIZE = 16 * 1024;
+constexpr uint32_t FRAME_INDEX_INTERVAL = 32; // 32: at most 32 samples are looked up in the sample table on seek
 int Sniff(const std::string &name, std::shared_ptr<DataSource> dataSource);
 Status RegisterPlugins(const std::shared_ptr<Register> &reg);
 }
@@ -51,7 +52,8 @@ MiniMP4DemuxerPlugin::MiniMP4DemuxerPlugin(std::string name)
       inIoBuffer_(nullptr),
       ioDataRemainSize_(0),
       inIoBufferSize_(MEDIA_IO_SIZE),
-      sampleIndex_(0)
+      sampleIndex_(0),
+      frameIndex_("MiniMP4DemuxerPlugin", FRAME_INDEX_INTERVAL, "")
 {
     (void)memset_s(&miniMP4_, sizeof(MP4D_demux_t), 0, sizeof(MP4D_demux_t));
     MEDIA_LOG_I("MiniMP4DemuxerPlugin, plugin name: " PUBLIC_LOG_S, pluginName_.c_str());
@@ -86,6 +88,7 @@ Status MiniMP4DemuxerPlugin::Init()
 
 Status MiniMP4DemuxerPlugin::Deinit()
 {
+    (void)frameIndex_.Save();
     if (inIoBuffer_) {
         free(inIoBuffer_);
         inIoBuffer_ = nullptr;
@@ -101,6 +104,8 @@ Status MiniMP4DemuxerPlugin::Prepare()
 Status MiniMP4DemuxerPlugin::Reset()
 {
     MEDIA_LOG_D("Reset in");
+    (void)frameIndex_.Save();
+    frameIndex_.Clear();
     ioContext_.eos = false;
     ioContext_.offset = 0;
     ioContext_.dataSource.reset();
@@ -250,6 +255,8 @@ Status MiniMP4DemuxerPlugin::GetMediaInfo(MediaInfo &mediaInfo)
     if (AudioAdapterForDecoder() != Status::OK) {
         return Status::ERROR_UNKNOWN;
     }
+    // the sample table is parsed by MP4D_open anyway, the index only shortens its lookups and stays in memory
+    frameIndex_.Clear();
     mediaInfo.tracks.resize(1);
     mediaInfo.tracks[0].Set<Tag::MEDIA_TYPE>(MediaType::AUDIO);
     mediaInfo.tracks[0].Set<Tag::AUDIO_SAMPLE_RATE>(miniMP4_.track->SampleDescription.audio.samplerate_hz);
@@ -341,6 +348,7 @@ Status MiniMP4DemuxerPlugin::ReadFrame(Buffer &outBuffer, int32_t timeOutMs)
 {
     std::shared_ptr<Memory> mp4FrameData;
     if (sampleIndex_ >= miniMP4_.track->sample_count) {
+        CompleteFrameIndex();
         (void)memset_s(inIoBuffer_, MEDIA_IO_SIZE, 0, MEDIA_IO_SIZE);
         ioDataRemainSize_ = 0;
         MEDIA_LOG_DD("sampleIndex_ " PUBLIC_LOG_D32, sampleIndex_);
@@ -354,6 +362,7 @@ Status MiniMP4DemuxerPlugin::ReadFrame(Buffer &outBuffer, int32_t timeOutMs)
     if (offset > fileSize_) {
         return Status::ERROR_UNKNOWN;
     }
+    IndexSample(sampleIndex_, timeStamp, offset);
     MEDIA_LOG_D("frameSize " PUBLIC_LOG_D32 " offset " PUBLIC_LOG_D32 " sampleIndex_ " PUBLIC_LOG_D32,
         frameSize, static_cast<uint32_t>(offset), sampleIndex_);
     if (outBuffer.IsEmpty()) {
@@ -373,6 +382,7 @@ Status MiniMP4DemuxerPlugin::ReadFrame(Buffer &outBuffer, int32_t timeOutMs)
     }
     FillADTSHead(mp4FrameData, frameSize);
     size_t writeSize = mp4FrameData->Write(inIoBuffer_, frameSize, ADTS_HEADER_SIZE);
+    outBuffer.pts = TimeStampToHstTime(timeStamp);
     sampleIndex_++;
     MEDIA_LOG_D("writeSize " PUBLIC_LOG_ZU " mp4FrameData size " PUBLIC_LOG_ZU, writeSize, mp4FrameData->GetSize());
     ioDataRemainSize_ -= frameSize;
@@ -381,38 +391,90 @@ Status MiniMP4DemuxerPlugin::ReadFrame(Buffer &outBuffer, int32_t timeOutMs)
     return Status::OK;
 }
 
-Status MiniMP4DemuxerPlugin::SeekTo(int32_t trackId, int64_t seekTime, SeekMode mode, int64_t& realSeekTime)
+void MiniMP4DemuxerPlugin::IndexSample(unsigned int index, unsigned int timeStamp, uint64_t offset)
+{
+    frameIndex_.Add(index, static_cast<int64_t>(timeStamp), offset);
+}
+
+void MiniMP4DemuxerPlugin::CompleteFrameIndex()
+{
+    unsigned int sampleCount = miniMP4_.track->sample_count;
+    // only an index built without gap up to the last sample is complete
+    if (sampleCount > 0 && frameIndex_.GetNextFrame() >= sampleCount) {
+        unsigned int frameSize = 0;
+        unsigned int timeStamp = 0;
+        unsigned int duration = 0;
+        (void)MP4D_frame_offset(&miniMP4_, 0, sampleCount - 1, &frameSize, &timeStamp, &duration);
+        frameIndex_.SetComplete(sampleCount, static_cast<int64_t>(timeStamp) + duration);
+    }
+    (void)frameIndex_.Save();
+}
+
+// seek to the sample holding target, in track time scale, looking up at most one index interval of samples
+Status MiniMP4DemuxerPlugin::SeekToTimeStamp(uint64_t target, int64_t& realSeekTime)
 {
     unsigned int frameSize = 0;
     unsigned int timeStamp = 0;
     unsigned int duration = 0;
-    uint64_t offsetStart = MP4D_frame_offset(&miniMP4_, 0, 0, &frameSize, &timeStamp, &duration);
-    uint64_t offsetEnd =
-        MP4D_frame_offset(&miniMP4_, 0, miniMP4_.track->sample_count - 1, &frameSize, &timeStamp, &duration);
-    uint64_t targetPos = (Plugin::HstTime2Ms(seekTime) * static_cast<int64_t>(miniMP4_.track->avg_bitrate_bps)) / 8 +
-        offsetStart;
-    if (targetPos >= offsetEnd) {
-        sampleIndex_ = miniMP4_.track->sample_count;
-        return Status::OK;
+    unsigned int index = 0;
+    FrameIndexCache::Entry entry;
+    if (frameIndex_.Lookup(static_cast<int64_t>(target), entry)) {
+        index = static_cast<unsigned int>(entry.frame);
     }
-    sampleIndex_ = 0;
-    uint64_t tempPos = 0;
-    while (sampleIndex_ < miniMP4_.track->sample_count) {
-        tempPos = MP4D_frame_offset(&miniMP4_, 0, sampleIndex_, &frameSize, &timeStamp, &duration);
-        if (tempPos < targetPos) {
-            sampleIndex_++;
-        } else {
+    uint64_t offset = 0;
+    for (; index < miniMP4_.track->sample_count; ++index) {
+        offset = MP4D_frame_offset(&miniMP4_, 0, index, &frameSize, &timeStamp, &duration);
+        IndexSample(index, timeStamp, offset);
+        if (static_cast<uint64_t>(timeStamp) + duration > target) {
             break;
         }
     }
-    ioContext_.offset = tempPos;
+    if (index >= miniMP4_.track->sample_count) {
+        sampleIndex_ = miniMP4_.track->sample_count;
+        CompleteFrameIndex();
+        realSeekTime = TimeStampToHstTime(static_cast<uint64_t>(timeStamp) + duration);
+        return Status::OK;
+    }
+    sampleIndex_ = index;
+    ioContext_.offset = static_cast<int64_t>(offset);
+    ioContext_.eos = false;
     ioDataRemainSize_ = 0;
     MEDIA_LOG_D("ioContext_.offset " PUBLIC_LOG_D32, static_cast<uint32_t>(ioContext_.offset));
     (void)memset_s(inIoBuffer_, inIoBufferSize_, 0x00, inIoBufferSize_);
-    realSeekTime = seekTime;
+    realSeekTime = TimeStampToHstTime(timeStamp);
     return Status::OK;
 }
 
+Status MiniMP4DemuxerPlugin::SeekTo(int32_t trackId, int64_t seekTime, SeekMode mode, int64_t& realSeekTime)
+{
+    uint64_t timeScale = GetTimeScale();
+    if (miniMP4_.track == nullptr || timeScale == 0) {
+        return Status::ERROR_WRONG_STATE;
+    }
+    // rounded up, seeking to the pts of a sample lands on that sample
+    uint64_t time = static_cast<uint64_t>(std::max(seekTime, static_cast<int64_t>(0)));
+    return SeekToTimeStamp(time / HST_SECOND * timeScale + (time % HST_SECOND * timeScale + HST_SECOND - 1) /
+                           HST_SECOND, realSeekTime);
+}
+
+uint64_t MiniMP4DemuxerPlugin::GetTimeScale() const
+{
+    if (miniMP4_.track->timescale != 0) {
+        return miniMP4_.track->timescale;
+    }
+    return miniMP4_.track->SampleDescription.audio.samplerate_hz;
+}
+
+int64_t MiniMP4DemuxerPlugin::TimeStampToHstTime(uint64_t timeStamp) const
+{
+    uint64_t timeScale = GetTimeScale();
+    if (timeScale == 0) {
+        return 0;
+    }
+    // split to avoid the overflow of timeStamp * HST_SECOND
+    return static_cast<int64_t>(timeStamp / timeScale * HST_SECOND + timeStamp % timeScale * HST_SECOND / timeScale);
+}
+
 uint64_t MiniMP4DemuxerPlugin::GetFileSize()
 {
     return fileSize_;
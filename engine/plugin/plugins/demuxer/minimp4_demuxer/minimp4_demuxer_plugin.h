@@ -21,6 +21,7 @@
 #include <vector>
 #include <set>
 #include "minimp4.h"
+#include "plugin/common/frame_index_cache.h"
 #include "plugin/interface/demuxer_plugin.h"
 
 namespace OHOS {
@@ -56,6 +57,11 @@ public:
 private:
     void FillADTSHead(std::shared_ptr<Memory> &data, unsigned int frameSize);
     static int ReadCallback(int64_t offset, void* buffer, size_t size, void* token);
+    void IndexSample(unsigned int index, unsigned int timeStamp, uint64_t offset);
+    void CompleteFrameIndex();
+    Status SeekToTimeStamp(uint64_t target, int64_t& realSeekTime);
+    uint64_t GetTimeScale() const;
+    int64_t TimeStampToHstTime(uint64_t timeStamp) const;
     struct IOContext {
         std::shared_ptr<DataSource> dataSource {nullptr};
         int64_t offset {0};
@@ -71,6 +77,7 @@ private:
     int           inIoBufferSize_;
     unsigned int sampleIndex_;
     uint32_t readDataSize_ = 0;
+    FrameIndexCache frameIndex_;
 };
 } // namespace Minimp4
 } // namespace Plugin
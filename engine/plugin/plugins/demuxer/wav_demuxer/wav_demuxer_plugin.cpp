@@ -18,10 +18,14 @@
 #include "wav_demuxer_plugin.h"
 
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <cstdio>
 #include <cstring>
+#include <securec.h>
 #include "foundation/log.h"
 #include "foundation/utils/constants.h"
+#include "plugin/common/plugin_audio_tags.h"
 #include "plugin/common/plugin_time.h"
 
 namespace OHOS {
@@ -31,14 +35,25 @@ namespace WavPlugin {
 namespace {
 constexpr uint8_t  MAX_RANK = 100;
 constexpr uint8_t  PROBE_READ_LENGTH  = 4;
-constexpr uint32_t WAV_PER_FRAME_SIZE = 8192;
-constexpr uint32_t WAV_HEAD_INFO_LEN = sizeof(WavHeadAttr);
+constexpr uint32_t RIFF_HEADER_SIZE = 12;
+constexpr uint32_t CHUNK_HEADER_SIZE = 8;
+constexpr uint32_t FMT_CHUNK_MIN_SIZE = 16;
+constexpr uint32_t FMT_CHUNK_EXTENSIBLE_SIZE = 40;
+constexpr uint32_t DS64_CHUNK_MIN_SIZE = 24;
+constexpr uint32_t RIFF_SIZE_UNKNOWN = 0xFFFFFFFF;
+constexpr uint32_t READ_DURATION_MS = 50; // 50: default duration of one output buffer
+constexpr uint64_t MAX_READ_SIZE = 4 * 1024 * 1024; // 4M: upper bound of one output buffer
 bool WavSniff(const uint8_t *inputBuf);
 std::map<uint32_t, AudioSampleFormat> g_WavAudioSampleFormatPacked = {
     {8, AudioSampleFormat::U8},
     {16, AudioSampleFormat::S16},
+    {24, AudioSampleFormat::S24},
     {32, AudioSampleFormat::S32},
 };
+std::map<uint32_t, AudioSampleFormat> g_WavAudioSampleFormatFloat = {
+    {32, AudioSampleFormat::F32},
+    {64, AudioSampleFormat::F64},
+};
 
 enum class WavAudioFormat {
     WAVE_FORMAT_PCM = 0x0001,
@@ -49,6 +64,69 @@ enum class WavAudioFormat {
 };
 int Sniff(const std::string& pluginName, std::shared_ptr<DataSource> dataSource);
 Status RegisterPlugin(const std::shared_ptr<Register>& reg);
+
+inline uint16_t GetLe16(const uint8_t* data)
+{
+    return static_cast<uint16_t>(data[0] | (data[1] << 8)); // 1 8
+}
+
+inline uint32_t GetLe32(const uint8_t* data)
+{
+    return static_cast<uint32_t>(GetLe16(data)) | (static_cast<uint32_t>(GetLe16(data + 2)) << 16); // 2 16
+}
+
+inline uint64_t GetLe64(const uint8_t* data)
+{
+    return static_cast<uint64_t>(GetLe32(data)) | (static_cast<uint64_t>(GetLe32(data + 4)) << 32); // 4 32
+}
+
+inline bool IsChunk(const uint8_t* id, const char* name)
+{
+    return memcmp(id, name, 4) == 0; // 4: chunk id length
+}
+
+int16_t AlawToLinear(uint8_t value)
+{
+    value ^= 0x55; // 0x55: even bits are inverted
+    int32_t sample = (value & 0x0F) << 4; // 4: mantissa
+    int32_t segment = (value & 0x70) >> 4; // 4: exponent
+    if (segment == 0) {
+        sample += 8; // 8: rounding of segment 0
+    } else {
+        sample = (sample + 0x108) << (segment - 1); // 0x108: leading one and rounding
+    }
+    return static_cast<int16_t>((value & 0x80) ? sample : -sample);
+}
+
+int16_t MulawToLinear(uint8_t value)
+{
+    value = ~value;
+    int32_t sample = (((value & 0x0F) << 3) + 0x84) << ((value & 0x70) >> 4); // 3 4 0x84: bias
+    return static_cast<int16_t>((value & 0x80) ? (0x84 - sample) : (sample - 0x84)); // 0x84: bias
+}
+
+struct G711Table {
+    explicit G711Table(int16_t (*expand)(uint8_t))
+    {
+        for (uint32_t i = 0; i < samples.size(); ++i) {
+            samples[i] = expand(static_cast<uint8_t>(i));
+        }
+    }
+    std::array<int16_t, 256> samples {}; // 256: all the 8 bit codes
+};
+
+const G711Table& GetG711Table(uint16_t format)
+{
+    static const G711Table alawTable(AlawToLinear);
+    static const G711Table mulawTable(MulawToLinear);
+    return format == static_cast<uint16_t>(WavAudioFormat::WAVE_FORMAT_ALAW) ? alawTable : mulawTable;
+}
+
+inline bool IsG711(uint16_t format)
+{
+    return format == static_cast<uint16_t>(WavAudioFormat::WAVE_FORMAT_ALAW) ||
+        format == static_cast<uint16_t>(WavAudioFormat::WAVE_FORMAT_MULAW);
+}
 }
 
 WavDemuxerPlugin::WavDemuxerPlugin(std::string name)
@@ -78,33 +156,161 @@ Status WavDemuxerPlugin::SetDataSource(const std::shared_ptr<DataSource>& source
     return Status::OK;
 }
 
-Status WavDemuxerPlugin::GetMediaInfo(MediaInfo& mediaInfo)
+Status WavDemuxerPlugin::ReadSource(uint64_t offset, uint8_t* data, size_t size)
 {
     auto buffer = std::make_shared<Buffer>();
-    buffer->WrapMemory((uint8_t*)&wavHeader_, sizeof(wavHeader_), 0);
-    Status status = ioContext_.dataSource->ReadAt(0, buffer, WAV_HEAD_INFO_LEN);
-    if (status != Status::OK) {
-        return status;
+    auto memory = buffer->WrapMemory(data, size, 0);
+    Status status = ioContext_.dataSource->ReadAt(static_cast<int64_t>(offset), buffer, size);
+    FALSE_RETURN_V(status == Status::OK, status);
+    return memory->GetSize() == size ? Status::OK : Status::ERROR_NOT_ENOUGH_DATA;
+}
+
+Status WavDemuxerPlugin::ParseFmtChunk(uint64_t offset, uint32_t size)
+{
+    FALSE_RETURN_V_MSG_E(size >= FMT_CHUNK_MIN_SIZE, Status::ERROR_UNSUPPORTED_FORMAT,
+                         "fmt chunk size " PUBLIC_LOG_U32 " is too small", size);
+    uint8_t fmt[FMT_CHUNK_EXTENSIBLE_SIZE] = {0};
+    uint32_t fmtSize = std::min(size, FMT_CHUNK_EXTENSIBLE_SIZE);
+    FALSE_RETURN_V(ReadSource(offset, fmt, fmtSize) == Status::OK, Status::ERROR_NOT_ENOUGH_DATA);
+    wavHeader_.subChunk1Size = size;
+    wavHeader_.audioFormat = GetLe16(fmt);
+    wavHeader_.numChannels = GetLe16(fmt + 2); // 2
+    wavHeader_.sampleRate = GetLe32(fmt + 4); // 4
+    wavHeader_.byteRate = GetLe32(fmt + 8); // 8
+    wavHeader_.blockAlign = GetLe16(fmt + 12); // 12
+    wavHeader_.bitsPerSample = GetLe16(fmt + 14); // 14
+    codecFormat_ = wavHeader_.audioFormat;
+    if (codecFormat_ == static_cast<uint16_t>(WavAudioFormat::WAVE_FORMAT_EXTENSIBLE) &&
+        fmtSize == FMT_CHUNK_EXTENSIBLE_SIZE) {
+        channelMask_ = GetLe32(fmt + 20); // 20: dwChannelMask
+        codecFormat_ = GetLe16(fmt + 24); // 24: first two bytes of the SubFormat GUID are the format code
+    }
+    return Status::OK;
+}
+
+Status WavDemuxerPlugin::ParseDs64Chunk(uint64_t offset, uint32_t size)
+{
+    FALSE_RETURN_V_MSG_E(size >= DS64_CHUNK_MIN_SIZE, Status::ERROR_UNSUPPORTED_FORMAT,
+                         "ds64 chunk size " PUBLIC_LOG_U32 " is too small", size);
+    uint8_t ds64[DS64_CHUNK_MIN_SIZE] = {0};
+    FALSE_RETURN_V(ReadSource(offset, ds64, DS64_CHUNK_MIN_SIZE) == Status::OK, Status::ERROR_NOT_ENOUGH_DATA);
+    ds64DataSize_ = GetLe64(ds64 + 8); // 8: riffSize comes first
+    return Status::OK;
+}
+
+// walk the chunks up to "data", chunks such as LIST, cue, fact and JUNK are skipped
+Status WavDemuxerPlugin::ParseHeader()
+{
+    uint8_t riff[RIFF_HEADER_SIZE] = {0};
+    FALSE_RETURN_V(ReadSource(0, riff, RIFF_HEADER_SIZE) == Status::OK, Status::ERROR_NOT_ENOUGH_DATA);
+    bool isRf64 = IsChunk(riff, "RF64");
+    FALSE_RETURN_V_MSG_E((IsChunk(riff, "RIFF") || isRf64) && IsChunk(riff + 8, "WAVE"), // 8: form type
+                         Status::ERROR_UNSUPPORTED_FORMAT, "not a wave file");
+    (void)memcpy_s(wavHeader_.chunkID, sizeof(wavHeader_.chunkID), riff, sizeof(wavHeader_.chunkID));
+    (void)memcpy_s(wavHeader_.format, sizeof(wavHeader_.format), riff + 8, sizeof(wavHeader_.format)); // 8
+    wavHeader_.chunkSize = GetLe32(riff + 4); // 4
+
+    bool hasFmt = false;
+    uint64_t offset = RIFF_HEADER_SIZE;
+    uint8_t chunk[CHUNK_HEADER_SIZE] = {0};
+    while (fileSize_ == 0 || offset + CHUNK_HEADER_SIZE <= fileSize_) {
+        FALSE_RETURN_V(ReadSource(offset, chunk, CHUNK_HEADER_SIZE) == Status::OK, Status::ERROR_NOT_ENOUGH_DATA);
+        uint32_t chunkSize = GetLe32(chunk + 4); // 4: size follows the id
+        uint64_t chunkData = offset + CHUNK_HEADER_SIZE;
+        Status status = Status::OK;
+        if (IsChunk(chunk, "fmt ")) {
+            (void)memcpy_s(wavHeader_.subChunk1ID, sizeof(wavHeader_.subChunk1ID), chunk, sizeof(chunk) / 2); // 2
+            status = ParseFmtChunk(chunkData, chunkSize);
+            hasFmt = status == Status::OK;
+        } else if (IsChunk(chunk, "ds64") && isRf64) {
+            status = ParseDs64Chunk(chunkData, chunkSize);
+        } else if (IsChunk(chunk, "data")) {
+            FALSE_RETURN_V_MSG_E(hasFmt, Status::ERROR_UNSUPPORTED_FORMAT, "data chunk before fmt chunk");
+            uint64_t dataSize = chunkSize;
+            if (chunkSize == RIFF_SIZE_UNKNOWN && isRf64) {
+                dataSize = ds64DataSize_;
+            } else if (chunkSize == 0 || chunkSize == RIFF_SIZE_UNKNOWN) {
+                dataSize = fileSize_ > chunkData ? fileSize_ - chunkData : UINT64_MAX - chunkData; // still growing
+            }
+            wavHeader_.subChunk3Size = chunkSize;
+            dataStart_ = chunkData;
+            dataEnd_ = dataStart_ + dataSize;
+            if (fileSize_ > 0 && dataEnd_ > fileSize_) {
+                dataEnd_ = fileSize_; // truncated file
+            }
+            wavHeadLength_ = static_cast<uint32_t>(std::min(dataStart_, static_cast<uint64_t>(UINT32_MAX)));
+            return Status::OK;
+        }
+        FALSE_RETURN_V(status == Status::OK, status);
+        offset = chunkData + chunkSize + (chunkSize & 1); // 1: chunks are padded to an even size
+    }
+    MEDIA_LOG_E("no data chunk found");
+    return Status::ERROR_UNSUPPORTED_FORMAT;
+}
+
+void WavDemuxerPlugin::UpdateReadSize()
+{
+    int64_t duration = readDuration_ > 0 ? readDuration_ : READ_DURATION_MS * HST_MSECOND;
+    // in double, a long duration times a high sample rate does not fit in 64 bits
+    double samples = static_cast<double>(wavHeader_.sampleRate) * static_cast<double>(duration) / HST_SECOND;
+    uint64_t maxSamples = MAX_READ_SIZE / blockAlign_;
+    readSize_ = (samples < 1 ? 1 : std::min(static_cast<uint64_t>(samples), maxSamples)) * blockAlign_;
+    MEDIA_LOG_D("read " PUBLIC_LOG_U64 " bytes per buffer", readSize_);
+}
+
+int64_t WavDemuxerPlugin::SamplesToHstTime(uint64_t samples) const
+{
+    uint64_t sampleRate = wavHeader_.sampleRate;
+    if (sampleRate == 0) {
+        return 0;
+    }
+    // split to avoid the overflow of samples * HST_SECOND
+    return static_cast<int64_t>(samples / sampleRate) * HST_SECOND +
+        static_cast<int64_t>(samples % sampleRate) * HST_SECOND / static_cast<int64_t>(sampleRate);
+}
+
+Status WavDemuxerPlugin::GetMediaInfo(MediaInfo& mediaInfo)
+{
+    Status status = ParseHeader();
+    FALSE_RETURN_V(status == Status::OK, status);
+    MEDIA_LOG_D("data start " PUBLIC_LOG_U64 " end " PUBLIC_LOG_U64, dataStart_, dataEnd_);
+
+    AudioSampleFormat sampleFormat = AudioSampleFormat::NONE;
+    uint32_t bitsPerSample = wavHeader_.bitsPerSample;
+    if (codecFormat_ == static_cast<uint16_t>(WavAudioFormat::WAVE_FORMAT_PCM)) {
+        auto iter = g_WavAudioSampleFormatPacked.find(bitsPerSample);
+        sampleFormat = iter != g_WavAudioSampleFormatPacked.end() ? iter->second : AudioSampleFormat::NONE;
+    } else if (codecFormat_ == static_cast<uint16_t>(WavAudioFormat::WAVE_FORMAT_IEEE_FLOAT)) {
+        auto iter = g_WavAudioSampleFormatFloat.find(bitsPerSample);
+        sampleFormat = iter != g_WavAudioSampleFormatFloat.end() ? iter->second : AudioSampleFormat::NONE;
+    } else if (IsG711(codecFormat_) && bitsPerSample == 8) { // 8: G.711 codes
+        sampleFormat = AudioSampleFormat::S16; // expanded while reading
+        bitsPerSample = 16; // 16: bits of the expanded samples
     }
-    wavHeadLength_  = WAV_HEAD_INFO_LEN;
-    if (wavHeader_.audioFormat == static_cast<uint16_t>(WavAudioFormat::WAVE_FORMAT_PCM)) {
-        wavHeadLength_ -= 12; // 12 = subChunk2ID(optional)+subChunk2Size(optional)+dataFactSize(optional)
+    FALSE_RETURN_V_MSG_E(sampleFormat != AudioSampleFormat::NONE && wavHeader_.numChannels > 0 &&
+                         wavHeader_.sampleRate > 0, Status::ERROR_UNSUPPORTED_FORMAT,
+                         "unsupported format " PUBLIC_LOG_U16 " bits " PUBLIC_LOG_U16,
+                         codecFormat_, wavHeader_.bitsPerSample);
+    blockAlign_ = wavHeader_.blockAlign;
+    if (blockAlign_ == 0) {
+        blockAlign_ = wavHeader_.bitsPerSample / 8 * wavHeader_.numChannels; // 8: bits per byte
     }
-    MEDIA_LOG_D("wavHeadLength_ " PUBLIC_LOG_U32, wavHeadLength_);
-    dataOffset_ = wavHeadLength_;
+    FALSE_RETURN_V_MSG_E(blockAlign_ > 0, Status::ERROR_UNSUPPORTED_FORMAT, "block align is 0");
+    dataEnd_ -= (dataEnd_ - dataStart_) % blockAlign_; // a partial block at the end is not played
+    UpdateReadSize();
+    dataOffset_ = dataStart_;
+
     mediaInfo.tracks.resize(1);
-    if (wavHeader_.numChannels == 1) {
+    if (channelMask_ != 0 && std::bitset<64>(channelMask_).count() == wavHeader_.numChannels) { // 64: mask bits
+        mediaInfo.tracks[0].Set<Tag::AUDIO_CHANNEL_LAYOUT>(static_cast<AudioChannelLayout>(channelMask_));
+    } else if (wavHeader_.numChannels == 1) {
         mediaInfo.tracks[0].Set<Tag::AUDIO_CHANNEL_LAYOUT>(AudioChannelLayout::MONO);
     } else {
         mediaInfo.tracks[0].Set<Tag::AUDIO_CHANNEL_LAYOUT>(AudioChannelLayout::STEREO);
     }
-    int64_t duration = 0;
-    if (wavHeader_.sampleRate == 0 || wavHeader_.bitsPerSample == 0 || wavHeader_.numChannels == 0 ||
-        !Sec2HstTime((fileSize_ - wavHeadLength_) * 8 /     // 8
-        (wavHeader_.sampleRate * wavHeader_.bitsPerSample * wavHeader_.numChannels), duration)) {
-        MEDIA_LOG_E("wavHeader_ is invalid or value overflow!");
+    if (dataEnd_ - dataStart_ < UINT64_MAX / 2) { // 2: the size is unknown for a growing file
+        mediaInfo.tracks[0].Set<Tag::MEDIA_DURATION>(SamplesToHstTime((dataEnd_ - dataStart_) / blockAlign_));
     }
-    mediaInfo.tracks[0].Set<Tag::MEDIA_DURATION>(duration);
     mediaInfo.tracks[0].Set<Tag::MEDIA_TYPE>(MediaType::AUDIO);
     mediaInfo.tracks[0].Set<Tag::AUDIO_SAMPLE_RATE>(wavHeader_.sampleRate);
     mediaInfo.tracks[0].Set<Tag::MEDIA_BITRATE>((wavHeader_.byteRate) * 8); // 8  byte to bit
@@ -112,32 +318,72 @@ Status WavDemuxerPlugin::GetMediaInfo(MediaInfo& mediaInfo)
     mediaInfo.tracks[0].Set<Tag::TRACK_ID>(0);
     mediaInfo.tracks[0].Set<Tag::MIME>(MEDIA_MIME_AUDIO_RAW);
     mediaInfo.tracks[0].Set<Tag::AUDIO_MPEG_VERSION>(1);
-    mediaInfo.tracks[0].Set<Tag::AUDIO_SAMPLE_PER_FRAME>(WAV_PER_FRAME_SIZE);
-    if (wavHeader_.audioFormat == static_cast<uint16_t>(WavAudioFormat::WAVE_FORMAT_PCM) ||
-        wavHeader_.audioFormat == static_cast<uint16_t>(WavAudioFormat::WAVE_FORMAT_EXTENSIBLE)) {
-        mediaInfo.tracks[0].Set<Tag::AUDIO_SAMPLE_FORMAT>
-            (g_WavAudioSampleFormatPacked[static_cast<uint32_t>(wavHeader_.bitsPerSample)]);
-    } else if (wavHeader_.audioFormat == static_cast<uint16_t>(WavAudioFormat::WAVE_FORMAT_IEEE_FLOAT)) {
-        mediaInfo.tracks[0].Set<Tag::AUDIO_SAMPLE_FORMAT>(AudioSampleFormat::F32);
-    } else {
-        mediaInfo.tracks[0].Set<Tag::AUDIO_SAMPLE_FORMAT>(AudioSampleFormat::NONE);
+    mediaInfo.tracks[0].Set<Tag::AUDIO_SAMPLE_PER_FRAME>(static_cast<uint32_t>(readSize_ / blockAlign_));
+    mediaInfo.tracks[0].Set<Tag::AUDIO_SAMPLE_FORMAT>(sampleFormat);
+    mediaInfo.tracks[0].Set<Tag::BITS_PER_CODED_SAMPLE>(bitsPerSample);
+    return Status::OK;
+}
+
+Status WavDemuxerPlugin::ReadG711Frame(const std::shared_ptr<Memory>& memory, uint64_t readSize)
+{
+    if (g711Buffer_ == nullptr || g711Buffer_->GetMemory()->GetCapacity() < readSize) {
+        g711Buffer_ = std::make_shared<Buffer>();
+        g711Buffer_->AllocMemory(nullptr, readSize);
+    }
+    auto codes = g711Buffer_->GetMemory();
+    codes->Reset();
+    Status status = ioContext_.dataSource->ReadAt(static_cast<int64_t>(dataOffset_), g711Buffer_, readSize);
+    FALSE_RETURN_V(status == Status::OK, status);
+    size_t count = codes->GetSize();
+    const auto& table = GetG711Table(codecFormat_).samples;
+    const uint8_t* in = codes->GetReadOnlyData();
+    auto out = reinterpret_cast<int16_t*>(memory->GetWritableAddr(count * sizeof(int16_t)));
+    FALSE_RETURN_V(out != nullptr, Status::ERROR_NO_MEMORY);
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = table[in[i]];
     }
-    mediaInfo.tracks[0].Set<Tag::BITS_PER_CODED_SAMPLE>(wavHeader_.bitsPerSample);
+    memory->UpdateDataSize(count * sizeof(int16_t));
     return Status::OK;
 }
 
+// one call fills the whole output buffer with readSize_ bytes, ending on a block boundary
 Status WavDemuxerPlugin::ReadFrame(Buffer& outBuffer, int32_t timeOutMs)
 {
-    std::shared_ptr<Buffer> outBufferPtr(&outBuffer, [](Buffer *) {});
+    FALSE_RETURN_V(blockAlign_ > 0, Status::ERROR_WRONG_STATE);
+    if (dataOffset_ >= dataEnd_) {
+        return Status::END_OF_STREAM;
+    }
+    uint64_t readSize = std::min(readSize_, dataEnd_ - dataOffset_);
+    uint32_t expand = IsG711(codecFormat_) ? sizeof(int16_t) : 1;
+    std::shared_ptr<Memory> memory;
     if (outBuffer.IsEmpty()) {
-        outBuffer.AllocMemory(nullptr, WAV_PER_FRAME_SIZE);
+        memory = outBuffer.AllocMemory(nullptr, readSize * expand);
+    } else {
+        memory = outBuffer.GetMemory();
+        readSize = std::min(readSize, memory->GetCapacity() / expand / blockAlign_ * blockAlign_);
+    }
+    FALSE_RETURN_V_MSG_E(memory != nullptr && readSize > 0, Status::ERROR_NO_MEMORY, "no memory to read to");
+    memory->Reset();
+
+    Status retResult;
+    if (expand > 1) {
+        retResult = ReadG711Frame(memory, readSize);
+    } else {
+        std::shared_ptr<Buffer> outBufferPtr(&outBuffer, [](Buffer *) {});
+        retResult = ioContext_.dataSource->ReadAt(static_cast<int64_t>(dataOffset_), outBufferPtr, readSize);
     }
-    Status retResult = ioContext_.dataSource->ReadAt(dataOffset_, outBufferPtr, WAV_PER_FRAME_SIZE);
-    dataOffset_ +=  outBuffer.GetMemory()->GetSize();
     if (retResult != Status::OK) {
         MEDIA_LOG_E("Read Data Error");
+        return retResult;
     }
-    return retResult;
+    uint64_t sampleIndex = (dataOffset_ - dataStart_) / blockAlign_;
+    // a file cut inside a block returns a part of it, drop the part so that the next read starts on a block
+    uint64_t readBytes = memory->GetSize() / expand / blockAlign_ * blockAlign_;
+    memory->UpdateDataSize(readBytes * expand);
+    outBuffer.pts = SamplesToHstTime(sampleIndex);
+    outBuffer.duration = SamplesToHstTime(sampleIndex + readBytes / blockAlign_) - outBuffer.pts;
+    dataOffset_ += readBytes;
+    return readBytes > 0 ? Status::OK : Status::END_OF_STREAM;
 }
 
 Status WavDemuxerPlugin::SeekTo(int32_t trackId, int64_t seekTime, SeekMode mode, int64_t& realSeekTime)
@@ -145,18 +391,16 @@ Status WavDemuxerPlugin::SeekTo(int32_t trackId, int64_t seekTime, SeekMode mode
     if (fileSize_ == 0 || seekable_ == Seekable::INVALID || seekable_ == Seekable::UNSEEKABLE) {
         return Status::ERROR_INVALID_OPERATION;
     }
-    auto blockAlign = wavHeader_.bitsPerSample / 8 * wavHeader_.numChannels; // blockAlign = wavHeader_.blockAlign
-    auto byteRate = blockAlign * wavHeader_.sampleRate; // byteRate = wavHeader_.byteRate
-
-    // time(sec) * byte per second= current time byte number
-    auto position = HstTime2Sec(seekTime)  * byteRate;
-
-    // current time byte number / blockAlign
-    // To round and position to the starting point of a complete sample.
-    if (blockAlign) {
-        position = position / blockAlign * blockAlign;
-    }
-    dataOffset_ = position;
+    FALSE_RETURN_V(blockAlign_ > 0 && wavHeader_.sampleRate > 0, Status::ERROR_WRONG_STATE);
+    seekTime = std::max(seekTime, static_cast<int64_t>(0));
+    uint64_t sampleRate = wavHeader_.sampleRate;
+    // position to the start of the sample at or before the seek time
+    uint64_t sampleIndex = static_cast<uint64_t>(seekTime / HST_SECOND) * sampleRate +
+        static_cast<uint64_t>(seekTime % HST_SECOND) * sampleRate / HST_SECOND;
+    uint64_t sampleCount = (dataEnd_ - dataStart_) / blockAlign_;
+    sampleIndex = std::min(sampleIndex, sampleCount);
+    dataOffset_ = dataStart_ + sampleIndex * blockAlign_;
+    realSeekTime = SamplesToHstTime(sampleIndex);
     return Status::OK;
 }
 
@@ -165,6 +409,14 @@ Status WavDemuxerPlugin::Reset()
     dataOffset_ = 0;
     fileSize_ = 0;
     seekable_ = Seekable::SEEKABLE;
+    codecFormat_ = 0;
+    channelMask_ = 0;
+    ds64DataSize_ = 0;
+    dataStart_ = 0;
+    dataEnd_ = 0;
+    blockAlign_ = 0;
+    readSize_ = 0;
+    g711Buffer_.reset();
     return Status::OK;
 }
 
@@ -175,7 +427,16 @@ Status WavDemuxerPlugin::GetParameter(Tag tag, ValueType &value)
 
 Status WavDemuxerPlugin::SetParameter(Tag tag, const ValueType &value)
 {
-    return Status::ERROR_UNIMPLEMENTED;
+    if (tag != Tag::MEDIA_READ_DURATION) {
+        return Status::ERROR_UNIMPLEMENTED;
+    }
+    FALSE_RETURN_V_MSG_E(Plugin::Any::IsSameTypeWith<int64_t>(value) && Plugin::AnyCast<int64_t>(value) > 0,
+                         Status::ERROR_INVALID_PARAMETER, "read duration should be a positive int64_t");
+    readDuration_ = Plugin::AnyCast<int64_t>(value);
+    if (blockAlign_ > 0) {
+        UpdateReadSize();
+    }
+    return Status::OK;
 }
 
 std::shared_ptr<Allocator> WavDemuxerPlugin::GetAllocator()
@@ -209,7 +470,7 @@ namespace {
 bool WavSniff(const uint8_t *inputBuf)
 {
     // 解析数据起始位置的值，判断是否为wav格式文件
-    return ((inputBuf[0] != 'R') || (inputBuf[1] != 'I') || (inputBuf[2] != 'F') || (inputBuf[3] != 'F')); // 0 1 2 3
+    return !IsChunk(inputBuf, "RIFF") && !IsChunk(inputBuf, "RF64");
 }
 int Sniff(const std::string& name, std::shared_ptr<DataSource> dataSource)
 {
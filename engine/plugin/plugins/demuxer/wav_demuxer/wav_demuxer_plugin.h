@@ -73,12 +73,29 @@ private:
         int64_t offset {0};
         bool eos {false};
     };
+    Status ReadSource(uint64_t offset, uint8_t* data, size_t size);
+    Status ParseHeader();
+    Status ParseFmtChunk(uint64_t offset, uint32_t size);
+    Status ParseDs64Chunk(uint64_t offset, uint32_t size);
+    Status ReadG711Frame(const std::shared_ptr<Memory>& memory, uint64_t readSize);
+    void UpdateReadSize();
+    int64_t SamplesToHstTime(uint64_t samples) const;
+
     uint64_t            fileSize_;
     IOContext           ioContext_;
-    uint32_t            dataOffset_;
+    uint64_t            dataOffset_;
     Seekable            seekable_;
     uint32_t            wavHeadLength_;
     WavHeadAttr         wavHeader_ {};
+    uint16_t            codecFormat_ {0};    // audioFormat, or the sub format of WAVE_FORMAT_EXTENSIBLE
+    uint64_t            channelMask_ {0};    // speaker positions of WAVE_FORMAT_EXTENSIBLE
+    uint64_t            ds64DataSize_ {0};   // data size of RF64 files, the data chunk size is 0xFFFFFFFF
+    uint64_t            dataStart_ {0};
+    uint64_t            dataEnd_ {0};
+    uint32_t            blockAlign_ {0};
+    int64_t             readDuration_ {0};   // duration of an output buffer set by MEDIA_READ_DURATION, 0 for 50ms
+    uint64_t            readSize_ {0};       // bytes read per output buffer, whole blocks
+    std::shared_ptr<Buffer> g711Buffer_ {nullptr};
 };
 } // namespace WavPlugin
 } // namespace Plugin
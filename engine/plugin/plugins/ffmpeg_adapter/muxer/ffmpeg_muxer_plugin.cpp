@@ -35,6 +35,8 @@ std::map<std::string, std::shared_ptr<AVOutputFormat>> g_pluginOutputFmt;
 
 std::set<std::string> g_supportedMuxer = {"mp4", "h264"};
 
+std::set<std::string> g_fragmentedMuxer = {"mp4"};
+
 bool IsMuxerSupported(const char* name)
 {
     return g_supportedMuxer.count(name) == 1;
@@ -385,6 +387,7 @@ Status FFmpegMuxerPlugin::Reset()
 {
     ResetIoCtx(ioContext_);
     generalParameters_.Clear();
+    fragmented_ = false;
     trackParameters_.clear();
     OSAL::ScopedLock lock(fmtMutex_);
     // refer to ffmpeg libavformat/mux.h ffofmt
@@ -446,12 +449,73 @@ Status FFmpegMuxerPlugin::WriteHeader()
     FALSE_RETURN_V(ioContext_.dataSink_ != nullptr && outputFormat_ != nullptr, Status::ERROR_WRONG_STATE);
     OSAL::ScopedLock lock(fmtMutex_);
     FALSE_RETURN_V(formatContext_ != nullptr, Status::ERROR_WRONG_STATE);
-    int ret = avformat_write_header(formatContext_.get(), nullptr);
+    AVDictionary* options = nullptr;
+    ConfigureFragmentLocked(&options);
+    int ret = avformat_write_header(formatContext_.get(), &options);
+    av_dict_free(&options);
     FALSE_RETURN_V_MSG_E(ret >= 0, Status::ERROR_UNKNOWN, "failed to write header " PUBLIC_LOG_S,
         AVStrError(ret).c_str());
     return Status::OK;
 }
 
+void FFmpegMuxerPlugin::ConfigureFragmentLocked(AVDictionary** options)
+{
+    fragmentDuration_ = 0;
+    fragmentKeyFrames_ = 0;
+    (void)generalParameters_.Get<Tag::MEDIA_FRAGMENT_DURATION>(fragmentDuration_);
+    (void)generalParameters_.Get<Tag::MEDIA_FRAGMENT_KEY_FRAMES>(fragmentKeyFrames_);
+    fragmented_ = (fragmentDuration_ > 0 || fragmentKeyFrames_ > 0) &&
+        g_fragmentedMuxer.count(outputFormat_->name) == 1;
+    fragmentStartPts_ = HST_TIME_NONE;
+    fragmentSyncFrames_ = 0;
+    if (!fragmented_) {
+        return;
+    }
+    // an empty moov up front and a sample table in each fragment: nothing is patched afterwards, the sample table
+    // is dropped once its fragment is written and the trailer only writes the last fragment
+    av_dict_set(options, "movflags", "empty_moov+default_base_moof+frag_custom+skip_trailer", 0);
+    formatContext_->pb->seekable = 0;
+    // the fragments are cut at the key frames of the first video track, or at any frame of the first track
+    fragmentTrackId_ = 0;
+    for (uint32_t i = 0; i < formatContext_->nb_streams; ++i) {
+        if (formatContext_->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
+            fragmentTrackId_ = i;
+            break;
+        }
+    }
+    MEDIA_LOG_I("fragmented output, fragment duration " PUBLIC_LOG_D64 ", key frames " PUBLIC_LOG_U32
+                ", cut on track " PUBLIC_LOG_U32, fragmentDuration_, fragmentKeyFrames_, fragmentTrackId_);
+}
+
+void FFmpegMuxerPlugin::CutFragmentIfNeeded(const std::shared_ptr<Buffer>& buffer)
+{
+    if (!fragmented_ || buffer->trackID != fragmentTrackId_) {
+        return;
+    }
+    if (formatContext_->streams[fragmentTrackId_]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO &&
+        !(buffer->flag & BUFFER_FLAG_KEY_FRAME)) {
+        return;
+    }
+    if (fragmentStartPts_ == HST_TIME_NONE) {
+        fragmentStartPts_ = buffer->pts;
+        fragmentSyncFrames_ = 1;
+        return;
+    }
+    bool enoughKeyFrames = fragmentKeyFrames_ > 0 && fragmentSyncFrames_ >= fragmentKeyFrames_;
+    bool longEnough = fragmentDuration_ > 0 && buffer->pts - fragmentStartPts_ >= fragmentDuration_;
+    if (!enoughKeyFrames && !longEnough) {
+        fragmentSyncFrames_++;
+        return;
+    }
+    // the frames written so far go out as one moof and mdat, this frame starts the next fragment
+    auto ret = av_write_frame(formatContext_.get(), nullptr);
+    if (ret < 0) {
+        MEDIA_LOG_W("failed to write fragment " PUBLIC_LOG_S, AVStrError(ret).c_str());
+    }
+    fragmentStartPts_ = buffer->pts;
+    fragmentSyncFrames_ = 1;
+}
+
 Status FFmpegMuxerPlugin::WriteFrame(const std::shared_ptr<Plugin::Buffer>& buffer)
 {
     FALSE_RETURN_V(buffer != nullptr && !buffer->IsEmpty(), Status::ERROR_INVALID_PARAMETER);
@@ -474,6 +538,7 @@ Status FFmpegMuxerPlugin::WriteFrame(const std::shared_ptr<Plugin::Buffer>& buff
         cachePacket_->flags |= AV_PKT_FLAG_KEY;
     }
     cachePacket_->duration = ConvertTimeToFFmpeg(buffer->duration, formatContext_->streams[trackId]->time_base);
+    CutFragmentIfNeeded(buffer);
     auto ret = av_write_frame(formatContext_.get(), cachePacket_.get());
     if (ret < 0) {
         MEDIA_LOG_D("failed to write frame " PUBLIC_LOG_S, AVStrError(ret).c_str());
@@ -17,6 +17,7 @@
 #define HISTREAMER_FFMPEG_MUXER_PLUGIN_H
 
 #include "foundation/osal/thread/mutex.h"
+#include "plugin/common/plugin_time.h"
 #include "plugin/interface/muxer_plugin.h"
 
 #ifdef __cplusplus
@@ -92,6 +93,10 @@ private:
 
     Status Release();
 
+    void ConfigureFragmentLocked(AVDictionary** options);
+
+    void CutFragmentIfNeeded(const std::shared_ptr<Buffer>& buffer);
+
     std::shared_ptr<AVOutputFormat> outputFormat_{};
 
     std::map<uint32_t, Meta> trackParameters_{};
@@ -104,6 +109,13 @@ private:
     std::shared_ptr<AVPacket> cachePacket_ {};
 
     IOContext ioContext_;
+
+    bool fragmented_ {false};
+    int64_t fragmentDuration_ {0};
+    uint32_t fragmentKeyFrames_ {0};
+    uint32_t fragmentTrackId_ {0};
+    int64_t fragmentStartPts_ {HST_TIME_NONE};
+    uint32_t fragmentSyncFrames_ {0};
 };
 } // Ffmpeg
 } // Plugin
@@ -478,6 +478,10 @@ Status VideoFfmpegDecoderPlugin::SendBufferLocked(const std::shared_ptr<Buffer>&
         avPacket_->data = const_cast<uint8_t*>(ptr);
         avPacket_->size = static_cast<int32_t>(bufferLength);
         avPacket_->pts = static_cast<int64_t>(inputBuffer->pts);
+        if (inputBuffer->flag & BUFFER_FLAG_PREROLL) {
+            // decoded as reference only, the frame is dropped by the codec before any conversion
+            avPacket_->flags |= AV_PKT_FLAG_DISCARD;
+        }
     }
     auto ret = avcodec_send_packet(avCodecContext_.get(), avPacket_.get());
     av_packet_unref(avPacket_.get());
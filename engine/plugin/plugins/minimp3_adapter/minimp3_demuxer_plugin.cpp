@@ -39,6 +39,9 @@ constexpr uint32_t MAX_RANK                = 100;
 constexpr uint32_t MEDIA_IO_SIZE           = 4 * 1024;
 constexpr uint32_t MAX_FRAME_SIZE          = MEDIA_IO_SIZE;
 constexpr uint32_t AUDIO_DEMUXER_SOURCE_ONCE_LENGTH_MAX = 1024;
+constexpr uint32_t MP3_FRAME_HEADER_SIZE   = 4;
+constexpr uint32_t FRAME_INDEX_INTERVAL    = 32; // one entry every 32 frames, about 0.8s at 44.1kHz
+constexpr uint32_t FRAME_SCAN_READ_SIZE    = 16 * 1024;
 uint32_t durationMs = 0;
 uint32_t fileSize = 0;
 AudioDemuxerMp3Attr mp3ProbeAttr;
@@ -51,6 +54,47 @@ size_t AudioDecmuxerMp3Id3v2SizeCalculate(const uint8_t *buf);
 bool AudioDemuxerMp3HasId3v2(const uint8_t *buf);
 size_t AudioDemuxerMp3GetId3v2Size(const uint8_t *buf, size_t bufSize);
 int AudioDemuxerMp3ProbeDecodeCheck(Mp3DemuxerFrameInfo *info);
+bool AudioDemuxerMp3ParseFrameHeader(const uint8_t *buf, uint32_t *frameLength, uint32_t *samples);
+// frame length and samples of an MPEG audio frame from its 4 bytes header, free format is not supported
+bool AudioDemuxerMp3ParseFrameHeader(const uint8_t *buf, uint32_t *frameLength, uint32_t *samples)
+{
+    static const uint16_t bitrateKbps[2][3][15] = { // 2 versions, 3 layers, 15 bitrate indexes
+        {
+            {0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448},
+            {0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384},
+            {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320},
+        },
+        {
+            {0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256},
+            {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160},
+            {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160},
+        },
+    };
+    static const uint32_t sampleRates[3] = {44100, 48000, 32000}; // 3 sample rates of MPEG-1
+    if (buf[0] != 0xFF || (buf[1] & 0xE0) != 0xE0) { // 0xE0: the 11 bits of frame sync
+        return false;
+    }
+    uint32_t version = (buf[1] >> 3) & 0x3; // 3: 0 MPEG-2.5, 1 reserved, 2 MPEG-2, 3 MPEG-1
+    uint32_t layer = 4 - ((buf[1] >> 1) & 0x3); // 4: layer bits 3 to 1 stand for layer I to III
+    uint32_t bitrateIndex = buf[2] >> 4; // 4
+    uint32_t sampleRateIndex = (buf[2] >> 2) & 0x3; // 2
+    uint32_t padding = (buf[2] >> 1) & 0x1;
+    if (version == 1 || layer > 3 || bitrateIndex == 0 || bitrateIndex == 15 || sampleRateIndex == 3) { // 3 15
+        return false;
+    }
+    bool isMpeg1 = version == 3; // 3: MPEG-1
+    uint32_t sampleRate = sampleRates[sampleRateIndex] >> (isMpeg1 ? 0 : (version == 2 ? 1 : 2)); // 2
+    uint32_t bitrate = bitrateKbps[isMpeg1 ? 0 : 1][layer - 1][bitrateIndex] * 1000; // 1000: kbps
+    if (layer == 1) {
+        *samples = 384; // 384: samples of layer I
+        *frameLength = (12 * bitrate / sampleRate + padding) * 4; // 12 4: slots of 4 bytes
+    } else {
+        *samples = (layer == 3 && !isMpeg1) ? 576 : 1152; // 576 1152: samples of layer II and III
+        *frameLength = *samples / 8 * bitrate / sampleRate + padding; // 8: bits per byte
+    }
+    return true;
+}
+
 int AudioDemuxerMp3IterateCallbackForProbe(void *userData, const uint8_t *frame, int frameSize,
                                            Mp3DemuxerFrameInfo *info);
 Status AudioDemuxerMp3Probe(AudioDemuxerMp3Attr *mp3DemuxerAttr, uint8_t *inputBuffer, uint32_t inputLength,
@@ -67,7 +111,8 @@ Minimp3DemuxerPlugin::Minimp3DemuxerPlugin(std::string name)
       ioDataRemainSize_(0),
       currentDemuxerPos_(0),
       durationMs_(0),
-      ioContext_()
+      ioContext_(),
+      frameIndex_("Minimp3DemuxerPlugin", FRAME_INDEX_INTERVAL)
 {
     FALSE_LOG(memset_s(&mp3DemuxerAttr_, sizeof(mp3DemuxerAttr_), 0x00, sizeof(AudioDemuxerMp3Attr)) == 0);
     FALSE_LOG(memset_s(&mp3DemuxerRst_, sizeof(mp3DemuxerRst_), 0x00, sizeof(AudioDemuxerRst)) == 0);
@@ -215,6 +260,16 @@ Status Minimp3DemuxerPlugin::GetMediaInfo(MediaInfo& mediaInfo)
     }
 
     mp3DemuxerAttr_.bitRate = mp3DemuxerRst_.frameBitrateKbps;
+    mp3DemuxerAttr_.sampleRate = mp3DemuxerRst_.frameSampleRate;
+    // frames are counted from here, the index of a former open gives the exact duration
+    positionKnown_ = true;
+    position_ = {0, 0, currentDemuxerPos_};
+    if (seekable_ == Seekable::SEEKABLE && localSource_) {
+        (void)frameIndex_.Open(ioContext_.dataSource, fileSize_);
+        if (frameIndex_.IsComplete() && !mediaInfo.tracks.empty()) {
+            mediaInfo.tracks[0].Set<Tag::MEDIA_DURATION>(SamplesToHstTime(frameIndex_.GetDuration()));
+        }
+    }
     MEDIA_LOG_D("mp3DemuxerAttr_.bitRate " PUBLIC_LOG_U32 "kbps durationMs " PUBLIC_LOG_U32 " ms",
                 mp3DemuxerRst_.frameBitrateKbps, durationMs);
     return Status::OK;
@@ -237,7 +292,18 @@ void Minimp3DemuxerPlugin::WriteMp3Data(Buffer& outBuffer)
     }
     MEDIA_LOG_DD("ReadFrame: success usedInputLength " PUBLIC_LOG_D32 " ioDataRemainSize_ " PUBLIC_LOG_D32,
                  (uint32_t)mp3DemuxerRst_.usedInputLength, ioDataRemainSize_);
+    int64_t framePts = -1;
     if (mp3DemuxerRst_.frameLength) {
+        if (positionKnown_) {
+            framePts = SamplesToHstTime(position_.samples);
+        }
+        if (mp3DemuxerRst_.usedInputLength >= mp3DemuxerRst_.frameLength) {
+            // the frame buffer is cleared while discarding after a seek, the header is read from the input
+            uint64_t frameStart = mp3DemuxerRst_.usedInputLength - mp3DemuxerRst_.frameLength;
+            IndexFrame(inIoBuffer_ + frameStart, mp3DemuxerRst_.frameLength, currentDemuxerPos_ + frameStart);
+        } else {
+            positionKnown_ = false;
+        }
         mp3FrameData->Write(mp3DemuxerRst_.frameBuffer, mp3DemuxerRst_.frameLength);
         ioDataRemainSize_ -= mp3DemuxerRst_.usedInputLength;
         currentDemuxerPos_ += mp3DemuxerRst_.usedInputLength;
@@ -253,7 +319,7 @@ void Minimp3DemuxerPlugin::WriteMp3Data(Buffer& outBuffer)
         ioDataRemainSize_ -= mp3DemuxerRst_.usedInputLength;
         currentDemuxerPos_ += mp3DemuxerRst_.usedInputLength;
     }
-    outBuffer.pts = GetCurrentPositionTimeS();
+    outBuffer.pts = framePts >= 0 ? framePts : static_cast<int64_t>(GetCurrentPositionTimeS());
     MEDIA_LOG_DD("ReadFrame: mp3DemuxerRst_.frameLength " PUBLIC_LOG_U32 ", pts " PUBLIC_LOG_U64,
                  mp3DemuxerRst_.frameLength, outBuffer.pts);
     if (mp3DemuxerRst_.frameBuffer) {
@@ -265,8 +331,11 @@ void Minimp3DemuxerPlugin::WriteMp3Data(Buffer& outBuffer)
 Status Minimp3DemuxerPlugin::ReadFrame(Buffer& outBuffer, int32_t timeOutMs)
 {
     int  status  = -1;
-    Status retResult = Status::OK;
-    NOK_RETURN(GetDataFromSource());
+    Status retResult = GetDataFromSource();
+    if (retResult == Status::END_OF_STREAM) {
+        CompleteFrameIndex();
+    }
+    NOK_RETURN(retResult);
     MEDIA_LOG_DD("ioDataRemainSize_ = " PUBLIC_LOG_D32, ioDataRemainSize_);
     status = AudioDemuxerMp3Process(inIoBuffer_, ioDataRemainSize_);
     MEDIA_LOG_DD("status = " PUBLIC_LOG_D32, status);
@@ -293,8 +362,124 @@ Status Minimp3DemuxerPlugin::ReadFrame(Buffer& outBuffer, int32_t timeOutMs)
     return retResult;
 }
 
+void Minimp3DemuxerPlugin::IndexFrame(const uint8_t* frame, uint32_t frameLength, uint64_t offset)
+{
+    uint32_t headerLength = 0;
+    uint32_t samples = 0;
+    if (!positionKnown_ || frameLength < MP3_FRAME_HEADER_SIZE ||
+        !AudioDemuxerMp3ParseFrameHeader(frame, &headerLength, &samples)) {
+        positionKnown_ = false;
+        return;
+    }
+    frameIndex_.Add(position_.frame, static_cast<int64_t>(position_.samples), offset);
+    position_.frame++;
+    position_.samples += samples;
+    position_.offset = offset + frameLength;
+}
+
+void Minimp3DemuxerPlugin::CompleteFrameIndex()
+{
+    if (positionKnown_) {
+        frameIndex_.SetComplete(position_.frame, static_cast<int64_t>(position_.samples));
+    }
+    (void)frameIndex_.Save();
+}
+
+Status Minimp3DemuxerPlugin::ReadSourceAt(uint64_t offset, uint8_t* data, size_t size, size_t& readSize)
+{
+    readSize = 0;
+    if (offset >= fileSize_) {
+        return Status::OK;
+    }
+    size = static_cast<size_t>(std::min(static_cast<uint64_t>(size), fileSize_ - offset));
+    auto buffer = std::make_shared<Buffer>();
+    auto memory = buffer->WrapMemory(data, size, 0);
+    auto ret = ioContext_.dataSource->ReadAt(static_cast<int64_t>(offset), buffer, size);
+    FALSE_RETURN_V_MSG_W(ret == Status::OK, ret, "read data from source error " PUBLIC_LOG_D32, (int)ret);
+    readSize = memory->GetSize();
+    return Status::OK;
+}
+
+// walk the frame headers from position up to the frame holding targetSamples, indexing the frames on the way
+Status Minimp3DemuxerPlugin::WalkFrames(FramePosition& position, uint64_t targetSamples)
+{
+    std::vector<uint8_t> window(FRAME_SCAN_READ_SIZE);
+    uint64_t windowStart = 0;
+    size_t windowSize = 0;
+    while (position.offset + MP3_FRAME_HEADER_SIZE <= fileSize_) {
+        if (position.offset < windowStart || position.offset + MP3_FRAME_HEADER_SIZE > windowStart + windowSize) {
+            windowStart = position.offset;
+            NOK_RETURN(ReadSourceAt(windowStart, window.data(), window.size(), windowSize));
+            if (windowSize < MP3_FRAME_HEADER_SIZE) {
+                break;
+            }
+        }
+        uint32_t frameLength = 0;
+        uint32_t samples = 0;
+        if (!AudioDemuxerMp3ParseFrameHeader(window.data() + (position.offset - windowStart), &frameLength,
+                                             &samples)) {
+            position.offset++; // lost sync, e.g. a tag or garbage between the frames
+            continue;
+        }
+        if (position.offset + frameLength > fileSize_) {
+            break; // the truncated last frame is never played
+        }
+        frameIndex_.Add(position.frame, static_cast<int64_t>(position.samples), position.offset);
+        if (position.samples + samples > targetSamples) {
+            return Status::OK;
+        }
+        position.frame++;
+        position.samples += samples;
+        position.offset += frameLength;
+    }
+    frameIndex_.SetComplete(position.frame, static_cast<int64_t>(position.samples));
+    position.offset = fileSize_;
+    return Status::OK;
+}
+
+Status Minimp3DemuxerPlugin::SeekToSample(uint64_t targetSamples, int64_t& realSeekTime)
+{
+    // start from the closest indexed frame, only the frames after it are walked
+    FramePosition position {0, 0, mp3DemuxerAttr_.id3v2Size};
+    FrameIndexCache::Entry entry;
+    if (frameIndex_.Lookup(static_cast<int64_t>(targetSamples), entry)) {
+        position = {entry.frame, static_cast<uint64_t>(entry.pts), entry.offset};
+    }
+    NOK_RETURN(WalkFrames(position, targetSamples));
+    ioContext_.offset = static_cast<int64_t>(position.offset);
+    ioContext_.eos = false;
+    ioDataRemainSize_ = 0;
+    currentDemuxerPos_ = position.offset;
+    (void)memset_s(inIoBuffer_, inIoBufferSize_, 0x00, inIoBufferSize_);
+    mp3DemuxerAttr_.mp3SeekFlag = 1;
+    mp3DemuxerAttr_.discardItemCount = 0;
+    position_ = position;
+    positionKnown_ = true;
+    realSeekTime = SamplesToHstTime(position.samples);
+    MEDIA_LOG_D("seek to frame " PUBLIC_LOG_U64 " offset " PUBLIC_LOG_U64, position.frame, position.offset);
+    return Status::OK;
+}
+
+int64_t Minimp3DemuxerPlugin::SamplesToHstTime(uint64_t samples) const
+{
+    uint64_t sampleRate = mp3DemuxerAttr_.sampleRate;
+    if (sampleRate == 0) {
+        return 0;
+    }
+    // split to avoid the overflow of samples * HST_SECOND
+    return static_cast<int64_t>(samples / sampleRate * HST_SECOND + samples % sampleRate * HST_SECOND / sampleRate);
+}
+
 Status Minimp3DemuxerPlugin::SeekTo(int32_t trackId, int64_t seekTime, SeekMode mode, int64_t& realSeekTime)
 {
+    uint64_t sampleRate = mp3DemuxerAttr_.sampleRate;
+    if (seekable_ == Seekable::SEEKABLE && sampleRate > 0 && fileSize_ > 0) {
+        // rounded up, seeking to the pts of a frame lands on that frame
+        uint64_t time = static_cast<uint64_t>(std::max(seekTime, static_cast<int64_t>(0)));
+        return SeekToSample(time / HST_SECOND * sampleRate +
+                            (time % HST_SECOND * sampleRate + HST_SECOND - 1) / HST_SECOND, realSeekTime);
+    }
+    positionKnown_ = false;
     uint64_t pos = 0;
     uint32_t targetTimeMs = static_cast<uint32_t>(HstTime2Ms(seekTime));
     if (AudioDemuxerMp3GetSeekPosition(targetTimeMs, &pos) == 0) {
@@ -324,6 +509,7 @@ Status Minimp3DemuxerPlugin::Init()
 
 Status Minimp3DemuxerPlugin::Deinit()
 {
+    (void)frameIndex_.Save();
     if (inIoBuffer_) {
         free(inIoBuffer_);
         inIoBuffer_ = nullptr;
@@ -338,6 +524,10 @@ Status Minimp3DemuxerPlugin::Prepare()
 
 Status Minimp3DemuxerPlugin::Reset()
 {
+    (void)frameIndex_.Save();
+    frameIndex_.Clear();
+    localSource_ = false;
+    positionKnown_ = false;
     ioContext_.eos = false;
     ioContext_.dataSource.reset();
     ioContext_.offset = 0;
@@ -364,7 +554,13 @@ Status Minimp3DemuxerPlugin::GetParameter(Tag tag, ValueType &value)
 
 Status Minimp3DemuxerPlugin::SetParameter(Tag tag, const ValueType &value)
 {
-    return Status::ERROR_UNIMPLEMENTED;
+    if (tag != Tag::MEDIA_FILE_URI) {
+        return Status::ERROR_UNIMPLEMENTED;
+    }
+    FALSE_RETURN_V_MSG_E(Plugin::Any::IsSameTypeWith<std::string>(value), Status::ERROR_INVALID_PARAMETER,
+                         "file uri should be std::string");
+    localSource_ = FrameIndexCache::IsLocalUri(Plugin::AnyCast<std::string>(value));
+    return Status::OK;
 }
 
 std::shared_ptr<Allocator> Minimp3DemuxerPlugin::GetAllocator()
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 #include "minimp3_wrapper.h"
+#include "plugin/common/frame_index_cache.h"
 #include "plugin/interface/demuxer_plugin.h"
 
 using Mp3DemuxerHandle     = Minimp3WrapperMp3dec;
@@ -111,6 +112,11 @@ private:
         int64_t offset {0};
         bool eos {false};
     };
+    struct FramePosition {
+        uint64_t frame {0};
+        uint64_t samples {0};
+        uint64_t offset {0};
+    };
     void AudioDemuxerMp3IgnoreTailZero(uint8_t *data, uint32_t *dataLen);
     static int  AudioDemuxerMp3IterateCallback(void *userData, const uint8_t *frame, int frameSize,
                                                uint64_t offset, Mp3DemuxerFrameInfo *info);
@@ -130,6 +136,12 @@ private:
     void FillInMediaInfo(MediaInfo& mediaInfo) const;
 
     void WriteMp3Data(Buffer& outBuffer);
+    void IndexFrame(const uint8_t* frame, uint32_t frameLength, uint64_t offset);
+    void CompleteFrameIndex();
+    Status ReadSourceAt(uint64_t offset, uint8_t* data, size_t size, size_t& readSize);
+    Status WalkFrames(FramePosition& position, uint64_t targetSamples);
+    Status SeekToSample(uint64_t targetSamples, int64_t& realSeekTime);
+    int64_t SamplesToHstTime(uint64_t samples) const;
     Seekable            seekable_;
     int                 inIoBufferSize_;
     size_t              fileSize_;
@@ -141,6 +153,10 @@ private:
     AudioDemuxerRst     mp3DemuxerRst_ {};
     Minimp3DemuxerOp    minimp3DemuxerImpl_ {};
     AudioDemuxerMp3Attr mp3DemuxerAttr_ {};
+    FrameIndexCache     frameIndex_;
+    bool                localSource_ {false}; // only the index of a local file is persisted
+    bool                positionKnown_ {false}; // the next frame is at position_, i.e. played on from an index
+    FramePosition       position_ {};
 };
 } // namespace Minimp3
 } // namespace Plugin
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define HST_LOG_TAG "AudioRenderWriter"
+
+#include "audio_render_writer.h"
+#include "foundation/log.h"
+#include "foundation/osal/thread/scoped_lock.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+namespace AuSrSinkPlugin {
+namespace {
+constexpr int64_t NS_PER_MS = 1000000;
+}
+
+AudioRenderWriter::AudioRenderWriter(int32_t maxWaitMs) : maxWaitMs_(maxWaitMs > 0 ? maxWaitMs : DEFAULT_MAX_WAIT_MS)
+{
+}
+
+RenderWriteResult AudioRenderWriter::Write(uint8_t* data, size_t length, const RenderFunc& render)
+{
+    int64_t start = OSAL::ConditionVariable::GetClockTimeNs();
+    RenderWriteResult result = RenderWriteResult::OK;
+    while (length > 0) {
+        uint64_t seq = 0;
+        {
+            OSAL::ScopedLock lock(mutex_);
+            if (interrupted_) {
+                result = RenderWriteResult::INTERRUPTED;
+                break;
+            }
+            seq = writableSeq_;
+        }
+        int32_t ret = render(data, length);
+        if (ret < 0) {
+            MEDIA_LOG_E("Write data error ret is: " PUBLIC_LOG_D32, ret);
+            result = RenderWriteResult::ERROR;
+            break;
+        }
+        data += ret;
+        length -= static_cast<size_t>(ret);
+        MEDIA_LOG_DD("written data size " PUBLIC_LOG_D32, ret);
+        if (length == 0) {
+            break;
+        }
+        // renderer is full, sleep until it consumed data since our write attempt
+        OSAL::ScopedLock lock(mutex_);
+        stats_.partialWriteCount++;
+        int64_t deadline = OSAL::ConditionVariable::GetClockTimeNs() + maxWaitMs_ * NS_PER_MS;
+        while (writableSeq_ == seq && !interrupted_) {
+            if (!cond_.WaitUntil(lock, deadline) && OSAL::ConditionVariable::GetClockTimeNs() >= deadline) {
+                stats_.timeoutWakeupCount++;
+                break;
+            }
+        }
+        stats_.wakeupCount++;
+    }
+    RecordLatency(OSAL::ConditionVariable::GetClockTimeNs() - start);
+    return result;
+}
+
+bool AudioRenderWriter::WaitForcePauseLifted()
+{
+    OSAL::ScopedLock lock(mutex_);
+    while (forcePaused_ && !interrupted_) {
+        cond_.Wait(lock);
+        stats_.wakeupCount++;
+    }
+    return !interrupted_;
+}
+
+void AudioRenderWriter::NotifyWritable()
+{
+    OSAL::ScopedLock lock(mutex_);
+    writableSeq_++;
+    cond_.NotifyAll();
+}
+
+void AudioRenderWriter::SetForcePaused(bool paused)
+{
+    OSAL::ScopedLock lock(mutex_);
+    forcePaused_ = paused;
+    if (!paused) {
+        cond_.NotifyAll();
+    }
+}
+
+bool AudioRenderWriter::IsForcePaused()
+{
+    OSAL::ScopedLock lock(mutex_);
+    return forcePaused_;
+}
+
+void AudioRenderWriter::Interrupt()
+{
+    OSAL::ScopedLock lock(mutex_);
+    interrupted_ = true;
+    cond_.NotifyAll();
+}
+
+void AudioRenderWriter::ClearInterrupt()
+{
+    OSAL::ScopedLock lock(mutex_);
+    interrupted_ = false;
+}
+
+AudioRenderWriteStats AudioRenderWriter::GetStats()
+{
+    OSAL::ScopedLock lock(mutex_);
+    return stats_;
+}
+
+void AudioRenderWriter::ResetStats()
+{
+    OSAL::ScopedLock lock(mutex_);
+    stats_ = AudioRenderWriteStats {};
+}
+
+void AudioRenderWriter::ReportStats()
+{
+    auto stats = GetStats();
+    const auto& hist = stats.latencyHistogram;
+    MEDIA_LOG_I("render write count " PUBLIC_LOG_U64 ", partial " PUBLIC_LOG_U64 ", wakeups " PUBLIC_LOG_U64
+                ", timeout wakeups " PUBLIC_LOG_U64 ", latency histogram(<1/<2/<5/<10/<20/<50/>=50 ms) "
+                PUBLIC_LOG_U64 "/" PUBLIC_LOG_U64 "/" PUBLIC_LOG_U64 "/" PUBLIC_LOG_U64 "/" PUBLIC_LOG_U64 "/"
+                PUBLIC_LOG_U64 "/" PUBLIC_LOG_U64, stats.writeCount, stats.partialWriteCount, stats.wakeupCount,
+                stats.timeoutWakeupCount, hist[0], hist[1], hist[2], hist[3], hist[4], hist[5], hist[6]); // 2-6 index
+}
+
+void AudioRenderWriter::RecordLatency(int64_t latencyNs)
+{
+    OSAL::ScopedLock lock(mutex_);
+    stats_.writeCount++;
+    size_t bucket = 0;
+    while (bucket < WRITE_LATENCY_BUCKETS_MS.size() && latencyNs >= WRITE_LATENCY_BUCKETS_MS[bucket] * NS_PER_MS) {
+        bucket++;
+    }
+    stats_.latencyHistogram[bucket]++;
+}
+} // namespace AuSrSinkPlugin
+} // namespace Plugin
+} // namespace Media
+} // namespace OHOS
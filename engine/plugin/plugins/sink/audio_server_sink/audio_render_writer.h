@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISTREAMER_AU_SERVER_SINK_RENDER_WRITER_H
+#define HISTREAMER_AU_SERVER_SINK_RENDER_WRITER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "foundation/osal/thread/condition_variable.h"
+#include "foundation/osal/thread/mutex.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+namespace AuSrSinkPlugin {
+/**
+ * Write bucket upper bounds in milliseconds, the last bucket collects everything above.
+ */
+constexpr std::array<int64_t, 6> WRITE_LATENCY_BUCKETS_MS = {1, 2, 5, 10, 20, 50};
+
+struct AudioRenderWriteStats {
+    uint64_t writeCount {0};
+    uint64_t partialWriteCount {0};
+    uint64_t wakeupCount {0};
+    uint64_t timeoutWakeupCount {0};
+    std::array<uint64_t, WRITE_LATENCY_BUCKETS_MS.size() + 1> latencyHistogram {};
+};
+
+enum struct RenderWriteResult : int32_t {
+    OK,
+    ERROR,
+    INTERRUPTED,
+};
+
+/**
+ * Writes pcm data into a renderer. When the renderer accepts less than offered or the stream is force paused, the
+ * writer sleeps on a condition variable until the renderer reports writable space, the pause is lifted or the
+ * write is interrupted by flush/stop, instead of polling.
+ */
+class AudioRenderWriter {
+public:
+    /**
+     * Renderer write function, returns the number of bytes accepted or a negative error code.
+     */
+    using RenderFunc = std::function<int32_t(uint8_t* data, size_t length)>;
+
+    explicit AudioRenderWriter(int32_t maxWaitMs = DEFAULT_MAX_WAIT_MS);
+    ~AudioRenderWriter() = default;
+
+    RenderWriteResult Write(uint8_t* data, size_t length, const RenderFunc& render);
+
+    /**
+     * Block while the stream is force paused by an audio interrupt.
+     *
+     * @return false if interrupted
+     */
+    bool WaitForcePauseLifted();
+
+    void NotifyWritable();
+
+    void SetForcePaused(bool paused);
+
+    bool IsForcePaused();
+
+    /**
+     * Make pending and further writes return INTERRUPTED until ClearInterrupt() is called.
+     */
+    void Interrupt();
+
+    void ClearInterrupt();
+
+    AudioRenderWriteStats GetStats();
+
+    void ResetStats();
+
+    void ReportStats();
+
+    static constexpr int32_t DEFAULT_MAX_WAIT_MS = 20;
+
+private:
+    void RecordLatency(int64_t latencyNs);
+
+    int32_t maxWaitMs_;
+    OSAL::Mutex mutex_ {};
+    OSAL::ConditionVariable cond_ {};
+    uint64_t writableSeq_ {0};
+    bool forcePaused_ {false};
+    bool interrupted_ {false};
+    AudioRenderWriteStats stats_ {};
+};
+} // namespace AuSrSinkPlugin
+} // namespace Plugin
+} // namespace Media
+} // namespace OHOS
+#endif // HISTREAMER_AU_SERVER_SINK_RENDER_WRITER_H
@@ -30,6 +30,7 @@ namespace {
 using namespace OHOS::Media::Plugin;
 constexpr uint32_t DEFAULT_OUTPUT_CHANNELS = 2;
 constexpr AudioChannelLayout DEFAULT_OUTPUT_CHANNEL_LAYOUT = AudioChannelLayout::STEREO;
+constexpr uint32_t MAX_RENDER_RATE_RATIO = 4;
 const std::pair<OHOS::AudioStandard::AudioSamplingRate, uint32_t> g_auSampleRateMap[] = {
     {OHOS::AudioStandard::SAMPLE_RATE_8000, 8000},
     {OHOS::AudioStandard::SAMPLE_RATE_11025, 11025},
@@ -192,21 +193,22 @@ namespace AuSrSinkPlugin {
 using namespace OHOS::Media::Plugin;
 
 
-AudioServerSinkPlugin::AudioRendererCallbackImpl::AudioRendererCallbackImpl(Callback* cb, const bool& isPaused)
-    : callback_(cb), isPaused_(isPaused)
+AudioServerSinkPlugin::AudioRendererCallbackImpl::AudioRendererCallbackImpl(Callback* cb,
+    std::weak_ptr<AudioRenderWriter> writer) : callback_(cb), writer_(std::move(writer))
 {
 }
 
 void AudioServerSinkPlugin::AudioRendererCallbackImpl::OnInterrupt(
     const OHOS::AudioStandard::InterruptEvent& interruptEvent)
 {
-    if (interruptEvent.forceType == OHOS::AudioStandard::INTERRUPT_FORCE) {
+    auto writer = writer_.lock();
+    if (interruptEvent.forceType == OHOS::AudioStandard::INTERRUPT_FORCE && writer != nullptr) {
         switch (interruptEvent.hintType) {
             case OHOS::AudioStandard::INTERRUPT_HINT_PAUSE:
-                isPaused_ = true;
+                writer->SetForcePaused(true);
                 break;
             default:
-                isPaused_ = false;
+                writer->SetForcePaused(false);
                 break;
         }
     }
@@ -222,8 +224,22 @@ void AudioServerSinkPlugin::AudioRendererCallbackImpl::OnStateChange(const OHOS:
     }
 }
 
+AudioServerSinkPlugin::RendererPeriodPositionCallbackImpl::RendererPeriodPositionCallbackImpl(
+    std::weak_ptr<AudioRenderWriter> writer) : writer_(std::move(writer))
+{
+}
+
+void AudioServerSinkPlugin::RendererPeriodPositionCallbackImpl::OnPeriodReached(const int64_t& frameNumber)
+{
+    auto writer = writer_.lock();
+    if (writer != nullptr) {
+        writer->NotifyWritable();
+    }
+}
+
 AudioServerSinkPlugin::AudioServerSinkPlugin(std::string name)
-    : Plugin::AudioSinkPlugin(std::move(name)), audioRenderer_(nullptr)
+    : Plugin::AudioSinkPlugin(std::move(name)), audioRenderer_(nullptr),
+      renderWriter_(std::make_shared<AudioRenderWriter>())
 {
     SetUpParamsSetterMap();
 }
@@ -262,7 +278,7 @@ Status AudioServerSinkPlugin::Init()
         }
         audioRenderer_->SetInterruptMode(audioInterruptMode_);
         if (audioRendererCallback_ == nullptr) {
-            audioRendererCallback_ = std::make_shared<AudioRendererCallbackImpl>(callback_, isForcePaused_);
+            audioRendererCallback_ = std::make_shared<AudioRendererCallbackImpl>(callback_, renderWriter_);
             audioRenderer_->SetRendererCallback(audioRendererCallback_);
         }
     }
@@ -271,6 +287,7 @@ Status AudioServerSinkPlugin::Init()
 
 void AudioServerSinkPlugin::ReleaseRender()
 {
+    renderWriter_->Interrupt();
     OSAL::ScopedLock lock(renderMutex_);
     if (audioRenderer_ != nullptr && audioRenderer_->GetStatus() != AudioStandard::RendererState::RENDERER_RELEASED) {
         if (!audioRenderer_->Release()) {
@@ -292,7 +309,7 @@ Status AudioServerSinkPlugin::Prepare()
 {
     MEDIA_LOG_I("Prepare entered.");
     FALSE_RETURN_V_MSG_E(fmtSupported_, Status::ERROR_INVALID_PARAMETER, "sample fmt is not supported");
-    if (bitsPerSample_ == 8 || bitsPerSample_ == 24) { // 8 24
+    if (bitsPerSample_ == 8 || bitsPerSample_ == 24 || sampleRate_ != renderSampleRate_) { // 8 24
         needReformat_ = true;
         rendererParams_.sampleFormat = reStdDestFmt_;
     }
@@ -315,21 +332,60 @@ Status AudioServerSinkPlugin::Prepare()
             MEDIA_LOG_E("audio renderer SetParams() fail with " PUBLIC_LOG_D32, ret);
             return Status::ERROR_UNKNOWN;
         }
+        RegisterWritableCallback();
     }
     if (needReformat_) {
-        resample_ = std::make_shared<Ffmpeg::Resample>();
-        Ffmpeg::ResamplePara resamplePara {
+        FALSE_RETURN_V_MSG(InitResample() == Status::OK, Status::ERROR_UNKNOWN, "Resample init error");
+    }
+    return Status::OK;
+}
+
+Status AudioServerSinkPlugin::InitResample()
+{
+    // prefer the native resampler, it avoids the ffmpeg swr context and also covers integer ratio rate conversion
+    if (AudioResampler::IsFormatSupported(sampleFmt_, false)) {
+        nativeResample_ = std::make_shared<AudioResampler>();
+        AudioResamplerPara resamplerPara {
             channels_,
             sampleRate_,
-            bitsPerSample_,
-            static_cast<int64_t>(channelLayout_),
-            reSrcFfFmt_,
-            samplesPerFrame_,
-            reFfDestFmt_,
+            renderSampleRate_,
+            sampleFmt_,
+            AudioSampleFormat::S16,
         };
-        FALSE_RETURN_V_MSG(resample_->Init(resamplePara) == Status::OK, Status::ERROR_UNKNOWN, "Resample init error");
+        return nativeResample_->Init(resamplerPara);
+    }
+    FALSE_RETURN_V_MSG_E(sampleRate_ == renderSampleRate_, Status::ERROR_UNSUPPORTED_FORMAT,
+                         "rate conversion is not supported for sample fmt " PUBLIC_LOG_U8,
+                         static_cast<uint8_t>(sampleFmt_));
+    resample_ = std::make_shared<Ffmpeg::Resample>();
+    Ffmpeg::ResamplePara resamplePara {
+        channels_,
+        sampleRate_,
+        bitsPerSample_,
+        static_cast<int64_t>(channelLayout_),
+        reSrcFfFmt_,
+        samplesPerFrame_,
+        reFfDestFmt_,
+    };
+    return resample_->Init(resamplePara);
+}
+
+void AudioServerSinkPlugin::RegisterWritableCallback()
+{
+    // the renderer consumed one period since the last notification, wake up the blocked writer
+    uint32_t sampleRate = 0;
+    if (!SampleRateEnum2Num(rendererParams_.sampleRate, sampleRate) || sampleRate == 0) {
+        return;
+    }
+    if (periodPositionCallback_ == nullptr) {
+        periodPositionCallback_ = std::make_shared<RendererPeriodPositionCallbackImpl>(renderWriter_);
+    }
+    int64_t periodFrames = sampleRate / 100; // 100: 10ms period
+    auto ret = audioRenderer_->SetRendererPeriodPositionCallback(periodFrames, periodPositionCallback_);
+    if (ret != AudioStandard::SUCCESS) {
+        MEDIA_LOG_W("set period position callback fail with " PUBLIC_LOG_D32 ", writes fall back to timed waits",
+                    ret);
     }
-    return Status::OK;
 }
 
 bool AudioServerSinkPlugin::StopRender()
@@ -358,11 +414,14 @@ Status AudioServerSinkPlugin::Reset()
     channels_ = 0;
     bitRate_ = 0;
     sampleRate_ = 0;
+    renderSampleRate_ = 0;
     samplesPerFrame_ = 0;
     needReformat_ = false;
     if (resample_) {
         resample_.reset();
     }
+    nativeResample_.reset();
+    renderWriter_->ResetStats();
     return Status::OK;
 }
 
@@ -370,6 +429,7 @@ Status AudioServerSinkPlugin::Start()
 {
     MEDIA_LOG_I("Start entered.");
     bool ret = false;
+    renderWriter_->ClearInterrupt();
     OSAL::ScopedLock lock(renderMutex_);
     {
         if (audioRenderer_ == nullptr) {
@@ -389,6 +449,8 @@ Status AudioServerSinkPlugin::Start()
 Status AudioServerSinkPlugin::Stop()
 {
     MEDIA_LOG_I("Stop entered.");
+    renderWriter_->Interrupt();
+    renderWriter_->ReportStats();
     if (StopRender()) {
         MEDIA_LOG_I("stop render success");
         return Status::OK;
@@ -443,9 +505,35 @@ Status AudioServerSinkPlugin::GetParameter(Tag tag, ValueType& para)
 bool AudioServerSinkPlugin::AssignSampleRateIfSupported(uint32_t sampleRate)
 {
     sampleRate_ = sampleRate;
+    if (IsRenderSampleRateSupported(sampleRate)) {
+        renderSampleRate_ = sampleRate;
+        return true;
+    }
+    // render at an integer ratio of the source rate, down first, so that the native resampler can convert it
+    for (uint32_t ratio = 2; ratio <= MAX_RENDER_RATE_RATIO; ++ratio) { // 2: smallest ratio
+        if (sampleRate % ratio == 0 && IsRenderSampleRateSupported(sampleRate / ratio)) {
+            renderSampleRate_ = sampleRate / ratio;
+            MEDIA_LOG_I("sample rate " PUBLIC_LOG_U32 " is resampled to " PUBLIC_LOG_U32, sampleRate,
+                        renderSampleRate_);
+            return true;
+        }
+    }
+    for (uint32_t ratio = 2; ratio <= MAX_RENDER_RATE_RATIO; ++ratio) { // 2: smallest ratio
+        if (IsRenderSampleRateSupported(sampleRate * ratio)) {
+            renderSampleRate_ = sampleRate * ratio;
+            MEDIA_LOG_I("sample rate " PUBLIC_LOG_U32 " is resampled to " PUBLIC_LOG_U32, sampleRate,
+                        renderSampleRate_);
+            return true;
+        }
+    }
+    MEDIA_LOG_E("sample rate " PUBLIC_LOG_U32 "not supported", sampleRate);
+    return false;
+}
+
+bool AudioServerSinkPlugin::IsRenderSampleRateSupported(uint32_t sampleRate)
+{
     AudioStandard::AudioSamplingRate aRate = AudioStandard::SAMPLE_RATE_8000;
     if (!SampleRateNum2Enum(sampleRate, aRate)) {
-        MEDIA_LOG_E("sample rate " PUBLIC_LOG_U32 "not supported", sampleRate);
         return false;
     }
     auto supportedSampleRateList = OHOS::AudioStandard::AudioRenderer::GetSupportedSamplingRates();
@@ -490,6 +578,7 @@ bool AudioServerSinkPlugin::AssignSampleFmtIfSupported(Plugin::AudioSampleFormat
     const auto& item = std::find_if(g_aduFmtMap.begin(), g_aduFmtMap.end(), [&sampleFormat] (const auto& tmp) -> bool {
         return std::get<0>(tmp) == sampleFormat;
     });
+    sampleFmt_ = sampleFormat;
     auto stdFmt = std::get<1>(*item);
     if (stdFmt == OHOS::AudioStandard::AudioSampleFormat::INVALID_WIDTH) {
         if (std::get<2>(*item) == AV_SAMPLE_FMT_NONE) { // 2
@@ -730,35 +819,34 @@ Status AudioServerSinkPlugin::Write(const std::shared_ptr<Buffer>& input)
     auto destBuffer = const_cast<uint8_t*>(srcBuffer);
     auto srcLength = mem->GetSize();
     auto destLength = srcLength;
-    if (needReformat_ && resample_ && srcLength >0) {
-        FALSE_LOG(resample_->Convert(srcBuffer, srcLength, destBuffer, destLength) == Status::OK);
-    }
-    MEDIA_LOG_DD("write data size " PUBLIC_LOG_ZU, destLength);
-    while (isForcePaused_ && seekable_ == Seekable::SEEKABLE) {
-        OSAL::SleepFor(5); // 5ms
+    if (seekable_ == Seekable::SEEKABLE && !renderWriter_->WaitForcePauseLifted()) {
+        MEDIA_LOG_D("write is interrupted while force paused");
+        return Status::OK;
     }
-    int32_t ret = 0;
     OSAL::ScopedLock lock(renderMutex_);
     FALSE_RETURN_V(audioRenderer_ != nullptr, Status::ERROR_WRONG_STATE);
-    for (; destLength > 0;) {
-        ret = audioRenderer_->Write(destBuffer, destLength);
-        if (ret < 0) {
-            MEDIA_LOG_E("Write data error ret is: " PUBLIC_LOG_D32, ret);
-            break;
-        } else if (static_cast<size_t>(ret) < destLength) {
-            OSAL::SleepFor(5); // 5ms
-        }
-        destBuffer += ret;
-        destLength -= ret;
-        MEDIA_LOG_DD("written data size " PUBLIC_LOG_D32, ret);
+    // convert under the render lock, the native resampler keeps filter history that Flush drops
+    if (needReformat_ && nativeResample_ && srcLength > 0) {
+        FALSE_LOG(nativeResample_->Convert(srcBuffer, srcLength, destBuffer, destLength) == Status::OK);
+    } else if (needReformat_ && resample_ && srcLength > 0) {
+        FALSE_LOG(resample_->Convert(srcBuffer, srcLength, destBuffer, destLength) == Status::OK);
     }
-    return ret >= 0 ? Status::OK : Status::ERROR_UNKNOWN;
+    MEDIA_LOG_DD("write data size " PUBLIC_LOG_ZU, destLength);
+    auto ret = renderWriter_->Write(destBuffer, destLength, [this](uint8_t* data, size_t length) {
+        return audioRenderer_->Write(data, length);
+    });
+    return ret != RenderWriteResult::ERROR ? Status::OK : Status::ERROR_UNKNOWN;
 }
 
 Status AudioServerSinkPlugin::Flush()
 {
     MEDIA_LOG_I("Flush entered.");
+    renderWriter_->Interrupt();
     OSAL::ScopedLock lock(renderMutex_);
+    renderWriter_->ClearInterrupt();
+    if (nativeResample_) {
+        nativeResample_->Reset();
+    }
     if (audioRenderer_ == nullptr) {
         return Status::ERROR_WRONG_STATE;
     }
@@ -21,9 +21,11 @@
 #include <unordered_map>
 
 #include "audio_info.h"
+#include "audio_render_writer.h"
 #include "audio_renderer.h"
 #include "foundation/osal/thread/mutex.h"
 #include "plugin/common/plugin_audio_tags.h"
+#include "plugin/convert/audio_resampler.h"
 #include "plugin/convert/ffmpeg_convert.h"
 #include "plugin/interface/audio_sink_plugin.h"
 #include "plugins/ffmpeg_adapter/utils/ffmpeg_utils.h"
@@ -114,17 +116,27 @@ public:
 private:
     class AudioRendererCallbackImpl : public OHOS::AudioStandard::AudioRendererCallback {
     public:
-        AudioRendererCallbackImpl(Callback* cb, const bool& isPaused);
+        AudioRendererCallbackImpl(Callback* cb, std::weak_ptr<AudioRenderWriter> writer);
         void OnInterrupt(const OHOS::AudioStandard::InterruptEvent& interruptEvent) override;
         void OnStateChange(const OHOS::AudioStandard::RendererState state,
             const OHOS::AudioStandard::StateChangeCmdType cmdType) override;
     private:
         Callback* callback_ {};
-        bool isPaused_ {false};
+        std::weak_ptr<AudioRenderWriter> writer_ {};
     };
+    class RendererPeriodPositionCallbackImpl : public OHOS::AudioStandard::RendererPeriodPositionCallback {
+    public:
+        explicit RendererPeriodPositionCallbackImpl(std::weak_ptr<AudioRenderWriter> writer);
+        void OnPeriodReached(const int64_t& frameNumber) override;
+    private:
+        std::weak_ptr<AudioRenderWriter> writer_ {};
+    };
+    void RegisterWritableCallback();
     void ReleaseRender();
     bool StopRender();
     bool AssignSampleRateIfSupported(uint32_t sampleRate);
+    bool IsRenderSampleRateSupported(uint32_t sampleRate);
+    Status InitResample();
     bool AssignChannelNumIfSupported(uint32_t channelNum);
     bool AssignSampleFmtIfSupported(AudioSampleFormat sampleFormat);
     void SetInterruptMode(AudioStandard::InterruptMode interruptMode);
@@ -150,11 +162,13 @@ private:
     AudioStandard::InterruptMode audioInterruptMode_ {AudioStandard::InterruptMode::SHARE_MODE};
     std::unique_ptr<AudioStandard::AudioRenderer> audioRenderer_ {nullptr};
     std::shared_ptr<OHOS::AudioStandard::AudioRendererCallback> audioRendererCallback_ {nullptr};
+    std::shared_ptr<OHOS::AudioStandard::RendererPeriodPositionCallback> periodPositionCallback_ {nullptr};
+    std::shared_ptr<AudioRenderWriter> renderWriter_ {nullptr};
     AudioStandard::AudioRendererParams rendererParams_ {};
 
     bool fmtSupported_ {false};
-    bool isForcePaused_ {false};
     AVSampleFormat reSrcFfFmt_ {AV_SAMPLE_FMT_NONE};
+    Plugin::AudioSampleFormat sampleFmt_ {Plugin::AudioSampleFormat::S16};
     const AudioStandard::AudioSampleFormat reStdDestFmt_ {AudioStandard::AudioSampleFormat::SAMPLE_S16LE};
     const AVSampleFormat reFfDestFmt_ {AV_SAMPLE_FMT_S16};
     AudioChannelLayout channelLayout_ {};
@@ -162,12 +176,14 @@ private:
     uint32_t samplesPerFrame_ {};
     uint32_t bitsPerSample_ {0};
     uint32_t sampleRate_ {};
+    uint32_t renderSampleRate_ {0};
     int64_t bitRate_ {0};
     int32_t appPid_ {0};
     int32_t appUid_ {0};
     bool needReformat_ {false};
     Plugin::Seekable seekable_ {Plugin::Seekable::INVALID};
     std::shared_ptr<Ffmpeg::Resample> resample_ {nullptr};
+    std::shared_ptr<AudioResampler> nativeResample_ {nullptr};
 
     std::unordered_map<Tag, std::function<Status(const ValueType& para)>> paramsSetterMap_;
 };
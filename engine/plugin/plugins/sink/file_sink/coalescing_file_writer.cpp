@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define HST_LOG_TAG "CoalescingFileWriter"
+
+#include "coalescing_file_writer.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#ifdef WIN32
+#include <fcntl.h>
+#else
+#include <sys/types.h>
+#include <sys/uio.h>
+#endif
+#include <unistd.h>
+#include <securec.h>
+#include "foundation/log.h"
+#include "foundation/osal/thread/scoped_lock.h"
+#include "plugin/common/plugin_time.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+namespace FileSink {
+namespace {
+constexpr size_t STAGE_ALIGNMENT = 4096; // 4096: page size, the staged data is written from whole pages
+
+std::shared_ptr<uint8_t> AllocStage(size_t size)
+{
+#ifdef WIN32
+    return std::shared_ptr<uint8_t>(new (std::nothrow) uint8_t[size], std::default_delete<uint8_t[]>());
+#else
+    void* addr = nullptr;
+    if (posix_memalign(&addr, STAGE_ALIGNMENT, size) != 0) {
+        return nullptr;
+    }
+    return std::shared_ptr<uint8_t>(static_cast<uint8_t*>(addr), [](uint8_t* ptr) { free(ptr); });
+#endif
+}
+}
+
+CoalescingFileWriter::CoalescingFileWriter() : CoalescingFileWriter(Options {})
+{
+}
+
+CoalescingFileWriter::CoalescingFileWriter(const Options& options) : options_(options)
+{
+    options_.bufferSize = std::max(options_.bufferSize, STAGE_ALIGNMENT);
+    options_.bufferSize = (options_.bufferSize + STAGE_ALIGNMENT - 1) / STAGE_ALIGNMENT * STAGE_ALIGNMENT;
+}
+
+CoalescingFileWriter::~CoalescingFileWriter()
+{
+    (void)Close();
+}
+
+Status CoalescingFileWriter::Open(int32_t fd)
+{
+    (void)Close();
+    FALSE_RETURN_V_MSG_E(fd != -1, Status::ERROR_INVALID_PARAMETER, "no valid fd.");
+    if (stage_ == nullptr) {
+        stage_ = AllocStage(options_.bufferSize);
+        FALSE_RETURN_V_MSG_E(stage_ != nullptr, Status::ERROR_NO_MEMORY, "alloc staging buffer failed");
+    }
+    OSAL::ScopedLock lock(mutex_);
+    // pipes and sockets are written in order, without seek nor patch
+    auto current = lseek(fd, 0, SEEK_CUR);
+    seekable_ = current >= 0;
+    fd_ = fd;
+    position_ = seekable_ ? static_cast<uint64_t>(current) : 0;
+    stageStart_ = position_;
+    stageSize_ = 0;
+    stats_ = {};
+    StartSyncLocked();
+    return Status::OK;
+}
+
+Status CoalescingFileWriter::Close()
+{
+    Status ret = Status::OK;
+    {
+        OSAL::ScopedLock lock(mutex_);
+        if (fd_ == -1) {
+            return Status::OK;
+        }
+        ret = FlushLocked();
+    }
+    StopSync();
+    OSAL::ScopedLock lock(mutex_);
+    if (seekable_) {
+        // leave the fd where the stream ends, as if it was written directly
+        (void)lseek(fd_, static_cast<off_t>(position_), SEEK_SET);
+    }
+    MEDIA_LOG_I("write calls " PUBLIC_LOG_U64 ", bytes " PUBLIC_LOG_U64 ", patches " PUBLIC_LOG_U64
+                ", max write latency " PUBLIC_LOG_D64 " ns", stats_.writeCalls, stats_.bytesWritten, stats_.patches,
+                stats_.maxWriteLatencyNs);
+    fd_ = -1;
+    return ret;
+}
+
+Status CoalescingFileWriter::Write(const uint8_t* data, size_t size)
+{
+    OSAL::ScopedLock lock(mutex_);
+    FALSE_RETURN_V_MSG_E(fd_ != -1, Status::ERROR_WRONG_STATE, "no valid fd.");
+    if (data == nullptr || size == 0) {
+        return Status::OK;
+    }
+    uint64_t stageEnd = stageStart_ + stageSize_;
+    if (!seekable_ || position_ == stageEnd) {
+        return AppendLocked(data, size);
+    }
+    if (position_ + size <= stageEnd) {
+        // rewrite of data already written or staged
+        PatchLocked(position_, data, size);
+        position_ += size;
+        if (patchBytes_ >= options_.bufferSize) {
+            return FlushLocked();
+        }
+        return Status::OK;
+    }
+    // the write goes beyond the end, the stage restarts at the new position
+    NOK_RETURN(FlushLocked());
+    stageStart_ = position_;
+    return AppendLocked(data, size);
+}
+
+Status CoalescingFileWriter::SeekTo(uint64_t offset)
+{
+    OSAL::ScopedLock lock(mutex_);
+    FALSE_RETURN_V_MSG_E(fd_ != -1, Status::ERROR_WRONG_STATE, "no valid fd.");
+    FALSE_RETURN_V_MSG_E(seekable_, Status::ERROR_UNKNOWN, "seek to " PUBLIC_LOG_U64 " on an unseekable fd", offset);
+    position_ = offset;
+    return Status::OK;
+}
+
+Status CoalescingFileWriter::Flush()
+{
+    OSAL::ScopedLock lock(mutex_);
+    FALSE_RETURN_V_MSG_E(fd_ != -1, Status::ERROR_WRONG_STATE, "no valid fd.");
+    return FlushLocked();
+}
+
+Status CoalescingFileWriter::Truncate()
+{
+    OSAL::ScopedLock lock(mutex_);
+    FALSE_RETURN_V_MSG_E(fd_ != -1, Status::ERROR_WRONG_STATE, "no valid fd.");
+    stageSize_ = 0;
+    patches_.clear();
+    patchBytes_ = 0;
+    position_ = 0;
+    stageStart_ = 0;
+    if (ftruncate(fd_, 0) != 0) {
+        MEDIA_LOG_W("truncate failed due to " PUBLIC_LOG_S, strerror(errno));
+    }
+    if (seekable_) {
+        (void)lseek(fd_, 0, SEEK_SET);
+    }
+    return Status::OK;
+}
+
+CoalescingFileWriter::Stats CoalescingFileWriter::GetStats()
+{
+    OSAL::ScopedLock lock(mutex_);
+    return stats_;
+}
+
+Status CoalescingFileWriter::AppendLocked(const uint8_t* data, size_t size)
+{
+    if (stageSize_ + size <= options_.bufferSize) {
+        (void)memcpy_s(stage_.get() + stageSize_, options_.bufferSize - stageSize_, data, size);
+        stageSize_ += size;
+        position_ += size;
+        return Status::OK;
+    }
+    // the staged data and the new data go out in one call, the new data is not copied
+    NOK_RETURN(FlushLocked(data, size));
+    position_ += size;
+    return Status::OK;
+}
+
+void CoalescingFileWriter::PatchLocked(uint64_t offset, const uint8_t* data, size_t size)
+{
+    uint64_t end = offset + size;
+    if (end > stageStart_) {
+        uint64_t from = std::max(offset, stageStart_);
+        (void)memcpy_s(stage_.get() + (from - stageStart_), stageSize_ - (from - stageStart_),
+                       data + (from - offset), end - from);
+        if (offset >= stageStart_) {
+            return;
+        }
+        size = static_cast<size_t>(stageStart_ - offset);
+    }
+    // already written, kept aside until the next flush
+    stats_.patches++;
+    patchBytes_ += size;
+    if (!patches_.empty() && patches_.back().offset + patches_.back().data.size() == offset) {
+        patches_.back().data.insert(patches_.back().data.end(), data, data + size);
+        return;
+    }
+    patches_.push_back({offset, std::vector<uint8_t>(data, data + size)});
+}
+
+Status CoalescingFileWriter::FlushLocked(const uint8_t* tail, size_t tailSize)
+{
+    if (stageSize_ > 0 || tailSize > 0) {
+        NOK_RETURN(WriteFully(stageStart_, stage_.get(), stageSize_, tail, tailSize));
+        stageStart_ += stageSize_ + tailSize;
+        stageSize_ = 0;
+    }
+    for (const auto& patch : patches_) {
+        NOK_RETURN(WriteFully(patch.offset, patch.data.data(), patch.data.size(), nullptr, 0));
+    }
+    patches_.clear();
+    patchBytes_ = 0;
+    return Status::OK;
+}
+
+Status CoalescingFileWriter::WriteFully(uint64_t offset, const uint8_t* first, size_t firstSize,
+                                        const uint8_t* second, size_t secondSize)
+{
+    const uint8_t* parts[] = {first, second};
+    size_t sizes[] = {firstSize, secondSize};
+    size_t index = (firstSize == 0) ? 1 : 0;
+    while (index < 2 && sizes[index] > 0) { // 2: parts
+        auto start = std::chrono::steady_clock::now();
+#ifdef WIN32
+        ssize_t ret = -1;
+        if (!seekable_ || lseek(fd_, static_cast<off_t>(offset), SEEK_SET) >= 0) {
+            ret = write(fd_, parts[index], sizes[index]);
+        }
+#else
+        struct iovec iov[2]; // 2: parts
+        int count = 0;
+        for (size_t i = index; i < 2 && sizes[i] > 0; ++i) { // 2: parts
+            iov[count].iov_base = const_cast<uint8_t*>(parts[i]);
+            iov[count].iov_len = sizes[i];
+            count++;
+        }
+        ssize_t ret = seekable_ ? pwritev(fd_, iov, count, static_cast<off_t>(offset)) : writev(fd_, iov, count);
+#endif
+        stats_.writeCalls++;
+        stats_.maxWriteLatencyNs = std::max(stats_.maxWriteLatencyNs, static_cast<int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            MEDIA_LOG_E("write at " PUBLIC_LOG_U64 " failed due to " PUBLIC_LOG_S, offset, strerror(errno));
+            return Status::ERROR_UNKNOWN;
+        }
+        auto written = static_cast<size_t>(ret);
+        stats_.bytesWritten += written;
+        offset += written;
+        // a short write resumes where it stopped
+        while (index < 2 && written >= sizes[index]) { // 2: parts
+            written -= sizes[index];
+            sizes[index] = 0;
+            index++;
+        }
+        if (index < 2) { // 2: parts
+            parts[index] += written;
+            sizes[index] -= written;
+        }
+    }
+    return Status::OK;
+}
+
+void CoalescingFileWriter::SetSyncInterval(int32_t syncIntervalMs)
+{
+    {
+        OSAL::ScopedLock lock(mutex_);
+        if (options_.syncIntervalMs == syncIntervalMs) {
+            return;
+        }
+        options_.syncIntervalMs = syncIntervalMs;
+    }
+    // the loop waits on the former interval, it is restarted on the new one
+    StopSync();
+    OSAL::ScopedLock lock(mutex_);
+    if (fd_ != -1) {
+        StartSyncLocked();
+    }
+}
+
+void CoalescingFileWriter::StartSyncLocked()
+{
+    if (options_.syncIntervalMs > 0) {
+        syncStopping_ = false;
+        syncTask_ = std::make_unique<OSAL::Task>("FileSinkSync", [this] { SyncLoop(); }, OSAL::ThreadPriority::LOW);
+        syncTask_->Start();
+    }
+}
+
+void CoalescingFileWriter::StopSync()
+{
+    {
+        OSAL::ScopedLock lock(mutex_);
+        syncStopping_ = true;
+        syncCond_.NotifyAll();
+    }
+    if (syncTask_ != nullptr) {
+        syncTask_->Stop();
+        syncTask_.reset();
+    }
+}
+
+void CoalescingFileWriter::SyncLoop()
+{
+    int32_t fd = -1;
+    {
+        OSAL::ScopedLock lock(mutex_);
+        int64_t deadline = OSAL::ConditionVariable::GetClockTimeNs() + options_.syncIntervalMs * HST_MSECOND;
+        while (!syncStopping_ && syncCond_.WaitUntil(lock, deadline)) {
+        }
+        if (syncStopping_ || fd_ == -1) {
+            return;
+        }
+        if (FlushLocked() != Status::OK) {
+            return;
+        }
+        fd = fd_;
+        stats_.syncCalls++;
+    }
+    // out of the lock, the writer is not blocked by the device
+#ifndef WIN32
+    int ret = options_.syncDataOnly ? fdatasync(fd) : fsync(fd);
+    if (ret != 0) {
+        MEDIA_LOG_W("sync failed due to " PUBLIC_LOG_S, strerror(errno));
+    }
+#endif
+}
+} // namespace FileSink
+} // namespace Plugin
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISTREAMER_COALESCING_FILE_WRITER_H
+#define HISTREAMER_COALESCING_FILE_WRITER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "foundation/osal/thread/condition_variable.h"
+#include "foundation/osal/thread/mutex.h"
+#include "foundation/osal/thread/task.h"
+#include "plugin/common/plugin_types.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+namespace FileSink {
+/**
+ * Writes a stream to a file descriptor with few syscalls. Contiguous writes are staged in an aligned buffer and
+ * written with one pwritev(), a large write goes out together with the staged data without being copied.
+ * Writes after a seek back, e.g. the header or moov rewrites of a muxer, patch the staged data in place or are kept
+ * aside and written at the next flush, the stream is not flushed for them.
+ */
+class CoalescingFileWriter {
+public:
+    struct Options {
+        size_t bufferSize {256 * 1024}; // 256K: staging buffer
+        int32_t syncIntervalMs {0};     // flush and sync in the background at this cadence, 0 to disable
+        bool syncDataOnly {true};       // fdatasync() rather than fsync()
+    };
+
+    struct Stats {
+        uint64_t writeCalls {0};       // write syscalls issued
+        uint64_t syncCalls {0};        // sync syscalls issued
+        uint64_t bytesWritten {0};
+        uint64_t patches {0};          // writes kept aside after a seek back
+        int64_t maxWriteLatencyNs {0}; // worst write syscall
+    };
+
+    CoalescingFileWriter();
+    explicit CoalescingFileWriter(const Options& options);
+    ~CoalescingFileWriter();
+
+    /**
+     * Start writing at the current offset of fd. The fd is not owned and has to outlive Close().
+     */
+    Status Open(int32_t fd);
+
+    /**
+     * Flush and stop the background sync.
+     */
+    Status Close();
+
+    Status Write(const uint8_t* data, size_t size);
+
+    Status SeekTo(uint64_t offset);
+
+    Status Flush();
+
+    /**
+     * Change the cadence of the background flush and sync, 0 to disable. Applies right away when open.
+     */
+    void SetSyncInterval(int32_t syncIntervalMs);
+
+    /**
+     * Drop the pending data and truncate the file.
+     */
+    Status Truncate();
+
+    bool IsSeekable() const
+    {
+        return seekable_;
+    }
+
+    Stats GetStats();
+
+private:
+    struct Patch {
+        uint64_t offset;
+        std::vector<uint8_t> data;
+    };
+
+    Status AppendLocked(const uint8_t* data, size_t size);
+    void PatchLocked(uint64_t offset, const uint8_t* data, size_t size);
+    Status FlushLocked(const uint8_t* tail = nullptr, size_t tailSize = 0);
+    Status WriteFully(uint64_t offset, const uint8_t* first, size_t firstSize, const uint8_t* second,
+                      size_t secondSize);
+    void StartSyncLocked();
+    void StopSync();
+    void SyncLoop();
+
+    Options options_;
+    int32_t fd_ {-1};
+    bool seekable_ {false};
+    uint64_t position_ {0};
+    uint64_t stageStart_ {0};
+    size_t stageSize_ {0};
+    std::shared_ptr<uint8_t> stage_ {nullptr};
+    std::vector<Patch> patches_ {};
+    size_t patchBytes_ {0};
+    Stats stats_ {};
+    OSAL::Mutex mutex_ {};
+    OSAL::ConditionVariable syncCond_ {};
+    std::unique_ptr<OSAL::Task> syncTask_ {nullptr};
+    bool syncStopping_ {false};
+};
+} // namespace FileSink
+} // namespace Plugin
+} // namespace Media
+} // namespace OHOS
+#endif // HISTREAMER_COALESCING_FILE_WRITER_H
@@ -56,11 +56,24 @@ FileFdSinkPlugin::~FileFdSinkPlugin()
     CloseFd();
 }
 
+Status FileFdSinkPlugin::SetParameter(Tag tag, const ValueType& value)
+{
+    if (tag != Tag::MEDIA_SYNC_INTERVAL) {
+        return Status::ERROR_UNIMPLEMENTED;
+    }
+    FALSE_RETURN_V_MSG_E(Plugin::Any::IsSameTypeWith<uint32_t>(value), Status::ERROR_INVALID_PARAMETER,
+                         "sync interval should be uint32_t");
+    writer_.SetSyncInterval(static_cast<int32_t>(Plugin::AnyCast<uint32_t>(value)));
+    return Status::OK;
+}
+
 Status FileFdSinkPlugin::SetSink(const MediaSink& sink)
 {
     FALSE_RETURN_V((sink.GetProtocolType() == ProtocolType::FD && sink.GetFd() != -1), Status::ERROR_INVALID_DATA);
     fd_ =  sink.GetFd();
-    return Status::OK;
+    auto ret = writer_.Open(fd_);
+    seekable_ = writer_.IsSeekable() ? Seekable::SEEKABLE : Seekable::UNSEEKABLE;
+    return ret;
 }
 
 Seekable FileFdSinkPlugin::GetSeekable()
@@ -71,13 +84,12 @@ Seekable FileFdSinkPlugin::GetSeekable()
 Status FileFdSinkPlugin::SeekTo(uint64_t offset)
 {
     FALSE_RETURN_V_MSG_E(fd_ != -1, Status::ERROR_WRONG_STATE, "no valid fd.");
-    int64_t ret = lseek(fd_, offset, SEEK_SET);
-    if (ret != -1) {
-        MEDIA_LOG_I("now seek to " PUBLIC_LOG_D64, ret);
-        return Status::OK;
+    // no syscall, the writes after a seek back are patched into the staged data or kept until the next flush
+    auto ret = writer_.SeekTo(offset);
+    if (ret == Status::OK) {
+        MEDIA_LOG_I("now seek to " PUBLIC_LOG_U64, offset);
     }
-    MEDIA_LOG_E("seek to " PUBLIC_LOG_U64 " failed due to " PUBLIC_LOG_S, offset, strerror(errno));
-    return Status::ERROR_UNKNOWN;
+    return ret;
 }
 
 Status FileFdSinkPlugin::Write(const std::shared_ptr<Buffer>& buffer)
@@ -87,28 +99,32 @@ Status FileFdSinkPlugin::Write(const std::shared_ptr<Buffer>& buffer)
         return Status::OK;
     }
     auto bufferData = buffer->GetMemory();
-    write(fd_, bufferData->GetReadOnlyData(), bufferData->GetSize());
-    return Status::OK;
+    return writer_.Write(bufferData->GetReadOnlyData(), bufferData->GetSize());
 }
 
 Status FileFdSinkPlugin::Flush()
 {
     MEDIA_LOG_D("Flush");
-    return Status::OK;
+    if (fd_ == -1) {
+        return Status::OK;
+    }
+    return writer_.Flush();
 }
 
 Status FileFdSinkPlugin::Reset()
 {
     MEDIA_LOG_D("Reset");
-    ftruncate(fd_, 0);
-    lseek(fd_, 0, SEEK_SET);
-    return Status::OK;
+    if (fd_ == -1) {
+        return Status::OK;
+    }
+    return writer_.Truncate();
 }
 
 void FileFdSinkPlugin::CloseFd()
 {
     if (fd_ != -1) {
         MEDIA_LOG_D("close fd");
+        (void)writer_.Close();
         close(fd_);
         fd_ = -1;
     }
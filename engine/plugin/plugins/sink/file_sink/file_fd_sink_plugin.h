@@ -17,6 +17,7 @@
 
 #include "plugin/common/media_sink.h"
 #include "plugin/interface/output_sink_plugin.h"
+#include "coalescing_file_writer.h"
 
 namespace OHOS {
 namespace Media {
@@ -27,6 +28,7 @@ public:
     explicit FileFdSinkPlugin(std::string name);
     ~FileFdSinkPlugin() override;
     // file fd sink
+    Status SetParameter(Tag tag, const ValueType& value) override;
     Status SetSink(const MediaSink& sink) override;
     Seekable GetSeekable()  override;
     Status SeekTo(uint64_t offset)  override;
@@ -38,6 +40,7 @@ private:
     void CloseFd();
     int32_t fd_ {-1};
     Seekable seekable_;
+    CoalescingFileWriter writer_ {};
 };
 }
 }
@@ -117,6 +117,18 @@ Status FileFdSourcePlugin::SetSource(std::shared_ptr<MediaSource> source)
 
 Status FileFdSourcePlugin::Read(std::shared_ptr<Buffer>& buffer, size_t expectedLen)
 {
+    if (mappedFile_.IsMapped()) {
+        size_t readSize = 0;
+        auto ret = mappedFile_.Read(position_ - static_cast<uint64_t>(offset_), buffer, expectedLen,
+                                    GetAllocator(), readSize);
+        position_ += readSize;
+        if (ret != Status::OK || mappedFile_.IsMapped()) {
+            MEDIA_LOG_DD("position_: " PUBLIC_LOG_U64 ", mapped readSize: " PUBLIC_LOG_ZU, position_, readSize);
+            return ret;
+        }
+        // the file is truncated, read() the rest from the current position
+        NOK_RETURN(SeekTo(position_ - static_cast<uint64_t>(offset_)));
+    }
     if (!buffer) {
         buffer = std::make_shared<Buffer>();
     }
@@ -154,6 +166,10 @@ Status FileFdSourcePlugin::SeekTo(uint64_t offset)
 {
     FALSE_RETURN_V_MSG_E(fd_ != -1 && seekable_ == Seekable::SEEKABLE,
                          Status::ERROR_WRONG_STATE, "no valid fd or no seekable.");
+    if (mappedFile_.IsMapped()) {
+        position_ = offset + static_cast<uint64_t>(offset_);
+        return Status::OK;
+    }
     int32_t ret = lseek(fd_, offset + static_cast<uint64_t>(offset_), SEEK_SET);
     if (ret == -1) {
         MEDIA_LOG_E("seek to " PUBLIC_LOG_U64 " failed due to " PUBLIC_LOG_S, offset, strerror(errno));
@@ -203,7 +219,11 @@ Status FileFdSourcePlugin::ParseUriInfo(const std::string& uri)
     position_ = offset_;
     seekable_ = OSAL::FileSystem::IsSeekable(fd_) ? Seekable::SEEKABLE : Seekable::UNSEEKABLE;
     if (seekable_ == Seekable::SEEKABLE) {
+        // regular files are read through a mapping, no read() nor lseek() per access
+        (void)mappedFile_.Open(fd_, static_cast<uint64_t>(offset_), size_);
         NOK_LOG(SeekTo(0));
+    } else {
+        mappedFile_.Close();
     }
     MEDIA_LOG_D("Fd: " PUBLIC_LOG_D32 ", offset: " PUBLIC_LOG_D64 ", size: " PUBLIC_LOG_U64, fd_, offset_, size_);
     return Status::OK;
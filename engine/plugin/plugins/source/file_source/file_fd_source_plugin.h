@@ -20,6 +20,7 @@
 #include <string>
 #include "plugin/common/plugin_types.h"
 #include "plugin/interface/source_plugin.h"
+#include "mapped_file_reader.h"
 
 namespace OHOS {
 namespace Media {
@@ -45,6 +46,7 @@ private:
     uint64_t fileSize_ {0};
     Seekable seekable_ {Seekable::SEEKABLE};
     uint64_t position_ {0};
+    MappedFileReader mappedFile_ {};
 };
 } // namespace FileSource
 } // namespace Plugin
@@ -152,6 +152,20 @@ Status FileSourcePlugin::Read(std::shared_ptr<Buffer>& buffer, size_t expectedLe
         MEDIA_LOG_W("It is the end of file!");
         return Status::END_OF_STREAM;
     }
+    if (mappedFile_.IsMapped()) {
+        size_t readSize = 0;
+        auto ret = mappedFile_.Read(position_, buffer, expectedLen, GetAllocator(), readSize);
+        position_ += readSize;
+        if (ret != Status::OK || mappedFile_.IsMapped()) {
+            MEDIA_LOG_DD("position_: " PUBLIC_LOG_U64 ", mapped readSize: " PUBLIC_LOG_ZU, position_, readSize);
+            return ret;
+        }
+        // the file is truncated, fread() the rest from the current position
+        if (std::fseek(fp_, static_cast<long int>(position_), SEEK_SET) != 0) {
+            MEDIA_LOG_E("Seek to " PUBLIC_LOG_U64, position_);
+            return Status::ERROR_UNKNOWN;
+        }
+    }
     if (buffer == nullptr) {
         buffer = std::make_shared<Buffer>();
     }
@@ -199,6 +213,11 @@ Status FileSourcePlugin::SeekTo(uint64_t offset)
         MEDIA_LOG_E("Invalid operation");
         return Status::ERROR_WRONG_STATE;
     }
+    if (mappedFile_.IsMapped()) {
+        position_ = offset;
+        MEDIA_LOG_D("seek to position_: " PUBLIC_LOG_U64 " success", position_);
+        return Status::OK;
+    }
     std::clearerr(fp_);
     if (std::fseek(fp_, static_cast<long int>(offset), SEEK_SET) != 0) {
         std::clearerr(fp_);
@@ -285,12 +304,15 @@ Status FileSourcePlugin::OpenFile()
     }
     fileSize_ = GetFileSize(fileName_);
     position_ = 0;
+    // regular files are read through a mapping, no fread() nor fseek() per access
+    (void)mappedFile_.Open(fileno(fp_), 0, fileSize_);
     MEDIA_LOG_D("FileName_: " PUBLIC_LOG_S ", fileSize_: " PUBLIC_LOG_U64, fileName_.c_str(), fileSize_);
     return Status::OK;
 }
 
 void FileSourcePlugin::CloseFile()
 {
+    mappedFile_.Close();
     if (fp_) {
         MEDIA_LOG_I("close file");
         std::fclose(fp_);
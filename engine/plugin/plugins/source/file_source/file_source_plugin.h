@@ -19,6 +19,7 @@
 #include <cstdio>
 #include "plugin/common/plugin_types.h"
 #include "plugin/interface/source_plugin.h"
+#include "mapped_file_reader.h"
 
 namespace OHOS {
 namespace Media {
@@ -59,6 +60,7 @@ private:
     Seekable seekable_;
     uint64_t position_;
     std::shared_ptr<FileSourceAllocator> mAllocator_ {nullptr};
+    MappedFileReader mappedFile_ {};
 
     Status ParseFileName(const std::string& uri);
     Status CheckFileStat();
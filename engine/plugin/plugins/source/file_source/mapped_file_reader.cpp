@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define HST_LOG_TAG "MappedFileReader"
+
+#include "mapped_file_reader.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <sys/stat.h>
+#ifndef WIN32
+#include <csetjmp>
+#include <csignal>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "foundation/log.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+namespace {
+constexpr uint64_t WINDOW_SIZE = 2 * 1024 * 1024; // 2M: checked against the file size and read ahead at once
+constexpr uint32_t SEQUENTIAL_READ_COUNT = 4; // 4: reads in a row before the access is taken as sequential
+
+#ifndef WIN32
+// volatile: the store has to happen before the copy, the compiler does not see the handler reading it
+thread_local sigjmp_buf* volatile g_copyGuard = nullptr;
+struct sigaction g_oldBusAction {};
+bool g_busHandlerInstalled = false;
+uint32_t g_busHandlerUsers = 0;
+std::mutex g_busHandlerMutex;
+
+void OnBusError(int sig, siginfo_t* info, void* context)
+{
+    sigjmp_buf* guard = g_copyGuard;
+    if (guard != nullptr) {
+        siglongjmp(*guard, 1);
+    }
+    // not raised by a guarded copy, hand it on to the action installed before
+    if ((g_oldBusAction.sa_flags & SA_SIGINFO) != 0 && g_oldBusAction.sa_sigaction != nullptr) {
+        g_oldBusAction.sa_sigaction(sig, info, context);
+        return;
+    }
+    if (g_oldBusAction.sa_handler == SIG_IGN) {
+        return;
+    }
+    if (g_oldBusAction.sa_handler != SIG_DFL && g_oldBusAction.sa_handler != nullptr) {
+        g_oldBusAction.sa_handler(sig);
+        return;
+    }
+    // a fault is raised again by the same instruction, a signal sent by someone else has to be raised again
+    (void)signal(sig, SIG_DFL);
+    if (info == nullptr || info->si_code <= 0) {
+        (void)raise(sig);
+    }
+}
+
+// the handler is only installed while a file is mapped, other signals are chained to the previous action
+bool AcquireBusHandler()
+{
+    std::lock_guard<std::mutex> lock(g_busHandlerMutex);
+    if (!g_busHandlerInstalled) {
+        struct sigaction action {};
+        action.sa_sigaction = OnBusError;
+        action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+        (void)sigemptyset(&action.sa_mask);
+        if (sigaction(SIGBUS, &action, &g_oldBusAction) != 0) {
+            MEDIA_LOG_W("install SIGBUS handler failed: " PUBLIC_LOG_S, strerror(errno));
+            return false;
+        }
+        g_busHandlerInstalled = true;
+        MEDIA_LOG_I("SIGBUS handler installed for the reads of mapped files");
+    }
+    g_busHandlerUsers++;
+    return true;
+}
+
+void ReleaseBusHandler()
+{
+    std::lock_guard<std::mutex> lock(g_busHandlerMutex);
+    if (g_busHandlerUsers == 0 || --g_busHandlerUsers > 0) {
+        return;
+    }
+    // an action installed after ours chains to it, it stays in place then
+    struct sigaction current {};
+    if (sigaction(SIGBUS, nullptr, &current) == 0 && (current.sa_flags & SA_SIGINFO) != 0 &&
+        current.sa_sigaction == OnBusError && sigaction(SIGBUS, &g_oldBusAction, nullptr) == 0) {
+        g_busHandlerInstalled = false;
+        MEDIA_LOG_I("SIGBUS handler restored");
+    }
+}
+
+// out of line, so that the copy can not be moved out of the guarded window
+__attribute__((noinline)) bool GuardedCopy(uint8_t* dest, const uint8_t* src, size_t length)
+{
+    return memcpy_s(dest, length, src, length) == EOK;
+}
+
+// the pages of a file truncated behind the check raise SIGBUS when touched, the copy gives up instead of crashing
+bool CopyFromMapping(uint8_t* dest, const uint8_t* src, size_t length)
+{
+    sigjmp_buf env;
+    if (sigsetjmp(env, 1) != 0) {
+        g_copyGuard = nullptr;
+        return false;
+    }
+    g_copyGuard = &env;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    bool ret = GuardedCopy(dest, src, length);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    g_copyGuard = nullptr;
+    return ret;
+}
+
+void Advise(uint8_t* mapping, uint8_t* addr, size_t length, int advice)
+{
+    // madvise() needs a page aligned address
+    auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    auto start = reinterpret_cast<uintptr_t>(addr) / pageSize * pageSize;
+    start = std::max(start, reinterpret_cast<uintptr_t>(mapping));
+    if (madvise(reinterpret_cast<void*>(start), reinterpret_cast<uintptr_t>(addr) + length - start, advice) != 0) {
+        MEDIA_LOG_D("madvise " PUBLIC_LOG_D32 " failed: " PUBLIC_LOG_S, advice, strerror(errno));
+    }
+}
+#else
+bool CopyFromMapping(uint8_t* dest, const uint8_t* src, size_t length)
+{
+    return memcpy_s(dest, length, src, length) == EOK;
+}
+#endif
+}
+
+MappedFileReader::~MappedFileReader()
+{
+    Close();
+}
+
+bool MappedFileReader::Open(int32_t fd, uint64_t offset, uint64_t size)
+{
+    Close();
+#ifdef WIN32
+    (void)fd;
+    (void)offset;
+    (void)size;
+    return false;
+#else
+    struct stat fileStat {};
+    if (fd < 0 || size == 0 || fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode) ||
+        offset + size > static_cast<uint64_t>(fileStat.st_size)) {
+        return false;
+    }
+    auto pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    uint64_t pageOffset = offset % pageSize;
+    if (size + pageOffset > SIZE_MAX) {
+        return false;
+    }
+    auto mapSize = static_cast<size_t>(size + pageOffset);
+    void* addr = mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fd,
+                      static_cast<off_t>(offset - pageOffset));
+    if (addr == MAP_FAILED) {
+        MEDIA_LOG_W("mmap " PUBLIC_LOG_ZU " bytes failed: " PUBLIC_LOG_S, mapSize, strerror(errno));
+        return false;
+    }
+    if (!AcquireBusHandler()) {
+        (void)munmap(addr, mapSize);
+        return false;
+    }
+    mapping_ = std::shared_ptr<uint8_t>(static_cast<uint8_t*>(addr), [mapSize](uint8_t* ptr) {
+        (void)munmap(ptr, mapSize);
+        ReleaseBusHandler();
+    });
+    data_ = mapping_.get() + pageOffset;
+    fd_ = fd;
+    offset_ = offset;
+    size_ = size;
+    windowStart_ = 0;
+    windowEnd_ = 0;
+    lastReadEnd_ = 0;
+    sequentialCount_ = 0;
+    sequential_ = false;
+    MEDIA_LOG_I("mapped " PUBLIC_LOG_U64 " bytes from " PUBLIC_LOG_U64, size_, offset_);
+    return true;
+#endif
+}
+
+void MappedFileReader::Close()
+{
+    mapping_.reset();
+    data_ = nullptr;
+    fd_ = -1;
+    size_ = 0;
+}
+
+Status MappedFileReader::Read(uint64_t position, std::shared_ptr<Buffer>& buffer, size_t expectedLen,
+                              const std::shared_ptr<Allocator>& allocator, size_t& readSize)
+{
+    readSize = 0;
+    FALSE_RETURN_V_MSG_E(IsMapped(), Status::ERROR_WRONG_STATE, "file is not mapped");
+    if (buffer == nullptr) {
+        buffer = std::make_shared<Buffer>();
+    }
+    if (position >= size_) {
+        if (buffer->IsEmpty()) {
+            buffer->WrapMemory(nullptr, 0, 0);
+        }
+        return Status::OK;
+    }
+    size_t length = static_cast<size_t>(std::min(static_cast<uint64_t>(expectedLen), size_ - position));
+    if (!buffer->IsEmpty()) {
+        length = std::min(length, buffer->GetMemory()->GetCapacity());
+    }
+    if (!Prefetch(position, length)) {
+        return Status::OK;
+    }
+    if (buffer->IsEmpty()) {
+        buffer->AllocMemory(allocator, length);
+    }
+    auto memory = buffer->GetMemory();
+    FALSE_RETURN_V_MSG_E(memory != nullptr, Status::ERROR_NO_MEMORY, "alloc " PUBLIC_LOG_ZU " bytes failed", length);
+    uint8_t* dest = memory->GetWritableAddr(length, 0);
+    FALSE_RETURN_V_MSG_E(dest != nullptr, Status::ERROR_NO_MEMORY, "buffer can not hold " PUBLIC_LOG_ZU " bytes",
+                         length);
+    if (!CopyFromMapping(dest, data_ + position, length)) {
+        MEDIA_LOG_W("file is truncated while reading, stop reading through the mapping");
+        memory->UpdateDataSize(0, 0);
+        Close();
+        return Status::OK;
+    }
+    readSize = length;
+    lastReadEnd_ = position + readSize;
+    return Status::OK;
+}
+
+// follow the access pattern and make sure the file still holds the range before the pages are touched
+bool MappedFileReader::Prefetch(uint64_t position, size_t length)
+{
+#ifndef WIN32
+    bool sequential = position == lastReadEnd_;
+    sequentialCount_ = sequential ? sequentialCount_ + 1 : 0;
+    if (!sequential && sequential_) {
+        sequential_ = false;
+        Advise(mapping_.get(), data_, static_cast<size_t>(size_), MADV_RANDOM);
+    } else if (sequentialCount_ >= SEQUENTIAL_READ_COUNT && !sequential_) {
+        sequential_ = true;
+        Advise(mapping_.get(), data_, static_cast<size_t>(size_), MADV_SEQUENTIAL);
+    }
+    uint64_t end = position + length;
+    if (position >= windowStart_ && end <= windowEnd_) {
+        return true;
+    }
+    uint64_t windowEnd = std::min(size_, std::max(end, position + WINDOW_SIZE));
+    if (!CheckFileSize(windowEnd)) {
+        return false;
+    }
+    if (sequential_) {
+        // random reads only fault in the pages they touch
+        Advise(mapping_.get(), data_ + position, static_cast<size_t>(windowEnd - position), MADV_WILLNEED);
+    }
+    windowStart_ = position;
+    windowEnd_ = windowEnd;
+#endif
+    return true;
+}
+
+bool MappedFileReader::CheckFileSize(uint64_t end)
+{
+    // touching a page beyond the end of a truncated file raises SIGBUS, the mapping is given up instead
+    struct stat fileStat {};
+    if (fstat(fd_, &fileStat) == 0 && static_cast<uint64_t>(fileStat.st_size) >= offset_ + end) {
+        return true;
+    }
+    MEDIA_LOG_W("file is truncated, stop reading through the mapping");
+    Close();
+    return false;
+}
+} // namespace Plugin
+} // namespace Media
+} // namespace OHOS
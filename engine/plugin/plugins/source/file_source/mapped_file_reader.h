@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISTREAMER_MAPPED_FILE_READER_H
+#define HISTREAMER_MAPPED_FILE_READER_H
+
+#include <cstdint>
+#include <memory>
+#include "plugin/common/plugin_buffer.h"
+#include "plugin/common/plugin_types.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+/**
+ * Reads a range of a regular file through a read only memory mapping, the data is copied out of the mapped pages
+ * and no buffer refers to the mapping. The read ahead of the kernel is driven by the access pattern: sequential
+ * reads are prefetched, random reads are not.
+ * The file size is checked again before serving each new prefetch window, and the copy is guarded against the
+ * SIGBUS of a file truncated in between. Either way the mapping is dropped and the caller has to read the rest
+ * from the file descriptor. The SIGBUS handler is installed while any file is mapped and passes the signals it
+ * does not expect on to the action installed before it.
+ */
+class MappedFileReader {
+public:
+    MappedFileReader() = default;
+    ~MappedFileReader();
+
+    /**
+     * Map size bytes of fd from offset. Only regular files are mapped, the fd has to stay open while mapped.
+     *
+     * @return whether the range is mapped, the caller falls back to read() otherwise
+     */
+    bool Open(int32_t fd, uint64_t offset, uint64_t size);
+
+    void Close();
+
+    bool IsMapped() const
+    {
+        return data_ != nullptr;
+    }
+
+    /**
+     * Read at position of the mapped range, readSize is 0 at the end of the range. An empty buffer gets its memory
+     * from allocator.
+     */
+    Status Read(uint64_t position, std::shared_ptr<Buffer>& buffer, size_t expectedLen,
+                const std::shared_ptr<Allocator>& allocator, size_t& readSize);
+
+private:
+    bool Prefetch(uint64_t position, size_t length);
+    bool CheckFileSize(uint64_t end);
+
+    int32_t fd_ {-1};
+    uint64_t offset_ {0};
+    uint64_t size_ {0};
+    std::shared_ptr<uint8_t> mapping_ {nullptr};
+    uint8_t* data_ {nullptr};
+    uint64_t windowStart_ {0};
+    uint64_t windowEnd_ {0};
+    uint64_t lastReadEnd_ {0};
+    uint32_t sequentialCount_ {0};
+    bool sequential_ {false};
+};
+} // namespace Plugin
+} // namespace Media
+} // namespace OHOS
+#endif // HISTREAMER_MAPPED_FILE_READER_H
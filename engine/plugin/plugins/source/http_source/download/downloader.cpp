@@ -89,6 +89,17 @@ void DownloadRequest::Close()
     headerInfo_.isClosed = true;
 }
 
+void DownloadRequest::SetRangePos(int64_t startPos, int64_t endPos)
+{
+    startPos_ = startPos;
+    endPos_ = endPos;
+}
+
+void DownloadRequest::SetDownloadDoneCallback(DownloadDoneFunc downloadDone)
+{
+    downloadDone_ = std::move(downloadDone);
+}
+
 void DownloadRequest::WaitHeaderUpdated() const
 {
     size_t times = 0;
@@ -230,8 +241,13 @@ bool Downloader::BeginDownload()
 
     client_->Open(url);
 
-    currentRequest_->requestSize_ = 1;
-    currentRequest_->startPos_ = 0;
+    if (currentRequest_->endPos_ >= 0) {
+        int64_t rangeSize = currentRequest_->endPos_ - currentRequest_->startPos_ + 1;
+        currentRequest_->requestSize_ = static_cast<int>(std::min(rangeSize, static_cast<int64_t>(PER_REQUEST_SIZE)));
+    } else {
+        currentRequest_->requestSize_ = 1;
+        currentRequest_->startPos_ = 0;
+    }
     currentRequest_->isEos_ = false;
     currentRequest_->retryTimes_ = 0;
 
@@ -256,7 +272,7 @@ void Downloader::HttpDownloadLoop()
     NetworkClientErrorCode clientCode = NetworkClientErrorCode::ERROR_OK;
     NetworkServerErrorCode serverCode = 0;
     long startPos = currentRequest_->startPos_;
-    if (currentRequest_->requestWholeFile_) {
+    if (currentRequest_->requestWholeFile_ && startPos == 0) { // a retry goes on from the data already saved
         startPos = -1;
     }
     Status ret = client_->RequestData(startPos, currentRequest_->requestSize_,
@@ -281,23 +297,23 @@ void Downloader::HandleRetOK()
     }
     int64_t remaining = static_cast<int64_t>(currentRequest_->headerInfo_.fileContentLen) -
         currentRequest_->startPos_;
+    if (currentRequest_->endPos_ >= 0) { // a byte range ends before the url does
+        remaining = std::min(remaining, currentRequest_->endPos_ + 1 - currentRequest_->startPos_);
+        if (remaining <= 0) {
+            MEDIA_LOG_I("http range reach end, endPos_ " PUBLIC_LOG_D64 " url: " PUBLIC_LOG_S,
+                currentRequest_->endPos_, currentRequest_->url_.c_str());
+            EndRequest(false);
+            return;
+        }
+    }
     if (currentRequest_->headerInfo_.fileContentLen > 0 && remaining <= 0) { // 检查是否播放结束
         MEDIA_LOG_I("http transfer reach end, startPos_ " PUBLIC_LOG_D64 " url: " PUBLIC_LOG_S,
             currentRequest_->startPos_, currentRequest_->url_.c_str());
-        currentRequest_->isEos_ = true;
-        if (requestQue_->Empty()) {
-            task_->PauseAsync();
-        }
-        shouldStartNextRequest = true;
+        EndRequest(false);
         return;
     }
     if (currentRequest_->headerInfo_.fileContentLen == 0 && remaining <= 0) {
-        currentRequest_->isEos_ = true;
-        currentRequest_->Close();
-        if (requestQue_->Empty()) {
-            task_->PauseAsync();
-        }
-        shouldStartNextRequest = true;
+        EndRequest(true);
         return;
     }
     if (remaining < PER_REQUEST_SIZE) {
@@ -307,6 +323,22 @@ void Downloader::HandleRetOK()
     }
 }
 
+void Downloader::EndRequest(bool closeRequest)
+{
+    currentRequest_->isEos_ = true;
+    if (closeRequest) {
+        currentRequest_->Close();
+    }
+    // a response without Content-Length ends here as well
+    if (currentRequest_->downloadDone_) {
+        currentRequest_->downloadDone_();
+    }
+    if (requestQue_->Empty()) {
+        task_->PauseAsync();
+    }
+    shouldStartNextRequest = true;
+}
+
 size_t Downloader::RxBodyData(void* buffer, size_t size, size_t nitems, void* userParam)
 {
     auto mediaDownloader = static_cast<Downloader *>(userParam);
@@ -392,10 +424,11 @@ size_t Downloader::RxHeaderData(void* buffer, size_t size, size_t nitems, void*
         char* token = strtok_s(nullptr, ":", &next);
         FALSE_RETURN_V(token != nullptr, size * nitems);
         char* strRange = StringTrim(token);
-        size_t start;
-        size_t end;
-        size_t fileLen;
-        FALSE_LOG_MSG(sscanf_s(strRange, "bytes %uld-%uld/%uld", &start, &end, &fileLen) != -1,
+        size_t start = 0;
+        size_t end = 0;
+        size_t fileLen = 0;
+        // the file length after the range is what a retry from the middle of the file needs
+        FALSE_LOG_MSG(sscanf_s(strRange, "bytes %zu-%zu/%zu", &start, &end, &fileLen) == 3, // 3: all fields
             "sscanf get range failed");
         if (info->fileContentLen > 0 && info->fileContentLen != fileLen) {
             MEDIA_LOG_E("FileContentLen doesn't equal to fileLen");
@@ -60,6 +60,8 @@ struct HeaderInfo {
 // uint8_t* : the data should save
 // uint32_t : length
 using DataSaveFunc = std::function<bool(uint8_t*, uint32_t)>;
+// called on the download thread once the last byte of a request was saved
+using DownloadDoneFunc = std::function<void()>;
 class Downloader;
 class DownloadRequest;
 using StatusCallbackFunc = std::function<void(DownloadStatus, std::shared_ptr<Downloader>&,
@@ -86,6 +88,9 @@ public:
     }
     bool IsClosed() const;
     void Close();
+    // download only [startPos, endPos] of the url, endPos included
+    void SetRangePos(int64_t startPos, int64_t endPos);
+    void SetDownloadDoneCallback(DownloadDoneFunc downloadDone);
 
 private:
     void WaitHeaderUpdated() const;
@@ -93,12 +98,14 @@ private:
     std::string url_;
     DataSaveFunc saveData_;
     StatusCallbackFunc statusCallback_;
+    DownloadDoneFunc downloadDone_;
 
     HeaderInfo headerInfo_;
 
     bool isHeaderUpdated {false};
     bool isEos_ {false}; // file download finished
-    int64_t startPos_;
+    int64_t startPos_ {0};
+    int64_t endPos_ {-1}; // -1: up to the end of the url
     bool isDownloading_;
     bool requestWholeFile_ {false};
     int requestSize_;
@@ -123,6 +130,7 @@ public:
     bool Retry(const std::shared_ptr<DownloadRequest>& request);
 private:
     bool BeginDownload();
+    void EndRequest(bool closeRequest);
 
     void HttpDownloadLoop();
     void HandleRetOK();
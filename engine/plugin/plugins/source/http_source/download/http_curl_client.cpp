@@ -16,6 +16,8 @@
 
 #include "http_curl_client.h"
 #include <algorithm>
+#include <chrono>
+#include <list>
 #include <regex>
 #include <vector>
 #include "foundation/log.h"
@@ -31,6 +33,142 @@ namespace OHOS {
 namespace Media {
 namespace Plugin {
 namespace HttpPlugin {
+namespace {
+constexpr size_t MAX_IDLE_HANDLES = 4; // 4: idle easy handles kept for all hosts
+constexpr size_t MAX_IDLE_HANDLES_PER_HOST = 2; // 2: a media download and its key or playlist requests
+constexpr int64_t IDLE_HANDLE_MAX_AGE_S = 120; // 120s, same as the keep alive header
+
+// Dns results and tls sessions shared by the easy handles of all clients, another client of the same host skips
+// the lookup and resumes the tls session. Connections cannot be shared between easy handles that run on
+// different threads, so each easy handle keeps its own connection cache. The handle of a client that is done
+// is kept a while, the next client of the same host takes it over together with its warm connections.
+class CurlShare {
+public:
+    static CurlShare& Instance()
+    {
+        static CurlShare instance;
+        return instance;
+    }
+
+    CURLSH* Get() const
+    {
+        return share_;
+    }
+
+    // an idle easy handle of the host, or a new one
+    CURL* TakeHandle(const std::string& host)
+    {
+        {
+            OSAL::ScopedLock lock(poolMutex_);
+            DropExpiredHandles();
+            for (auto it = idleHandles_.begin(); it != idleHandles_.end(); ++it) {
+                if (it->host == host) {
+                    CURL* handle = it->handle;
+                    idleHandles_.erase(it);
+                    return handle;
+                }
+            }
+        }
+        return curl_easy_init();
+    }
+
+    void GiveBackHandle(const std::string& host, CURL* handle)
+    {
+        // the options point into the client that is going away
+        curl_easy_reset(handle);
+        std::vector<CURL*> dropped;
+        {
+            OSAL::ScopedLock lock(poolMutex_);
+            DropExpiredHandles();
+            idleHandles_.push_front({host, handle, std::chrono::steady_clock::now()});
+            size_t kept = 0;
+            size_t sameHost = 0;
+            for (auto it = idleHandles_.begin(); it != idleHandles_.end();) {
+                if (kept >= MAX_IDLE_HANDLES || (it->host == host && ++sameHost > MAX_IDLE_HANDLES_PER_HOST)) {
+                    dropped.push_back(it->handle);
+                    it = idleHandles_.erase(it);
+                } else {
+                    ++kept;
+                    ++it;
+                }
+            }
+        }
+        for (CURL* idle : dropped) {
+            curl_easy_cleanup(idle);
+        }
+    }
+
+private:
+    struct IdleHandle {
+        std::string host;
+        CURL* handle;
+        std::chrono::steady_clock::time_point since;
+    };
+
+    CurlShare()
+    {
+        // own reference, the Deinit of the last client must not clean up curl under the shared cache
+        FALSE_RETURN(curl_global_init(CURL_GLOBAL_ALL) == CURLE_OK);
+        share_ = curl_share_init();
+        FALSE_RETURN(share_ != nullptr);
+        curl_share_setopt(share_, CURLSHOPT_LOCKFUNC, &CurlShare::Lock);
+        curl_share_setopt(share_, CURLSHOPT_UNLOCKFUNC, &CurlShare::Unlock);
+        curl_share_setopt(share_, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
+
+    ~CurlShare()
+    {
+        for (auto& idle : idleHandles_) {
+            curl_easy_cleanup(idle.handle);
+        }
+        idleHandles_.clear();
+        if (share_ != nullptr && curl_share_cleanup(share_) == CURLSHE_OK) {
+            curl_global_cleanup();
+        }
+    }
+
+    static void Lock(CURL* handle, curl_lock_data data, curl_lock_access access, void* userParam)
+    {
+        (void)handle;
+        (void)access;
+        static_cast<CurlShare*>(userParam)->mutex_[data].Lock();
+    }
+
+    static void Unlock(CURL* handle, curl_lock_data data, void* userParam)
+    {
+        (void)handle;
+        static_cast<CurlShare*>(userParam)->mutex_[data].Unlock();
+    }
+
+    // the servers have closed the connections of older handles anyway
+    void DropExpiredHandles()
+    {
+        auto now = std::chrono::steady_clock::now();
+        while (!idleHandles_.empty() &&
+            now - idleHandles_.back().since >= std::chrono::seconds(IDLE_HANDLE_MAX_AGE_S)) {
+            curl_easy_cleanup(idleHandles_.back().handle);
+            idleHandles_.pop_back();
+        }
+    }
+
+    CURLSH* share_ {nullptr};
+    OSAL::Mutex mutex_[CURL_LOCK_DATA_LAST];
+    OSAL::Mutex poolMutex_;
+    std::list<IdleHandle> idleHandles_; // most recently given back first
+};
+
+// scheme, host and port of the url, the connections of an easy handle are only reused for the same ones
+std::string GetOrigin(const std::string& url)
+{
+    size_t hostStart = url.find("://");
+    hostStart = hostStart == std::string::npos ? 0 : hostStart + 3; // 3: "://"
+    size_t hostEnd = url.find_first_of("/?#", hostStart);
+    return url.substr(0, hostEnd);
+}
+}
+
 HttpCurlClient::HttpCurlClient(RxHeader headCallback, RxBody bodyCallback, void *userParam)
     : rxHeader_(headCallback), rxBody_(bodyCallback), userParam_(userParam)
 {
@@ -40,18 +178,38 @@ HttpCurlClient::HttpCurlClient(RxHeader headCallback, RxBody bodyCallback, void
 HttpCurlClient::~HttpCurlClient()
 {
     MEDIA_LOG_I("~HttpCurlClient dtor");
+    ReleaseHandle();
+    if (headers_ != nullptr) {
+        curl_slist_free_all(headers_);
+        headers_ = nullptr;
+    }
 }
 
 Status HttpCurlClient::Init()
 {
     FALSE_LOG(curl_global_init(CURL_GLOBAL_ALL) == CURLE_OK);
+    if (headers_ == nullptr) {
+        headers_ = curl_slist_append(headers_, "Connection: Keep-alive");
+        headers_ = curl_slist_append(headers_, "Keep-Alive: timeout=120");
+    }
     return Status::OK;
 }
 
+// Opening a new url of the same host keeps the easy handle, curl_easy_reset leaves its connections and caches
+// alive. Another host gets an idle handle of that host if there is one.
 Status HttpCurlClient::Open(const std::string& url)
 {
-    easyHandle_ = curl_easy_init();
-    FALSE_RETURN_V(easyHandle_ != nullptr, Status::ERROR_NULL_POINTER);
+    OSAL::ScopedLock lock(mutex_);
+    std::string host = GetOrigin(url);
+    if (easyHandle_ != nullptr && host != handleHost_) {
+        ReleaseHandle();
+    }
+    if (easyHandle_ == nullptr) {
+        easyHandle_ = CurlShare::Instance().TakeHandle(host);
+        FALSE_RETURN_V(easyHandle_ != nullptr, Status::ERROR_NULL_POINTER);
+        handleHost_ = host;
+    }
+    curl_easy_reset(easyHandle_);
     InitCurlEnvironment(url);
     return Status::OK;
 }
@@ -60,24 +218,27 @@ Status HttpCurlClient::Close()
 {
     OSAL::ScopedLock lock(mutex_);
     MEDIA_LOG_I("Close client");
-    curl_easy_setopt(easyHandle_, CURLOPT_TIMEOUT, 1);
-    if (easyHandle_) {
-        curl_easy_cleanup(easyHandle_);
-        easyHandle_ = nullptr;
-    }
+    // the easy handle and its connections stay for the next Open(), Deinit() releases them
     return Status::OK;
 }
 
 Status HttpCurlClient::Deinit()
 {
-    if (easyHandle_) {
-        curl_easy_cleanup(easyHandle_);
-        easyHandle_ = nullptr;
-    }
+    OSAL::ScopedLock lock(mutex_);
+    ReleaseHandle();
     curl_global_cleanup();
     return Status::OK;
 }
 
+void HttpCurlClient::ReleaseHandle()
+{
+    if (easyHandle_ != nullptr) {
+        CurlShare::Instance().GiveBackHandle(handleHost_, easyHandle_);
+        easyHandle_ = nullptr;
+        handleHost_.clear();
+    }
+}
+
 void HttpCurlClient::InitCurlEnvironment(const std::string& url)
 {
     curl_easy_setopt(easyHandle_, CURLOPT_URL, UrlParse(url).c_str());
@@ -102,6 +263,14 @@ void HttpCurlClient::InitCurlEnvironment(const std::string& url)
 
     curl_easy_setopt(easyHandle_, CURLOPT_TCP_KEEPALIVE, 1L);
     curl_easy_setopt(easyHandle_, CURLOPT_TCP_KEEPINTVL, 5L); // 5 心跳
+
+    curl_easy_setopt(easyHandle_, CURLOPT_HTTPHEADER, headers_);
+    CURLSH* share = CurlShare::Instance().Get();
+    if (share != nullptr) {
+        curl_easy_setopt(easyHandle_, CURLOPT_SHARE, share);
+    }
+    curl_easy_setopt(easyHandle_, CURLOPT_DNS_CACHE_TIMEOUT, 300L); // 300s, the shared dns results
+    curl_easy_setopt(easyHandle_, CURLOPT_MAXAGE_CONN, 120L); // 120s, same as the keep alive header
 }
 
 std::string HttpCurlClient::UrlParse(const std::string& url)
@@ -131,18 +300,11 @@ Status HttpCurlClient::RequestData(long startPos, int len, NetworkServerErrorCod
         MEDIA_LOG_DD("RequestData: requestRange " PUBLIC_LOG_S, requestRange);
         curl_easy_setopt(easyHandle_, CURLOPT_RANGE, requestRange);
     }
-    curl_slist *headers {nullptr};
-    headers = curl_slist_append(headers, "Connection: Keep-alive");
-    headers = curl_slist_append(headers, "Keep-Alive: timeout=120");
-    curl_easy_setopt(easyHandle_, CURLOPT_HTTPHEADER, headers);
-    
+
     MEDIA_LOG_D("RequestData: startPos " PUBLIC_LOG_D32 ", len " PUBLIC_LOG_D32, static_cast<int>(startPos), len);
     OSAL::ScopedLock lock(mutex_);
     FALSE_RETURN_V(easyHandle_ != nullptr, Status::ERROR_NULL_POINTER);
     CURLcode returnCode = curl_easy_perform(easyHandle_);
-    if (headers != nullptr) {
-        curl_slist_free_all(headers);
-    }
     clientCode = NetworkClientErrorCode::ERROR_OK;
     serverCode = 0;
     if (returnCode != CURLE_OK) {
@@ -43,12 +43,16 @@ public:
     Status Deinit() override;
 private:
     void InitCurlEnvironment(const std::string& url);
+    // the easy handle and its connections go to the idle handles of its host
+    void ReleaseHandle();
     static std::string UrlParse(const std::string& url);
 private:
     RxHeader rxHeader_;
     RxBody rxBody_;
     void *userParam_;
     CURL* easyHandle_ {nullptr};
+    std::string handleHost_;
+    curl_slist* headers_ {nullptr};
     mutable OSAL::Mutex mutex_;
 };
 }
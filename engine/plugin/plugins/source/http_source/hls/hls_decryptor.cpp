@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define HST_LOG_TAG "HlsDecryptor"
+
+#include <algorithm>
+#include "hls_decryptor.h"
+#include "openssl/evp.h"
+#include "foundation/log.h"
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+namespace HttpPlugin {
+HlsDecryptor::HlsDecryptor() noexcept
+{
+    ctx_ = EVP_CIPHER_CTX_new();
+}
+
+HlsDecryptor::~HlsDecryptor()
+{
+    if (ctx_ != nullptr) {
+        EVP_CIPHER_CTX_free(ctx_);
+        ctx_ = nullptr;
+    }
+}
+
+bool HlsDecryptor::Init(const uint8_t* key, const uint8_t* iv)
+{
+    FALSE_RETURN_V_MSG_E(ctx_ != nullptr, false, "cipher context is null");
+    // the EVP implementation picks AES-NI or the ARMv8 crypto extensions when the cpu has them
+    FALSE_RETURN_V_MSG_E(EVP_DecryptInit_ex(ctx_, EVP_aes_128_cbc(), nullptr, key, iv) == 1, false,
+        "init AES-128-CBC failed");
+    return true;
+}
+
+bool HlsDecryptor::Update(const uint8_t* data, uint32_t len, const DataSaveFunc& save)
+{
+    FALSE_RETURN_V(ctx_ != nullptr, false);
+    if (len == 0) {
+        return true;
+    }
+    // the downloader starts again at accepted_, the front of data may have gone through the cipher already
+    uint64_t skip = std::min<uint64_t>(decrypted_ - accepted_, len);
+    uint32_t newLen = len - static_cast<uint32_t>(skip);
+    if (newLen > 0) {
+        FALSE_RETURN_V_MSG_E(!finished_, false, "data after the final block");
+        // a block held back from the last call can come out in front of this data
+        size_t pendingSize = pending_.size();
+        pending_.resize(pendingSize + newLen + HLS_AES_BLOCK_SIZE);
+        int outLen = 0;
+        if (EVP_DecryptUpdate(ctx_, pending_.data() + pendingSize, &outLen, data + skip,
+            static_cast<int>(newLen)) != 1) {
+            pending_.resize(pendingSize);
+            MEDIA_LOG_E("decrypt failed");
+            return false;
+        }
+        pending_.resize(pendingSize + static_cast<size_t>(outLen));
+        decrypted_ += newLen;
+    }
+    FALSE_RETURN_V(Save(save), false);
+    accepted_ += len;
+    return true;
+}
+
+bool HlsDecryptor::Finish(const DataSaveFunc& save)
+{
+    FALSE_RETURN_V(ctx_ != nullptr, false);
+    if (!finished_) { // a refused final block is offered again, the cipher is done with it
+        size_t pendingSize = pending_.size();
+        pending_.resize(pendingSize + HLS_AES_BLOCK_SIZE);
+        int outLen = 0;
+        if (EVP_DecryptFinal_ex(ctx_, pending_.data() + pendingSize, &outLen) != 1) {
+            pending_.resize(pendingSize);
+            MEDIA_LOG_E("decrypt final block failed, the segment is cut or the key is wrong");
+            return false;
+        }
+        pending_.resize(pendingSize + static_cast<size_t>(outLen));
+        finished_ = true;
+    }
+    return Save(save);
+}
+
+bool HlsDecryptor::Save(const DataSaveFunc& save)
+{
+    if (pending_.empty()) {
+        return true;
+    }
+    if (!save(pending_.data(), static_cast<uint32_t>(pending_.size()))) {
+        return false;
+    }
+    pending_.clear();
+    return true;
+}
+}
+}
+}
+}
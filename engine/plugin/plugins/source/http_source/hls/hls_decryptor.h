@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISTREAMER_HLS_DECRYPTOR_H
+#define HISTREAMER_HLS_DECRYPTOR_H
+
+#include <cstdint>
+#include <vector>
+#include "plugin/plugins/source/http_source/download/downloader.h"
+
+struct evp_cipher_ctx_st;
+
+namespace OHOS {
+namespace Media {
+namespace Plugin {
+namespace HttpPlugin {
+constexpr size_t HLS_AES_KEY_SIZE = 16; // 16: AES-128 key and iv
+constexpr size_t HLS_AES_BLOCK_SIZE = 16; // 16: AES block
+
+// AES-128-CBC with PKCS7 padding of one segment, as EXT-X-KEY METHOD=AES-128 describes it.
+// The segment can be fed in pieces of any size, the plain data of the whole blocks in them is passed on right away.
+// When save refuses the plain data, the downloader asks for the same cipher bytes again from the end of the data
+// it last accepted. Those bytes were fed to the cipher already, so they are skipped and the kept plain data is
+// offered again instead, the CBC chain never sees a block twice.
+class HlsDecryptor {
+public:
+    HlsDecryptor() noexcept;
+    ~HlsDecryptor();
+    HlsDecryptor(const HlsDecryptor&) = delete;
+    HlsDecryptor& operator=(const HlsDecryptor&) = delete;
+
+    bool Init(const uint8_t* key, const uint8_t* iv);
+    // the last block is held back, only Finish() knows it is the one with the padding
+    bool Update(const uint8_t* data, uint32_t len, const DataSaveFunc& save);
+    bool Finish(const DataSaveFunc& save);
+
+private:
+    bool Save(const DataSaveFunc& save);
+
+    evp_cipher_ctx_st* ctx_ {nullptr};
+    uint64_t accepted_ {0}; // cipher bytes whose plain data save took
+    uint64_t decrypted_ {0}; // cipher bytes fed to the cipher
+    bool finished_ {false};
+    std::vector<uint8_t> pending_; // plain data save has not taken yet
+};
+}
+}
+}
+}
+#endif
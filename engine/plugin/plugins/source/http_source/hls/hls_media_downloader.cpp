@@ -16,6 +16,7 @@
 
 #include "hls_media_downloader.h"
 #include "hls_playlist_downloader.h"
+#include "plugin/plugins/source/http_source/download/http_curl_client.h"
 #include "securec.h"
 
 namespace OHOS {
@@ -24,6 +25,13 @@ namespace Plugin {
 namespace HttpPlugin {
 namespace {
 constexpr int RING_BUFFER_SIZE = 5 * 48 * 1024;
+constexpr size_t MAX_CACHED_KEYS = 16; // 16: live streams rotate keys, older ones are not used again
+
+// fragments of a single file playlist share the url, they differ in the byte range
+std::string RangeKey(const std::string& url, int64_t offset, int64_t length)
+{
+    return offset < 0 ? url : url + "@" + std::to_string(offset) + "-" + std::to_string(length);
+}
 }
 
 // Description:
@@ -38,7 +46,7 @@ HlsMediaDownloader::HlsMediaDownloader() noexcept
     downloadTask_ = std::make_shared<OSAL::Task>(std::string("FragmentDownload"));
     downloadTask_->RegisterHandler([this] { FragmentDownloadLoop(); });
 
-    playList_ = std::make_shared<BlockingQueue<std::string>>("PlayList", 50); // 50
+    playList_ = std::make_shared<BlockingQueue<PlayInfo>>("PlayList", 50); // 50
 
     dataSave_ =  [this] (uint8_t*&& data, uint32_t&& len) {
         return SaveData(std::forward<decltype(data)>(data), std::forward<decltype(len)>(len));
@@ -50,24 +58,124 @@ HlsMediaDownloader::HlsMediaDownloader() noexcept
 
 void HlsMediaDownloader::FragmentDownloadLoop()
 {
-    std::string url = playList_->Pop();
-    if (url.empty()) { // when monitor pause, playList_ set active false, it's empty
+    PlayInfo playInfo = playList_->Pop();
+    if (playInfo.url.empty()) { // when monitor pause, playList_ set active false, it's empty
         OSAL::SleepFor(10); // 10
         return;
     }
-    if (!fragmentDownloadStart[url]) {
-        fragmentDownloadStart[url] = true;
-        auto realStatusCallback = [this] (DownloadStatus&& status, std::shared_ptr<Downloader>& downloader,
-                                          std::shared_ptr<DownloadRequest>& request) {
-            statusCallback_(status, downloader_, std::forward<decltype(request)>(request));
-        };
-        // TO DO: If the fragment file is too large, should not requestWholeFile.
-        downloadRequest_ = std::make_shared<DownloadRequest>(url, dataSave_, realStatusCallback, true);
-        downloader_->Download(downloadRequest_, -1); // -1
+    std::string key = RangeKey(playInfo.url, playInfo.offset, playInfo.length);
+    if (!fragmentDownloadStart[key]) {
+        std::shared_ptr<HlsDecryptor> decryptor;
+        if (!playInfo.keyUrl.empty()) {
+            decryptor = CreateDecryptor(playInfo);
+            if (decryptor == nullptr) { // not marked as started, the next play list update tries again
+                MEDIA_LOG_E("no key for fragment " PUBLIC_LOG_S, key.c_str());
+                return;
+            }
+        }
+        fragmentDownloadStart[key] = true;
+        if (!playInfo.initUrl.empty()) {
+            std::string initKey = RangeKey(playInfo.initUrl, playInfo.initOffset, playInfo.initLength);
+            if (initKey != initSection_) {
+                MEDIA_LOG_I("initialization section changed " PUBLIC_LOG_S, initKey.c_str());
+                initSection_ = initKey;
+                DownloadRange(playInfo.initUrl, playInfo.initOffset, playInfo.initLength);
+            }
+        }
+        DownloadRange(playInfo.url, playInfo.offset, playInfo.length, decryptor);
         downloader_->Start();
     }
 }
 
+void HlsMediaDownloader::DownloadRange(const std::string& url, int64_t offset, int64_t length,
+                                       const std::shared_ptr<HlsDecryptor>& decryptor)
+{
+    auto realStatusCallback = [this] (DownloadStatus&& status, std::shared_ptr<Downloader>& downloader,
+                                      std::shared_ptr<DownloadRequest>& request) {
+        statusCallback_(status, downloader_, std::forward<decltype(request)>(request));
+    };
+    // TO DO: If the fragment file is too large, should not requestWholeFile.
+    bool requestWholeFile = offset < 0 || length <= 0;
+    DataSaveFunc saveData = dataSave_;
+    if (decryptor != nullptr) {
+        // decrypted as the data comes in, the ring buffer never holds cipher text
+        saveData = [this, decryptor] (uint8_t* data, uint32_t len) {
+            return decryptor->Update(data, len, dataSave_);
+        };
+    }
+    downloadRequest_ = std::make_shared<DownloadRequest>(url, saveData, realStatusCallback, requestWholeFile);
+    if (!requestWholeFile) {
+        downloadRequest_->SetRangePos(offset, offset + length - 1);
+    }
+    if (decryptor != nullptr) {
+        downloadRequest_->SetDownloadDoneCallback([this, decryptor, url] {
+            if (decryptor->Finish(dataSave_)) {
+                return;
+            }
+            // a cut segment or a wrong key, the plain data of the last block is lost
+            MEDIA_LOG_E("decrypt fragment " PUBLIC_LOG_S " failed", url.c_str());
+            if (callback_ != nullptr) {
+                callback_->OnEvent({PluginEventType::CLIENT_ERROR, {NetworkClientErrorCode::ERROR_NOT_RETRY}, "hls"});
+            }
+        });
+    }
+    downloader_->Download(downloadRequest_, -1); // -1
+}
+
+std::shared_ptr<HlsDecryptor> HlsMediaDownloader::CreateDecryptor(const PlayInfo& playInfo)
+{
+    auto it = keys_.find(playInfo.keyUrl);
+    if (it == keys_.end()) {
+        std::string key;
+        FALSE_RETURN_V(DownloadKey(playInfo.keyUrl, key), nullptr);
+        if (keys_.size() >= MAX_CACHED_KEYS) {
+            keys_.clear();
+        }
+        it = keys_.emplace(playInfo.keyUrl, key).first;
+    }
+    auto decryptor = std::make_shared<HlsDecryptor>();
+    FALSE_RETURN_V(decryptor->Init(reinterpret_cast<const uint8_t*>(it->second.data()), playInfo.iv), nullptr);
+    return decryptor;
+}
+
+bool HlsMediaDownloader::DownloadKey(const std::string& url, std::string& key)
+{
+    if (keyClient_ == nullptr) {
+        keyClient_ = std::make_shared<HttpCurlClient>(&RxKeyHeader, &RxKeyBody, this);
+        keyClient_->Init();
+    }
+    keyData_.clear();
+    NetworkServerErrorCode serverCode = 0;
+    NetworkClientErrorCode clientCode = NetworkClientErrorCode::ERROR_OK;
+    FALSE_RETURN_V_MSG_E(keyClient_->Open(url) == Status::OK, false, "open key " PUBLIC_LOG_S " failed", url.c_str());
+    Status ret = keyClient_->RequestData(-1, 0, serverCode, clientCode); // -1: the whole key file
+    FALSE_RETURN_V_MSG_E(ret == Status::OK, false, "download key " PUBLIC_LOG_S " failed, server error "
+        PUBLIC_LOG_D32, url.c_str(), static_cast<int32_t>(serverCode));
+    FALSE_RETURN_V_MSG_E(keyData_.size() == HLS_AES_KEY_SIZE, false, "key " PUBLIC_LOG_S " has " PUBLIC_LOG_ZU
+        " bytes", url.c_str(), keyData_.size());
+    key = keyData_;
+    MEDIA_LOG_I("key " PUBLIC_LOG_S " downloaded", url.c_str());
+    return true;
+}
+
+size_t HlsMediaDownloader::RxKeyHeader(void* buffer, size_t size, size_t nitems, void* userParam)
+{
+    (void)buffer;
+    (void)userParam;
+    return size * nitems;
+}
+
+size_t HlsMediaDownloader::RxKeyBody(void* buffer, size_t size, size_t nitems, void* userParam)
+{
+    auto mediaDownloader = static_cast<HlsMediaDownloader*>(userParam);
+    size_t dataLen = size * nitems;
+    if (mediaDownloader->keyData_.size() + dataLen > HLS_AES_KEY_SIZE) {
+        return 0; // not a key, stop the transfer
+    }
+    mediaDownloader->keyData_.append(static_cast<char*>(buffer), dataLen);
+    return dataLen;
+}
+
 bool HlsMediaDownloader::Open(const std::string& url)
 {
     playListDownloader_->Open(url);
@@ -82,6 +190,10 @@ void HlsMediaDownloader::Close(bool isAsync)
     downloadTask_->Stop();
     playListDownloader_->Close();
     downloader_->Stop();
+    if (keyClient_ != nullptr) {
+        keyClient_->Deinit();
+        keyClient_ = nullptr;
+    }
 }
 
 void HlsMediaDownloader::Pause()
@@ -148,7 +260,7 @@ void HlsMediaDownloader::SetCallback(Callback* cb)
     callback_ = cb;
 }
 
-void HlsMediaDownloader::OnPlayListChanged(const std::vector<std::string>& playList)
+void HlsMediaDownloader::OnPlayListChanged(const std::vector<PlayInfo>& playList)
 {
     for (auto& fragment : playList) {
         playList_->Push(fragment);
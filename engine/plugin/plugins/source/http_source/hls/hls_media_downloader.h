@@ -17,6 +17,7 @@
 #define HISTREAMER_HLS_MEDIA_DOWNLOADER_H
 
 #include "playlist_downloader.h"
+#include "hls_decryptor.h"
 #include "foundation/utils/ring_buffer.h"
 #include "plugin/plugins/source/http_source/media_downloader.h"
 
@@ -39,13 +40,19 @@ public:
     double GetDuration() const override;
     Seekable GetSeekable() const override;
     void SetCallback(Callback* cb) override;
-    void OnPlayListChanged(const std::vector<std::string>& playList) override;
+    void OnPlayListChanged(const std::vector<PlayInfo>& playList) override;
     void SetStatusCallback(StatusCallbackFunc cb) override;
     bool GetStartedStatus() override;
 
 private:
     bool SaveData(uint8_t* data, uint32_t len);
     void FragmentDownloadLoop();
+    void DownloadRange(const std::string& url, int64_t offset, int64_t length,
+                       const std::shared_ptr<HlsDecryptor>& decryptor = nullptr);
+    std::shared_ptr<HlsDecryptor> CreateDecryptor(const PlayInfo& playInfo);
+    bool DownloadKey(const std::string& url, std::string& key);
+    static size_t RxKeyHeader(void* buffer, size_t size, size_t nitems, void* userParam);
+    static size_t RxKeyBody(void* buffer, size_t size, size_t nitems, void* userParam);
 
 private:
     std::shared_ptr<RingBuffer> buffer_;
@@ -60,8 +67,16 @@ private:
     std::shared_ptr<PlayListDownloader> playListDownloader_;
 
     std::shared_ptr<OSAL::Task> downloadTask_;
-    std::shared_ptr<BlockingQueue<std::string>> playList_;
+    std::shared_ptr<BlockingQueue<PlayInfo>> playList_;
     std::map<std::string, bool> fragmentDownloadStart;
+    // the initialization section last sent in front of a fragment, it is sent again only when it changes
+    std::string initSection_;
+    // keys are small and fetched on the fragment download thread before the fragment is queued. The key client has
+    // its own connections, it only reuses the dns results, tls sessions and idle handles of other clients.
+    std::shared_ptr<NetworkClient> keyClient_;
+    std::string keyData_;
+    // keys of this playlist by url, a fragment with a known key does not wait for a download
+    std::map<std::string, std::string> keys_;
 };
 }
 }
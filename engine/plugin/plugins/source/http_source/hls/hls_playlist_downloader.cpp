@@ -15,6 +15,7 @@
 #define HST_LOG_TAG "HlsPlayListDownloader"
 #include <mutex>
 #include "hls_playlist_downloader.h"
+#include "securec.h"
 
 namespace OHOS {
 namespace Media {
@@ -80,10 +81,23 @@ void HlsPlayListDownloader::ParseManifest()
     } else {
         currentVariant_->m3u8_->Update(playList_);
         auto files = currentVariant_->m3u8_->files_;
-        auto playList = std::vector<std::string>();
+        auto playList = std::vector<PlayInfo>();
         playList.reserve(files.size());
         for (auto &file: files) {
-            playList.push_back(file->uri_);
+            PlayInfo playInfo;
+            playInfo.url = file->uri_;
+            playInfo.offset = file->offset_;
+            playInfo.length = file->size_;
+            if (file->initFile_ != nullptr) {
+                playInfo.initUrl = file->initFile_->uri;
+                playInfo.initOffset = file->initFile_->offset;
+                playInfo.initLength = file->initFile_->size;
+            }
+            if (!file->key_.empty()) {
+                playInfo.keyUrl = file->key_;
+                (void)memcpy_s(playInfo.iv, sizeof(playInfo.iv), file->iv_, sizeof(file->iv_));
+            }
+            playList.push_back(playInfo);
         }
         callback_->OnPlayListChanged(playList);
     }   
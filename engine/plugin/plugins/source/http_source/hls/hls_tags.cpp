@@ -338,13 +338,10 @@ static void ParseTag(std::list<std::shared_ptr<Tag>>& entriesList, std::shared_p
 {
     if (line.find("#EXT") != std::string::npos) { // tag
         line = line.substr(1);
-        std::string key;
-        std::string value;
-        auto keyValue = Split(line, ":");
-        key = keyValue[0];
-        if (keyValue.size() == 2) { // 2
-            value = keyValue[1];
-        }
+        // only the first colon ends the name, values like key uris have colons of their own
+        auto colon = line.find(':');
+        std::string key = line.substr(0, colon);
+        std::string value = colon == std::string::npos ? "" : line.substr(colon + 1);
         if (!key.empty()) {
             auto tag = TagFactory::CreateTagByName(key, value);
             if (tag) {
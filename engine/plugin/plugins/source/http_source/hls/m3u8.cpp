@@ -40,9 +40,19 @@ std::string UriJoin(std::string& baseUrl, const std::string& uri)
         return baseUrl.substr(0, pos + 1) + uri;
     }
 }
+
+// the iv of a fragment without IV attribute is its media sequence number as a 128 bit big endian integer
+void FillSequenceIv(int64_t sequence, uint8_t* iv, size_t size)
+{
+    auto value = static_cast<uint64_t>(sequence);
+    for (size_t i = 0; i < size; ++i) {
+        size_t shift = 8 * i; // 8: bits of a byte
+        iv[size - 1 - i] = shift < 64 ? static_cast<uint8_t>(value >> shift) : 0; // 64: bits of the sequence
+    }
+}
 }
 
-M3U8Fragment::M3U8Fragment(std::string uri, std::string title, double duration, int sequence, bool discont)
+M3U8Fragment::M3U8Fragment(std::string uri, std::string title, double duration, int64_t sequence, bool discont)
     : uri_(std::move(uri)), title_(std::move(title)), duration_(duration), sequence_(sequence), discont_(discont)
 {
 }
@@ -105,9 +115,10 @@ void M3U8::InitTagUpdatersMap()
     };
 
     tagUpdatersMap_[HlsTag::EXTXBYTERANGE] = [](std::shared_ptr<Tag> &tag, M3U8Info &info) {
-        std::ignore = tag;
-        std::ignore = info;
-        MEDIA_LOG_I("need to parse EXTXBYTERANGE");
+        const Attribute& value = std::static_pointer_cast<SingleValueTag>(tag)->GetValue();
+        auto range = value.GetByteRange();
+        info.size = static_cast<int64_t>(range.second);
+        info.offset = value.QuotedString().find('@') != std::string::npos ? static_cast<int64_t>(range.first) : -1;
     };
 
     tagUpdatersMap_[HlsTag::EXTXDISCONTINUITY] = [this](std::shared_ptr<Tag> &tag, M3U8Info &info) {
@@ -116,16 +127,58 @@ void M3U8::InitTagUpdatersMap()
         info.discontinuity = true;
     };
 
-    tagUpdatersMap_[HlsTag::EXTXKEY] = [](std::shared_ptr<Tag> &tag, M3U8Info &info) {
-        std::ignore = tag;
-        std::ignore = info;
-        MEDIA_LOG_I("need to parse EXTXKEY");
+    tagUpdatersMap_[HlsTag::EXTXKEY] = [this](std::shared_ptr<Tag> &tag, M3U8Info &info) {
+        auto item = std::static_pointer_cast<AttributesTag>(tag);
+        auto formatAttribute = item->GetAttributeByName("KEYFORMAT");
+        if (formatAttribute != nullptr && formatAttribute->QuotedString() != "identity") {
+            // keys of a DRM system come next to the identity one, they are not for us
+            MEDIA_LOG_I("ignore EXTXKEY KEYFORMAT " PUBLIC_LOG_S, formatAttribute->QuotedString().c_str());
+            return;
+        }
+        auto methodAttribute = item->GetAttributeByName("METHOD");
+        std::string method = methodAttribute != nullptr ? methodAttribute->QuotedString() : "NONE";
+        if (method == "NONE") {
+            info.key = nullptr;
+            return;
+        }
+        auto key = std::make_shared<M3U8Key>();
+        key->method = method;
+        auto uriAttribute = item->GetAttributeByName("URI");
+        if (uriAttribute != nullptr) {
+            key->uri = UriJoin(uri_, uriAttribute->QuotedString());
+        }
+        auto ivAttribute = item->GetAttributeByName("IV");
+        if (ivAttribute != nullptr) {
+            auto iv = ivAttribute->HexSequence();
+            if (iv.size() == sizeof(key->iv)) {
+                std::copy(iv.begin(), iv.end(), key->iv);
+                key->hasIv = true;
+            } else {
+                MEDIA_LOG_W("EXTXKEY IV of " PUBLIC_LOG_ZU " bytes, use the media sequence number", iv.size());
+            }
+        }
+        if (method != "AES-128" || key->uri.empty()) {
+            MEDIA_LOG_E("EXTXKEY METHOD " PUBLIC_LOG_S " is not supported, fragments stay encrypted", method.c_str());
+        }
+        info.key = key;
     };
 
-    tagUpdatersMap_[HlsTag::EXTXMAP] = [](std::shared_ptr<Tag> &tag, M3U8Info &info) {
-        std::ignore = tag;
-        std::ignore = info;
-        MEDIA_LOG_I("need to parse EXTXMAP");
+    tagUpdatersMap_[HlsTag::EXTXMAP] = [this](std::shared_ptr<Tag> &tag, M3U8Info &info) {
+        auto item = std::static_pointer_cast<AttributesTag>(tag);
+        auto uriAttribute = item->GetAttributeByName("URI");
+        if (uriAttribute == nullptr) {
+            MEDIA_LOG_W("EXTXMAP without URI");
+            return;
+        }
+        auto initFile = std::make_shared<M3U8InitFile>();
+        initFile->uri = UriJoin(uri_, uriAttribute->QuotedString());
+        auto rangeAttribute = item->GetAttributeByName("BYTERANGE");
+        if (rangeAttribute != nullptr) {
+            auto range = rangeAttribute->UnescapeQuotes().GetByteRange();
+            initFile->offset = static_cast<int64_t>(range.first);
+            initFile->size = static_cast<int64_t>(range.second);
+        }
+        info.initFile = initFile;
     };
 }
 
@@ -134,6 +187,7 @@ void M3U8::UpdateFromTags(std::list<std::shared_ptr<Tag>>& tags)
     M3U8Info info;
     info.bVod = !tags.empty() && tags.back()->GetType() == HlsTag::EXTXENDLIST;
     bLive_ = !info.bVod;
+    sequence_ = 0; // the fragment ivs depend on it, it must not carry on from the last update
     for (auto& tag : tags) {
         HlsTag hlsTag = tag->GetType();
         auto iter = tagUpdatersMap_.find(hlsTag);
@@ -143,9 +197,26 @@ void M3U8::UpdateFromTags(std::list<std::shared_ptr<Tag>>& tags)
         }
 
         if (!info.uri.empty()) {
-            files_.emplace_back(std::make_shared<M3U8Fragment>(info.uri, info.title, info.duration, sequence_++,
-                                                               info.discontinuity));
+            auto fragment = std::make_shared<M3U8Fragment>(info.uri, info.title, info.duration, sequence_++,
+                                                           info.discontinuity);
+            if (info.size > 0) {
+                fragment->offset_ = info.offset >= 0 ? info.offset : (info.rangeUri == info.uri ? info.rangeEnd : 0);
+                fragment->size_ = info.size;
+                info.rangeUri = info.uri;
+                info.rangeEnd = fragment->offset_ + fragment->size_;
+            }
+            fragment->initFile_ = info.initFile;
+            if (info.key != nullptr && info.key->method == "AES-128" && !info.key->uri.empty()) {
+                fragment->key_ = info.key->uri;
+                if (info.key->hasIv) {
+                    std::copy(std::begin(info.key->iv), std::end(info.key->iv), fragment->iv_);
+                } else {
+                    FillSequenceIv(fragment->sequence_, fragment->iv_, sizeof(fragment->iv_));
+                }
+            }
+            files_.emplace_back(fragment);
             info.uri = "", info.title = "", info.duration = 0, info.discontinuity = false;
+            info.offset = -1, info.size = 0;
         }
     }
 }
@@ -36,23 +36,33 @@ enum class M3U8MediaType : int32_t {
     M3U8_N_MEDIA_TYPES,
 };
 
+// EXT-X-MAP, the initialization section of the fragments that follow it
 struct M3U8InitFile {
     std::string uri;
-    int offset;
-    int size;
+    int64_t offset {-1}; // -1 with the whole resource
+    int64_t size {0};
+};
+
+// EXT-X-KEY, applies to the fragments that follow it until the next one
+struct M3U8Key {
+    std::string method; // AES-128 or SAMPLE-AES, METHOD=NONE leaves no key
+    std::string uri;
+    bool hasIv {false}; // without IV the media sequence number of each fragment is its iv
+    uint8_t iv[16] {0}; // 16: AES block
 };
 
 struct M3U8Fragment {
-    M3U8Fragment(std::string uri, std::string title, double duration, int sequence, bool discont);
+    M3U8Fragment(std::string uri, std::string title, double duration, int64_t sequence, bool discont);
     std::string uri_;
     std::string title_;
     double duration_;
     int64_t sequence_;
     bool discont_ {false};
-    std::string key_ {};
-    int iv_[16] {0};
-    int offset_ {-1};
-    int size_ {0};
+    std::string key_ {}; // uri of the AES-128 key, empty when the fragment is not encrypted
+    uint8_t iv_[16] {0}; // 16: AES block
+    int64_t offset_ {-1}; // EXT-X-BYTERANGE, -1 with the whole resource
+    int64_t size_ {0};
+    std::shared_ptr<M3U8InitFile> initFile_;
 };
 
 struct M3U8Info {
@@ -61,6 +71,12 @@ struct M3U8Info {
     double duration = 0;
     bool discontinuity = false;
     bool bVod;
+    int64_t offset = -1; // -1: the range starts where the last range of the same uri ended
+    int64_t size = 0;
+    std::shared_ptr<M3U8InitFile> initFile;
+    std::shared_ptr<M3U8Key> key;
+    std::string rangeUri;
+    int64_t rangeEnd = 0;
 };
 
 struct M3U8 {
@@ -79,7 +95,7 @@ struct M3U8 {
     double targetDuration_ {0.0};
     bool bLive_ {};
     std::list<std::shared_ptr<M3U8Fragment>> files_;
-    uint64_t sequence_ {1}; // default 1
+    uint64_t sequence_ {0}; // 0: the first fragment without EXT-X-MEDIA-SEQUENCE
     int discontSequence_ {0};
     std::string playList_;
 };
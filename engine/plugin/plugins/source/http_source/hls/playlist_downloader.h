@@ -23,9 +23,23 @@ namespace OHOS {
 namespace Media {
 namespace Plugin {
 namespace HttpPlugin {
+// One fragment of a play list. An offset of -1 downloads the whole url, otherwise length bytes from offset.
+struct PlayInfo {
+    std::string url;
+    int64_t offset {-1};
+    int64_t length {0};
+    // initialization section that has to be in front of the fragment, empty when there is none
+    std::string initUrl;
+    int64_t initOffset {-1};
+    int64_t initLength {0};
+    // AES-128 key of the fragment and its iv, empty when the fragment is not encrypted
+    std::string keyUrl;
+    uint8_t iv[16] {0}; // 16: AES block
+};
+
 struct PlayListChangeCallback {
     virtual ~PlayListChangeCallback() = default;
-    virtual void OnPlayListChanged(const std::vector<std::string>& playList) = 0;
+    virtual void OnPlayListChanged(const std::vector<PlayInfo>& playList) = 0;
 };
 class PlayListDownloader {
 public:
@@ -86,6 +86,15 @@ HiPlayerImpl::HiPlayerImpl(int32_t appUid, int32_t appPid)
 HiPlayerImpl::~HiPlayerImpl()
 {
     MEDIA_LOG_I("dtor called.");
+    {
+        OSAL::ScopedLock lock(seekMutex_);
+        seekStopping_ = true;
+        seekCond_.NotifyAll();
+    }
+    if (seekTask_ != nullptr) {
+        seekTask_->Stop();
+        seekTask_.reset();
+    }
     if (pipelineStates_ != PLAYER_STOPPED) {
         DoStop();
         HiPlayerImpl::OnStateChanged(StateId::STOPPED);
@@ -255,7 +264,10 @@ int32_t HiPlayerImpl::Play()
     auto ret {ErrorCode::SUCCESS};
     callbackLooper_.StartReportMediaProgress(100); // 100 MS
     if (pipelineStates_ == PlayerStates::PLAYER_PLAYBACK_COMPLETE) {
-        ret = DoSeek(0, Plugin::SeekMode::SEEK_PREVIOUS_SYNC);
+        // the restart replaces the seeks not done yet, a late one would move the playback away from the start
+        OSAL::ScopedLock pipelineLock(pipelineMutex_);
+        uint32_t seekRequests = SupersedePendingSeeks(0);
+        ret = DoSeekLocked(0, Plugin::SeekMode::SEEK_PREVIOUS_SYNC, seekRequests + 1);
     } else if (pipelineStates_ == PlayerStates::PLAYER_PAUSED) {
         ret = DoResume();
     } else {
@@ -329,8 +341,88 @@ int32_t HiPlayerImpl::Seek(int32_t mSeconds, PlayerSeekMode mode)
         return TransErrorCode(ErrorCode::ERROR_INVALID_PARAMETER_VALUE);
     }
     auto smode = Transform2SeekMode(mode);
-    auto ret = DoSeek(hstTime, smode);
-    return TransErrorCode(ret);
+    // a scrub posts seeks faster than they complete, only the latest target is carried out
+    OSAL::ScopedLock lock(seekMutex_);
+    if (seekPending_) {
+        MEDIA_LOG_I("seek to " PUBLIC_LOG_D64 " superseded", Plugin::HstTime2Ms(pendingSeekTime_));
+    }
+    pendingSeekTime_ = hstTime;
+    pendingSeekMode_ = smode;
+    pendingSeekRequests_++;
+    seekPending_ = true;
+    if (seekTask_ == nullptr) {
+        seekTask_ = std::make_unique<OSAL::Task>("HiPlayerSeek", [this] { SeekLoop(); });
+        seekTask_->Start();
+    }
+    seekCond_.NotifyOne();
+    return TransErrorCode(ErrorCode::SUCCESS);
+}
+
+void HiPlayerImpl::SeekLoop()
+{
+    int64_t seekTime = 0;
+    Plugin::SeekMode seekMode = Plugin::SeekMode::SEEK_PREVIOUS_SYNC;
+    uint32_t seekRequests = 0;
+    uint64_t generation = 0;
+    {
+        OSAL::ScopedLock lock(seekMutex_);
+        seekCond_.Wait(lock, [this] { return seekPending_ || seekStopping_; });
+        if (seekStopping_) {
+            return;
+        }
+        seekTime = pendingSeekTime_;
+        seekMode = pendingSeekMode_;
+        seekRequests = pendingSeekRequests_;
+        generation = seekGeneration_;
+        takenSeekRequests_ = seekRequests;
+        pendingSeekRequests_ = 0;
+        seekPending_ = false;
+        seekRunning_ = true;
+    }
+    {
+        OSAL::ScopedLock pipelineLock(pipelineMutex_);
+        bool cancelled = false;
+        {
+            // a stop may have come in while we were waiting for the pipeline
+            OSAL::ScopedLock lock(seekMutex_);
+            cancelled = generation != seekGeneration_;
+            takenSeekRequests_ = 0;
+        }
+        if (cancelled) {
+            MEDIA_LOG_I("seek to " PUBLIC_LOG_D64 " cancelled", Plugin::HstTime2Ms(seekTime));
+        } else {
+            (void)DoSeekLocked(seekTime, seekMode, seekRequests);
+        }
+    }
+    OSAL::ScopedLock lock(seekMutex_);
+    seekRunning_ = false;
+}
+
+void HiPlayerImpl::CancelPendingSeek()
+{
+    OSAL::ScopedLock lock(seekMutex_);
+    seekGeneration_++;
+    if (seekPending_) {
+        MEDIA_LOG_I("seek to " PUBLIC_LOG_D64 " cancelled", Plugin::HstTime2Ms(pendingSeekTime_));
+        seekPending_ = false;
+    }
+    pendingSeekRequests_ = 0;
+}
+
+uint32_t HiPlayerImpl::SupersedePendingSeeks(int64_t hstTime)
+{
+    // called with the pipeline locked, a seek taken by the seek task has not started yet
+    OSAL::ScopedLock lock(seekMutex_);
+    seekGeneration_++;
+    uint32_t seekRequests = pendingSeekRequests_ + takenSeekRequests_;
+    if (seekRequests > 0) {
+        MEDIA_LOG_I("seek to " PUBLIC_LOG_D64 " superseded", Plugin::HstTime2Ms(pendingSeekTime_));
+    }
+    pendingSeekTime_ = hstTime;
+    seekPending_ = false;
+    pendingSeekRequests_ = 0;
+    takenSeekRequests_ = 0;
+    return seekRequests;
 }
 
 int32_t HiPlayerImpl::SetVolume(float leftVolume, float rightVolume)
@@ -588,6 +680,7 @@ ErrorCode HiPlayerImpl::PrepareFilters()
 
 ErrorCode HiPlayerImpl::DoPlay()
 {
+    OSAL::ScopedLock lock(pipelineMutex_);
     syncManager_->Resume();
     auto ret = pipeline_->Start();
     if (ret != ErrorCode::SUCCESS) {
@@ -598,6 +691,7 @@ ErrorCode HiPlayerImpl::DoPlay()
 
 ErrorCode HiPlayerImpl::DoPause()
 {
+    OSAL::ScopedLock lock(pipelineMutex_);
     auto ret = pipeline_->Pause();
     syncManager_->Pause();
     if (ret != ErrorCode::SUCCESS) {
@@ -608,6 +702,7 @@ ErrorCode HiPlayerImpl::DoPause()
 
 ErrorCode HiPlayerImpl::DoResume()
 {
+    OSAL::ScopedLock lock(pipelineMutex_);
     syncManager_->Resume();
     auto ret = pipeline_->Resume();
     if (ret != ErrorCode::SUCCESS) {
@@ -618,6 +713,8 @@ ErrorCode HiPlayerImpl::DoResume()
 
 ErrorCode HiPlayerImpl::DoStop()
 {
+    CancelPendingSeek();
+    OSAL::ScopedLock lock(pipelineMutex_);
     DUMP_BUFFER2FILE_END();
     mediaStats_.Reset();
     // 先关闭demuxer线程，防止元数据解析prepare过程中出现并发问题
@@ -637,7 +734,7 @@ ErrorCode HiPlayerImpl::DoReset()
     return DoStop();
 }
 
-ErrorCode HiPlayerImpl::DoSeek(int64_t hstTime, Plugin::SeekMode mode)
+ErrorCode HiPlayerImpl::DoSeekLocked(int64_t hstTime, Plugin::SeekMode mode, uint32_t seekRequests)
 {
     SYNC_TRACER();
     PROFILE_BEGIN();
@@ -667,8 +764,12 @@ ErrorCode HiPlayerImpl::DoSeek(int64_t hstTime, Plugin::SeekMode mode)
     } else {
         Format format;
         int64_t currentPos = Plugin::HstTime2Ms(seekPos);
-        MEDIA_LOG_I("Seek done, currentPos : " PUBLIC_LOG_D64, currentPos);
-        callbackLooper_.OnInfo(INFO_TYPE_SEEKDONE, static_cast<int32_t>(currentPos), format);
+        MEDIA_LOG_I("Seek done, currentPos : " PUBLIC_LOG_D64 ", requests : " PUBLIC_LOG_U32, currentPos,
+                    seekRequests);
+        // the requests merged into this seek are done as well, each caller waits for its own seek done
+        for (uint32_t i = 0; i < seekRequests; ++i) {
+            callbackLooper_.OnInfo(INFO_TYPE_SEEKDONE, static_cast<int32_t>(currentPos), format);
+        }
         callbackLooper_.OnInfo(INFO_TYPE_POSITION_UPDATE, static_cast<int32_t>(currentPos), format);
     }
 
@@ -813,10 +914,37 @@ int32_t HiPlayerImpl::Reset()
 
 int32_t HiPlayerImpl::GetCurrentTime(int32_t& currentPositionMs)
 {
+    {
+        OSAL::ScopedLock lock(seekMutex_);
+        if (seekPending_ || seekRunning_) {
+            // the clock still runs at the old position until the seek is done
+            currentPositionMs = Plugin::HstTime2Ms(pendingSeekTime_);
+            return TransErrorCode(ErrorCode::SUCCESS);
+        }
+    }
     currentPositionMs = Plugin::HstTime2Ms(syncManager_->GetMediaTimeNow());
     return TransErrorCode(ErrorCode::SUCCESS);
 }
 
+void HiPlayerImpl::UpdateDurationFromDemuxer()
+{
+    // demuxers which estimate the duration at prepare report the exact one once they have indexed the whole stream
+    Plugin::Any value;
+    if (demuxer_ == nullptr ||
+        demuxer_->GetParameter(static_cast<int32_t>(Plugin::Tag::MEDIA_DURATION), value) != ErrorCode::SUCCESS ||
+        !Plugin::Any::IsSameTypeWith<int64_t>(value)) {
+        return;
+    }
+    auto duration = Plugin::AnyCast<int64_t>(value);
+    if (duration <= 0 || duration == duration_) {
+        return;
+    }
+    MEDIA_LOG_I("duration updated to " PUBLIC_LOG_D64, duration);
+    duration_ = duration;
+    Format format;
+    callbackLooper_.OnInfo(INFO_TYPE_DURATION_UPDATE, Plugin::HstTime2Ms(duration_), format);
+}
+
 int32_t HiPlayerImpl::GetDuration(int32_t& durationMs)
 {
     durationMs = 0;
@@ -826,6 +954,7 @@ int32_t HiPlayerImpl::GetDuration(int32_t& durationMs)
                     StringnessPlayerState(pipelineStates_).c_str());
         return MSERR_INVALID_STATE;
     }
+    UpdateDurationFromDemuxer();
     if (duration_ < 0) {
         durationMs = -1;
         MEDIA_LOG_W("no valid duration");
@@ -23,6 +23,7 @@
 #include <i_player_engine.h>
 #include "foundation/osal/thread/condition_variable.h"
 #include "foundation/osal/thread/mutex.h"
+#include "foundation/osal/thread/task.h"
 #include "hiplayer_callback_looper.h"
 #include "internal/state_machine.h"
 #include "pipeline/core/error_code.h"
@@ -96,7 +97,7 @@ public:
     ErrorCode DoResume();
     ErrorCode DoStop();
     ErrorCode DoReset();
-    ErrorCode DoSeek(int64_t hstTime, Plugin::SeekMode mode);
+    ErrorCode DoSeekLocked(int64_t hstTime, Plugin::SeekMode mode, uint32_t seekRequests);
     ErrorCode DoOnReady();
     ErrorCode DoOnComplete();
     ErrorCode DoOnError(ErrorCode);
@@ -104,6 +105,7 @@ public:
 private:
     ErrorCode StopAsync();
     ErrorCode SetVolumeToSink(float volume, bool reportUpward = true);
+    void UpdateDurationFromDemuxer();
     Pipeline::PFilter CreateAudioDecoder(const std::string& desc);
     ErrorCode NewAudioPortFound(Pipeline::Filter* filter, const Plugin::Any& parameter);
 #ifdef VIDEO_SUPPORT
@@ -121,6 +123,9 @@ private:
     void NotifyBufferingUpdate(const std::string_view& type, int32_t param);
     void HandleResolutionChangeEvent(const Event& event);
     void HandlePluginEvent(const Event& event);
+    void SeekLoop();
+    void CancelPendingSeek();
+    uint32_t SupersedePendingSeeks(int64_t hstTime);
     
     OSAL::Mutex stateMutex_ {};
     OSAL::ConditionVariable cond_ {};
@@ -154,6 +159,20 @@ private:
     int32_t videoWidth_ {0};
     int32_t videoHeight_ {0};
     std::string url_;
+
+    // seeks are posted to the seek task, a target not started yet is replaced by the next one
+    OSAL::Mutex seekMutex_ {};
+    OSAL::ConditionVariable seekCond_ {};
+    std::unique_ptr<OSAL::Task> seekTask_ {nullptr};
+    bool seekPending_ {false};
+    bool seekRunning_ {false};
+    bool seekStopping_ {false};
+    int64_t pendingSeekTime_ {0}; // the latest target, reported as the position until the seek is done
+    Plugin::SeekMode pendingSeekMode_ {Plugin::SeekMode::SEEK_PREVIOUS_SYNC};
+    uint32_t pendingSeekRequests_ {0}; // each request merged into the pending one gets its own seek done
+    uint32_t takenSeekRequests_ {0}; // requests of the seek taken by the seek task until it gets the pipeline
+    uint64_t seekGeneration_ {0}; // changed by stop and restart, a seek taken before that is not carried out
+    OSAL::Mutex pipelineMutex_ {}; // the seek task and the player calls drive the pipeline one at a time
 };
 }  // namespace Media
 }  // namespace OHOS
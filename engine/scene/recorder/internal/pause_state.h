@@ -56,6 +56,12 @@ public:
         return {ErrorCode::SUCCESS, Action::TRANS_TO_RECORDING};
     }
 
+    std::tuple<ErrorCode, Action> Configure(const Plugin::Any& param) override
+    {
+        auto ret = executor_.DoConfigure(param);
+        return {ret, Action::ACTION_BUTT};
+    }
+
     std::tuple<ErrorCode, Action> Stop(const Plugin::Any& param) override
     {
         MEDIA_LOG_D("Stop called in pause state.");
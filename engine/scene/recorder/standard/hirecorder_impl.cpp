@@ -16,10 +16,13 @@
 #define HST_LOG_TAG "HiRecorderImpl"
 
 #include "hirecorder_impl.h"
+#include <algorithm>
+#include <cstdlib>
 #include <regex>
 #include "foundation/cpp_ext/type_traits_ext.h"
 #include "foundation/utils/hitrace_utils.h"
 #include "foundation/utils/steady_clock.h"
+#include "parameter.h"
 #include "pipeline/factory/filter_factory.h"
 #include "plugin/common/media_sink.h"
 #include "plugin/common/plugin_time.h"
@@ -32,6 +35,22 @@ namespace OHOS {
 namespace Media {
 namespace Record {
 using namespace Pipeline;
+namespace {
+// fragmented output is not among the recorder params of the player framework, it is switched on by system parameters
+constexpr const char* FRAGMENT_DURATION_KEY = "persist.multimedia.mediafoundation.recorder.fragmentduration";
+constexpr const char* FRAGMENT_KEY_FRAMES_KEY = "persist.multimedia.mediafoundation.recorder.fragmentkeyframes";
+
+int64_t ReadIntParameter(const char* key)
+{
+    char value[21] = {0}; // 21: int64 digits, sign and terminator
+    if (GetParameter(key, "0", value, sizeof(value)) <= 0) {
+        return 0;
+    }
+    char* end = nullptr;
+    auto result = std::strtoll(value, &end, 10); // 10: decimal
+    return (end != value && result > 0) ? result : 0;
+}
+}
 
 HiRecorderImpl::HiRecorderImpl(int32_t appUid, int32_t appPid, uint32_t appTokenId, uint64_t appFullTokenId)
     : appUid_(appUid), appPid_(appPid), appTokenId_(appTokenId), appFullTokenId_(appFullTokenId),
@@ -353,6 +372,14 @@ ErrorCode HiRecorderImpl::DoConfigure(const Plugin::Any &param) const
     }
     ErrorCode ret  = ErrorCode::SUCCESS;
     const auto* hstParam = Plugin::AnyCast<HstRecParam>(&param);
+    if (curFsmState_ == StateId::RECORDING || curFsmState_ == StateId::PAUSE) {
+        // only the output of the next segment and the segment limits can change while recording
+        FALSE_RETURN_V_MSG_E(hstParam->stdParamType == RecorderPublicParamType::OUT_FD ||
+                             hstParam->stdParamType == RecorderPublicParamType::MAX_DURATION ||
+                             hstParam->stdParamType == RecorderPublicParamType::MAX_SIZE,
+                             ErrorCode::ERROR_INVALID_OPERATION, "param " PUBLIC_LOG_U32 " can not be set now",
+                             static_cast<uint32_t>(hstParam->stdParamType));
+    }
     switch (hstParam->stdParamType) {
         case RecorderPublicParamType::AUD_SAMPLERATE:
         case RecorderPublicParamType::AUD_CHANNEL:
@@ -371,6 +398,8 @@ ErrorCode HiRecorderImpl::DoConfigure(const Plugin::Any &param) const
         case RecorderPublicParamType::OUT_FD:
         case RecorderPublicParamType::VID_ORIENTATION_HINT:
         case RecorderPublicParamType::GEO_LOCATION:
+        case RecorderPublicParamType::MAX_DURATION:
+        case RecorderPublicParamType::MAX_SIZE:
             ret = DoConfigureOther(*hstParam);
             break;
         default:
@@ -400,9 +429,21 @@ ErrorCode HiRecorderImpl::DoSetOutputFormat(const Plugin::Any& param) const
 
 ErrorCode HiRecorderImpl::DoPrepare()
 {
+    ConfigureFragments();
     return pipeline_->Prepare();
 }
 
+void HiRecorderImpl::ConfigureFragments() const
+{
+    int64_t durationMs = std::min<int64_t>(ReadIntParameter(FRAGMENT_DURATION_KEY), INT64_MAX / HST_MSECOND);
+    auto keyFrames = static_cast<uint32_t>(std::min<int64_t>(ReadIntParameter(FRAGMENT_KEY_FRAMES_KEY), UINT32_MAX));
+    if (durationMs > 0 || keyFrames > 0) {
+        MEDIA_LOG_I("fragmented output, fragment duration " PUBLIC_LOG_D64 " ms, key frames " PUBLIC_LOG_U32,
+                    durationMs, keyFrames);
+    }
+    (void)muxer_->SetFragmentParameters(durationMs * HST_MSECOND, keyFrames);
+}
+
 ErrorCode HiRecorderImpl::DoStart()
 {
     return pipeline_->Start();
@@ -619,6 +660,11 @@ ErrorCode HiRecorderImpl::DoConfigureOther(const HstRecParam& param) const
             FALSE_RETURN_V(fd >= 0, ErrorCode::ERROR_INVALID_PARAMETER_VALUE);
 #endif
             mediaSink.SetFd(fd);
+            if (curFsmState_ == StateId::RECORDING || curFsmState_ == StateId::PAUSE) {
+                // an output fd set while recording takes the next segment
+                FAIL_RETURN(outputSink_->SetNextSink(mediaSink));
+                return muxer_->AddNextOutput();
+            }
             return outputSink_->SetSink(mediaSink);
         }
         case RecorderPublicParamType::MAX_DURATION: {
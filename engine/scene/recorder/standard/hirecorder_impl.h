@@ -88,6 +88,7 @@ private:
     ErrorCode DoConfigureAudio(const HstRecParam& param) const;
     ErrorCode DoConfigureVideo(const HstRecParam& param) const;
     ErrorCode DoConfigureOther(const HstRecParam& param) const;
+    void ConfigureFragments() const;
     bool CheckParamType(int32_t sourceId, const RecorderParam& recParam) const;
 
     std::atomic<uint32_t> audioCount_ {0};
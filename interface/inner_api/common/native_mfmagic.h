@@ -16,7 +16,11 @@
 #ifndef NATIVE_MFMAGIC_H
 #define NATIVE_MFMAGIC_H
 
+#include <map>
+#include <mutex>
 #include <refbase.h>
+#include <unordered_map>
+#include <vector>
 #include "buffer/avbuffer.h"
 #include "buffer/avsharedmemory.h"
 #include "meta/format.h"
@@ -28,6 +32,7 @@ enum class MFMagic {
     MFMAGIC_AVBUFFER = MF_MAGIC('B', 'B', 'U', 'F'),
     MFMAGIC_FORMAT = MF_MAGIC('F', 'R', 'M', 'T'),
     MFMAGIC_SHARED_MEMORY = MF_MAGIC('S', 'M', 'E', 'M'),
+    MFMAGIC_AVBUFFER_POOL = MF_MAGIC('B', 'P', 'O', 'L'),
 };
 
 struct MFObjectMagic : public OHOS::RefBase {
@@ -36,12 +41,27 @@ struct MFObjectMagic : public OHOS::RefBase {
     enum MFMagic magic_;
 };
 
+struct OH_AVFormat;
+
 struct OH_AVBuffer : public MFObjectMagic {
     explicit OH_AVBuffer(const std::shared_ptr<OHOS::Media::AVBuffer> &buf);
     virtual ~OH_AVBuffer();
     bool IsEqualBuffer(const std::shared_ptr<OHOS::Media::AVBuffer> &buf);
     std::shared_ptr<OHOS::Media::AVBuffer> buffer_;
     bool isUserCreated = false;
+    OH_AVFormat *paramView_ = nullptr; // shares the meta of buffer_, created on first use
+};
+
+struct OH_AVBufferPool : public MFObjectMagic {
+    OH_AVBufferPool(int32_t capacity, uint32_t maxIdleCount);
+    ~OH_AVBufferPool() override;
+    int32_t capacity_;
+    uint32_t maxIdleCount_;
+    std::mutex mutex_;
+    std::map<int32_t, std::vector<OH_AVBuffer *>> idleBuffers_; // keyed on size class
+    std::unordered_map<OH_AVBuffer *, int32_t> busyBuffers_; // buffer to its size class
+    uint32_t idleCount_ = 0;
+    uint64_t allocCount_ = 0; // shared memory allocations, each one is an ashmem create and mmap
 };
 
 struct OH_AVMemory : public MFObjectMagic {
@@ -59,5 +79,6 @@ struct OH_AVFormat : public MFObjectMagic {
     OHOS::Media::Format format_;
     char *outString_ = nullptr;
     char *dumpInfo_ = nullptr;
+    bool isBorrowed = false; // owned by an OH_AVBuffer, see OH_AVBuffer_GetParameterView
 };
 #endif // NATIVE_MFMAGIC_H
\ No newline at end of file
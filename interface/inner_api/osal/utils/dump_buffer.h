@@ -41,9 +41,9 @@ namespace Media {
 #endif
 
 #if DUMP_BUFFER2FILE_ENABLE
-#define DUMP_BUFFER2FILE(fileName, buffer) OHOS::Media::Pipeline::DumpBufferToFile(fileName, buffer)
-#define DUMP_BUFFER2FILE_PREPARE() OHOS::Media::Pipeline::PrepareDumpDir()
-#define DUMP_BUFFER2FILE_END() OHOS::Media::Pipeline::EndDumpFile()
+#define DUMP_BUFFER2FILE(fileName, buffer) OHOS::Media::DumpAVBufferToFile("a", fileName, buffer)
+#define DUMP_BUFFER2FILE_PREPARE() OHOS::Media::PrepareDumpDir()
+#define DUMP_BUFFER2FILE_END() OHOS::Media::EndDumpFile()
 #else
 #define DUMP_BUFFER2FILE(fileName, buffer)
 #define DUMP_BUFFER2FILE_PREPARE()
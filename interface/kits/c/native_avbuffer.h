@@ -48,6 +48,7 @@ extern "C" {
 #endif
 typedef struct OH_AVBuffer OH_AVBuffer;
 typedef struct OH_NativeBuffer OH_NativeBuffer;
+typedef struct OH_AVBufferPool OH_AVBufferPool;
 
 /**
  * @brief Create an OH_AVBuffer instance, It should be noted that the OH_AVBuffer instance pointed
@@ -136,6 +137,113 @@ OH_AVFormat *OH_AVBuffer_GetParameter(OH_AVBuffer *buffer);
  */
 OH_AVErrCode OH_AVBuffer_SetParameter(OH_AVBuffer *buffer, const OH_AVFormat *format);
 
+/**
+ * @brief Get a view of the parameters carried by the buffer, without copying them. Values read from the view are
+ * the current values of the buffer, values set through the view are set on the buffer directly. The view is owned
+ * by the buffer and stays valid as long as the buffer, it must not be released by {@link OH_AVFormat_Destroy}.
+ * Passing the view to {@link OH_AVBuffer_SetParameter} of the same buffer is a no-op. Reading or setting a value
+ * through the view still looks the key up by its name and may allocate for it.
+ * @syscap SystemCapability.Multimedia.Media.Core
+ * @param buffer Encapsulate OH_AVBuffer structure instance pointer
+ * @return Returns Encapsulate OH_AVFormat structure instance pointer if the execution is successful,
+ * otherwise returns NULL. Possible failure causes:
+ * 1. input buffer is NULL;
+ * 2. structure verification failed of the buffer;
+ * 3. buffer's meta is NULL.
+ * @since 12
+ */
+OH_AVFormat *OH_AVBuffer_GetParameterView(OH_AVBuffer *buffer);
+
+/**
+ * @brief Get an int parameter of the buffer without copying the other parameters.
+ * @syscap SystemCapability.Multimedia.Media.Core
+ * @param buffer Encapsulate OH_AVBuffer structure instance pointer
+ * @param key Key of the parameter
+ * @param out The read value
+ * @return The return value is TRUE for success, FALSE for failure. Possible failure causes:
+ * 1. input buffer, key or out is NULL;
+ * 2. structure verification failed of the buffer;
+ * 3. the buffer does not carry the key or its value is not an int.
+ * @since 12
+ */
+bool OH_AVBuffer_GetIntParameter(OH_AVBuffer *buffer, const char *key, int32_t *out);
+
+/**
+ * @brief Get a long parameter of the buffer without copying the other parameters.
+ * @syscap SystemCapability.Multimedia.Media.Core
+ * @param buffer Encapsulate OH_AVBuffer structure instance pointer
+ * @param key Key of the parameter
+ * @param out The read value
+ * @return The return value is TRUE for success, FALSE for failure. Possible failure causes:
+ * 1. input buffer, key or out is NULL;
+ * 2. structure verification failed of the buffer;
+ * 3. the buffer does not carry the key or its value is not a long.
+ * @since 12
+ */
+bool OH_AVBuffer_GetLongParameter(OH_AVBuffer *buffer, const char *key, int64_t *out);
+
+/**
+ * @brief Get a double parameter of the buffer without copying the other parameters.
+ * @syscap SystemCapability.Multimedia.Media.Core
+ * @param buffer Encapsulate OH_AVBuffer structure instance pointer
+ * @param key Key of the parameter
+ * @param out The read value
+ * @return The return value is TRUE for success, FALSE for failure. Possible failure causes:
+ * 1. input buffer, key or out is NULL;
+ * 2. structure verification failed of the buffer;
+ * 3. the buffer does not carry the key or its value is not a double.
+ * @since 12
+ */
+bool OH_AVBuffer_GetDoubleParameter(OH_AVBuffer *buffer, const char *key, double *out);
+
+/**
+ * @brief Set an int parameter of the buffer, the other parameters are kept.
+ * @syscap SystemCapability.Multimedia.Media.Core
+ * @param buffer Encapsulate OH_AVBuffer structure instance pointer
+ * @param key Key of the parameter
+ * @param value The value to set
+ * @return Function result code.
+ *         {@link AV_ERR_OK} if the execution is successful.
+ *         {@link AV_ERR_INVALID_VAL}
+ *         1. input buffer or key is NULL;
+ *         2. structure verification failed of the buffer;
+ *         3. the value type of the key is not int.
+ * @since 12
+ */
+OH_AVErrCode OH_AVBuffer_SetIntParameter(OH_AVBuffer *buffer, const char *key, int32_t value);
+
+/**
+ * @brief Set a long parameter of the buffer, the other parameters are kept.
+ * @syscap SystemCapability.Multimedia.Media.Core
+ * @param buffer Encapsulate OH_AVBuffer structure instance pointer
+ * @param key Key of the parameter
+ * @param value The value to set
+ * @return Function result code.
+ *         {@link AV_ERR_OK} if the execution is successful.
+ *         {@link AV_ERR_INVALID_VAL}
+ *         1. input buffer or key is NULL;
+ *         2. structure verification failed of the buffer;
+ *         3. the value type of the key is not long.
+ * @since 12
+ */
+OH_AVErrCode OH_AVBuffer_SetLongParameter(OH_AVBuffer *buffer, const char *key, int64_t value);
+
+/**
+ * @brief Set a double parameter of the buffer, the other parameters are kept.
+ * @syscap SystemCapability.Multimedia.Media.Core
+ * @param buffer Encapsulate OH_AVBuffer structure instance pointer
+ * @param key Key of the parameter
+ * @param value The value to set
+ * @return Function result code.
+ *         {@link AV_ERR_OK} if the execution is successful.
+ *         {@link AV_ERR_INVALID_VAL}
+ *         1. input buffer or key is NULL;
+ *         2. structure verification failed of the buffer;
+ *         3. the value type of the key is not double.
+ * @since 12
+ */
+OH_AVErrCode OH_AVBuffer_SetDoubleParameter(OH_AVBuffer *buffer, const char *key, double value);
+
 /**
  * @brief Get the buffer's virtual address.
  * @syscap SystemCapability.Multimedia.Media.Core
@@ -176,6 +284,66 @@ int32_t OH_AVBuffer_GetCapacity(OH_AVBuffer *buffer);
  */
 OH_NativeBuffer *OH_AVBuffer_GetNativeBuffer(OH_AVBuffer *buffer);
 
+/**
+ * @brief Create an OH_AVBufferPool instance, which keeps released buffers for reuse, so that acquiring a buffer
+ * does not allocate memory once the pool is warmed up. The pool allocates count buffers of the capacity at once.
+ * It should be noted that the OH_AVBufferPool instance pointed to by the return value * needs to be released by
+ * {@link OH_AVBufferPool_Destroy}.
+ * @syscap SystemCapability.Multimedia.Media.Core
+ * @param capacity the default capacity of the buffers, bytes
+ * @param count the max number of released buffers kept by the pool
+ * @return Returns a pointer to an OH_AVBufferPool instance if the execution is successful, otherwise returns NULL.
+ * Possible failure causes:
+ * 1. capacity <= 0 or count <= 0;
+ * 2. internal error occurred, the system has no resources.
+ * @since 12
+ */
+OH_AVBufferPool *OH_AVBufferPool_Create(int32_t capacity, int32_t count);
+
+/**
+ * @brief Acquire a buffer from the pool. The capacity is rounded up to a size class, so the capacity of the
+ * returned buffer may be larger than requested. The attributes and parameters of the buffer are reset.
+ * The buffer must be returned by {@link OH_AVBufferPool_Release}, it can not be destroyed by
+ * {@link OH_AVBuffer_Destroy}.
+ * @syscap SystemCapability.Multimedia.Media.Core
+ * @param pool Encapsulate OH_AVBufferPool structure instance pointer
+ * @param capacity the minimum capacity of the buffer, bytes, the default capacity of the pool is used if <= 0
+ * @return Returns a pointer to an OH_AVBuffer instance if the execution is successful, otherwise returns NULL.
+ * Possible failure causes:
+ * 1. input pool is NULL or structure verification failed of the pool;
+ * 2. internal error occurred, the system has no resources.
+ * @since 12
+ */
+OH_AVBuffer *OH_AVBufferPool_Acquire(OH_AVBufferPool *pool, int32_t capacity);
+
+/**
+ * @brief Return a buffer acquired from the pool. The buffer is kept for reuse if the pool has room for it,
+ * otherwise it is destroyed. The buffer can not be used after it is released.
+ * @syscap SystemCapability.Multimedia.Media.Core
+ * @param pool Encapsulate OH_AVBufferPool structure instance pointer
+ * @param buffer Encapsulate OH_AVBuffer structure instance pointer
+ * @return Function result code.
+ *         {@link AV_ERR_OK} if the execution is successful.
+ *         {@link AV_ERR_INVALID_VAL}
+ *         1. input pool or buffer is NULL;
+ *         2. structure verification failed of the pool or the buffer;
+ *         3. the buffer is not acquired from the pool, or it is released already.
+ * @since 12
+ */
+OH_AVErrCode OH_AVBufferPool_Release(OH_AVBufferPool *pool, OH_AVBuffer *buffer);
+
+/**
+ * @brief Destroy the pool and the buffers kept by it. Buffers which are acquired and not released yet stay valid,
+ * they are destroyed by {@link OH_AVBuffer_Destroy} from then on.
+ * @syscap SystemCapability.Multimedia.Media.Core
+ * @param pool Encapsulate OH_AVBufferPool structure instance pointer
+ * @return Function result code.
+ *         {@link AV_ERR_OK} if the execution is successful.
+ *         {@link AV_ERR_INVALID_VAL} if input pool is NULL or structure verification failed of the pool.
+ * @since 12
+ */
+OH_AVErrCode OH_AVBufferPool_Destroy(OH_AVBufferPool *pool);
+
 #ifdef __cplusplus
 }
 #endif
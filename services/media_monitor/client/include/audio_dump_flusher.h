@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AUDIO_DUMP_FLUSHER_H
+#define AUDIO_DUMP_FLUSHER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+
+/**
+ * Byte ring of one dump file. The audio threads append without blocking, a write that does not fit or that races
+ * with another writer is dropped and counted. The flusher thread is the only reader.
+ * A ring that is no longer written is retired: its memory is freed and its slot can be reused for another file.
+ * Users Acquire() the ring before they look at it, a retired ring cannot be acquired.
+ */
+class AudioDumpRing {
+public:
+    AudioDumpRing(const std::string &fileName, size_t capacity);
+    ~AudioDumpRing() = default;
+
+    bool Acquire();
+    void Release();
+
+    // only without users and pending data, the caller serializes it with Reuse()
+    bool Retire();
+    void Reuse(const std::string &fileName);
+    bool IsRetired() const;
+
+    // flusher side, whether nothing was written for idleMs
+    bool CheckIdle(std::chrono::steady_clock::time_point now, int32_t idleMs);
+
+    bool Write(const void *data, size_t size);
+    size_t Read(uint8_t *data, size_t size);
+    size_t GetPendingSize() const;
+
+    const std::string &GetFileName() const
+    {
+        return fileName_;
+    }
+
+    uint64_t GetDroppedWrites() const
+    {
+        return droppedWrites_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetDroppedBytes() const
+    {
+        return droppedBytes_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void Drop(size_t size);
+
+    std::string fileName_;
+    const size_t capacity_;
+    std::unique_ptr<uint8_t[]> data_ = nullptr;
+    std::atomic<uint64_t> head_ {0};
+    std::atomic<uint64_t> tail_ {0};
+    std::atomic_flag writing_ = ATOMIC_FLAG_INIT;
+    // users in the low bits, RING_RETIRED on top
+    std::atomic<uint32_t> state_ {0};
+    uint64_t seenTail_ {0};
+    std::chrono::steady_clock::time_point lastActive_ {std::chrono::steady_clock::now()};
+    std::atomic<uint64_t> droppedWrites_ {0};
+    std::atomic<uint64_t> droppedBytes_ {0};
+};
+
+/**
+ * Asynchronous dump channel. WriteAudioBuffer() only copies into the ring of the file, a flusher thread drains the
+ * rings in bulk and hands each batch to the sink, one IPC for many buffers.
+ */
+class AudioDumpFlusher {
+public:
+    using DumpSink = std::function<int32_t(const std::string &fileName, const uint8_t *data, size_t size)>;
+
+    struct Options {
+        size_t ringSize {512 * 1024};   // 512K: about 2.7s of 48kHz stereo float per file
+        size_t batchSize {256 * 1024};  // 256K: data sent in one call, at most MAX_RAW_DATA_SIZE
+        int32_t flushIntervalMs {20};   // 20ms: cadence while data keeps coming
+        int32_t ringReleaseMs {10000};  // 10s: a ring not written for this long frees its memory and its slot
+    };
+
+    struct Stats {
+        uint64_t writes {0};
+        uint64_t batches {0};
+        uint64_t droppedWrites {0};
+        uint64_t droppedBytes {0};
+        uint64_t failedBatches {0};
+    };
+
+    explicit AudioDumpFlusher(DumpSink sink);
+    AudioDumpFlusher(DumpSink sink, const Options &options);
+    ~AudioDumpFlusher();
+
+    void Start();
+
+    /**
+     * Drain what is left and stop the flusher thread.
+     */
+    void Stop();
+
+    /**
+     * Called from the audio threads, never blocks on the sink.
+     */
+    bool Write(const std::string &fileName, const void *data, size_t size);
+
+    /**
+     * Drain the rings from the calling thread.
+     */
+    void Flush();
+
+    Stats GetStats();
+
+private:
+    static constexpr size_t MAX_DUMP_FILES = 32;
+
+    // the ring is acquired, the caller releases it
+    AudioDumpRing *AcquireRing(const std::string &fileName);
+    AudioDumpRing *FindRing(const std::string &fileName, size_t count);
+    void ReleaseIdleRing(AudioDumpRing *ring, std::chrono::steady_clock::time_point now);
+    bool DrainRings();
+    bool HasPendingData();
+    void FlushLoop();
+
+    DumpSink sink_;
+    Options options_;
+    std::array<std::atomic<AudioDumpRing *>, MAX_DUMP_FILES> rings_ {};
+    std::atomic<size_t> ringCount_ {0};
+    std::vector<std::unique_ptr<AudioDumpRing>> ringStorage_;
+    std::mutex ringMutex_;
+    std::vector<uint8_t> batch_;
+    std::mutex drainMutex_;
+    std::atomic<uint64_t> writes_ {0};
+    std::atomic<uint64_t> unknownFileDrops_ {0};
+    uint64_t batches_ {0};
+    uint64_t failedBatches_ {0};
+    uint64_t reportedDrops_ {0};
+    std::mutex loopMutex_;
+    std::condition_variable loopCond_;
+    std::atomic<bool> idle_ {false};
+    bool stopping_ {false};
+    std::thread flushThread_;
+};
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
+#endif // AUDIO_DUMP_FLUSHER_H
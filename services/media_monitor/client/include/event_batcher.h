@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_BATCHER_H
+#define EVENT_BATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "event_bean.h"
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+
+/**
+ * Coalesces the events written by the process into batches, one WriteLogMsgBatch IPC for many events. A batch goes
+ * out when it is full or when its oldest event has waited maxDelayMs, whichever comes first. Order is kept.
+ */
+class EventBatcher {
+public:
+    using BatchSink = std::function<void(const std::vector<EventBean> &beans)>;
+
+    struct Options {
+        size_t maxEvents {64};          // 64: events in one IPC
+        size_t maxBytes {64 * 1024};    // 64K: parcel size of one IPC, well below the binder limit
+        int32_t maxDelayMs {50};        // 50ms: latency added to an event at most
+        size_t maxPendingEvents {1024}; // 1024: events held while the service is slow, newer ones are dropped
+    };
+
+    struct Stats {
+        uint64_t events {0};
+        uint64_t batches {0};
+        uint64_t droppedEvents {0};
+    };
+
+    explicit EventBatcher(BatchSink sink);
+    EventBatcher(BatchSink sink, const Options &options);
+    ~EventBatcher();
+
+    /**
+     * Copy the event into the pending batch, never waits for the IPC.
+     */
+    bool Submit(const EventBean &bean);
+
+    /**
+     * Send all pending events from the calling thread.
+     */
+    void Flush();
+
+    Stats GetStats();
+
+private:
+    bool IsBatchFull() const;
+    size_t TakeBatch(std::vector<EventBean> &batch);
+    void SendPending(bool all);
+    void FlushLoop();
+
+    BatchSink sink_;
+    Options options_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<std::pair<EventBean, size_t>> pending_;
+    size_t pendingBytes_ {0};
+    std::chrono::steady_clock::time_point deadline_ {};
+    bool stopping_ {false};
+    std::thread flushThread_;
+    // taken before mutex_, keeps the batches in order between the flusher and Flush()
+    std::mutex sendMutex_;
+    uint64_t events_ {0};
+    uint64_t batches_ {0};
+    uint64_t droppedEvents_ {0};
+};
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
+#endif // EVENT_BATCHER_H
@@ -16,7 +16,9 @@
 #ifndef ST_MEDIA_MONITOR_MANAGER_H
 #define ST_MEDIA_MONITOR_MANAGER_H
 
+#include "audio_dump_flusher.h"
 #include "event_bean.h"
+#include "event_batcher.h"
 #include "monitor_utils.h"
 
 namespace OHOS {
@@ -67,10 +69,15 @@ private:
     ~MediaMonitorManager() {}
     void WatchHiviewUeEnableParameter();
     static bool ShouldWriteLogEvent(EventId eventId);
+    static int32_t SendAudioBuffer(const std::string &fileName, const uint8_t *data, size_t size);
+    static void SendEvents(const std::vector<EventBean> &beans);
+    static void FlushOnExit();
     bool dumpEnable_ = false;
     std::string dumpType_ = DEFAULT_DUMP_TYPE;
     std::string versionType_ = COMMERCIAL_VERSION;
     std::time_t dumpStartTime_ = 0;
+    std::unique_ptr<AudioDumpFlusher> dumpFlusher_ = nullptr;
+    std::unique_ptr<EventBatcher> eventBatcher_ = nullptr;
     static std::atomic_bool hiviewUeEnable_;
 };
 } // namespace MediaMonitor
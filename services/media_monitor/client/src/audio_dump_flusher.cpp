@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "audio_dump_flusher.h"
+#include <algorithm>
+#include <chrono>
+#include "log.h"
+#include "monitor_error.h"
+#include "securec.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_FOUNDATION, "AudioDumpFlusher"};
+}
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+namespace {
+constexpr size_t MAX_BATCH_SIZE = 1024 * 1024; // 1M: MAX_RAW_DATA_SIZE of AudioDumpBuffer
+constexpr int32_t IDLE_CHECK_MS = 500; // 500ms: bound on a wake up lost while going idle
+constexpr uint32_t RING_RETIRED = 1u << 31; // 31: top bit of the ring state, the rest counts the users
+
+size_t RoundUpToPowerOfTwo(size_t size)
+{
+    size_t capacity = 1;
+    while (capacity < size) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+}
+
+AudioDumpRing::AudioDumpRing(const std::string &fileName, size_t capacity)
+    : fileName_(fileName), capacity_(RoundUpToPowerOfTwo(capacity)),
+      data_(std::make_unique<uint8_t[]>(capacity_))
+{
+}
+
+bool AudioDumpRing::Acquire()
+{
+    if ((state_.fetch_add(1, std::memory_order_acquire) & RING_RETIRED) != 0) {
+        state_.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+void AudioDumpRing::Release()
+{
+    state_.fetch_sub(1, std::memory_order_release);
+}
+
+bool AudioDumpRing::Retire()
+{
+    uint32_t expected = 0;
+    if (!state_.compare_exchange_strong(expected, RING_RETIRED, std::memory_order_acq_rel)) {
+        return false;
+    }
+    // nobody can acquire it any more, a write that got in before is still to be drained
+    if (GetPendingSize() > 0) {
+        state_.fetch_and(~RING_RETIRED, std::memory_order_release);
+        return false;
+    }
+    data_.reset();
+    fileName_.clear();
+    return true;
+}
+
+void AudioDumpRing::Reuse(const std::string &fileName)
+{
+    data_ = std::make_unique<uint8_t[]>(capacity_);
+    fileName_ = fileName;
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    seenTail_ = 0;
+    lastActive_ = std::chrono::steady_clock::now();
+    state_.fetch_and(~RING_RETIRED, std::memory_order_release);
+}
+
+bool AudioDumpRing::IsRetired() const
+{
+    return (state_.load(std::memory_order_acquire) & RING_RETIRED) != 0;
+}
+
+bool AudioDumpRing::CheckIdle(std::chrono::steady_clock::time_point now, int32_t idleMs)
+{
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    if (tail != seenTail_) {
+        seenTail_ = tail;
+        lastActive_ = now;
+        return false;
+    }
+    return now - lastActive_ >= std::chrono::milliseconds(idleMs);
+}
+
+bool AudioDumpRing::Write(const void *data, size_t size)
+{
+    if (data == nullptr || size == 0) {
+        return false;
+    }
+    if (size > capacity_ || writing_.test_and_set(std::memory_order_acquire)) {
+        Drop(size);
+        return false;
+    }
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    if (capacity_ - static_cast<size_t>(tail - head) < size) {
+        writing_.clear(std::memory_order_release);
+        Drop(size);
+        return false;
+    }
+    size_t offset = static_cast<size_t>(tail & (capacity_ - 1));
+    size_t first = std::min(size, capacity_ - offset);
+    const uint8_t *src = static_cast<const uint8_t *>(data);
+    (void)memcpy_s(data_.get() + offset, capacity_ - offset, src, first);
+    if (first < size) {
+        (void)memcpy_s(data_.get(), capacity_, src + first, size - first);
+    }
+    tail_.store(tail + size, std::memory_order_release);
+    writing_.clear(std::memory_order_release);
+    return true;
+}
+
+size_t AudioDumpRing::Read(uint8_t *data, size_t size)
+{
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    size = std::min(size, static_cast<size_t>(tail - head));
+    if (size == 0) {
+        return 0;
+    }
+    size_t offset = static_cast<size_t>(head & (capacity_ - 1));
+    size_t first = std::min(size, capacity_ - offset);
+    (void)memcpy_s(data, size, data_.get() + offset, first);
+    if (first < size) {
+        (void)memcpy_s(data + first, size - first, data_.get(), size - first);
+    }
+    head_.store(head + size, std::memory_order_release);
+    return size;
+}
+
+size_t AudioDumpRing::GetPendingSize() const
+{
+    return static_cast<size_t>(tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire));
+}
+
+void AudioDumpRing::Drop(size_t size)
+{
+    droppedWrites_.fetch_add(1, std::memory_order_relaxed);
+    droppedBytes_.fetch_add(size, std::memory_order_relaxed);
+}
+
+AudioDumpFlusher::AudioDumpFlusher(DumpSink sink) : AudioDumpFlusher(std::move(sink), Options {})
+{
+}
+
+AudioDumpFlusher::AudioDumpFlusher(DumpSink sink, const Options &options) : sink_(std::move(sink)), options_(options)
+{
+    options_.batchSize = std::clamp(options_.batchSize, static_cast<size_t>(1), MAX_BATCH_SIZE);
+    for (auto &ring : rings_) {
+        ring.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+AudioDumpFlusher::~AudioDumpFlusher()
+{
+    Stop();
+}
+
+void AudioDumpFlusher::Start()
+{
+    std::lock_guard<std::mutex> lock(loopMutex_);
+    if (flushThread_.joinable()) {
+        return;
+    }
+    stopping_ = false;
+    flushThread_ = std::thread([this] { FlushLoop(); });
+    pthread_setname_np(flushThread_.native_handle(), "MDFlushThread");
+}
+
+void AudioDumpFlusher::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(loopMutex_);
+        stopping_ = true;
+    }
+    loopCond_.notify_all();
+    if (flushThread_.joinable()) {
+        flushThread_.join();
+    }
+    Flush();
+}
+
+bool AudioDumpFlusher::Write(const std::string &fileName, const void *data, size_t size)
+{
+    writes_.fetch_add(1, std::memory_order_relaxed);
+    AudioDumpRing *ring = AcquireRing(fileName);
+    if (ring == nullptr) {
+        unknownFileDrops_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    bool ret = ring->Write(data, size);
+    ring->Release();
+    if (ret && idle_.exchange(false, std::memory_order_acq_rel)) {
+        // once per idle period, the flusher polls on its own while data keeps coming
+        loopCond_.notify_one();
+    }
+    return ret;
+}
+
+void AudioDumpFlusher::Flush()
+{
+    (void)DrainRings();
+}
+
+AudioDumpFlusher::Stats AudioDumpFlusher::GetStats()
+{
+    Stats stats;
+    stats.writes = writes_.load(std::memory_order_relaxed);
+    stats.droppedWrites = unknownFileDrops_.load(std::memory_order_relaxed);
+    size_t count = ringCount_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        AudioDumpRing *ring = rings_[i].load(std::memory_order_acquire);
+        stats.droppedWrites += ring->GetDroppedWrites();
+        stats.droppedBytes += ring->GetDroppedBytes();
+    }
+    std::lock_guard<std::mutex> lock(drainMutex_);
+    stats.batches = batches_;
+    stats.failedBatches = failedBatches_;
+    return stats;
+}
+
+AudioDumpRing *AudioDumpFlusher::FindRing(const std::string &fileName, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        AudioDumpRing *ring = rings_[i].load(std::memory_order_acquire);
+        // the name of a ring is only looked at while it cannot be retired
+        if (!ring->Acquire()) {
+            continue;
+        }
+        if (ring->GetFileName() == fileName) {
+            return ring;
+        }
+        ring->Release();
+    }
+    return nullptr;
+}
+
+AudioDumpRing *AudioDumpFlusher::AcquireRing(const std::string &fileName)
+{
+    AudioDumpRing *ring = FindRing(fileName, ringCount_.load(std::memory_order_acquire));
+    if (ring != nullptr) {
+        return ring;
+    }
+    // first buffer of the file, the only time a writer takes a lock
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    size_t count = ringCount_.load(std::memory_order_relaxed);
+    ring = FindRing(fileName, count);
+    if (ring != nullptr) {
+        return ring;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        ring = rings_[i].load(std::memory_order_acquire);
+        if (ring->IsRetired()) {
+            ring->Reuse(fileName);
+            return ring->Acquire() ? ring : nullptr;
+        }
+    }
+    if (count >= MAX_DUMP_FILES) {
+        // counted as dropped, not logged from the audio thread
+        return nullptr;
+    }
+    ringStorage_.push_back(std::make_unique<AudioDumpRing>(fileName, options_.ringSize));
+    ring = ringStorage_.back().get();
+    rings_[count].store(ring, std::memory_order_release);
+    ringCount_.store(count + 1, std::memory_order_release);
+    return ring->Acquire() ? ring : nullptr;
+}
+
+void AudioDumpFlusher::ReleaseIdleRing(AudioDumpRing *ring, std::chrono::steady_clock::time_point now)
+{
+    if (!ring->Acquire()) {
+        return;
+    }
+    bool idle = ring->CheckIdle(now, options_.ringReleaseMs);
+    std::string fileName = idle ? ring->GetFileName() : "";
+    ring->Release();
+    if (!idle) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    if (ring->Retire()) {
+        MEDIA_LOG_I("dump of %{public}s is idle, ring released", fileName.c_str());
+    }
+}
+
+bool AudioDumpFlusher::DrainRings()
+{
+    std::lock_guard<std::mutex> lock(drainMutex_);
+    if (batch_.size() < options_.batchSize) {
+        batch_.resize(options_.batchSize);
+    }
+    bool drained = false;
+    uint64_t dropped = 0;
+    auto now = std::chrono::steady_clock::now();
+    size_t count = ringCount_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        AudioDumpRing *ring = rings_[i].load(std::memory_order_acquire);
+        dropped += ring->GetDroppedWrites();
+        if (!ring->Acquire()) {
+            continue;
+        }
+        size_t size = 0;
+        while ((size = ring->Read(batch_.data(), options_.batchSize)) > 0) {
+            drained = true;
+            batches_++;
+            int32_t ret = sink_ ? sink_(ring->GetFileName(), batch_.data(), size) : ERROR;
+            if (ret != SUCCESS) {
+                failedBatches_++;
+                MEDIA_LOG_D("write dump batch of %{public}zu bytes failed %{public}d", size, ret);
+            }
+        }
+        ring->Release();
+        ReleaseIdleRing(ring, now);
+    }
+    if (dropped > reportedDrops_) {
+        MEDIA_LOG_W("dump rings full, %{public}llu buffers dropped",
+            static_cast<unsigned long long>(dropped - reportedDrops_));
+        reportedDrops_ = dropped;
+    }
+    return drained;
+}
+
+bool AudioDumpFlusher::HasPendingData()
+{
+    size_t count = ringCount_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        if (rings_[i].load(std::memory_order_acquire)->GetPendingSize() > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AudioDumpFlusher::FlushLoop()
+{
+    MEDIA_LOG_I("dump flusher started");
+    while (true) {
+        bool drained = DrainRings();
+        std::unique_lock<std::mutex> lock(loopMutex_);
+        if (stopping_) {
+            break;
+        }
+        if (drained) {
+            loopCond_.wait_for(lock, std::chrono::milliseconds(options_.flushIntervalMs), [this] {
+                return stopping_;
+            });
+            continue;
+        }
+        idle_.store(true, std::memory_order_release);
+        loopCond_.wait_for(lock, std::chrono::milliseconds(IDLE_CHECK_MS), [this] {
+            return stopping_ || !idle_.load(std::memory_order_acquire) || HasPendingData();
+        });
+        idle_.store(false, std::memory_order_release);
+    }
+    MEDIA_LOG_I("dump flusher stopped");
+}
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_batcher.h"
+#include <algorithm>
+#include "log.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_FOUNDATION, "EventBatcher"};
+}
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+
+EventBatcher::EventBatcher(BatchSink sink) : EventBatcher(std::move(sink), Options {})
+{
+}
+
+EventBatcher::EventBatcher(BatchSink sink, const Options &options) : sink_(std::move(sink)), options_(options)
+{
+    options_.maxEvents = std::max(options_.maxEvents, static_cast<size_t>(1));
+    options_.maxPendingEvents = std::max(options_.maxPendingEvents, options_.maxEvents);
+}
+
+EventBatcher::~EventBatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cond_.notify_all();
+    if (flushThread_.joinable()) {
+        flushThread_.join();
+    }
+    Flush();
+}
+
+bool EventBatcher::Submit(const EventBean &bean)
+{
+    size_t size = bean.GetParcelSize();
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.size() >= options_.maxPendingEvents) {
+            if (droppedEvents_++ == 0) {
+                MEDIA_LOG_W("event batch backlog full, dropping events");
+            }
+            return false;
+        }
+        if (!stopping_ && !flushThread_.joinable()) {
+            flushThread_ = std::thread([this] { FlushLoop(); });
+            pthread_setname_np(flushThread_.native_handle(), "MMEventBatcher");
+        }
+        if (pending_.empty()) {
+            deadline_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(options_.maxDelayMs);
+            notify = true;
+        }
+        pending_.emplace_back(bean, size);
+        pendingBytes_ += size;
+        events_++;
+        // the flusher only needs a wake up to learn a new deadline or a full batch
+        notify = notify || IsBatchFull();
+    }
+    if (notify) {
+        cond_.notify_one();
+    }
+    return true;
+}
+
+void EventBatcher::Flush()
+{
+    SendPending(true);
+}
+
+EventBatcher::Stats EventBatcher::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.events = events_;
+    stats.batches = batches_;
+    stats.droppedEvents = droppedEvents_;
+    return stats;
+}
+
+bool EventBatcher::IsBatchFull() const
+{
+    return pending_.size() >= options_.maxEvents || pendingBytes_ >= options_.maxBytes;
+}
+
+size_t EventBatcher::TakeBatch(std::vector<EventBean> &batch)
+{
+    size_t count = 0;
+    size_t bytes = 0;
+    while (count < pending_.size() && count < options_.maxEvents) {
+        size_t size = pending_[count].second;
+        if (count > 0 && bytes + size > options_.maxBytes) {
+            break;
+        }
+        batch.push_back(std::move(pending_[count].first));
+        bytes += size;
+        count++;
+    }
+    pending_.erase(pending_.begin(), pending_.begin() + count);
+    pendingBytes_ -= bytes;
+    batches_++;
+    return count;
+}
+
+void EventBatcher::SendPending(bool all)
+{
+    std::lock_guard<std::mutex> sendLock(sendMutex_);
+    std::vector<EventBean> batch;
+    batch.reserve(options_.maxEvents);
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pending_.empty()) {
+                return;
+            }
+            if (!all && !IsBatchFull() && std::chrono::steady_clock::now() < deadline_) {
+                return;
+            }
+            (void)TakeBatch(batch);
+        }
+        if (sink_) {
+            sink_(batch);
+        }
+        batch.clear();
+    }
+}
+
+void EventBatcher::FlushLoop()
+{
+    MEDIA_LOG_I("event batcher started");
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (pending_.empty()) {
+            cond_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+            continue;
+        }
+        // the events left behind by a full batch keep the deadline of the oldest one
+        cond_.wait_until(lock, deadline_, [this] { return stopping_ || IsBatchFull(); });
+        lock.unlock();
+        SendPending(false);
+        lock.lock();
+    }
+    MEDIA_LOG_I("event batcher stopped");
+}
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
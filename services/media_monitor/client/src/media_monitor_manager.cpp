@@ -24,6 +24,7 @@
 #include "media_monitor_death_recipient.h"
 #include "audio_dump_buffer.h"
 #include <atomic>
+#include <cstdlib>
 #include <cstring>
 #include <set>
 
@@ -54,15 +55,29 @@ MediaMonitorManager::MediaMonitorManager()
 {
     versionType_ = OHOS::system::GetParameter("const.logsystem.versiontype", COMMERCIAL_VERSION);
     MEDIA_LOG_I("version type:%{public}s", versionType_.c_str());
+    dumpFlusher_ = std::make_unique<AudioDumpFlusher>(&MediaMonitorManager::SendAudioBuffer);
+    eventBatcher_ = std::make_unique<EventBatcher>(&MediaMonitorManager::SendEvents);
     WatchHiviewUeEnableParameter();
 }
 
 MediaMonitorManager& MediaMonitorManager::GetInstance()
 {
     static MediaMonitorManager monitorManager;
+    // registered after the instance is constructed, so it runs before the instance is destroyed at exit
+    static int exitFlush = std::atexit(&MediaMonitorManager::FlushOnExit);
+    (void)exitFlush;
     return monitorManager;
 }
 
+void MediaMonitorManager::FlushOnExit()
+{
+    // the events still waiting for their batch would be lost with the process
+    MediaMonitorManager &monitorManager = GetInstance();
+    if (monitorManager.eventBatcher_ != nullptr) {
+        monitorManager.eventBatcher_->Flush();
+    }
+}
+
 static const sptr<IMediaMonitor> GetMediaMonitorProxy()
 {
     MEDIA_LOG_D("Start to get media monitor manager proxy.");
@@ -130,16 +145,25 @@ void MediaMonitorManager::MediaMonitorDied(pid_t pid)
 void MediaMonitorManager::WriteLogMsg(std::shared_ptr<EventBean> &bean)
 {
     MEDIA_LOG_D("Write event to media monitor");
-    sptr<IMediaMonitor> proxy = GetMediaMonitorProxy();
-    if (proxy == nullptr) {
-        MEDIA_LOG_E("proxy is nullptr.");
-        return;
-    }
     FALSE_RETURN_MSG(bean != nullptr, "bean is nullptr.");
     FALSE_RETURN_MSG(ShouldWriteLogEvent(bean->GetEventId()),
         "persist.hiviewdfx.hiview.ue.enable is false, skip write log msg, eventId %{public}d",
         bean->GetEventId());
-    proxy->WriteLogMsg(*bean);
+    (void)eventBatcher_->Submit(*bean);
+}
+
+void MediaMonitorManager::SendEvents(const std::vector<EventBean> &beans)
+{
+    sptr<IMediaMonitor> proxy = GetMediaMonitorProxy();
+    if (proxy == nullptr) {
+        MEDIA_LOG_E("proxy is nullptr, %{public}zu events lost.", beans.size());
+        return;
+    }
+    if (beans.size() == 1) {
+        proxy->WriteLogMsg(beans.front());
+        return;
+    }
+    proxy->WriteLogMsgBatch(beans);
 }
 
 bool MediaMonitorManager::ShouldWriteLogEvent(EventId eventId)
@@ -239,15 +263,24 @@ void MediaMonitorManager::WriteAudioBuffer(const std::string &fileName, void *pt
     }
 
     FALSE_RETURN_MSG(ptr != nullptr, "in data is empty");
+    // copied into the ring of the file, the flusher sends it with the following buffers
+    (void)dumpFlusher_->Write(fileName, ptr, size);
+}
+
+int32_t MediaMonitorManager::SendAudioBuffer(const std::string &fileName, const uint8_t *data, size_t size)
+{
     sptr<IMediaMonitor> proxy = GetMediaMonitorProxy();
-    FALSE_RETURN_MSG(proxy != nullptr, "proxy is nullptr");
+    FALSE_RETURN_V_MSG_E(proxy != nullptr, ERROR, "proxy is nullptr");
 
-    int32_t ret;
+    int32_t ret = ERROR;
     AudioDumpBuffer buffer;
-    buffer.size = size;
-    buffer.RawDataCpy(ptr);
+    buffer.size = static_cast<uint32_t>(size);
+    buffer.data = data;
     proxy->WriteAudioBuffer(fileName, buffer, ret);
+    // the batch belongs to the flusher
+    buffer.data = nullptr;
     MEDIA_LOG_D("write audio buffer ret %{public}d", ret);
+    return ret;
 }
 
 int32_t MediaMonitorManager::GetMediaParameters(const std::vector<std::string> &subKeys,
@@ -326,6 +359,9 @@ int32_t MediaMonitorManager::SetMediaParameters(const std::vector<std::pair<std:
     dumpEnable_ = (dumpEnable == "true") ? true : false;
     if (dumpEnable_) {
         dumpStartTime_ = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        dumpFlusher_->Start();
+    } else {
+        dumpFlusher_->Stop();
     }
 
     MEDIA_LOG_I("set dump media param, %{public}d %{public}s", dumpEnable_, dumpType_.c_str());
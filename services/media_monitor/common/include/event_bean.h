@@ -16,7 +16,11 @@
 #ifndef I_EVENT_BEAN_H
 #define I_EVENT_BEAN_H
 
+#include <array>
 #include <map>
+#include <utility>
+#include <vector>
+#include "event_keys.h"
 #include "media_monitor_info.h"
 #include "iremote_proxy.h"
 #include "parcel.h"
@@ -25,6 +29,108 @@ namespace OHOS {
 namespace Media {
 namespace MediaMonitor {
 
+/**
+ * Fields of one value type in the order they were added. The first N builtin keys live inside the bean, the rest go
+ * to the heap. Keys outside BUILTIN_EVENT_KEYS keep their name, nothing is registered for them.
+ */
+template <typename T, size_t N>
+class EventFieldList {
+public:
+    using Field = std::pair<EventKeyId, T>;
+
+    T *Find(EventKeyId key)
+    {
+        for (size_t i = 0; i < inlineSize_; ++i) {
+            if (inline_[i].first == key) {
+                return &inline_[i].second;
+            }
+        }
+        for (auto &field : spill_) {
+            if (field.first == key) {
+                return &field.second;
+            }
+        }
+        return nullptr;
+    }
+
+    const T *Find(EventKeyId key) const
+    {
+        return const_cast<EventFieldList *>(this)->Find(key);
+    }
+
+    T *Find(const std::string &key)
+    {
+        EventKeyId id = EventKeys::Find(key);
+        if (id != INVALID_EVENT_KEY) {
+            return Find(id);
+        }
+        for (auto &field : named_) {
+            if (field.first == key) {
+                return &field.second;
+            }
+        }
+        return nullptr;
+    }
+
+    // a key that is already there keeps its value
+    void Add(EventKeyId key, T value)
+    {
+        if (Find(key) != nullptr) {
+            return;
+        }
+        if (inlineSize_ < N) {
+            inline_[inlineSize_++] = Field(key, std::move(value));
+            return;
+        }
+        spill_.emplace_back(key, std::move(value));
+    }
+
+    void Add(const std::string &key, T value)
+    {
+        EventKeyId id = EventKeys::Find(key);
+        if (id != INVALID_EVENT_KEY) {
+            Add(id, std::move(value));
+            return;
+        }
+        if (Find(key) == nullptr) {
+            named_.emplace_back(key, std::move(value));
+        }
+    }
+
+    size_t Size() const
+    {
+        return inlineSize_ + spill_.size() + named_.size();
+    }
+
+    // calls func(const std::string &key, const T &value), stops at the first field it returns false for
+    template <typename Func>
+    bool ForEach(Func &&func) const
+    {
+        for (size_t i = 0; i < inlineSize_; ++i) {
+            if (!func(EventKeys::GetName(inline_[i].first), inline_[i].second)) {
+                return false;
+            }
+        }
+        for (auto &field : spill_) {
+            if (!func(EventKeys::GetName(field.first), field.second)) {
+                return false;
+            }
+        }
+        for (auto &field : named_) {
+            if (!func(field.first, field.second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    std::array<Field, N> inline_ {};
+    size_t inlineSize_ = 0;
+    std::vector<Field> spill_;
+    std::vector<std::pair<std::string, T>> named_;
+};
+
 class EventBean : public Parcelable {
 public:
     EventBean();
@@ -52,6 +158,12 @@ public:
     uint64_t GetUint64Value(const std::string &key);
     float GetFloatValue(const std::string &key);
 
+    // the same lookups with a key resolved up front, see FindBuiltinEventKey()
+    int32_t GetIntValue(EventKeyId key) const;
+    std::string GetStringValue(EventKeyId key) const;
+    uint64_t GetUint64Value(EventKeyId key) const;
+    float GetFloatValue(EventKeyId key) const;
+
     ModuleId GetModuleId();
     EventId GetEventId();
     EventType GetEventType();
@@ -63,16 +175,19 @@ public:
     void ReadFromParcel(MessageParcel &parcel);
 
     bool Marshalling(Parcel &parcel) const override;
+    // bytes written by Marshalling(), used to bound the size of a batch
+    size_t GetParcelSize() const;
     static EventBean *Unmarshalling(Parcel &data);
 
 private:
     ModuleId moduleId_ = UNKNOW_MODULEID;
     EventId eventId_ = UNKNOW_EVENTID;
     EventType eventType_ = UNKNOW_EVENTTYPE;
-    std::map<std::string, int32_t> intMap_;
-    std::map<std::string, std::string> stringMap_;
-    std::map<std::string, uint64_t> uint64Map_;
-    std::map<std::string, float> floatMap_;
+    // sized for the usual event, a bigger one spills the rest
+    EventFieldList<int32_t, 8> intFields_; // 8: int fields kept inline
+    EventFieldList<std::string, 2> stringFields_; // 2: string fields kept inline
+    EventFieldList<uint64_t, 2> uint64Fields_; // 2: uint64 fields kept inline
+    EventFieldList<float, 1> floatFields_; // 1: float fields kept inline
 };
 } // namespace MediaMonitor
 } // namespace Media
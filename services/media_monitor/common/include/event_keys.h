@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_KEYS_H
+#define EVENT_KEYS_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+
+using EventKeyId = uint16_t;
+constexpr EventKeyId INVALID_EVENT_KEY = UINT16_MAX;
+
+// keys written by the audio framework, sorted, the index of a key is its id in every process
+inline constexpr std::string_view BUILTIN_EVENT_KEYS[] = {
+    "ACTIVE_PID", "ACTIVE_PKG", "ACTIVE_SOURCE", "ACTIVE_UID", "ADDRESS", "ADD_REMOVE_OPERATION",
+    "APP_BACKGROUND_STATE", "APP_BUNDLE_NAME", "APP_NAME", "APP_NAMES", "APP_PID", "APP_UID", "APP_VERSION_CODE",
+    "AUDIODIRECTION", "AUDIOSTREAM", "AUDIO_DEVICE_USAGE", "AUDIO_NODE_COUNT", "AUDIO_NODE_TYPE", "AUDIO_SCENE",
+    "BT_TYPE", "BUNDLENAME", "CALLFUNC", "CAPTURE_DEVICE_TYPE", "CATEGORY", "CHANGE_REASON", "CHANNEL_LAYOUT",
+    "CLIENT_UID", "CLIENT_UID_U", "COLLABORATIVE_STATE", "COUNT", "CURRENT_NAME", "CURRENT_NAME_U", "CURRENT_VALUE",
+    "CURR_APP_NAME", "CURR_RENDERER_INFO", "CURR_SESSION_INFO", "CUR_AUDIO_SCENE", "DB_TYPE", "DES_NAME", "DES_NAME_U",
+    "DETAIL", "DEVICETYPE", "DEVICE_DESC", "DEVICE_LIST", "DEVICE_NAME", "DEVICE_TYPE", "DEVICE_TYPE_AFTER_CHANGE",
+    "DEVICE_TYPE_BEFORE_CHANGE", "DM_DEVICE_TYPE", "DUBIOUS_APP", "DURATION", "EDIT_MODE_RENDER_COUNT",
+    "EDIT_MODE_RTF_OVER_100_COUNT", "EDIT_MODE_RTF_OVER_110BASE_COUNT", "EDIT_MODE_RTF_OVER_120BASE_COUNT",
+    "EDIT_MODE_RTF_OVER_BASE_COUNT", "EFFECT_CHAIN", "ENCODING_TYPE", "ENGINE_TYPE", "ERROR_CASE", "ERROR_CODE",
+    "ERROR_DESCRIPTION", "ERROR_DESCRIPTION_U", "ERROR_INFO", "ERROR_MSG", "ERROR_REASON", "ERROR_SCENE", "ERROR_SCOPE",
+    "ERROR_TYPE", "ERROR_UID", "EXCEEDED_SCENE", "EXCLUSION_STATUS", "FEATURE", "FILE_SIZE", "FUNC_NAME", "HASMIC",
+    "HAS_BACK_TASK", "HAS_SESSION", "HDI_ADAPTER", "HDI_PIN", "HDI_TYPE", "INCOMING_PID", "INCOMING_PKG",
+    "INCOMING_SOURCE", "INCOMING_UID", "INTERRUPT_HINTTYPE", "ISCONNECT", "ISOUTPUT", "IS_ADD", "IS_PLAYBACK",
+    "JANK_START_TIME", "LEVEL", "LOUD_VOLUME_TIMES", "MEDIA_TYPE", "MIGRATE_DIRECTION", "MIME_TYPE",
+    "MSG_ERROR_DESCRIPTION", "MSG_ERROR_DESCRIPTION_U", "MSG_FUNC_NAME", "MSG_FUNC_NAME_U", "MSG_TYPE", "MSG_TYPE_U",
+    "MUTED", "MUTETYPE", "MUTE_HAPTICS", "MUTE_PLAY_DURATION", "MUTE_PLAY_START_TIME", "MUTE_STATE", "NETWORKID",
+    "NETWORK_ID", "ORIGINAL_INFO", "PARAM_VALUE", "PERIOD_MS", "PID", "PIPE_TYPE", "PIPE_TYPE_AFTER_CHANGE",
+    "PIPE_TYPE_BEFORE_CHANGE", "PKGNAME", "POSITION", "POWERVOLUMEFACTOR", "PRE_AUDIO_SCENE", "REASON", "RENDERER_INFO",
+    "RENDERER_PLAY_TIMES", "RENDER_DEVICE_TYPE", "RESULT", "RINGTONE_CATEGORY", "RING_MODE", "ROUTER_TYPE",
+    "RT_MODE_RENDER_COUNT", "RT_MODE_RTF_OVER_100_COUNT", "RT_MODE_RTF_OVER_110BASE_COUNT",
+    "RT_MODE_RTF_OVER_120BASE_COUNT", "RT_MODE_RTF_OVER_BASE_COUNT", "SAMPLE_RATE", "SCENE_INFO", "SCENE_TYPE",
+    "SERVICE_ID", "SERVICE_STATUS", "SESSIONID", "SESSION_ID", "SESSION_ID_U", "SESSION_INFO", "STANDBY",
+    "STANDBY_DURATION_S", "START_TIME", "STATE", "STATUS", "STREAMID", "STREAM_OR_SOURCE_TYPE", "STREAM_TYPE",
+    "STREAM_TYPE_U", "STREAM_VOLUME", "SUBSCRIBE_KEY", "SUBSCRIBE_RESULT", "SYSTEMHAP_SET_FOCUSSTRATEGY",
+    "SYSTEM_SOUND_TYPE", "SYSVOLUME", "TIMES", "TIMESTAMP", "TIME_STAMP", "TRANSACTIONID", "TYPE", "UID", "UPLOAD_TIME",
+    "VIBRATION_STATE", "VOLUME", "VOLUMEFACTOR", "VOLUME_LEVEL", "WINDOW_STATE"
+};
+constexpr size_t BUILTIN_EVENT_KEY_COUNT = sizeof(BUILTIN_EVENT_KEYS) / sizeof(BUILTIN_EVENT_KEYS[0]);
+
+constexpr EventKeyId FindBuiltinEventKey(std::string_view key)
+{
+    size_t low = 0;
+    size_t high = BUILTIN_EVENT_KEY_COUNT;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2; // 2: halves the range
+        int result = BUILTIN_EVENT_KEYS[mid].compare(key);
+        if (result == 0) {
+            return static_cast<EventKeyId>(mid);
+        }
+        if (result < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return INVALID_EVENT_KEY;
+}
+
+constexpr bool IsBuiltinEventKeysSorted()
+{
+    for (size_t i = 1; i < BUILTIN_EVENT_KEY_COUNT; ++i) {
+        if (!(BUILTIN_EVENT_KEYS[i - 1] < BUILTIN_EVENT_KEYS[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(IsBuiltinEventKeysSorted(), "BUILTIN_EVENT_KEYS must be sorted and unique");
+
+/**
+ * Maps the builtin keys of EventBean to their ids. Keys the table does not know have no id, EventBean keeps them
+ * as strings. The parcel keeps carrying strings.
+ */
+class EventKeys {
+public:
+    // INVALID_EVENT_KEY for a key outside BUILTIN_EVENT_KEYS
+    static EventKeyId Find(const std::string &key);
+
+    // empty for an id outside BUILTIN_EVENT_KEYS
+    static const std::string &GetName(EventKeyId id);
+};
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
+#endif // EVENT_KEYS_H
@@ -28,7 +28,8 @@ enum class MediaMonitorInterfaceCode {
     ERASE_PREFERRED_DEVICE,
     GET_EXCLUDED_DEVICES_MSG,
     GET_UNIFIED_FAULT_CODE_RECORDS,
-    MEDIA_MONITOR_CODE_MAX = GET_UNIFIED_FAULT_CODE_RECORDS,
+    WRITE_LOG_MSG_BATCH,
+    MEDIA_MONITOR_CODE_MAX = WRITE_LOG_MSG_BATCH,
 };
 
 } // namespace MediaMonitor
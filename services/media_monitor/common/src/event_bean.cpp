@@ -27,6 +27,19 @@ namespace MediaMonitor {
 
 constexpr int MAX_MAP_SIZE = 1000;
 
+namespace {
+template <typename T, size_t N>
+std::map<std::string, T> ToMap(const EventFieldList<T, N> &fields)
+{
+    std::map<std::string, T> map;
+    fields.ForEach([&map](const std::string &key, const T &value) {
+        map.emplace(key, value);
+        return true;
+    });
+    return map;
+}
+}
+
 EventBean::EventBean() {}
 
 EventBean::EventBean(const ModuleId &mId, const EventId &eId,
@@ -43,9 +56,10 @@ void EventBean::ReadFromParcel(MessageParcel &parcel)
     FALSE_RETURN_MSG(intMapSize < MAX_MAP_SIZE,
         "The size of intMapSize exceeds the maximum value");
     for (int32_t index = 0; index < intMapSize; index++) {
+        // the keys of a peer are kept as they came, they never enter a process wide table
         std::string key = parcel.ReadString();
         int32_t value = parcel.ReadInt32();
-        Add(key, value);
+        intFields_.Add(key, value);
     }
 
     int32_t stringMapSize = parcel.ReadInt32();
@@ -53,8 +67,7 @@ void EventBean::ReadFromParcel(MessageParcel &parcel)
         "The size of stringMapSize exceeds the maximum value");
     for (int32_t index = 0; index < stringMapSize; index++) {
         std::string key = parcel.ReadString();
-        std::string value = parcel.ReadString();
-        Add(key, value);
+        stringFields_.Add(key, parcel.ReadString());
     }
 
     int32_t uint64MapSize = parcel.ReadInt32();
@@ -63,7 +76,7 @@ void EventBean::ReadFromParcel(MessageParcel &parcel)
     for (int32_t index = 0; index < uint64MapSize; index++) {
         std::string key = parcel.ReadString();
         uint64_t value = parcel.ReadUint64();
-        Add(key, value);
+        uint64Fields_.Add(key, value);
     }
 
     int32_t floatMapSize = parcel.ReadInt32();
@@ -72,7 +85,7 @@ void EventBean::ReadFromParcel(MessageParcel &parcel)
     for (int32_t index = 0; index < floatMapSize; index++) {
         std::string key = parcel.ReadString();
         float value = parcel.ReadFloat();
-        Add(key, value);
+        floatFields_.Add(key, value);
     }
 }
 
@@ -82,38 +95,75 @@ bool EventBean::Marshalling(Parcel &parcel) const
     FALSE_RETURN_V_MSG_E(parcel.WriteInt32(eventId_), false, "write eventId failed");
     FALSE_RETURN_V_MSG_E(parcel.WriteInt32(eventType_), false, "write eventId failed");
 
-    FALSE_RETURN_V_MSG_E(intMap_.size() < MAX_MAP_SIZE, false,
+    // the keys go as strings, a peer may not know the builtin table of this build
+    FALSE_RETURN_V_MSG_E(intFields_.Size() < MAX_MAP_SIZE, false,
         "The size of intMap_ exceeds the maximum value");
-    FALSE_RETURN_V_MSG_E(parcel.WriteInt32(intMap_.size()), false, "write intMap.size() failed");
-    for (auto &it : intMap_) {
-        FALSE_RETURN_V_MSG_E(parcel.WriteString(it.first), false, "intMap failed to WriteString for key");
-        FALSE_RETURN_V_MSG_E(parcel.WriteInt32(it.second), false, "intMap failed to WriteInt32 for value");
-    }
-
-    FALSE_RETURN_V_MSG_E(stringMap_.size() < MAX_MAP_SIZE, false,
+    FALSE_RETURN_V_MSG_E(parcel.WriteInt32(intFields_.Size()), false, "write intMap.size() failed");
+    bool ret = intFields_.ForEach([&parcel](const std::string &key, int32_t value) {
+        FALSE_RETURN_V_MSG_E(parcel.WriteString(key), false,
+            "intMap failed to WriteString for key");
+        FALSE_RETURN_V_MSG_E(parcel.WriteInt32(value), false, "intMap failed to WriteInt32 for value");
+        return true;
+    });
+    FALSE_RETURN_V(ret, false);
+
+    FALSE_RETURN_V_MSG_E(stringFields_.Size() < MAX_MAP_SIZE, false,
         "The size of stringMap_ exceeds the maximum value");
-    FALSE_RETURN_V_MSG_E(parcel.WriteInt32(stringMap_.size()), false, "write stringMap.size() failed");
-    for (auto &it : stringMap_) {
-        FALSE_RETURN_V_MSG_E(parcel.WriteString(it.first), false, "stringMap failed to WriteString for key");
-        FALSE_RETURN_V_MSG_E(parcel.WriteString(it.second), false, "stringMap failed to WriteString for value");
-    }
-
-    FALSE_RETURN_V_MSG_E(uint64Map_.size() < MAX_MAP_SIZE, false,
+    FALSE_RETURN_V_MSG_E(parcel.WriteInt32(stringFields_.Size()), false, "write stringMap.size() failed");
+    ret = stringFields_.ForEach([&parcel](const std::string &key, const std::string &value) {
+        FALSE_RETURN_V_MSG_E(parcel.WriteString(key), false,
+            "stringMap failed to WriteString for key");
+        FALSE_RETURN_V_MSG_E(parcel.WriteString(value), false, "stringMap failed to WriteString for value");
+        return true;
+    });
+    FALSE_RETURN_V(ret, false);
+
+    FALSE_RETURN_V_MSG_E(uint64Fields_.Size() < MAX_MAP_SIZE, false,
         "The size of uint64Map_ exceeds the maximum value");
-    FALSE_RETURN_V_MSG_E(parcel.WriteInt32(uint64Map_.size()), false, "write uint64Map.size() failed");
-    for (auto &it : uint64Map_) {
-        FALSE_RETURN_V_MSG_E(parcel.WriteString(it.first), false, "uint64Map failed to WriteString for key");
-        FALSE_RETURN_V_MSG_E(parcel.WriteUint64(it.second), false, "uint64Map failed to WriteInt32 for value");
-    }
-
-    FALSE_RETURN_V_MSG_E(floatMap_.size() < MAX_MAP_SIZE, false,
+    FALSE_RETURN_V_MSG_E(parcel.WriteInt32(uint64Fields_.Size()), false, "write uint64Map.size() failed");
+    ret = uint64Fields_.ForEach([&parcel](const std::string &key, uint64_t value) {
+        FALSE_RETURN_V_MSG_E(parcel.WriteString(key), false,
+            "uint64Map failed to WriteString for key");
+        FALSE_RETURN_V_MSG_E(parcel.WriteUint64(value), false, "uint64Map failed to WriteInt32 for value");
+        return true;
+    });
+    FALSE_RETURN_V(ret, false);
+
+    FALSE_RETURN_V_MSG_E(floatFields_.Size() < MAX_MAP_SIZE, false,
         "The size of floatMap_ exceeds the maximum value");
-    FALSE_RETURN_V_MSG_E(parcel.WriteInt32(floatMap_.size()), false, "write floatMap.size() failed");
-    for (auto &it : floatMap_) {
-        FALSE_RETURN_V_MSG_E(parcel.WriteString(it.first), false, "floatMap failed to WriteString for key");
-        FALSE_RETURN_V_MSG_E(parcel.WriteFloat(it.second), false, "floatMap failed to WriteInt32 for value");
-    }
-    return true;
+    FALSE_RETURN_V_MSG_E(parcel.WriteInt32(floatFields_.Size()), false, "write floatMap.size() failed");
+    return floatFields_.ForEach([&parcel](const std::string &key, float value) {
+        FALSE_RETURN_V_MSG_E(parcel.WriteString(key), false,
+            "floatMap failed to WriteString for key");
+        FALSE_RETURN_V_MSG_E(parcel.WriteFloat(value), false, "floatMap failed to WriteInt32 for value");
+        return true;
+    });
+}
+
+size_t EventBean::GetParcelSize() const
+{
+    // a string goes as its length and the characters with a terminator, padded to 4 bytes
+    auto stringSize = [](const std::string &str) {
+        return sizeof(int32_t) + (str.size() + sizeof(int32_t)) / sizeof(int32_t) * sizeof(int32_t);
+    };
+    size_t size = sizeof(int32_t) * 7; // 7: ids, type and the four map sizes
+    intFields_.ForEach([&size, &stringSize](const std::string &key, int32_t) {
+        size += stringSize(key) + sizeof(int32_t);
+        return true;
+    });
+    stringFields_.ForEach([&size, &stringSize](const std::string &key, const std::string &value) {
+        size += stringSize(key) + stringSize(value);
+        return true;
+    });
+    uint64Fields_.ForEach([&size, &stringSize](const std::string &key, uint64_t) {
+        size += stringSize(key) + sizeof(uint64_t);
+        return true;
+    });
+    floatFields_.ForEach([&size, &stringSize](const std::string &key, float) {
+        size += stringSize(key) + sizeof(int32_t);
+        return true;
+    });
+    return size;
 }
 
 EventBean *EventBean::Unmarshalling(Parcel &data)
@@ -127,42 +177,42 @@ EventBean *EventBean::Unmarshalling(Parcel &data)
 
 void EventBean::Add(const std::string &key, int32_t value)
 {
-    intMap_.emplace(key, value);
+    intFields_.Add(key, value);
 }
 
 void EventBean::Add(const std::string &key, std::string value)
 {
-    stringMap_.emplace(key, value);
+    stringFields_.Add(key, std::move(value));
 }
 
 void EventBean::Add(const std::string &key, uint64_t value)
 {
-    uint64Map_.emplace(key, value);
+    uint64Fields_.Add(key, value);
 }
 
 void EventBean::Add(const std::string &key, float value)
 {
-    floatMap_.emplace(key, value);
+    floatFields_.Add(key, value);
 }
 
 std::map<std::string, int32_t> EventBean::GetIntMap()
 {
-    return intMap_;
+    return ToMap(intFields_);
 }
 
 std::map<std::string, std::string> EventBean::GetStringMap()
 {
-    return stringMap_;
+    return ToMap(stringFields_);
 }
 
 std::map<std::string, uint64_t> EventBean::GetUint64Map()
 {
-    return uint64Map_;
+    return ToMap(uint64Fields_);
 }
 
 std::map<std::string, float> EventBean::GetFloatMap()
 {
-    return floatMap_;
+    return ToMap(floatFields_);
 }
 
 ModuleId EventBean::GetModuleId()
@@ -196,65 +246,81 @@ void EventBean::SetEventType(const EventType &type)
 
 int32_t EventBean::GetIntValue(const std::string &key)
 {
-    if (intMap_.find(key) != intMap_.end()) {
-        return intMap_.find(key)->second;
-    } else {
-        return -1;
-    }
+    const int32_t *value = intFields_.Find(key);
+    return value != nullptr ? *value : -1;
 }
 
 std::string EventBean::GetStringValue(const std::string &key)
 {
-    if (stringMap_.find(key) != stringMap_.end()) {
-        return stringMap_.find(key)->second;
-    } else {
-        return "UNKNOWN";
-    }
+    const std::string *value = stringFields_.Find(key);
+    return value != nullptr ? *value : "UNKNOWN";
 }
 
 uint64_t EventBean::GetUint64Value(const std::string &key)
 {
-    if (uint64Map_.find(key) != uint64Map_.end()) {
-        return uint64Map_.find(key)->second;
-    } else {
-        return 0;
-    }
+    const uint64_t *value = uint64Fields_.Find(key);
+    return value != nullptr ? *value : 0;
 }
 
 float EventBean::GetFloatValue(const std::string &key)
 {
-    if (floatMap_.find(key) != floatMap_.end()) {
-        return floatMap_.find(key)->second;
-    } else {
-        return 0;
-    }
+    const float *value = floatFields_.Find(key);
+    return value != nullptr ? *value : 0;
+}
+
+int32_t EventBean::GetIntValue(EventKeyId key) const
+{
+    const int32_t *value = intFields_.Find(key);
+    return value != nullptr ? *value : -1;
+}
+
+std::string EventBean::GetStringValue(EventKeyId key) const
+{
+    const std::string *value = stringFields_.Find(key);
+    return value != nullptr ? *value : "UNKNOWN";
+}
+
+uint64_t EventBean::GetUint64Value(EventKeyId key) const
+{
+    const uint64_t *value = uint64Fields_.Find(key);
+    return value != nullptr ? *value : 0;
+}
+
+float EventBean::GetFloatValue(EventKeyId key) const
+{
+    const float *value = floatFields_.Find(key);
+    return value != nullptr ? *value : 0;
 }
 
 void EventBean::UpdateIntMap(const std::string &key, int32_t value)
 {
-    if (intMap_.find(key) != intMap_.end()) {
-        intMap_[key] = value;
+    int32_t *field = intFields_.Find(key);
+    if (field != nullptr) {
+        *field = value;
     }
 }
 
 void EventBean::UpdateStringMap(const std::string &key, std::string value)
 {
-    if (stringMap_.find(key) != stringMap_.end()) {
-        stringMap_[key] = value;
+    std::string *field = stringFields_.Find(key);
+    if (field != nullptr) {
+        *field = std::move(value);
     }
 }
 
 void EventBean::UpdateUint64Map(const std::string &key, uint64_t value)
 {
-    if (uint64Map_.find(key) != uint64Map_.end()) {
-        uint64Map_[key] = value;
+    uint64_t *field = uint64Fields_.Find(key);
+    if (field != nullptr) {
+        *field = value;
     }
 }
 
 void EventBean::UpdateFloatMap(const std::string &key, float value)
 {
-    if (floatMap_.find(key) != floatMap_.end()) {
-        floatMap_[key] = value;
+    float *field = floatFields_.Find(key);
+    if (field != nullptr) {
+        *field = value;
     }
 }
 } // namespace MediaMonitor
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_keys.h"
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+namespace {
+class KeyTable {
+public:
+    static KeyTable &GetInstance()
+    {
+        static KeyTable instance;
+        return instance;
+    }
+
+    EventKeyId Find(const std::string &key) const
+    {
+        auto it = ids_.find(key);
+        return it == ids_.end() ? INVALID_EVENT_KEY : it->second;
+    }
+
+    const std::string &GetName(EventKeyId id) const
+    {
+        return id < names_.size() ? names_[id] : emptyName_;
+    }
+
+private:
+    KeyTable()
+    {
+        names_.reserve(BUILTIN_EVENT_KEY_COUNT);
+        for (size_t i = 0; i < BUILTIN_EVENT_KEY_COUNT; ++i) {
+            names_.emplace_back(BUILTIN_EVENT_KEYS[i]);
+            ids_.emplace(BUILTIN_EVENT_KEYS[i], static_cast<EventKeyId>(i));
+        }
+    }
+
+    // never written after the constructor, read without a lock
+    std::vector<std::string> names_;
+    std::unordered_map<std::string_view, EventKeyId> ids_;
+    const std::string emptyName_;
+};
+}
+
+EventKeyId EventKeys::Find(const std::string &key)
+{
+    return KeyTable::GetInstance().Find(key);
+}
+
+const std::string &EventKeys::GetName(EventKeyId id)
+{
+    return KeyTable::GetInstance().GetName(id);
+}
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
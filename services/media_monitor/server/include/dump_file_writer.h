@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DUMP_FILE_WRITER_H
+#define DUMP_FILE_WRITER_H
+
+#include <sys/uio.h>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+#include "audio_dump_buffer.h"
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+
+/**
+ * Takes the pcm of one dump stream instead of its file, see DumpFileWriter::Options::encoderFactory.
+ */
+class DumpStreamEncoder {
+public:
+    virtual ~DumpStreamEncoder() = default;
+    virtual int32_t Feed(const uint8_t *data, size_t size) = 0;
+    // leaves a complete file behind, nothing is fed after this
+    virtual int32_t Close() = 0;
+};
+
+/**
+ * Appends dump buffers to the files of one directory. A file stays open between batches, the buffers of a batch
+ * that go to the same file are written with one writev.
+ */
+class DumpFileWriter {
+public:
+    using DumpBuffer = std::pair<std::string, std::shared_ptr<AudioDumpBuffer>>;
+    using EncoderFactory = std::function<std::shared_ptr<DumpStreamEncoder>(const std::string &filePath)>;
+
+    struct Options {
+        // a file that reached this size starts over, 0 lets it grow
+        size_t maxFileSize {0};
+        size_t maxOpenFiles {16}; // 16: least recently written files are closed beyond this
+        int64_t idleCloseMs {3000}; // 3000ms: CloseIdle() closes files not written for this long
+        // when set, .pcm files are handed to an encoder while there are less than maxEncoders of them
+        EncoderFactory encoderFactory;
+        size_t maxEncoders {4}; // 4: encoders hold a frame and a codec each, the other streams stay pcm
+        // 30000ms: CloseIdle() finishes an encoded stream not fed for this long and frees its encoder
+        int64_t encoderIdleCloseMs {30000};
+    };
+
+    struct Stats {
+        uint64_t buffers {0};
+        uint64_t bytes {0};
+        uint64_t writeCalls {0};
+        uint64_t opens {0};
+        uint64_t rotations {0};
+        uint64_t encoders {0};
+    };
+
+    DumpFileWriter(const std::string &dir, const Options &options);
+    ~DumpFileWriter();
+
+    /**
+     * Write and pop every buffer of the queue. Buffers of the same file keep their order.
+     */
+    void Write(std::queue<DumpBuffer> &bufferQueue);
+
+    void CloseIdle();
+    void CloseAll();
+
+    Stats GetStats();
+
+private:
+    struct DumpFile {
+        int fd {-1};
+        size_t size {0};
+        std::chrono::steady_clock::time_point lastWrite;
+        std::vector<struct iovec> pending;
+        size_t pendingBytes {0};
+        // an encoded stream has no fd, closing it finishes its file
+        std::shared_ptr<DumpStreamEncoder> encoder;
+    };
+
+    std::string GetFileName(const std::string &streamName) const;
+    DumpFile *GetFile(const std::string &fileName);
+    std::shared_ptr<DumpStreamEncoder> CreateEncoder(const std::string &fileName);
+    // false when the encoder is gone and the buffer still has to be written as pcm
+    bool Feed(const std::string &fileName, DumpFile &file, const std::shared_ptr<AudioDumpBuffer> &buffer);
+    void ContinueAsPcm(const std::string &fileName);
+    void Append(const std::string &fileName, DumpFile &file, const std::shared_ptr<AudioDumpBuffer> &buffer);
+    void Flush(const std::string &fileName, DumpFile &file);
+    bool Rotate(const std::string &fileName, DumpFile &file);
+    void Close(std::map<std::string, DumpFile>::iterator it);
+
+    std::mutex mutex_;
+    std::string dir_;
+    Options options_;
+    std::map<std::string, DumpFile> files_;
+    Stats stats_;
+    size_t encoderCount_ = 0;
+    // streams kept as pcm from then on: already written as pcm, or their encoder failed or was finished
+    std::set<std::string> pcmStreams_;
+    // pcm file of a stream whose encoded file was left behind by a failed or finished encoder
+    std::map<std::string, std::string> pcmFallback_;
+};
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
+#endif // DUMP_FILE_WRITER_H
@@ -32,6 +32,16 @@ enum DeviceChangeEvent {
     FOR_VOLUME_CHANGE_EVENT
 };
 
+// events of one shard are aggregated in order on one thread, the shards run side by side
+enum EventShard : uint32_t {
+    // device, route and stream changes share the usage vectors, they stay together
+    ROUTE_STREAM_SHARD = 0,
+    FAULT_SHARD,
+    FREQUENCY_SHARD,
+    STATE_SHARD,
+    EVENT_SHARD_COUNT
+};
+
 class EventAggregate {
 public:
     static EventAggregate& GetEventAggregate()
@@ -49,8 +59,18 @@ public:
 
     std::vector<std::shared_ptr<EventBean>> GetUnifiedFaultCodeRecords();
 
+    static uint32_t GetEventShard(EventId eventId);
+
 private:
-    void UpdateAggregateEventList(std::shared_ptr<EventBean> &bean);
+    using EventHandler = void (EventAggregate::*)(std::shared_ptr<EventBean> &bean);
+    struct EventRoute {
+        EventHandler handler = nullptr;
+        EventShard shard = STATE_SHARD;
+    };
+    static constexpr int32_t EVENT_ROUTE_SIZE = KARAOKE_FEATURE_UTILIZATION + 1;
+
+    static const EventRoute *GetEventRoute(EventId eventId);
+    void WritePolicyEvent(std::shared_ptr<EventBean> &bean);
     void HandleDeviceChangeEvent(std::shared_ptr<EventBean> &bean);
     void HandleStreamChangeEvent(std::shared_ptr<EventBean> &bean);
 
@@ -86,7 +106,6 @@ private:
     void HandleSetDeviceCollaborativeState(std::shared_ptr<EventBean> &bean);
     void HandleAppSessionStateChange(std::shared_ptr<EventBean> &bean);
     void HandleAppBackTaskStateChange(std::shared_ptr<EventBean> &bean);
-    void UpdateAggregateStateEventList(std::shared_ptr<EventBean> &bean);
     void HandleVolumeApiInvokeEvent(std::shared_ptr<EventBean> &bean);
     void HandleCallSessionEvent(std::shared_ptr<EventBean> &bean);
     void HandleDistributedDeviceInfo(std::shared_ptr<EventBean> &bean);
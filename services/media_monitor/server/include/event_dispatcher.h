@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_DISPATCHER_H
+#define EVENT_DISPATCHER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "event_bean.h"
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+
+/**
+ * Unbounded multi-producer single-consumer queue. Push() is one atomic exchange, wait free for the binder threads.
+ * Pop() is only called from the consumer thread.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue()
+    {
+        Node *stub = new Node();
+        head_.store(stub, std::memory_order_relaxed);
+        tail_ = stub;
+    }
+
+    ~MpscQueue()
+    {
+        T value;
+        while (Pop(value)) {
+        }
+        delete tail_;
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    void Push(T value)
+    {
+        Node *node = new Node();
+        node->value = std::move(value);
+        Node *prev = head_.exchange(node, std::memory_order_acq_rel);
+        // seq_cst pairs with the sleeping flag of the consumer, see EventDispatcher::Shard
+        prev->next.store(node, std::memory_order_seq_cst);
+    }
+
+    bool Pop(T &value)
+    {
+        Node *next = tail_->next.load(std::memory_order_seq_cst);
+        if (next == nullptr) {
+            return false;
+        }
+        value = std::move(next->value);
+        next->value = T();
+        delete tail_;
+        tail_ = next;
+        return true;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node *> next {nullptr};
+        T value {};
+    };
+
+    std::atomic<Node *> head_ {nullptr};
+    Node *tail_ = nullptr;
+};
+
+/**
+ * Spreads the events over independent shards, one consumer thread each. Events of the same shard are handled in the
+ * order they were dispatched, a slow handler only holds back its own shard.
+ */
+class EventDispatcher {
+public:
+    using EventHandler = std::function<void(std::shared_ptr<EventBean> &bean)>;
+    using ShardSelector = std::function<uint32_t(EventId eventId)>;
+
+    struct Stats {
+        uint64_t dispatched {0};
+        uint64_t handled {0};
+    };
+
+    EventDispatcher(uint32_t shardCount, ShardSelector selector, EventHandler handler);
+    ~EventDispatcher();
+
+    void Start();
+
+    /**
+     * Handle what is queued and stop the shard threads.
+     */
+    void Stop();
+
+    bool Dispatch(std::shared_ptr<EventBean> &bean);
+
+    Stats GetStats() const;
+
+private:
+    struct Shard {
+        MpscQueue<std::shared_ptr<EventBean>> queue;
+        std::atomic<bool> sleeping {false};
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::thread thread;
+        std::atomic<uint64_t> dispatched {0};
+        std::atomic<uint64_t> handled {0};
+    };
+
+    void Wake(Shard &shard);
+    void ShardLoop(Shard &shard);
+    bool Drain(Shard &shard);
+
+    ShardSelector selector_;
+    EventHandler handler_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::mutex stateMutex_;
+    std::atomic<bool> running_ {false};
+    std::atomic<bool> stopping_ {false};
+};
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
+#endif // EVENT_DISPATCHER_H
@@ -19,6 +19,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include "dump_file_writer.h"
 #include "ffmpeg_api_wrap.h"
 
 namespace OHOS {
@@ -68,12 +69,16 @@ private:
     std::shared_ptr<FFmpegApiWrap> apiWrap_ = nullptr;
 };
 
-class MediaAudioEncoder {
+class MediaAudioEncoder : public DumpStreamEncoder {
 public:
     MediaAudioEncoder() {};
-    ~MediaAudioEncoder() {};
+    ~MediaAudioEncoder() override;
     size_t PcmDataSize();
     int32_t EncodePcmFiles(const std::string &fileDir);
+    // encodes one dump stream as it is written, the flac file is where the pcm file would have been
+    int32_t Open(const std::string &pcmFile);
+    int32_t Feed(const uint8_t *data, size_t size) override;
+    int32_t Close() override;
 private:
     int32_t EncodePcmToFlac(const std::string &in);
     int32_t Init(const std::string &inputFile);
@@ -95,6 +100,8 @@ private:
     void ResetEncoderCtx();
     bool DeleteSrcFile(const std::string &filePath);
     bool isInit_ = false;
+    size_t frameBytes_ = 0;
+    std::vector<uint8_t> pendingPcm_;
     std::string fileName_;
     SampleFormat srcSampleFormat_ = SampleFormat::S16LE;
     std::shared_ptr<AVFormatContext> formatContext_ = nullptr;
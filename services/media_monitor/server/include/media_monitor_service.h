@@ -25,7 +25,9 @@
 #include "system_ability.h"
 #include "media_monitor_stub.h"
 #include "event_aggregate.h"
+#include "event_dispatcher.h"
 #include "audio_dump_buffer.h"
+#include "dump_file_writer.h"
 
 namespace OHOS {
 namespace Media {
@@ -33,13 +35,6 @@ namespace MediaMonitor {
 
 class EventAggregate;
 
-struct MessageSignal {
-    std::mutex messageMutex_;
-    std::condition_variable messageCond_;
-    std::queue<std::shared_ptr<EventBean>> messageQueue_;
-    std::atomic<bool> isRunning_ = false;
-};
-
 struct DumpSignal {
     std::mutex dumpMutex_;
     std::condition_variable dumpCond_;
@@ -73,6 +68,8 @@ public:
 
     ErrCode WriteLogMsg(const EventBean &bean)  override;
 
+    ErrCode WriteLogMsgBatch(const std::vector<EventBean> &beans) override;
+
     ErrCode GetAudioRouteMsg(std::unordered_map<int32_t, MonitorDeviceInfo> &preferredDevices,
         int32_t &funcResult) override;
 
@@ -105,16 +102,14 @@ public:
 
 private:
     MediaMonitorService();
-    void MessageLoopFunc();
     void GetMessageFromQueue(std::shared_ptr<EventBean> &message);
     void AddMessageToQueue(std::shared_ptr<EventBean> &message);
+    void AddMessagesToQueue(std::vector<std::shared_ptr<EventBean>> &messages);
     void AudioEncodeDump();
 
     EventAggregate& eventAggregate_;
     AudioMemo& audioMemo_;
-    std::unique_ptr<std::thread> messageLoopThread_ = nullptr;
-    std::shared_ptr<MessageSignal> signal_ = nullptr;
-    bool isExit_ = false;
+    std::unique_ptr<EventDispatcher> eventDispatcher_ = nullptr;
 
     bool VerifyIsAudio();
     bool IsNeedDump();
@@ -129,7 +124,6 @@ private:
     bool DeleteHistoryFile(const std::string &filePath);
     void DumpBufferWrite(std::queue<std::pair<std::string, std::shared_ptr<AudioDumpBuffer>>> &bufferQueue);
     void AddBufferToQueue(const std::string &fileName, std::shared_ptr<AudioDumpBuffer> &buffer);
-    void WriteBufferFromQueue(const std::string &fileName, std::shared_ptr<AudioDumpBuffer> &buffer);
     bool isDumpExit_ = false;
     bool dumpEnable_ = false;
     std::mutex paramMutex_;
@@ -139,6 +133,7 @@ private:
     std::string fileFloader_ = DEFAULT_DUMP_DIR;
     std::unique_ptr<std::thread> dumpLoopThread_ = nullptr;
     std::shared_ptr<DumpSignal> dumpSignal_ = nullptr;
+    std::unique_ptr<DumpFileWriter> dumpFileWriter_ = nullptr;
     std::time_t dumpThreadTime_ = 0;
 };
 
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dump_file_writer.h"
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "log.h"
+#include "monitor_error.h"
+#include "monitor_utils.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_FOUNDATION, "DumpFileWriter"};
+}
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+namespace {
+constexpr size_t MAX_IOV_PER_WRITE = 64; // 64: buffers gathered by one writev, well below IOV_MAX
+constexpr mode_t DUMP_FILE_MODE = 0666; // 0666: what fopen creates files with
+const std::string PCM_SUFFIX = ".pcm";
+// the .flac of an encoder that failed or was finished midway is kept, the rest of its stream becomes a pcm file
+const std::string FALLBACK_PREFIX = "continued_";
+
+bool IsPcmFile(const std::string &fileName)
+{
+    return fileName.size() > PCM_SUFFIX.size() &&
+        fileName.compare(fileName.size() - PCM_SUFFIX.size(), PCM_SUFFIX.size(), PCM_SUFFIX) == 0;
+}
+}
+
+DumpFileWriter::DumpFileWriter(const std::string &dir, const Options &options) : dir_(dir), options_(options)
+{
+    options_.maxOpenFiles = std::max(options_.maxOpenFiles, static_cast<size_t>(1));
+}
+
+DumpFileWriter::~DumpFileWriter()
+{
+    CloseAll();
+}
+
+void DumpFileWriter::Write(std::queue<DumpBuffer> &bufferQueue)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the gathered iovecs point into these buffers until they are flushed
+    std::vector<std::shared_ptr<AudioDumpBuffer>> written;
+    written.reserve(bufferQueue.size());
+    while (!bufferQueue.empty()) {
+        DumpBuffer dumpData = std::move(bufferQueue.front());
+        bufferQueue.pop();
+        if (dumpData.second == nullptr || dumpData.second->data == nullptr || dumpData.second->size == 0) {
+            MEDIA_LOG_E("buffer is nullptr");
+            continue;
+        }
+        std::string fileName = GetFileName(dumpData.first);
+        DumpFile *file = GetFile(fileName);
+        if (file == nullptr) {
+            continue;
+        }
+        if (file->encoder != nullptr) {
+            if (Feed(fileName, *file, dumpData.second)) {
+                continue;
+            }
+            // the encoder is gone, this buffer goes to the pcm file taking the rest of the stream
+            fileName = GetFileName(dumpData.first);
+            file = GetFile(fileName);
+            if (file == nullptr) {
+                continue;
+            }
+        }
+        Append(fileName, *file, dumpData.second);
+        written.push_back(std::move(dumpData.second));
+    }
+    for (auto &it : files_) {
+        Flush(it.first, it.second);
+    }
+}
+
+void DumpFileWriter::CloseIdle()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+    for (auto it = files_.begin(); it != files_.end();) {
+        auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second.lastWrite).count();
+        if (it->second.encoder == nullptr && idle >= options_.idleCloseMs) {
+            Close(it++);
+        } else if (it->second.encoder != nullptr && idle >= options_.encoderIdleCloseMs) {
+            // finishing the encoder frees its slot for another stream, what this one writes later stays pcm
+            MEDIA_LOG_I("%{public}s idle for %{public}lld ms, finish it", it->first.c_str(),
+                static_cast<long long>(idle));
+            std::string fileName = it->first;
+            Close(it++);
+            ContinueAsPcm(fileName);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void DumpFileWriter::CloseAll()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!files_.empty()) {
+        Close(files_.begin());
+    }
+}
+
+DumpFileWriter::Stats DumpFileWriter::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+std::string DumpFileWriter::GetFileName(const std::string &streamName) const
+{
+    auto it = pcmFallback_.find(streamName);
+    return it != pcmFallback_.end() ? it->second : streamName;
+}
+
+DumpFileWriter::DumpFile *DumpFileWriter::GetFile(const std::string &fileName)
+{
+    auto it = files_.find(fileName);
+    if (it != files_.end()) {
+        return &it->second;
+    }
+    if (options_.encoderFactory != nullptr && encoderCount_ < options_.maxEncoders && IsPcmFile(fileName) &&
+        pcmStreams_.count(fileName) == 0) {
+        auto encoder = CreateEncoder(fileName);
+        if (encoder != nullptr) {
+            DumpFile &file = files_[fileName];
+            file.encoder = std::move(encoder);
+            file.lastWrite = std::chrono::steady_clock::now();
+            encoderCount_++;
+            return &file;
+        }
+    }
+    if (files_.size() - encoderCount_ >= options_.maxOpenFiles) {
+        auto oldest = files_.end();
+        for (auto iter = files_.begin(); iter != files_.end(); ++iter) {
+            if (iter->second.encoder == nullptr &&
+                (oldest == files_.end() || iter->second.lastWrite < oldest->second.lastWrite)) {
+                oldest = iter;
+            }
+        }
+        if (oldest != files_.end()) {
+            Close(oldest);
+        }
+    }
+    FALSE_RETURN_V_MSG_E(IsRealPath(dir_), nullptr, "check path failed");
+    std::string filePath = dir_ + fileName;
+    int fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, DUMP_FILE_MODE);
+    FALSE_RETURN_V_MSG_E(fd >= 0, nullptr, "pcm file open failed, errno %{public}d", errno);
+    if (options_.encoderFactory != nullptr) {
+        // an encoder taking over later would truncate what this stream already wrote
+        pcmStreams_.insert(fileName);
+    }
+    struct stat fileStat = {};
+    DumpFile &file = files_[fileName];
+    file.fd = fd;
+    file.size = fstat(fd, &fileStat) == 0 ? static_cast<size_t>(fileStat.st_size) : 0;
+    file.lastWrite = std::chrono::steady_clock::now();
+    stats_.opens++;
+    return &file;
+}
+
+std::shared_ptr<DumpStreamEncoder> DumpFileWriter::CreateEncoder(const std::string &fileName)
+{
+    FALSE_RETURN_V_MSG_E(IsRealPath(dir_), nullptr, "check path failed");
+    auto encoder = options_.encoderFactory(dir_ + fileName);
+    if (encoder == nullptr) {
+        MEDIA_LOG_E("create encoder for %{public}s failed, keep it as pcm", fileName.c_str());
+        pcmStreams_.insert(fileName);
+        return nullptr;
+    }
+    stats_.encoders++;
+    return encoder;
+}
+
+bool DumpFileWriter::Feed(const std::string &fileName, DumpFile &file,
+    const std::shared_ptr<AudioDumpBuffer> &buffer)
+{
+    if (options_.maxFileSize > 0 && file.size >= options_.maxFileSize) {
+        MEDIA_LOG_I("%{public}s reached %{public}zu bytes, start over", fileName.c_str(), file.size);
+        (void)file.encoder->Close();
+        // the factory truncates what the previous encoder left behind
+        file.encoder = CreateEncoder(fileName);
+        file.size = 0;
+        stats_.rotations++;
+        if (file.encoder == nullptr) {
+            encoderCount_--;
+            files_.erase(fileName);
+            ContinueAsPcm(fileName);
+            return false;
+        }
+    }
+    if (file.encoder->Feed(static_cast<const uint8_t *>(buffer->data), buffer->size) != SUCCESS) {
+        MEDIA_LOG_E("encode %{public}s failed, keep the rest as pcm", fileName.c_str());
+        Close(files_.find(fileName));
+        ContinueAsPcm(fileName);
+        return false;
+    }
+    file.size += buffer->size;
+    file.lastWrite = std::chrono::steady_clock::now();
+    stats_.buffers++;
+    stats_.bytes += buffer->size;
+    return true;
+}
+
+void DumpFileWriter::ContinueAsPcm(const std::string &fileName)
+{
+    // the encoded file is already there, AudioEncodeDump() would overwrite it with the pcm of the same name
+    std::string pcmName = FALLBACK_PREFIX + fileName;
+    pcmStreams_.insert(fileName);
+    pcmStreams_.insert(pcmName);
+    pcmFallback_[fileName] = pcmName;
+}
+
+void DumpFileWriter::Append(const std::string &fileName, DumpFile &file,
+    const std::shared_ptr<AudioDumpBuffer> &buffer)
+{
+    if (options_.maxFileSize > 0 && file.size + file.pendingBytes >= options_.maxFileSize) {
+        Flush(fileName, file);
+        if (!Rotate(fileName, file)) {
+            return;
+        }
+    }
+    file.pending.push_back({const_cast<void *>(buffer->data), buffer->size});
+    file.pendingBytes += buffer->size;
+    stats_.buffers++;
+    stats_.bytes += buffer->size;
+    if (file.pending.size() >= MAX_IOV_PER_WRITE) {
+        Flush(fileName, file);
+    }
+}
+
+void DumpFileWriter::Flush(const std::string &fileName, DumpFile &file)
+{
+    size_t index = 0;
+    while (index < file.pending.size()) {
+        int count = static_cast<int>(std::min(file.pending.size() - index, MAX_IOV_PER_WRITE));
+        ssize_t ret = writev(file.fd, &file.pending[index], count);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            MEDIA_LOG_E("write %{public}s failed, errno %{public}d", fileName.c_str(), errno);
+            break;
+        }
+        stats_.writeCalls++;
+        file.size += static_cast<size_t>(ret);
+        // skip what went out, a short write continues inside the iovec it stopped in
+        size_t left = static_cast<size_t>(ret);
+        while (index < file.pending.size() && left >= file.pending[index].iov_len) {
+            left -= file.pending[index].iov_len;
+            index++;
+        }
+        if (left > 0) {
+            file.pending[index].iov_base = static_cast<uint8_t *>(file.pending[index].iov_base) + left;
+            file.pending[index].iov_len -= left;
+        }
+    }
+    if (!file.pending.empty()) {
+        file.lastWrite = std::chrono::steady_clock::now();
+    }
+    file.pending.clear();
+    file.pendingBytes = 0;
+}
+
+bool DumpFileWriter::Rotate(const std::string &fileName, DumpFile &file)
+{
+    MEDIA_LOG_I("%{public}s reached %{public}zu bytes, start over", fileName.c_str(), file.size);
+    std::string filePath = dir_ + fileName;
+    (void)close(file.fd);
+    (void)unlink(filePath.c_str());
+    file.fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, DUMP_FILE_MODE);
+    file.size = 0;
+    stats_.rotations++;
+    if (file.fd < 0) {
+        MEDIA_LOG_E("reopen file failed, errno %{public}d", errno);
+        files_.erase(fileName);
+        return false;
+    }
+    return true;
+}
+
+void DumpFileWriter::Close(std::map<std::string, DumpFile>::iterator it)
+{
+    if (it->second.encoder != nullptr) {
+        (void)it->second.encoder->Close();
+        encoderCount_--;
+        files_.erase(it);
+        return;
+    }
+    Flush(it->first, it->second);
+    (void)close(it->second.fd);
+    files_.erase(it);
+}
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
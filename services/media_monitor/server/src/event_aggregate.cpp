@@ -14,6 +14,7 @@
  */
 
 #include "event_aggregate.h"
+#include <array>
 #include "log.h"
 #include "media_monitor_info.h"
 #include "monitor_utils.h"
@@ -35,6 +36,23 @@ namespace MediaMonitor {
 static constexpr int32_t NEED_INCREASE_FREQUENCY = 30;
 static constexpr int32_t UNINITIALIZED = -1;
 
+// looked up for every bean kept in the aggregate vectors, resolved at compile time
+constexpr EventKeyId KEY_CHANNEL_LAYOUT = FindBuiltinEventKey("CHANNEL_LAYOUT");
+constexpr EventKeyId KEY_DEVICETYPE = FindBuiltinEventKey("DEVICETYPE");
+constexpr EventKeyId KEY_DEVICE_TYPE = FindBuiltinEventKey("DEVICE_TYPE");
+constexpr EventKeyId KEY_ENCODING_TYPE = FindBuiltinEventKey("ENCODING_TYPE");
+constexpr EventKeyId KEY_ISOUTPUT = FindBuiltinEventKey("ISOUTPUT");
+constexpr EventKeyId KEY_IS_PLAYBACK = FindBuiltinEventKey("IS_PLAYBACK");
+constexpr EventKeyId KEY_LEVEL = FindBuiltinEventKey("LEVEL");
+constexpr EventKeyId KEY_PID = FindBuiltinEventKey("PID");
+constexpr EventKeyId KEY_PIPE_TYPE = FindBuiltinEventKey("PIPE_TYPE");
+constexpr EventKeyId KEY_SAMPLE_RATE = FindBuiltinEventKey("SAMPLE_RATE");
+constexpr EventKeyId KEY_STATE = FindBuiltinEventKey("STATE");
+constexpr EventKeyId KEY_STREAMID = FindBuiltinEventKey("STREAMID");
+constexpr EventKeyId KEY_STREAM_TYPE = FindBuiltinEventKey("STREAM_TYPE");
+constexpr EventKeyId KEY_SYSVOLUME = FindBuiltinEventKey("SYSVOLUME");
+constexpr EventKeyId KEY_UID = FindBuiltinEventKey("UID");
+
 EventAggregate::EventAggregate()
     :audioMemo_(AudioMemo::GetAudioMemo()),
     mediaMonitorPolicy_(MediaMonitorPolicy::GetMediaMonitorPolicy())
@@ -47,6 +65,83 @@ EventAggregate::~EventAggregate()
     MEDIA_LOG_D("EventAggregate Destructor");
 }
 
+const EventAggregate::EventRoute *EventAggregate::GetEventRoute(EventId eventId)
+{
+    static const std::array<EventRoute, EVENT_ROUTE_SIZE> routes = [] {
+        std::array<EventRoute, EVENT_ROUTE_SIZE> table {};
+        // the first route of an id wins, like the first matching case of a switch
+        auto add = [&table](EventId id, EventHandler handler, EventShard shard) {
+            if (id >= 0 && id < EVENT_ROUTE_SIZE && table[id].handler == nullptr) {
+                table[id] = {handler, shard};
+            }
+        };
+        const EventHandler writePolicy = &EventAggregate::WritePolicyEvent;
+        add(HEADSET_CHANGE, writePolicy, ROUTE_STREAM_SHARD);
+        add(AUDIO_ROUTE_CHANGE, writePolicy, ROUTE_STREAM_SHARD);
+        add(LOAD_CONFIG_ERROR, writePolicy, FAULT_SHARD);
+        add(APP_WRITE_MUTE, writePolicy, FAULT_SHARD);
+        add(HDI_EXCEPTION, writePolicy, FAULT_SHARD);
+        add(AUDIO_SERVICE_STARTUP_ERROR, writePolicy, FAULT_SHARD);
+        add(STREAM_STANDBY, writePolicy, STATE_SHARD);
+        add(SMARTPA_STATUS, writePolicy, STATE_SHARD);
+        add(DB_ACCESS_EXCEPTION, writePolicy, FAULT_SHARD);
+        add(DEVICE_CHANGE_EXCEPTION, writePolicy, FAULT_SHARD);
+        add(AI_VOICE_NOISE_SUPPRESSION, writePolicy, STATE_SHARD);
+        add(LOAD_EFFECT_ENGINE_ERROR, writePolicy, FAULT_SHARD);
+        add(SYSTEM_TONE_PLAYBACK, writePolicy, FREQUENCY_SHARD);
+        add(ADD_REMOVE_CUSTOMIZED_TONE, writePolicy, STATE_SHARD);
+        add(RECORD_ERROR, writePolicy, FAULT_SHARD);
+        add(STREAM_OCCUPANCY, writePolicy, FREQUENCY_SHARD);
+        add(HPAE_MESSAGE_QUEUE_EXCEPTION, writePolicy, FAULT_SHARD);
+        add(STREAM_MOVE_EXCEPTION, writePolicy, FAULT_SHARD);
+        add(PROCESS_IN_MAINTHREAD, writePolicy, STATE_SHARD);
+        add(SUITE_ENGINE_EXCEPTION, writePolicy, FAULT_SHARD);
+        add(MUTE_BUNDLE_NAME, writePolicy, STATE_SHARD);
+        add(AUDIO_STREAM_CREATE_ERROR_STATS, writePolicy, FREQUENCY_SHARD);
+        add(TONE_PLAYBACK_FAILED, writePolicy, FAULT_SHARD);
+        add(LOOPBACK_EXCEPTION, writePolicy, FAULT_SHARD);
+        add(AUDIO_STREAM_EXHAUSTED_STATS, writePolicy, FREQUENCY_SHARD);
+        add(UNIFIED_FAULT_CODE, &EventAggregate::AddToUnifiedFaultCodeVector, FAULT_SHARD);
+
+        add(DEVICE_CHANGE, &EventAggregate::HandleDeviceChangeEvent, ROUTE_STREAM_SHARD);
+        add(STREAM_CHANGE, &EventAggregate::HandleStreamChangeEvent, ROUTE_STREAM_SHARD);
+        add(BACKGROUND_SILENT_PLAYBACK, &EventAggregate::HandleBackgroundSilentPlayback, FREQUENCY_SHARD);
+        add(PERFORMANCE_UNDER_OVERRUN_STATS, &EventAggregate::HandleUnderrunStatistic, FREQUENCY_SHARD);
+        add(SET_FORCE_USE_AUDIO_DEVICE, &EventAggregate::HandleForceUseDevice, ROUTE_STREAM_SHARD);
+        add(CAPTURE_MUTE_STATUS_CHANGE, &EventAggregate::HandleCaptureMutedStatusChange, ROUTE_STREAM_SHARD);
+        add(VOLUME_CHANGE, &EventAggregate::HandleVolumeChange, ROUTE_STREAM_SHARD);
+        add(AUDIO_PIPE_CHANGE, &EventAggregate::HandlePipeChange, ROUTE_STREAM_SHARD);
+        add(AUDIO_FOCUS_MIGRATE, &EventAggregate::HandleFocusMigrate, ROUTE_STREAM_SHARD);
+        add(JANK_PLAYBACK, &EventAggregate::HandleJankPlaybackEvent, FAULT_SHARD);
+        add(EXCLUDE_OUTPUT_DEVICE, &EventAggregate::HandleExcludedOutputDevices, ROUTE_STREAM_SHARD);
+
+        add(SET_DEVICE_COLLABORATIVE_STATE, &EventAggregate::HandleSetDeviceCollaborativeState, STATE_SHARD);
+        add(APP_SESSION_STATE, &EventAggregate::HandleAppSessionStateChange, STATE_SHARD);
+        add(APP_BACKTASK_STATE, &EventAggregate::HandleAppBackTaskStateChange, STATE_SHARD);
+        add(VOLUME_API_INVOKE, &EventAggregate::HandleVolumeApiInvokeEvent, FREQUENCY_SHARD);
+        add(HAP_CALL_AUDIO_SESSION, &EventAggregate::HandleCallSessionEvent, FREQUENCY_SHARD);
+        add(DISTRIBUTED_DEVICE_INFO, &EventAggregate::HandleDistributedDeviceInfo, STATE_SHARD);
+        add(DISTRIBUTED_SCENE_INFO, &EventAggregate::HandleDistributedSceneInfo, STATE_SHARD);
+        add(DM_DEVICE_INFO, &EventAggregate::HandleDmDeviceInfo, STATE_SHARD);
+        add(SUITE_ENGINE_UTILIZATION_STATS, &EventAggregate::HandleSuiteEngineUtilizationStats, FREQUENCY_SHARD);
+        add(VOLUME_SETTING_STATISTICS, &EventAggregate::HandleVolumeSettingStatisticsEvent, FREQUENCY_SHARD);
+        add(INTERRUPT_ERROR, &EventAggregate::HandleAudioInterruptErrorEvent, FAULT_SHARD);
+        add(AUDIO_PLAYBACK_ERROR, &EventAggregate::HandleAudioPlaybackErrorEvent, FAULT_SHARD);
+        add(KARAOKE_FEATURE_UTILIZATION, &EventAggregate::HandleKaraokeFeatureEvent, FREQUENCY_SHARD);
+        return table;
+    }();
+    if (eventId < 0 || eventId >= EVENT_ROUTE_SIZE) {
+        return nullptr;
+    }
+    return &routes[eventId];
+}
+
+uint32_t EventAggregate::GetEventShard(EventId eventId)
+{
+    const EventRoute *route = GetEventRoute(eventId);
+    return route == nullptr ? STATE_SHARD : route->shard;
+}
+
 void EventAggregate::WriteEvent(std::shared_ptr<EventBean> &bean)
 {
     MEDIA_LOG_D("WriteEvent enter");
@@ -55,135 +150,17 @@ void EventAggregate::WriteEvent(std::shared_ptr<EventBean> &bean)
         return;
     }
 
-    EventId eventId = bean->GetEventId();
-    switch (eventId) {
-        case HEADSET_CHANGE:
-        case AUDIO_ROUTE_CHANGE:
-        case LOAD_CONFIG_ERROR:
-        case APP_WRITE_MUTE:
-        case HDI_EXCEPTION:
-        case AUDIO_SERVICE_STARTUP_ERROR:
-        case STREAM_STANDBY:
-        case SMARTPA_STATUS:
-        case DB_ACCESS_EXCEPTION:
-        case DEVICE_CHANGE_EXCEPTION:
-        case AI_VOICE_NOISE_SUPPRESSION:
-        case LOAD_EFFECT_ENGINE_ERROR:
-        case SYSTEM_TONE_PLAYBACK:
-        case ADD_REMOVE_CUSTOMIZED_TONE:
-        case RECORD_ERROR:
-        case STREAM_OCCUPANCY:
-        case HPAE_MESSAGE_QUEUE_EXCEPTION:
-        case STREAM_MOVE_EXCEPTION:
-        case PROCESS_IN_MAINTHREAD:
-        case SUITE_ENGINE_EXCEPTION:
-        case MUTE_BUNDLE_NAME:
-        case AUDIO_STREAM_CREATE_ERROR_STATS:
-        case TONE_PLAYBACK_FAILED:
-        case LOOPBACK_EXCEPTION:
-        case AUDIO_STREAM_EXHAUSTED_STATS:
-            mediaMonitorPolicy_.WriteEvent(bean->GetEventId(), bean);
-            break;
-        case UNIFIED_FAULT_CODE:
-            AddToUnifiedFaultCodeVector(bean);
-            break;
-        default:
-            UpdateAggregateEventList(bean);
-            break;
-    }
-}
-
-void EventAggregate::UpdateAggregateEventList(std::shared_ptr<EventBean> &bean)
-{
-    MEDIA_LOG_D("Update Aggregate Event List");
-    EventId eventId = bean->GetEventId();
-    switch (eventId) {
-        case DEVICE_CHANGE:
-            HandleDeviceChangeEvent(bean);
-            break;
-        case STREAM_CHANGE:
-            HandleStreamChangeEvent(bean);
-            break;
-        case BACKGROUND_SILENT_PLAYBACK:
-            HandleBackgroundSilentPlayback(bean);
-            break;
-        case PERFORMANCE_UNDER_OVERRUN_STATS:
-            HandleUnderrunStatistic(bean);
-            break;
-        case SET_FORCE_USE_AUDIO_DEVICE:
-            HandleForceUseDevice(bean);
-            break;
-        case CAPTURE_MUTE_STATUS_CHANGE:
-            HandleCaptureMutedStatusChange(bean);
-            break;
-        case VOLUME_CHANGE:
-            HandleVolumeChange(bean);
-            break;
-        case AUDIO_PIPE_CHANGE:
-            HandlePipeChange(bean);
-            break;
-        case AUDIO_FOCUS_MIGRATE:
-            HandleFocusMigrate(bean);
-            break;
-        case JANK_PLAYBACK:
-            HandleJankPlaybackEvent(bean);
-            break;
-        case EXCLUDE_OUTPUT_DEVICE:
-            HandleExcludedOutputDevices(bean);
-            break;
-        default:
-            UpdateAggregateStateEventList(bean);
-            break;
+    const EventRoute *route = GetEventRoute(bean->GetEventId());
+    if (route == nullptr || route->handler == nullptr) {
+        MEDIA_LOG_D("no handler for event %{public}d", bean->GetEventId());
+        return;
     }
+    (this->*(route->handler))(bean);
 }
 
-void EventAggregate::UpdateAggregateStateEventList(std::shared_ptr<EventBean> &bean)
-{
-    MEDIA_LOG_D("Update Aggregate State Event List");
-    EventId eventId = bean->GetEventId();
-    switch (eventId) {
-        case SET_DEVICE_COLLABORATIVE_STATE:
-            HandleSetDeviceCollaborativeState(bean);
-            break;
-        case APP_SESSION_STATE:
-            HandleAppSessionStateChange(bean);
-            break;
-        case APP_BACKTASK_STATE:
-            HandleAppBackTaskStateChange(bean);
-            break;
-        case VOLUME_API_INVOKE:
-            HandleVolumeApiInvokeEvent(bean);
-            break;
-        case HAP_CALL_AUDIO_SESSION:
-            HandleCallSessionEvent(bean);
-            break;
-        case DISTRIBUTED_DEVICE_INFO:
-            HandleDistributedDeviceInfo(bean);
-            break;
-        case DISTRIBUTED_SCENE_INFO:
-            HandleDistributedSceneInfo(bean);
-            break;
-        case DM_DEVICE_INFO:
-            HandleDmDeviceInfo(bean);
-            break;
-        case SUITE_ENGINE_UTILIZATION_STATS:
-            HandleSuiteEngineUtilizationStats(bean);
-            break;
-        case VOLUME_SETTING_STATISTICS:
-            HandleVolumeSettingStatisticsEvent(bean);
-            break;
-        case INTERRUPT_ERROR:
-            HandleAudioInterruptErrorEvent(bean);
-            break;
-        case AUDIO_PLAYBACK_ERROR:
-            HandleAudioPlaybackErrorEvent(bean);
-            break;
-        case KARAOKE_FEATURE_UTILIZATION:
-            HandleKaraokeFeatureEvent(bean);
-            break;
-        default:
-            break;
-    }
+void EventAggregate::WritePolicyEvent(std::shared_ptr<EventBean> &bean)
+{
+    mediaMonitorPolicy_.WriteEvent(bean->GetEventId(), bean);
 }
 
 void EventAggregate::HandleDistributedDeviceInfo(std::shared_ptr<EventBean> &bean)
@@ -235,8 +212,8 @@ void EventAggregate::HandleDeviceChangeForDeviceUsage(std::shared_ptr<EventBean>
 {
     MEDIA_LOG_D("Handle device change for device event aggregate.");
     auto isExist = [&bean](const std::shared_ptr<EventBean> &deviceUsageBean) {
-        if (bean->GetIntValue("ISOUTPUT") == deviceUsageBean->GetIntValue("IS_PLAYBACK") &&
-            bean->GetIntValue("STREAMID") == deviceUsageBean->GetIntValue("STREAMID")) {
+        if (bean->GetIntValue(KEY_ISOUTPUT) == deviceUsageBean->GetIntValue(KEY_IS_PLAYBACK) &&
+            bean->GetIntValue(KEY_STREAMID) == deviceUsageBean->GetIntValue(KEY_STREAMID)) {
             MEDIA_LOG_D("Find the existing device usage");
             return true;
         }
@@ -257,7 +234,7 @@ void EventAggregate::HandleDeviceChangeForCaptureMuted(std::shared_ptr<EventBean
         return;
     }
     auto isExist = [&bean](const std::shared_ptr<EventBean> &captureMutedBean) {
-        if (bean->GetIntValue("STREAMID") == captureMutedBean->GetIntValue("STREAMID")) {
+        if (bean->GetIntValue(KEY_STREAMID) == captureMutedBean->GetIntValue(KEY_STREAMID)) {
             MEDIA_LOG_D("Find the existing capture muted");
             return true;
         }
@@ -277,7 +254,7 @@ void EventAggregate::HandleDeviceChangeForVolume(std::shared_ptr<EventBean> &bea
         return;
     }
     auto isExist = [&bean](const std::shared_ptr<EventBean> &volumeBean) {
-        if (bean->GetIntValue("STREAMID") == volumeBean->GetIntValue("STREAMID")) {
+        if (bean->GetIntValue(KEY_STREAMID) == volumeBean->GetIntValue(KEY_STREAMID)) {
             MEDIA_LOG_D("Find the existing volume");
             return true;
         }
@@ -338,13 +315,13 @@ void EventAggregate::AddToDeviceUsage(std::shared_ptr<EventBean> &bean, uint64_t
 {
     MEDIA_LOG_D("Add to device usage from stream change event");
     auto isExist = [&bean](const std::shared_ptr<EventBean> &eventBean) {
-        if (bean->GetIntValue("ISOUTPUT") == eventBean->GetIntValue("IS_PLAYBACK") &&
-            bean->GetIntValue("STREAMID") == eventBean->GetIntValue("STREAMID") &&
-            bean->GetIntValue("UID") == eventBean->GetIntValue("UID") &&
-            bean->GetIntValue("PID") == eventBean->GetIntValue("PID") &&
-            bean->GetIntValue("STREAM_TYPE") == eventBean->GetIntValue("STREAM_TYPE") &&
-            bean->GetIntValue("STATE") == eventBean->GetIntValue("STATE") &&
-            bean->GetIntValue("DEVICETYPE") == eventBean->GetIntValue("DEVICE_TYPE")) {
+        if (bean->GetIntValue(KEY_ISOUTPUT) == eventBean->GetIntValue(KEY_IS_PLAYBACK) &&
+            bean->GetIntValue(KEY_STREAMID) == eventBean->GetIntValue(KEY_STREAMID) &&
+            bean->GetIntValue(KEY_UID) == eventBean->GetIntValue(KEY_UID) &&
+            bean->GetIntValue(KEY_PID) == eventBean->GetIntValue(KEY_PID) &&
+            bean->GetIntValue(KEY_STREAM_TYPE) == eventBean->GetIntValue(KEY_STREAM_TYPE) &&
+            bean->GetIntValue(KEY_STATE) == eventBean->GetIntValue(KEY_STATE) &&
+            bean->GetIntValue(KEY_DEVICETYPE) == eventBean->GetIntValue(KEY_DEVICE_TYPE)) {
             MEDIA_LOG_D("Find the existing device usage");
             return true;
         }
@@ -376,14 +353,14 @@ void EventAggregate::AddToStreamUsage(std::shared_ptr<EventBean> &bean, uint64_t
 {
     MEDIA_LOG_D("Add to stream usage from stream change event");
     auto isExist = [&bean](const std::shared_ptr<EventBean> &eventBean) {
-        if (bean->GetIntValue("STREAMID") == eventBean->GetIntValue("STREAMID") &&
-            bean->GetIntValue("UID") == eventBean->GetIntValue("UID") &&
-            bean->GetIntValue("PID") == eventBean->GetIntValue("PID") &&
-            bean->GetIntValue("STREAM_TYPE") == eventBean->GetIntValue("STREAM_TYPE") &&
-            bean->GetIntValue("DEVICETYPE") == eventBean->GetIntValue("DEVICE_TYPE") &&
-            bean->GetIntValue("ISOUTPUT") == eventBean->GetIntValue("IS_PLAYBACK") &&
-            bean->GetIntValue("PIPE_TYPE") == eventBean->GetIntValue("PIPE_TYPE") &&
-            bean->GetIntValue("SAMPLE_RATE") == eventBean->GetIntValue("SAMPLE_RATE")) {
+        if (bean->GetIntValue(KEY_STREAMID) == eventBean->GetIntValue(KEY_STREAMID) &&
+            bean->GetIntValue(KEY_UID) == eventBean->GetIntValue(KEY_UID) &&
+            bean->GetIntValue(KEY_PID) == eventBean->GetIntValue(KEY_PID) &&
+            bean->GetIntValue(KEY_STREAM_TYPE) == eventBean->GetIntValue(KEY_STREAM_TYPE) &&
+            bean->GetIntValue(KEY_DEVICETYPE) == eventBean->GetIntValue(KEY_DEVICE_TYPE) &&
+            bean->GetIntValue(KEY_ISOUTPUT) == eventBean->GetIntValue(KEY_IS_PLAYBACK) &&
+            bean->GetIntValue(KEY_PIPE_TYPE) == eventBean->GetIntValue(KEY_PIPE_TYPE) &&
+            bean->GetIntValue(KEY_SAMPLE_RATE) == eventBean->GetIntValue(KEY_SAMPLE_RATE)) {
             MEDIA_LOG_D("Find the existing stream usage");
             return true;
         }
@@ -414,11 +391,11 @@ void EventAggregate::AddToStreamPropertyVector(std::shared_ptr<EventBean> &bean,
 {
     MEDIA_LOG_D("Add to stream prorerty vector from stream change event");
     auto isExist = [&bean](const std::shared_ptr<EventBean> &eventBean) {
-        if (bean->GetUint64Value("CHANNEL_LAYOUT") == eventBean->GetUint64Value("CHANNEL_LAYOUT") &&
-            bean->GetIntValue("UID") == eventBean->GetIntValue("UID") &&
-            bean->GetIntValue("ENCODING_TYPE") == eventBean->GetIntValue("ENCODING_TYPE") &&
-            bean->GetIntValue("STREAM_TYPE") == eventBean->GetIntValue("STREAM_TYPE") &&
-            bean->GetIntValue("ISOUTPUT") == eventBean->GetIntValue("IS_PLAYBACK")) {
+        if (bean->GetUint64Value(KEY_CHANNEL_LAYOUT) == eventBean->GetUint64Value(KEY_CHANNEL_LAYOUT) &&
+            bean->GetIntValue(KEY_UID) == eventBean->GetIntValue(KEY_UID) &&
+            bean->GetIntValue(KEY_ENCODING_TYPE) == eventBean->GetIntValue(KEY_ENCODING_TYPE) &&
+            bean->GetIntValue(KEY_STREAM_TYPE) == eventBean->GetIntValue(KEY_STREAM_TYPE) &&
+            bean->GetIntValue(KEY_ISOUTPUT) == eventBean->GetIntValue(KEY_IS_PLAYBACK)) {
             MEDIA_LOG_D("Find the existing stream property");
             return true;
         }
@@ -453,9 +430,9 @@ void EventAggregate::AddToCaptureMuteUsage(std::shared_ptr<EventBean> &bean, uin
         return;
     }
     auto isExist = [&bean](const std::shared_ptr<EventBean> &eventBean) {
-        if (bean->GetIntValue("STREAMID") == eventBean->GetIntValue("STREAMID") &&
-            bean->GetIntValue("STREAM_TYPE") == eventBean->GetIntValue("STREAM_TYPE") &&
-            bean->GetIntValue("DEVICETYPE") == eventBean->GetIntValue("DEVICE_TYPE")) {
+        if (bean->GetIntValue(KEY_STREAMID) == eventBean->GetIntValue(KEY_STREAMID) &&
+            bean->GetIntValue(KEY_STREAM_TYPE) == eventBean->GetIntValue(KEY_STREAM_TYPE) &&
+            bean->GetIntValue(KEY_DEVICETYPE) == eventBean->GetIntValue(KEY_DEVICE_TYPE)) {
             MEDIA_LOG_D("Find the existing capture muted usage");
             return true;
         }
@@ -482,7 +459,7 @@ void EventAggregate::AddToVolumeVector(std::shared_ptr<EventBean> &bean, uint64_
         return;
     }
     auto isExist = [&bean](const std::shared_ptr<EventBean> &volumeBean) {
-        if (bean->GetIntValue("STREAMID") == volumeBean->GetIntValue("STREAMID")) {
+        if (bean->GetIntValue(KEY_STREAMID) == volumeBean->GetIntValue(KEY_STREAMID)) {
             MEDIA_LOG_D("Find the existing capture volume vector");
             return true;
         }
@@ -506,12 +483,12 @@ void EventAggregate::HandleDeviceUsage(std::shared_ptr<EventBean> &bean)
 {
     MEDIA_LOG_D("Handle device usage");
     auto isExist = [&bean](const std::shared_ptr<EventBean> &deviceUsageBean) {
-        if (bean->GetIntValue("STREAMID") == deviceUsageBean->GetIntValue("STREAMID") &&
-            bean->GetIntValue("UID") == deviceUsageBean->GetIntValue("UID") &&
-            bean->GetIntValue("PID") == deviceUsageBean->GetIntValue("PID") &&
-            bean->GetIntValue("STREAM_TYPE") == deviceUsageBean->GetIntValue("STREAM_TYPE") &&
-            bean->GetIntValue("DEVICETYPE") == deviceUsageBean->GetIntValue("DEVICE_TYPE") &&
-            bean->GetIntValue("ISOUTPUT") == deviceUsageBean->GetIntValue("IS_PLAYBACK")) {
+        if (bean->GetIntValue(KEY_STREAMID) == deviceUsageBean->GetIntValue(KEY_STREAMID) &&
+            bean->GetIntValue(KEY_UID) == deviceUsageBean->GetIntValue(KEY_UID) &&
+            bean->GetIntValue(KEY_PID) == deviceUsageBean->GetIntValue(KEY_PID) &&
+            bean->GetIntValue(KEY_STREAM_TYPE) == deviceUsageBean->GetIntValue(KEY_STREAM_TYPE) &&
+            bean->GetIntValue(KEY_DEVICETYPE) == deviceUsageBean->GetIntValue(KEY_DEVICE_TYPE) &&
+            bean->GetIntValue(KEY_ISOUTPUT) == deviceUsageBean->GetIntValue(KEY_IS_PLAYBACK)) {
             MEDIA_LOG_D("Find the existing device usage");
             return true;
         }
@@ -538,13 +515,13 @@ void EventAggregate::HandleStreamUsage(std::shared_ptr<EventBean> &bean)
 {
     MEDIA_LOG_D("Handle stream usage");
     auto isExist = [&bean](const std::shared_ptr<EventBean> &streamUsageBean) {
-        if (bean->GetIntValue("STREAMID") == streamUsageBean->GetIntValue("STREAMID") &&
-            bean->GetIntValue("UID") == streamUsageBean->GetIntValue("UID") &&
-            bean->GetIntValue("PID") == streamUsageBean->GetIntValue("PID") &&
-            bean->GetIntValue("STREAM_TYPE") == streamUsageBean->GetIntValue("STREAM_TYPE") &&
-            bean->GetIntValue("ISOUTPUT") == streamUsageBean->GetIntValue("IS_PLAYBACK") &&
-            bean->GetIntValue("PIPE_TYPE") == streamUsageBean->GetIntValue("PIPE_TYPE") &&
-            bean->GetIntValue("SAMPLE_RATE") == streamUsageBean->GetIntValue("SAMPLE_RATE")) {
+        if (bean->GetIntValue(KEY_STREAMID) == streamUsageBean->GetIntValue(KEY_STREAMID) &&
+            bean->GetIntValue(KEY_UID) == streamUsageBean->GetIntValue(KEY_UID) &&
+            bean->GetIntValue(KEY_PID) == streamUsageBean->GetIntValue(KEY_PID) &&
+            bean->GetIntValue(KEY_STREAM_TYPE) == streamUsageBean->GetIntValue(KEY_STREAM_TYPE) &&
+            bean->GetIntValue(KEY_ISOUTPUT) == streamUsageBean->GetIntValue(KEY_IS_PLAYBACK) &&
+            bean->GetIntValue(KEY_PIPE_TYPE) == streamUsageBean->GetIntValue(KEY_PIPE_TYPE) &&
+            bean->GetIntValue(KEY_SAMPLE_RATE) == streamUsageBean->GetIntValue(KEY_SAMPLE_RATE)) {
             MEDIA_LOG_D("Find the existing stream usage");
             return true;
         }
@@ -566,11 +543,11 @@ void EventAggregate::HandleStreamPropertyStats(std::shared_ptr<EventBean> &bean)
 {
     MEDIA_LOG_D("Handle stream property stats");
     auto isExist = [&bean](const std::shared_ptr<EventBean> &streamPropertyBean) {
-        if (bean->GetUint64Value("CHANNEL_LAYOUT") == streamPropertyBean->GetUint64Value("CHANNEL_LAYOUT") &&
-            bean->GetIntValue("UID") == streamPropertyBean->GetIntValue("UID") &&
-            bean->GetIntValue("ENCODING_TYPE") == streamPropertyBean->GetIntValue("ENCODING_TYPE") &&
-            bean->GetIntValue("STREAM_TYPE") == streamPropertyBean->GetIntValue("STREAM_TYPE") &&
-            bean->GetIntValue("ISOUTPUT") == streamPropertyBean->GetIntValue("IS_PLAYBACK")) {
+        if (bean->GetUint64Value(KEY_CHANNEL_LAYOUT) == streamPropertyBean->GetUint64Value(KEY_CHANNEL_LAYOUT) &&
+            bean->GetIntValue(KEY_UID) == streamPropertyBean->GetIntValue(KEY_UID) &&
+            bean->GetIntValue(KEY_ENCODING_TYPE) == streamPropertyBean->GetIntValue(KEY_ENCODING_TYPE) &&
+            bean->GetIntValue(KEY_STREAM_TYPE) == streamPropertyBean->GetIntValue(KEY_STREAM_TYPE) &&
+            bean->GetIntValue(KEY_ISOUTPUT) == streamPropertyBean->GetIntValue(KEY_IS_PLAYBACK)) {
             MEDIA_LOG_D("Find the existing stream property");
             return true;
         }
@@ -596,9 +573,9 @@ void EventAggregate::HandleCaptureMuted(std::shared_ptr<EventBean> &bean)
         return;
     }
     auto isExist = [&bean](const std::shared_ptr<EventBean> &captureMutedBean) {
-        if (bean->GetIntValue("STREAMID") == captureMutedBean->GetIntValue("STREAMID") &&
-            bean->GetIntValue("STREAM_TYPE") == captureMutedBean->GetIntValue("STREAM_TYPE") &&
-            bean->GetIntValue("DEVICETYPE") == captureMutedBean->GetIntValue("DEVICE_TYPE")) {
+        if (bean->GetIntValue(KEY_STREAMID) == captureMutedBean->GetIntValue(KEY_STREAMID) &&
+            bean->GetIntValue(KEY_STREAM_TYPE) == captureMutedBean->GetIntValue(KEY_STREAM_TYPE) &&
+            bean->GetIntValue(KEY_DEVICETYPE) == captureMutedBean->GetIntValue(KEY_DEVICE_TYPE)) {
             MEDIA_LOG_D("Find the existing capture muted");
             return true;
         }
@@ -620,10 +597,10 @@ void EventAggregate::HandleStreamChangeForVolume(std::shared_ptr<EventBean> &bea
 {
     MEDIA_LOG_D("Handle stream Change for volume");
     auto isExist = [&bean](const std::shared_ptr<EventBean> &volumeBean) {
-        if (bean->GetIntValue("ISOUTPUT") &&
-            bean->GetIntValue("STREAMID") == volumeBean->GetIntValue("STREAMID") &&
-            bean->GetIntValue("STREAM_TYPE") == volumeBean->GetIntValue("STREAM_TYPE") &&
-            bean->GetIntValue("DEVICETYPE") == volumeBean->GetIntValue("DEVICE_TYPE")) {
+        if (bean->GetIntValue(KEY_ISOUTPUT) &&
+            bean->GetIntValue(KEY_STREAMID) == volumeBean->GetIntValue(KEY_STREAMID) &&
+            bean->GetIntValue(KEY_STREAM_TYPE) == volumeBean->GetIntValue(KEY_STREAM_TYPE) &&
+            bean->GetIntValue(KEY_DEVICETYPE) == volumeBean->GetIntValue(KEY_DEVICE_TYPE)) {
             MEDIA_LOG_D("Find the existing volume vector");
             return true;
         }
@@ -663,8 +640,8 @@ void EventAggregate::HandleVolumeChange(std::shared_ptr<EventBean> &bean)
         return;
     }
     auto isExist = [&bean](const std::shared_ptr<EventBean> &volumeBean) {
-        if (bean->GetIntValue("STREAMID") == volumeBean->GetIntValue("STREAMID") &&
-            bean->GetIntValue("SYSVOLUME") != volumeBean->GetIntValue("LEVEL")) {
+        if (bean->GetIntValue(KEY_STREAMID) == volumeBean->GetIntValue(KEY_STREAMID) &&
+            bean->GetIntValue(KEY_SYSVOLUME) != volumeBean->GetIntValue(KEY_LEVEL)) {
             MEDIA_LOG_D("Find the existing volume vector");
             return true;
         }
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_dispatcher.h"
+#include "log.h"
+
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_FOUNDATION, "EventDispatcher"};
+}
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+namespace {
+constexpr int32_t IDLE_SPIN_ROUNDS = 16; // 16: yields before a shard sleeps, a burst rarely needs a wake up
+}
+
+EventDispatcher::EventDispatcher(uint32_t shardCount, ShardSelector selector, EventHandler handler)
+    : selector_(std::move(selector)), handler_(std::move(handler))
+{
+    shardCount = shardCount == 0 ? 1 : shardCount;
+    for (uint32_t i = 0; i < shardCount; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+EventDispatcher::~EventDispatcher()
+{
+    Stop();
+}
+
+void EventDispatcher::Start()
+{
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    if (running_.load()) {
+        return;
+    }
+    stopping_.store(false);
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        Shard &shard = *shards_[i];
+        shard.thread = std::thread([this, &shard] { ShardLoop(shard); });
+        std::string name = "MMEventShard" + std::to_string(i);
+        pthread_setname_np(shard.thread.native_handle(), name.c_str());
+    }
+    running_.store(true);
+    MEDIA_LOG_I("event dispatcher started with %{public}zu shards", shards_.size());
+}
+
+void EventDispatcher::Stop()
+{
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    if (!running_.load()) {
+        return;
+    }
+    running_.store(false);
+    stopping_.store(true);
+    for (auto &shard : shards_) {
+        {
+            std::lock_guard<std::mutex> shardLock(shard->mutex);
+        }
+        shard->cond.notify_all();
+        if (shard->thread.joinable()) {
+            shard->thread.join();
+        }
+        // the threads are gone, what came in meanwhile is handled here
+        (void)Drain(*shard);
+    }
+    MEDIA_LOG_I("event dispatcher stopped");
+}
+
+bool EventDispatcher::Dispatch(std::shared_ptr<EventBean> &bean)
+{
+    if (bean == nullptr) {
+        MEDIA_LOG_E("eventBean is nullptr");
+        return false;
+    }
+    if (!running_.load(std::memory_order_acquire)) {
+        MEDIA_LOG_E("!isRunning_");
+        return false;
+    }
+    uint32_t index = selector_ ? selector_(bean->GetEventId()) : 0;
+    Shard &shard = *shards_[index < shards_.size() ? index : 0];
+    shard.dispatched.fetch_add(1, std::memory_order_relaxed);
+    shard.queue.Push(bean);
+    Wake(shard);
+    return true;
+}
+
+EventDispatcher::Stats EventDispatcher::GetStats() const
+{
+    Stats stats;
+    for (auto &shard : shards_) {
+        stats.dispatched += shard->dispatched.load(std::memory_order_relaxed);
+        stats.handled += shard->handled.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void EventDispatcher::Wake(Shard &shard)
+{
+    // only a producer that finds the consumer asleep touches the mutex
+    if (shard.sleeping.exchange(false, std::memory_order_seq_cst)) {
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+        }
+        shard.cond.notify_one();
+    }
+}
+
+bool EventDispatcher::Drain(Shard &shard)
+{
+    bool handled = false;
+    std::shared_ptr<EventBean> bean;
+    while (shard.queue.Pop(bean)) {
+        handled = true;
+        if (handler_) {
+            handler_(bean);
+        }
+        bean = nullptr;
+        shard.handled.fetch_add(1, std::memory_order_relaxed);
+    }
+    return handled;
+}
+
+void EventDispatcher::ShardLoop(Shard &shard)
+{
+    while (true) {
+        if (Drain(shard)) {
+            continue;
+        }
+        if (stopping_.load()) {
+            break;
+        }
+        bool drained = false;
+        for (int32_t i = 0; i < IDLE_SPIN_ROUNDS && !drained; ++i) {
+            std::this_thread::yield();
+            drained = Drain(shard);
+        }
+        if (drained) {
+            continue;
+        }
+        shard.sleeping.store(true, std::memory_order_seq_cst);
+        // a push that raced with going to sleep is seen here or wakes us up
+        if (Drain(shard)) {
+            shard.sleeping.store(false, std::memory_order_seq_cst);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        shard.cond.wait(lock, [this, &shard] {
+            return !shard.sleeping.load(std::memory_order_seq_cst) || stopping_.load();
+        });
+        shard.sleeping.store(false, std::memory_order_seq_cst);
+    }
+}
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
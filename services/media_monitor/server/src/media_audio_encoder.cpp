@@ -14,6 +14,7 @@
  */
 
 #include "media_audio_encoder.h"
+#include <algorithm>
 #include <filesystem>
 #include <sstream>
 #include <map>
@@ -23,6 +24,11 @@
 #include "monitor_error.h"
 #include "monitor_utils.h"
 #include "string_converter.h"
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, LOG_DOMAIN_FOUNDATION, "HiStreamer"};
@@ -180,6 +186,83 @@ int32_t MediaAudioEncoder::EncodePcmFiles(const std::string &fileDir)
     return SUCCESS;
 }
 
+MediaAudioEncoder::~MediaAudioEncoder()
+{
+    if (frameBytes_ > 0) {
+        (void)Close();
+    }
+}
+
+int32_t MediaAudioEncoder::Open(const std::string &pcmFile)
+{
+    FALSE_RETURN_V_MSG_E(apiWrap_ == nullptr, ERROR, "encoder is in use");
+    apiWrap_ = std::make_shared<FFmpegApiWrap>();
+    if (!apiWrap_->Open()) {
+        apiWrap_->Close();
+        MEDIA_LOG_E("load encoder api failed");
+        apiWrap_ = nullptr;
+        return ERROR;
+    }
+    size_t frameBytes = 0;
+    if (Init(pcmFile) == SUCCESS) {
+        frameBytes = PcmDataSize();
+    }
+    if (frameBytes == 0 || frameBytes > MAX_BUFFER_LEN) {
+        MEDIA_LOG_E("open encoder for %{public}s failed", pcmFile.c_str());
+        Release();
+        apiWrap_->Close();
+        apiWrap_ = nullptr;
+        return ERROR;
+    }
+    frameBytes_ = frameBytes;
+    pendingPcm_.reserve(frameBytes_);
+    MEDIA_LOG_I("encode %{public}s while dumping", fileName_.c_str());
+    return SUCCESS;
+}
+
+int32_t MediaAudioEncoder::Feed(const uint8_t *data, size_t size)
+{
+    FALSE_RETURN_V_MSG_E(isInit_ == true && frameBytes_ > 0, ERROR, "init error");
+    FALSE_RETURN_V_MSG_E(data != nullptr, ERROR, "buffer nullptr");
+    int32_t ret = SUCCESS;
+    while (size > 0 && ret == SUCCESS) {
+        // whole frames go to the encoder straight from the dump buffer
+        if (pendingPcm_.empty() && size >= frameBytes_) {
+            ret = WritePcm(data, frameBytes_);
+            data += frameBytes_;
+            size -= frameBytes_;
+            continue;
+        }
+        size_t copySize = std::min(frameBytes_ - pendingPcm_.size(), size);
+        pendingPcm_.insert(pendingPcm_.end(), data, data + copySize);
+        data += copySize;
+        size -= copySize;
+        if (pendingPcm_.size() == frameBytes_) {
+            ret = WritePcm(pendingPcm_.data(), frameBytes_);
+            pendingPcm_.clear();
+        }
+    }
+    return ret;
+}
+
+int32_t MediaAudioEncoder::Close()
+{
+    int32_t ret = SUCCESS;
+    // the last frame is padded with silence, as EncodePcmToFlac does with the end of a file
+    if (isInit_ && !pendingPcm_.empty()) {
+        pendingPcm_.resize(frameBytes_, 0);
+        ret = WritePcm(pendingPcm_.data(), frameBytes_);
+    }
+    pendingPcm_.clear();
+    frameBytes_ = 0;
+    Release();
+    if (apiWrap_ != nullptr) {
+        apiWrap_->Close();
+        apiWrap_ = nullptr;
+    }
+    return ret;
+}
+
 int32_t MediaAudioEncoder::EncodePcmToFlac(const std::string &in)
 {
     int32_t status = SUCCESS;
@@ -442,13 +525,31 @@ void MediaAudioEncoder::CopyS24ToS32(int32_t *dst, const uint8_t *src, size_t co
         return;
     }
 
-    dst += count;
-    src += count * S24LE_SAMPLESIZE;
-    for (; count > 0; --count) {
-        src -= S24LE_SAMPLESIZE;
-        *--dst = (int32_t)((src[S24LE_BYTE_INDEX_0] << S24LE_BYTE_SHIFT_8) |
-            (src[S24LE_BYTE_INDEX_1] << S24LE_BYTE_SHIFT_16) |
-            (src[S24LE_BYTE_INDEX_2] << S24LE_BYTE_SHIFT_24));
+    // every sample becomes {0, b0, b1, b2}, the sample bytes moved up by one
+    size_t i = 0;
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    constexpr size_t neonSamples = 16; // 16: samples of one 48 byte load
+    uint8x16_t zero = vdupq_n_u8(0);
+    for (; i + neonSamples <= count; i += neonSamples) {
+        uint8x16x3_t in = vld3q_u8(src + i * S24LE_SAMPLESIZE);
+        uint8x16x4_t out = {{zero, in.val[S24LE_BYTE_INDEX_0], in.val[S24LE_BYTE_INDEX_1], in.val[S24LE_BYTE_INDEX_2]}};
+        vst4q_u8(reinterpret_cast<uint8_t *>(dst + i), out);
+    }
+#elif defined(__SSSE3__)
+    constexpr size_t sseSamples = 4; // 4: samples of one 16 byte store
+    constexpr size_t sseReadSamples = 6; // 6: the 16 byte load reads into the fifth and sixth sample
+    // -1: zero byte, others: index of the source byte
+    const __m128i shuffle = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    for (; i + sseReadSamples <= count; i += sseSamples) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * S24LE_SAMPLESIZE));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_shuffle_epi8(in, shuffle));
+    }
+#endif
+    for (; i < count; ++i) {
+        const uint8_t *sample = src + i * S24LE_SAMPLESIZE;
+        dst[i] = static_cast<int32_t>((static_cast<uint32_t>(sample[S24LE_BYTE_INDEX_0]) << S24LE_BYTE_SHIFT_8) |
+            (static_cast<uint32_t>(sample[S24LE_BYTE_INDEX_1]) << S24LE_BYTE_SHIFT_16) |
+            (static_cast<uint32_t>(sample[S24LE_BYTE_INDEX_2]) << S24LE_BYTE_SHIFT_24));
     }
 }
 
@@ -42,7 +42,9 @@ REGISTER_SYSTEM_ABILITY_BY_ID(MediaMonitorService, MEDIA_MONITOR_SERVICE_ID, tru
 MediaMonitorService::MediaMonitorService(int32_t systemAbilityId, bool runOnCreate)
     : SystemAbility(systemAbilityId, runOnCreate),
     eventAggregate_(EventAggregate::GetEventAggregate()),
-    audioMemo_(AudioMemo::GetAudioMemo())
+    audioMemo_(AudioMemo::GetAudioMemo()),
+    eventDispatcher_(std::make_unique<EventDispatcher>(EVENT_SHARD_COUNT, &EventAggregate::GetEventShard,
+        [this](std::shared_ptr<EventBean> &bean) { GetMessageFromQueue(bean); }))
 {
         MEDIA_LOG_I("MediaMonitorService constructor");
 }
@@ -79,10 +81,7 @@ void MediaMonitorService::OnStart()
         MEDIA_LOG_I("publish sa err");
         return;
     }
-    signal_ = std::make_shared<MessageSignal>();
-    signal_->isRunning_.store(true);
-    messageLoopThread_ = make_unique<thread>(&MediaMonitorService::MessageLoopFunc, this);
-    pthread_setname_np(messageLoopThread_->native_handle(), "MMLoopThread");
+    eventDispatcher_->Start();
     versionType_ = OHOS::system::GetParameter("const.logsystem.versiontype", COMMERCIAL_VERSION);
     MEDIA_LOG_I("MediaMonitorService get version type %{public}s", versionType_.c_str());
 }
@@ -90,8 +89,7 @@ void MediaMonitorService::OnStart()
 void MediaMonitorService::OnStop()
 {
     MEDIA_LOG_I("OnStop");
-    isExit_ = true;
-    signal_->isRunning_.store(false);
+    eventDispatcher_->Stop();
     DumpThreadExit();
 }
 
@@ -117,33 +115,16 @@ ErrCode MediaMonitorService::WriteLogMsg(const EventBean &bean)
     return SUCCESS;
 }
 
-void MediaMonitorService::MessageLoopFunc()
+ErrCode MediaMonitorService::WriteLogMsgBatch(const std::vector<EventBean> &beans)
 {
-    MEDIA_LOG_D("MediaMonitorService MessageLoopFunc");
-    if (signal_ == nullptr) {
-        MEDIA_LOG_E("MediaMonitorService MessageLoopFunc signal_ is nullptr");
-        return;
-    }
-    while (!isExit_) {
-        if (!signal_->isRunning_.load()) {
-            break;
-        }
-        std::shared_ptr<EventBean> msg;
-        {
-            unique_lock<mutex> lock(signal_->messageMutex_);
-            signal_->messageCond_.wait(lock, [this]() { return signal_->messageQueue_.size() > 0; });
-            if (!signal_->isRunning_.load()) {
-                break;
-            }
-            msg = signal_->messageQueue_.front();
-            if (msg == nullptr) {
-                signal_->messageQueue_.pop();
-                continue;
-            }
-            signal_->messageQueue_.pop();
-        }
-        GetMessageFromQueue(msg);
+    MEDIA_LOG_D("Write %{public}zu events", beans.size());
+    std::vector<std::shared_ptr<EventBean>> eventBeans;
+    eventBeans.reserve(beans.size());
+    for (auto &bean : beans) {
+        eventBeans.push_back(std::make_shared<EventBean>(bean));
     }
+    AddMessagesToQueue(eventBeans);
+    return SUCCESS;
 }
 
 void MediaMonitorService::GetMessageFromQueue(std::shared_ptr<EventBean> &message)
@@ -158,17 +139,15 @@ void MediaMonitorService::GetMessageFromQueue(std::shared_ptr<EventBean> &messag
 void MediaMonitorService::AddMessageToQueue(std::shared_ptr<EventBean> &message)
 {
     MEDIA_LOG_D("MediaMonitorService AddMessageToQueue");
-    if (signal_ == nullptr) {
-        MEDIA_LOG_E("signal_ is null");
-        return;
-    }
-    unique_lock<mutex> lock(signal_->messageMutex_);
-    if (!signal_->isRunning_.load()) {
-        MEDIA_LOG_E("!isRunning_");
-        return;
+    (void)eventDispatcher_->Dispatch(message);
+}
+
+void MediaMonitorService::AddMessagesToQueue(std::vector<std::shared_ptr<EventBean>> &messages)
+{
+    MEDIA_LOG_D("MediaMonitorService AddMessagesToQueue");
+    for (auto &message : messages) {
+        (void)eventDispatcher_->Dispatch(message);
     }
-    signal_->messageQueue_.push(message);
-    signal_->messageCond_.notify_all();
 }
 
 ErrCode MediaMonitorService::GetAudioRouteMsg(std::unordered_map<int32_t,
@@ -260,6 +239,7 @@ ErrCode MediaMonitorService::GetUnifiedFaultCodeRecords(std::vector<std::string>
 
 void MediaMonitorService::AudioEncodeDump()
 {
+    // only the streams that could not get an encoder while dumping are left as pcm here
     MEDIA_LOG_I("encode pcm start");
     std::shared_ptr<MediaAudioEncoder> encoder = std::make_shared<MediaAudioEncoder>();
     encoder->EncodePcmFiles(fileFloader_);
@@ -377,6 +357,17 @@ void MediaMonitorService::DumpThreadStart()
 {
     MEDIA_LOG_I("DumpThreadStart enter");
     DumpFileClear();
+    DumpFileWriter::Options options;
+    // a beta dump starts a file over once it is full, the default one lets it grow
+    options.maxFileSize = (dumpType_ == BETA_DUMP_TYPE) ? FILE_MAX_SIZE : 0;
+    if (dumpType_ == BETA_DUMP_TYPE) {
+        // beta dumps end up as flac, encode them while they come in instead of all at once on stop
+        options.encoderFactory = [](const std::string &filePath) -> std::shared_ptr<DumpStreamEncoder> {
+            auto encoder = std::make_shared<MediaAudioEncoder>();
+            return encoder->Open(filePath) == SUCCESS ? encoder : nullptr;
+        };
+    }
+    dumpFileWriter_ = std::make_unique<DumpFileWriter>(fileFloader_, options);
     dumpSignal_ = std::make_shared<DumpSignal>();
     dumpSignal_->isRunning_.store(true);
     dumpLoopThread_ = std::make_unique<thread>(&MediaMonitorService::DumpLoopFunc, this);
@@ -389,6 +380,9 @@ void MediaMonitorService::DumpThreadStop()
     dumpSignal_->isRunning_.store(false);
     dumpEnable_ = false;
     DumpBufferClear();
+    if (dumpFileWriter_ != nullptr) {
+        dumpFileWriter_->CloseAll();
+    }
     if (dumpType_ == BETA_DUMP_TYPE) {
         HistoryFilesHandle();
         AudioEncodeDump();
@@ -424,6 +418,9 @@ void MediaMonitorService::DumpLoopFunc()
         }
 
         DumpBufferWrite(tmpBufferQue);
+        if (dumpFileWriter_ != nullptr) {
+            dumpFileWriter_->CloseIdle();
+        }
         int duration = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()) - dumpThreadTime_;
         if (dumpType_ == BETA_DUMP_TYPE && duration >= MAX_DUMP_TIME) {
             MEDIA_LOG_I("dump duration %{public}d", duration);
@@ -435,14 +432,11 @@ void MediaMonitorService::DumpLoopFunc()
 void MediaMonitorService::DumpBufferWrite(std::queue<std::pair<std::string,
     std::shared_ptr<AudioDumpBuffer>>> &bufferQueue)
 {
-    std::pair<std::string, std::shared_ptr<AudioDumpBuffer>> dumpData;
-    while (!bufferQueue.empty()) {
-        dumpData = bufferQueue.front();
-        bufferQueue.pop();
-        if (dumpEnable_) {
-            WriteBufferFromQueue(dumpData.first, dumpData.second);
-        }
+    if (!dumpEnable_ || dumpFileWriter_ == nullptr) {
+        std::queue<std::pair<std::string, std::shared_ptr<AudioDumpBuffer>>>().swap(bufferQueue);
+        return;
     }
+    dumpFileWriter_->Write(bufferQueue);
 }
 
 void MediaMonitorService::AddBufferToQueue(const std::string &fileName, std::shared_ptr<AudioDumpBuffer> &buffer)
@@ -458,32 +452,6 @@ void MediaMonitorService::AddBufferToQueue(const std::string &fileName, std::sha
     dumpSignal_->dumpCond_.notify_all();
 }
 
-void MediaMonitorService::WriteBufferFromQueue(const std::string &fileName, std::shared_ptr<AudioDumpBuffer> &buffer)
-{
-    MEDIA_LOG_D("WriteBufferFromQueue enter");
-    FALSE_RETURN_MSG(buffer != nullptr, "buffer is nullptr");
-    FALSE_RETURN_MSG(buffer->data != nullptr, "buffer data is nullptr");
-    std::string realFilePath = fileFloader_ + fileName;
-    FALSE_RETURN_MSG(IsRealPath(fileFloader_), "check path failed");
-    FILE *dumpFile = fopen(realFilePath.c_str(), "a");
-    FALSE_RETURN_MSG(dumpFile != nullptr, "pcm file open failed");
-    if (fseek(dumpFile, 0, SEEK_END)) {
-        (void)fclose(dumpFile);
-        return;
-    }
-    int filelen = ftell(dumpFile);
-    if (filelen >= FILE_MAX_SIZE && dumpType_ == BETA_DUMP_TYPE) {
-        (void)fclose(dumpFile);
-        (void)DeleteHistoryFile(realFilePath);
-        dumpFile = fopen(realFilePath.c_str(), "a");
-        FALSE_RETURN_MSG(dumpFile != nullptr, "reopen file failed");
-    }
-
-    (void)fwrite(buffer->data, 1, buffer->size, dumpFile);
-    (void)fclose(dumpFile);
-    dumpFile = nullptr;
-}
-
 void MediaMonitorService::DumpFileClear()
 {
     std::error_code errorCode;
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "dump_file_writer.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+namespace {
+const std::string DUMP_DIR = "/data/local/tmp/media_monitor_dump_writer/";
+
+class DumpFileWriterUnitTest : public testing::Test {
+public:
+    void SetUp() override
+    {
+        (void)mkdir(DUMP_DIR.c_str(), 0775); // 0775: test directory mode
+        for (auto name : {"a.pcm", "b.pcm", "c.pcm", "continued_a.pcm"}) {
+            (void)unlink((DUMP_DIR + name).c_str());
+        }
+    }
+};
+
+std::shared_ptr<AudioDumpBuffer> MakeBuffer(uint8_t value, uint32_t size)
+{
+    std::vector<uint8_t> raw(size, value);
+    auto buffer = std::make_shared<AudioDumpBuffer>();
+    buffer->size = size;
+    (void)buffer->RawDataCpy(raw.data());
+    return buffer;
+}
+
+std::vector<uint8_t> ReadFile(const std::string &fileName)
+{
+    std::ifstream file(DUMP_DIR + fileName, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+class FakeEncoder : public DumpStreamEncoder {
+public:
+    int32_t Feed(const uint8_t *data, size_t size) override
+    {
+        fed.insert(fed.end(), data, data + size);
+        return failFeed ? -1 : 0;
+    }
+
+    int32_t Close() override
+    {
+        closed = true;
+        return 0;
+    }
+
+    std::vector<uint8_t> fed;
+    bool closed = false;
+    bool failFeed = false;
+};
+}
+
+HWTEST_F(DumpFileWriterUnitTest, DumpFileWriter_Batch_001, TestSize.Level0)
+{
+    DumpFileWriter writer(DUMP_DIR, DumpFileWriter::Options {});
+    std::vector<uint8_t> expectA;
+    std::vector<uint8_t> expectB;
+    constexpr int32_t rounds = 3;
+    constexpr int32_t buffers = 40;
+    constexpr uint32_t size = 960; // 960: 10ms of 48k mono s16
+    for (int32_t round = 0; round < rounds; ++round) {
+        std::queue<DumpFileWriter::DumpBuffer> bufferQueue;
+        for (int32_t i = 0; i < buffers; ++i) {
+            uint8_t value = static_cast<uint8_t>(round * buffers + i);
+            bool toA = i % 2 == 0; // 2: interleave both files
+            bufferQueue.push(std::make_pair(toA ? "a.pcm" : "b.pcm", MakeBuffer(value, size)));
+            (toA ? expectA : expectB).insert((toA ? expectA : expectB).end(), size, value);
+        }
+        writer.Write(bufferQueue);
+        EXPECT_TRUE(bufferQueue.empty());
+    }
+    auto stats = writer.GetStats();
+    EXPECT_EQ(static_cast<uint64_t>(rounds * buffers), stats.buffers);
+    EXPECT_EQ(2u, stats.opens); // 2: each file opened once
+    EXPECT_EQ(static_cast<uint64_t>(rounds * 2), stats.writeCalls); // 2: one writev per file and batch
+    EXPECT_EQ(expectA, ReadFile("a.pcm"));
+    EXPECT_EQ(expectB, ReadFile("b.pcm"));
+}
+
+HWTEST_F(DumpFileWriterUnitTest, DumpFileWriter_Rotate_001, TestSize.Level0)
+{
+    DumpFileWriter::Options options;
+    options.maxFileSize = 1000; // 1000: bytes before a file starts over
+    DumpFileWriter writer(DUMP_DIR, options);
+    std::queue<DumpFileWriter::DumpBuffer> bufferQueue;
+    for (uint8_t i = 0; i < 5; ++i) { // 5: 2 buffers fill the file
+        bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(i, 600))); // 600: bytes per buffer
+    }
+    writer.Write(bufferQueue);
+    EXPECT_EQ(2u, writer.GetStats().rotations); // 2: after the second and the fourth buffer
+    std::vector<uint8_t> expect(600, 4); // 600: the last buffer, 4: its value
+    EXPECT_EQ(expect, ReadFile("a.pcm"));
+}
+
+HWTEST_F(DumpFileWriterUnitTest, DumpFileWriter_Close_001, TestSize.Level0)
+{
+    DumpFileWriter::Options options;
+    options.maxOpenFiles = 2; // 2: the third file closes the oldest one
+    options.idleCloseMs = 0;
+    DumpFileWriter writer(DUMP_DIR, options);
+    std::queue<DumpFileWriter::DumpBuffer> bufferQueue;
+    bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(1, 10))); // 10: bytes
+    bufferQueue.push(std::make_pair("b.pcm", MakeBuffer(2, 10))); // 2: value, 10: bytes
+    bufferQueue.push(std::make_pair("c.pcm", MakeBuffer(3, 10))); // 3: value, 10: bytes
+    bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(4, 10))); // 4: value, 10: bytes
+    writer.Write(bufferQueue);
+    EXPECT_EQ(4u, writer.GetStats().opens); // 4: a.pcm was closed and opened again
+
+    writer.CloseIdle();
+    bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(5, 10))); // 5: value, 10: bytes
+    writer.Write(bufferQueue);
+    EXPECT_EQ(5u, writer.GetStats().opens); // 5: idle files were closed
+
+    std::vector<uint8_t> expect(10, 1); // 10: bytes, 1: value
+    expect.insert(expect.end(), 10, 4); // 10: bytes, 4: value
+    expect.insert(expect.end(), 10, 5); // 10: bytes, 5: value
+    EXPECT_EQ(expect, ReadFile("a.pcm"));
+    EXPECT_EQ(std::vector<uint8_t>(10, 3), ReadFile("c.pcm")); // 10: bytes, 3: value
+}
+
+HWTEST_F(DumpFileWriterUnitTest, DumpFileWriter_Invalid_001, TestSize.Level0)
+{
+    DumpFileWriter writer("/path/not/exist/", DumpFileWriter::Options {});
+    std::queue<DumpFileWriter::DumpBuffer> bufferQueue;
+    bufferQueue.push(std::make_pair("a.pcm", nullptr));
+    bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(1, 10))); // 10: bytes
+    writer.Write(bufferQueue);
+    EXPECT_TRUE(bufferQueue.empty());
+    EXPECT_EQ(0u, writer.GetStats().buffers);
+}
+
+HWTEST_F(DumpFileWriterUnitTest, DumpFileWriter_Encoder_001, TestSize.Level0)
+{
+    std::vector<std::pair<std::string, std::shared_ptr<FakeEncoder>>> encoders;
+    bool failFeed = false;
+    DumpFileWriter::Options options;
+    options.maxFileSize = 1000; // 1000: pcm bytes before a stream starts over
+    options.idleCloseMs = 0;
+    options.maxEncoders = 1;
+    options.encoderFactory = [&encoders, &failFeed](const std::string &filePath) {
+        auto encoder = std::make_shared<FakeEncoder>();
+        encoder->failFeed = failFeed;
+        encoders.emplace_back(filePath, encoder);
+        return encoder;
+    };
+    DumpFileWriter writer(DUMP_DIR, options);
+    std::queue<DumpFileWriter::DumpBuffer> bufferQueue;
+    bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(1, 600))); // 600: bytes per buffer
+    bufferQueue.push(std::make_pair("b.pcm", MakeBuffer(2, 600))); // 2: value, 600: bytes
+    bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(3, 600))); // 3: value, 600: bytes
+    writer.Write(bufferQueue);
+    writer.CloseIdle();
+    bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(4, 600))); // 4: value, 600: bytes
+    writer.Write(bufferQueue);
+
+    // only one encoder is allowed, b.pcm stays a plain file
+    EXPECT_EQ(std::vector<uint8_t>(600, 2), ReadFile("b.pcm")); // 600: bytes, 2: value
+    ASSERT_EQ(2u, encoders.size()); // 2: the second one after a.pcm started over
+    EXPECT_EQ(DUMP_DIR + "a.pcm", encoders[0].first);
+    std::vector<uint8_t> expect(600, 1); // 600: bytes, 1: value
+    expect.insert(expect.end(), 600, 3); // 600: bytes, 3: value
+    EXPECT_EQ(expect, encoders[0].second->fed);
+    EXPECT_TRUE(encoders[0].second->closed);
+    // an idle encoder is not closed
+    EXPECT_EQ(std::vector<uint8_t>(600, 4), encoders[1].second->fed); // 600: bytes, 4: value
+    EXPECT_FALSE(encoders[1].second->closed);
+    EXPECT_TRUE(ReadFile("a.pcm").empty());
+
+    writer.CloseAll();
+    EXPECT_TRUE(encoders[1].second->closed);
+    auto stats = writer.GetStats();
+    EXPECT_EQ(2u, stats.encoders); // 2: a.pcm before and after starting over
+    EXPECT_EQ(1u, stats.rotations);
+    EXPECT_EQ(4u, stats.buffers); // 4: every buffer was taken
+
+    // a failed encoder leaves the rest of its stream, the failed buffer included, as pcm beside its file
+    failFeed = true;
+    bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(5, 10))); // 5: value, 10: bytes
+    bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(6, 10))); // 6: value, 10: bytes
+    writer.Write(bufferQueue);
+    bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(7, 10))); // 7: value, 10: bytes
+    writer.Write(bufferQueue);
+    ASSERT_EQ(3u, encoders.size()); // 3: no new encoder after the failed one
+    EXPECT_TRUE(encoders[2].second->closed);
+    EXPECT_TRUE(ReadFile("a.pcm").empty());
+    expect.assign(10, 5); // 10: bytes, 5: value
+    expect.insert(expect.end(), 10, 6); // 10: bytes, 6: value
+    expect.insert(expect.end(), 10, 7); // 10: bytes, 7: value
+    EXPECT_EQ(expect, ReadFile("continued_a.pcm"));
+    EXPECT_EQ(7u, writer.GetStats().buffers); // 7: no buffer is dropped
+}
+
+HWTEST_F(DumpFileWriterUnitTest, DumpFileWriter_EncoderIdle_001, TestSize.Level0)
+{
+    std::vector<std::pair<std::string, std::shared_ptr<FakeEncoder>>> encoders;
+    DumpFileWriter::Options options;
+    options.encoderIdleCloseMs = 0;
+    options.maxEncoders = 1;
+    options.encoderFactory = [&encoders](const std::string &filePath) {
+        auto encoder = std::make_shared<FakeEncoder>();
+        encoders.emplace_back(filePath, encoder);
+        return encoder;
+    };
+    DumpFileWriter writer(DUMP_DIR, options);
+    std::queue<DumpFileWriter::DumpBuffer> bufferQueue;
+    bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(1, 10))); // 1: value, 10: bytes
+    bufferQueue.push(std::make_pair("b.pcm", MakeBuffer(2, 10))); // 2: value, 10: bytes
+    writer.Write(bufferQueue);
+    ASSERT_EQ(1u, encoders.size());
+
+    // the idle encoder of a.pcm is finished and its slot goes to the next stream
+    writer.CloseIdle();
+    EXPECT_TRUE(encoders[0].second->closed);
+    bufferQueue.push(std::make_pair("c.pcm", MakeBuffer(3, 10))); // 3: value, 10: bytes
+    bufferQueue.push(std::make_pair("b.pcm", MakeBuffer(4, 10))); // 4: value, 10: bytes
+    bufferQueue.push(std::make_pair("a.pcm", MakeBuffer(5, 10))); // 5: value, 10: bytes
+    writer.Write(bufferQueue);
+    ASSERT_EQ(2u, encoders.size()); // 2: the slot was reused once
+    EXPECT_EQ(DUMP_DIR + "c.pcm", encoders[1].first);
+    EXPECT_EQ(std::vector<uint8_t>(10, 3), encoders[1].second->fed); // 10: bytes, 3: value
+    EXPECT_FALSE(encoders[1].second->closed);
+
+    // b.pcm was written as pcm already, a.pcm keeps its finished file and goes on as pcm beside it
+    std::vector<uint8_t> expect(10, 2); // 10: bytes, 2: value
+    expect.insert(expect.end(), 10, 4); // 10: bytes, 4: value
+    EXPECT_EQ(expect, ReadFile("b.pcm"));
+    EXPECT_EQ(std::vector<uint8_t>(10, 1), encoders[0].second->fed); // 10: bytes, 1: value
+    EXPECT_EQ(std::vector<uint8_t>(10, 5), ReadFile("continued_a.pcm")); // 10: bytes, 5: value
+    EXPECT_EQ(5u, writer.GetStats().buffers); // 5: no buffer is dropped
+}
+
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
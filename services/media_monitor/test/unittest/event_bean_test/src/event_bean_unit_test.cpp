@@ -245,6 +245,105 @@ HWTEST(EventBeanUnitTest, Event_Bean_UpdateFloatMap_002, TestSize.Level0)
     bean->UpdateFloatMap(key, secondValue);
     EXPECT_NE(bean->GetFloatValue(key), firstValue);
 }
+
+HWTEST(EventBeanUnitTest, Event_Bean_GetParcelSize_001, TestSize.Level0)
+{
+    std::shared_ptr<EventBean> bean = std::make_shared<EventBean>(AUDIO, STREAM_CHANGE, BEHAVIOR_EVENT);
+    bean->Add("UID", 20020000); // 20020000: uid
+    bean->Add("APP_NAME", std::string("com.example.player"));
+    bean->Add("DURATION", static_cast<uint64_t>(1000));
+    bean->Add("VOLUME", 0.5f);
+
+    Parcel parcel;
+    EXPECT_TRUE(bean->Marshalling(parcel));
+    EXPECT_EQ(bean->GetParcelSize(), parcel.GetDataSize());
+}
+
+HWTEST(EventBeanUnitTest, Event_Bean_Fields_001, TestSize.Level0)
+{
+    std::shared_ptr<EventBean> bean = std::make_shared<EventBean>(AUDIO, STREAM_CHANGE, BEHAVIOR_EVENT);
+    constexpr int32_t fields = 20; // 20: more than fit inline
+    for (int32_t i = 0; i < fields; ++i) {
+        bean->Add("FIELD_" + std::to_string(i), i);
+    }
+    bean->Add("FIELD_3", 100); // 100: an existing key keeps its value
+    bean->UpdateIntMap("FIELD_15", 150); // 150: updates a spilled field
+    bean->UpdateIntMap("NOT_ADDED", 1);
+    EXPECT_EQ(3, bean->GetIntValue("FIELD_3"));
+    EXPECT_EQ(150, bean->GetIntValue("FIELD_15"));
+    EXPECT_EQ(-1, bean->GetIntValue("NOT_ADDED"));
+    EXPECT_EQ(static_cast<size_t>(fields), bean->GetIntMap().size());
+
+    bean->Add("UID", std::string("uid")); // the same key may hold one value of each type
+    bean->Add("UID", 1000); // 1000: uid
+    EXPECT_EQ("uid", bean->GetStringValue("UID"));
+    EXPECT_EQ(1000, bean->GetIntValue("UID"));
+    EXPECT_EQ("UNKNOWN", bean->GetStringValue("APP_NAME"));
+    EXPECT_EQ(0u, bean->GetUint64Value("UID"));
+
+    EventBean copy = *bean;
+    bean->UpdateIntMap("FIELD_0", 10); // 10: the copy does not follow
+    EXPECT_EQ(0, copy.GetIntValue("FIELD_0"));
+}
+
+HWTEST(EventBeanUnitTest, Event_Bean_BuiltinKey_001, TestSize.Level0)
+{
+    constexpr EventKeyId uid = FindBuiltinEventKey("UID");
+    static_assert(uid != INVALID_EVENT_KEY, "UID is a builtin key");
+    EXPECT_EQ(uid, EventKeys::Find("UID"));
+    EXPECT_EQ("UID", EventKeys::GetName(uid));
+    EXPECT_EQ(INVALID_EVENT_KEY, FindBuiltinEventKey("Event_Bean_BuiltinKey_001"));
+
+    EventBean bean(AUDIO, STREAM_CHANGE, BEHAVIOR_EVENT);
+    bean.Add("UID", 20020000); // 20020000: uid
+    EXPECT_EQ(20020000, bean.GetIntValue(uid)); // 20020000: uid
+    // a key outside the table stays on the bean and is not registered anywhere
+    bean.Add("Event_Bean_BuiltinKey_001", 1);
+    EXPECT_EQ(1, bean.GetIntValue("Event_Bean_BuiltinKey_001"));
+    EXPECT_EQ(INVALID_EVENT_KEY, EventKeys::Find("Event_Bean_BuiltinKey_001"));
+    EXPECT_TRUE(EventKeys::GetName(INVALID_EVENT_KEY).empty());
+}
+
+HWTEST(EventBeanUnitTest, Event_Bean_UnknownKeys_001, TestSize.Level0)
+{
+    // 5000: more unknown keys than any bound a process wide table would have, none of them is dropped
+    constexpr int32_t keys = 5000;
+    for (int32_t i = 0; i < keys; ++i) {
+        MessageParcel parcel;
+        EventBean bean(AUDIO, STREAM_CHANGE, BEHAVIOR_EVENT);
+        bean.Add("PEER_KEY_" + std::to_string(i), i);
+        ASSERT_TRUE(bean.Marshalling(parcel));
+        std::unique_ptr<EventBean> result(EventBean::Unmarshalling(parcel));
+        ASSERT_NE(nullptr, result);
+        ASSERT_EQ(i, result->GetIntValue("PEER_KEY_" + std::to_string(i)));
+    }
+    EXPECT_EQ(INVALID_EVENT_KEY, EventKeys::Find("PEER_KEY_0"));
+}
+
+HWTEST(EventBeanUnitTest, Event_Bean_Marshalling_001, TestSize.Level0)
+{
+    EventBean bean(AUDIO, STREAM_CHANGE, BEHAVIOR_EVENT);
+    for (int32_t i = 0; i < 12; ++i) { // 12: more than fit inline
+        bean.Add("STREAM_" + std::to_string(i), i);
+    }
+    bean.Add("UID", 20020000); // 20020000: uid
+    bean.Add("APP_NAME", std::string("com.example.player"));
+    bean.Add("CUSTOM_NAME", std::string("custom"));
+    bean.Add("DETAIL", std::string(100, 'x')); // 100: a long string
+    bean.Add("DURATION", static_cast<uint64_t>(1000));
+    bean.Add("VOLUME", 0.5f);
+
+    MessageParcel parcel;
+    EXPECT_TRUE(bean.Marshalling(parcel));
+    EXPECT_EQ(bean.GetParcelSize(), parcel.GetDataSize());
+    std::unique_ptr<EventBean> result(EventBean::Unmarshalling(parcel));
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(STREAM_CHANGE, result->GetEventId());
+    EXPECT_EQ(bean.GetIntMap(), result->GetIntMap());
+    EXPECT_EQ(bean.GetStringMap(), result->GetStringMap());
+    EXPECT_EQ(bean.GetUint64Map(), result->GetUint64Map());
+    EXPECT_EQ(bean.GetFloatMap(), result->GetFloatMap());
+}
 } // namespace MediaMonitor
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "event_dispatcher.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+namespace {
+constexpr uint32_t SHARD_COUNT = 4;
+constexpr int32_t PRODUCERS = 4; // 4: binder threads
+constexpr int32_t EVENTS_PER_PRODUCER = 5000;
+constexpr int32_t BURST_EVENTS = 10; // 10: events a client sends back to back
+constexpr int32_t BURST_GAP_US = 100; // 100us: pause between bursts
+constexpr int32_t HANDLER_WORK = 200; // 200: rounds of work per event, about a microsecond
+constexpr int32_t BLOCKING_EVERY = 200; // 200: one event of shard 0 in so many waits on the bundle manager
+constexpr int32_t BLOCKING_MS = 2; // 2ms: an IPC to the bundle manager
+const std::string KEY_PRODUCER = "PRODUCER";
+const std::string KEY_SEQUENCE = "SEQUENCE";
+const std::string KEY_SEND_TIME = "SEND_TIME";
+
+int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::shared_ptr<EventBean> MakeEvent(int32_t producer, int32_t sequence)
+{
+    auto bean = std::make_shared<EventBean>(AUDIO, static_cast<EventId>(sequence % SHARD_COUNT), BEHAVIOR_EVENT);
+    bean->Add(KEY_PRODUCER, producer);
+    bean->Add(KEY_SEQUENCE, sequence);
+    bean->Add(KEY_SEND_TIME, static_cast<uint64_t>(NowNs()));
+    return bean;
+}
+
+uint32_t SelectShard(EventId eventId)
+{
+    return static_cast<uint32_t>(eventId) % SHARD_COUNT;
+}
+
+void DoWork()
+{
+    volatile uint64_t sum = 0;
+    for (int32_t i = 0; i < HANDLER_WORK; ++i) {
+        sum = sum + static_cast<uint64_t>(i) * 31; // 31: any factor
+    }
+}
+
+// the former service loop: one locked queue, one consumer, a notify for every event
+class LockedEventLoop {
+public:
+    explicit LockedEventLoop(EventDispatcher::EventHandler handler) : handler_(std::move(handler))
+    {
+        thread_ = std::thread([this] { Loop(); });
+    }
+
+    ~LockedEventLoop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cond_.notify_all();
+        thread_.join();
+    }
+
+    void Dispatch(std::shared_ptr<EventBean> &bean)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        queue_.push(bean);
+        cond_.notify_all();
+    }
+
+private:
+    void Loop()
+    {
+        while (true) {
+            std::shared_ptr<EventBean> bean;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) {
+                    return;
+                }
+                bean = queue_.front();
+                queue_.pop();
+            }
+            handler_(bean);
+        }
+    }
+
+    EventDispatcher::EventHandler handler_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::queue<std::shared_ptr<EventBean>> queue_;
+    bool stopping_ {false};
+    std::thread thread_;
+};
+
+// the aggregation work, shard 0 now and then blocks like a bundle name lookup
+class LoadHandler {
+public:
+    explicit LoadHandler(size_t capacity) : latencies_(capacity) {}
+
+    void Handle(std::shared_ptr<EventBean> &bean)
+    {
+        DoWork();
+        if (SelectShard(bean->GetEventId()) == 0) {
+            if (bean->GetIntValue(KEY_SEQUENCE) % BLOCKING_EVERY == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(BLOCKING_MS));
+            }
+        } else {
+            size_t index = next_++;
+            latencies_[index % latencies_.size()] =
+                NowNs() - static_cast<int64_t>(bean->GetUint64Value(KEY_SEND_TIME));
+        }
+        handled_++;
+    }
+
+    std::atomic<int64_t> handled_ {0};
+    std::atomic<size_t> next_ {0};
+    std::vector<int64_t> latencies_;
+};
+
+struct LoadResult {
+    double eventsPerSecond {0};
+    int64_t dispatchP99Ns {0};
+    int64_t latencyP99Ns {0};
+    int64_t latencyMaxNs {0};
+};
+
+int64_t Percentile(std::vector<int64_t> values, double ratio)
+{
+    if (values.empty()) {
+        return 0;
+    }
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(values.size() * ratio));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+// PRODUCERS threads send bursts like binder threads, measures the dispatch call and the time until an event of
+// the other shards is handled
+template <typename Dispatch>
+LoadResult RunLoad(Dispatch dispatch, LoadHandler &handler)
+{
+    constexpr int64_t total = static_cast<int64_t>(PRODUCERS) * EVENTS_PER_PRODUCER;
+    std::vector<std::vector<int64_t>> dispatchNs(PRODUCERS);
+    int64_t start = NowNs();
+    std::vector<std::thread> producers;
+    for (int32_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([p, &dispatch, &dispatchNs] {
+            dispatchNs[p].reserve(EVENTS_PER_PRODUCER);
+            for (int32_t i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+                auto bean = MakeEvent(p, i);
+                int64_t begin = NowNs();
+                dispatch(bean);
+                dispatchNs[p].push_back(NowNs() - begin);
+                if (i % BURST_EVENTS == BURST_EVENTS - 1) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(BURST_GAP_US));
+                }
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    while (handler.handled_.load() < total) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100)); // 100us
+    }
+    LoadResult result;
+    result.eventsPerSecond = total * 1e9 / static_cast<double>(NowNs() - start);
+    std::vector<int64_t> allDispatchNs;
+    for (auto &ns : dispatchNs) {
+        allDispatchNs.insert(allDispatchNs.end(), ns.begin(), ns.end());
+    }
+    std::vector<int64_t> latencies(handler.latencies_.begin(),
+        handler.latencies_.begin() + std::min(handler.next_.load(), handler.latencies_.size()));
+    result.dispatchP99Ns = Percentile(allDispatchNs, 0.99); // 0.99: p99
+    result.latencyP99Ns = Percentile(latencies, 0.99); // 0.99: p99
+    result.latencyMaxNs = latencies.empty() ? 0 : *std::max_element(latencies.begin(), latencies.end());
+    return result;
+}
+}
+
+HWTEST(EventDispatcherUnitTest, MpscQueue_Order_001, TestSize.Level0)
+{
+    MpscQueue<int32_t> queue;
+    int32_t value = 0;
+    EXPECT_FALSE(queue.Pop(value));
+    for (int32_t i = 1; i <= 3; ++i) { // 3: values
+        queue.Push(i);
+    }
+    for (int32_t i = 1; i <= 3; ++i) { // 3: values
+        ASSERT_TRUE(queue.Pop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_FALSE(queue.Pop(value));
+}
+
+HWTEST(EventDispatcherUnitTest, EventDispatcher_ShardOrder_001, TestSize.Level0)
+{
+    std::vector<std::vector<int32_t>> lastSequence(SHARD_COUNT, std::vector<int32_t>(PRODUCERS, -1));
+    std::atomic<int64_t> handled {0};
+    std::atomic<int64_t> outOfOrder {0};
+    EventDispatcher dispatcher(SHARD_COUNT, SelectShard, [&](std::shared_ptr<EventBean> &bean) {
+        // each shard is one thread, its row is only touched here
+        int32_t &last = lastSequence[SelectShard(bean->GetEventId())][bean->GetIntValue(KEY_PRODUCER)];
+        int32_t sequence = bean->GetIntValue(KEY_SEQUENCE);
+        if (sequence <= last) {
+            outOfOrder++;
+        }
+        last = sequence;
+        handled++;
+    });
+    dispatcher.Start();
+    std::vector<std::thread> producers;
+    for (int32_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([p, &dispatcher] {
+            for (int32_t i = 0; i < 1000; ++i) { // 1000: events per producer
+                auto bean = MakeEvent(p, i);
+                EXPECT_TRUE(dispatcher.Dispatch(bean));
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    dispatcher.Stop();
+    EXPECT_EQ(PRODUCERS * 1000, handled.load()); // 1000: events per producer
+    EXPECT_EQ(0, outOfOrder.load());
+    auto stats = dispatcher.GetStats();
+    EXPECT_EQ(stats.dispatched, stats.handled);
+
+    auto late = MakeEvent(0, 0);
+    EXPECT_FALSE(dispatcher.Dispatch(late));
+}
+
+HWTEST(EventDispatcherUnitTest, EventDispatcher_SlowShard_001, TestSize.Level0)
+{
+    constexpr int32_t slowHandlerMs = 200; // 200ms: a stalled handler
+    std::atomic<int64_t> fastLatencyNs {-1};
+    EventDispatcher dispatcher(SHARD_COUNT, SelectShard, [&](std::shared_ptr<EventBean> &bean) {
+        if (SelectShard(bean->GetEventId()) == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(slowHandlerMs));
+            return;
+        }
+        fastLatencyNs = NowNs() - static_cast<int64_t>(bean->GetUint64Value(KEY_SEND_TIME));
+    });
+    dispatcher.Start();
+    auto slow = MakeEvent(0, 0); // 0: sequence of shard 0
+    auto fast = MakeEvent(0, 1); // 1: sequence of shard 1
+    EXPECT_TRUE(dispatcher.Dispatch(slow));
+    EXPECT_TRUE(dispatcher.Dispatch(fast));
+    for (int32_t i = 0; i < 100 && fastLatencyNs.load() < 0; ++i) { // 100: 1s at most
+        std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10ms
+    }
+    EXPECT_GE(fastLatencyNs.load(), 0);
+    EXPECT_LT(fastLatencyNs.load(), static_cast<int64_t>(slowHandlerMs) * 1000 * 1000); // 1000 * 1000: ms to ns
+    dispatcher.Stop();
+}
+
+HWTEST(EventDispatcherUnitTest, EventDispatcher_Load_001, TestSize.Level1)
+{
+    constexpr size_t total = static_cast<size_t>(PRODUCERS) * EVENTS_PER_PRODUCER;
+    LoadHandler lockedHandler(total);
+    LoadResult locked;
+    {
+        LockedEventLoop loop([&lockedHandler](std::shared_ptr<EventBean> &bean) { lockedHandler.Handle(bean); });
+        locked = RunLoad([&loop](std::shared_ptr<EventBean> &bean) { loop.Dispatch(bean); }, lockedHandler);
+    }
+
+    LoadHandler shardedHandler(total);
+    LoadResult sharded;
+    {
+        EventDispatcher dispatcher(SHARD_COUNT, SelectShard,
+            [&shardedHandler](std::shared_ptr<EventBean> &bean) { shardedHandler.Handle(bean); });
+        dispatcher.Start();
+        sharded = RunLoad([&dispatcher](std::shared_ptr<EventBean> &bean) { (void)dispatcher.Dispatch(bean); },
+            shardedHandler);
+        dispatcher.Stop();
+    }
+    RecordProperty("locked_events_per_second", std::to_string(static_cast<int64_t>(locked.eventsPerSecond)));
+    RecordProperty("sharded_events_per_second", std::to_string(static_cast<int64_t>(sharded.eventsPerSecond)));
+    RecordProperty("locked_handled_p99_ns", std::to_string(locked.latencyP99Ns));
+    RecordProperty("sharded_handled_p99_ns", std::to_string(sharded.latencyP99Ns));
+    RecordProperty("sharded_dispatch_p99_ns", std::to_string(sharded.dispatchP99Ns));
+    EXPECT_EQ(static_cast<int64_t>(total), shardedHandler.handled_.load());
+    // a blocked shard 0 no longer holds back the others
+    EXPECT_LT(sharded.latencyP99Ns, locked.latencyP99Ns);
+}
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
@@ -1058,6 +1058,65 @@ HWTEST(MediaMonitorDtTest, MediaAudioEncoder_FrameAndWriteBranch_001, TestSize.L
     EXPECT_EQ(encoder.FillFrameFromBuffer(srcData, sizeof(frameData) + 1), ERROR);
 }
 
+HWTEST(MediaMonitorDtTest, MediaAudioEncoder_CopyS24ToS32Block_001, TestSize.Level0)
+{
+    MediaAudioEncoder encoder;
+    constexpr size_t count = 37; // 37: whole vector blocks and a scalar tail
+    std::vector<uint8_t> src(count * 3);
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+    std::vector<int32_t> dst(count + 1, -1);
+    encoder.CopyS24ToS32(dst.data(), src.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t expect = (static_cast<uint32_t>(src[i * 3]) << 8) | (static_cast<uint32_t>(src[i * 3 + 1]) << 16) |
+            (static_cast<uint32_t>(src[i * 3 + 2]) << 24);
+        EXPECT_EQ(static_cast<uint32_t>(dst[i]), expect);
+    }
+    EXPECT_EQ(dst[count], -1);
+}
+
+HWTEST(MediaMonitorDtTest, MediaAudioEncoder_FeedAndCloseBranch_001, TestSize.Level0)
+{
+    MediaAudioEncoder encoder;
+    uint8_t srcData[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    EXPECT_EQ(encoder.Feed(srcData, sizeof(srcData)), ERROR);
+
+    uint8_t frameData[16] = {};
+    AVFrame *frame = new AVFrame();
+    frame->data[0] = frameData;
+    frame->linesize[0] = sizeof(frameData);
+    encoder.avFrame_ = std::shared_ptr<AVFrame>(frame, [](AVFrame *ptr) {
+        delete ptr;
+    });
+    encoder.audioCodecContext_ = std::shared_ptr<AVCodecContext>(new AVCodecContext(), [](AVCodecContext *ptr) {
+        delete ptr;
+    });
+    encoder.avPacket_ = std::shared_ptr<AVPacket>(new AVPacket(), [](AVPacket *ptr) {
+        delete ptr;
+    });
+    encoder.apiWrap_ = std::make_shared<FFmpegApiWrap>();
+    encoder.apiWrap_->sendFrameFunc = CodecSendFrameStub;
+    encoder.apiWrap_->recvPacketFunc = CodecRecvPacketStub;
+    encoder.srcSampleFormat_ = SampleFormat::S16LE;
+    encoder.isInit_ = true;
+    encoder.frameBytes_ = sizeof(frameData);
+
+    EXPECT_EQ(encoder.Feed(nullptr, sizeof(srcData)), ERROR);
+    EXPECT_EQ(encoder.Feed(srcData, sizeof(srcData)), SUCCESS);
+    EXPECT_EQ(encoder.pendingPcm_.size(), sizeof(srcData));
+    EXPECT_EQ(encoder.Feed(srcData, sizeof(srcData)), SUCCESS);
+    EXPECT_EQ(encoder.pendingPcm_.size(), 2U * sizeof(srcData) - sizeof(frameData));
+    EXPECT_EQ(memcmp(frameData + sizeof(srcData), srcData, sizeof(frameData) - sizeof(srcData)), 0);
+
+    EXPECT_EQ(encoder.Close(), SUCCESS);
+    EXPECT_EQ(frameData[0], srcData[sizeof(frameData) - sizeof(srcData)]);
+    EXPECT_EQ(frameData[sizeof(frameData) - 1], 0);
+    EXPECT_TRUE(encoder.pendingPcm_.empty());
+    EXPECT_EQ(encoder.apiWrap_, nullptr);
+    EXPECT_EQ(encoder.Feed(srcData, sizeof(srcData)), ERROR);
+}
+
 HWTEST(MediaMonitorDtTest, SampleConvert_InitConvertAndReleaseBranch_001, TestSize.Level0)
 {
     ResamplePara param;
@@ -1758,8 +1817,9 @@ HWTEST(MediaMonitorDtTest, EventAggregate_DeviceVolumeAndStateBranch_001, TestSi
 
     auto unknown = MakeEvent(UNKNOW_EVENTID, BEHAVIOR_EVENT);
     aggregate.WriteEvent(unknown);
-    aggregate.UpdateAggregateStateEventList(unknown);
     EXPECT_EQ(unknown->GetEventId(), UNKNOW_EVENTID);
+    EXPECT_EQ(EventAggregate::GetEventShard(UNKNOW_EVENTID), STATE_SHARD);
+    EXPECT_EQ(EventAggregate::GetEventShard(DEVICE_CHANGE), EventAggregate::GetEventShard(STREAM_CHANGE));
 }
 
 void VerifyExcludedDeviceBranch(AudioMemo &memo)
@@ -1952,19 +2012,19 @@ HWTEST(MediaMonitorDtTest, MediaMonitorService_MessageDumpAndFileBranch_001, Tes
     MediaMonitorService service(MEDIA_MONITOR_SERVICE_ID, false);
     std::shared_ptr<EventBean> nullBean = nullptr;
     service.GetMessageFromQueue(nullBean);
-    service.MessageLoopFunc();
     service.AddMessageToQueue(nullBean);
 
-    service.signal_ = std::make_shared<MessageSignal>();
-    service.signal_->isRunning_.store(false);
-    service.AddMessageToQueue(nullBean);
-    service.signal_->isRunning_.store(true);
     auto bean = MakeEvent(HEADSET_CHANGE, BEHAVIOR_EVENT);
     bean->Add("HASMIC", 1);
     bean->Add("ISCONNECT", 1);
     bean->Add("DEVICETYPE", 2);
     service.AddMessageToQueue(bean);
-    EXPECT_EQ(service.signal_->messageQueue_.size(), 1U);
+    EXPECT_EQ(service.eventDispatcher_->GetStats().dispatched, 0U);
+    service.eventDispatcher_->Start();
+    service.AddMessageToQueue(bean);
+    service.eventDispatcher_->Stop();
+    EXPECT_EQ(service.eventDispatcher_->GetStats().dispatched, 1U);
+    EXPECT_EQ(service.eventDispatcher_->GetStats().handled, 1U);
     service.GetMessageFromQueue(bean);
 
     service.dumpSignal_ = std::make_shared<DumpSignal>();
@@ -1983,9 +2043,15 @@ HWTEST(MediaMonitorDtTest, MediaMonitorService_MessageDumpAndFileBranch_001, Tes
     service.DumpBufferWrite(writeQueue);
     EXPECT_TRUE(writeQueue.empty());
     std::shared_ptr<AudioDumpBuffer> nullBuffer = nullptr;
-    service.WriteBufferFromQueue("dt.pcm", nullBuffer);
+    service.dumpEnable_ = true;
+    service.dumpFileWriter_ = std::make_unique<DumpFileWriter>("/path/not/exist/", DumpFileWriter::Options {});
+    writeQueue.push(std::make_pair("dt.pcm", nullBuffer));
     dumpBuffer->size = 1;
-    service.WriteBufferFromQueue("dt.pcm", dumpBuffer);
+    writeQueue.push(std::make_pair("dt.pcm", dumpBuffer));
+    service.DumpBufferWrite(writeQueue);
+    EXPECT_TRUE(writeQueue.empty());
+    EXPECT_EQ(service.dumpFileWriter_->GetStats().buffers, 0U);
+    service.dumpEnable_ = false;
     EXPECT_FALSE(service.DeleteHistoryFile("/path/not/exist/media_monitor_dt.pcm"));
 
     service.dumpType_ = DEFAULT_DUMP_TYPE;
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "audio_dump_flusher.h"
+#include "monitor_error.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+namespace {
+constexpr size_t PERIOD_SIZE = 960 * 2 * 2; // 960 * 2 * 2: 20ms of 48kHz stereo S16
+const std::string FILE_CAPTURE = "unit_test_capture_48000_2_1.pcm";
+const std::string FILE_RENDER = "unit_test_render_48000_2_1.pcm";
+
+// stands in for the media monitor service, appends each batch to its file
+class LocalDumpServer {
+public:
+    AudioDumpFlusher::DumpSink GetSink()
+    {
+        return [this](const std::string &fileName, const uint8_t *data, size_t size) {
+            if (delayMs_ > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(delayMs_));
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto &file = files_[fileName];
+            file.insert(file.end(), data, data + size);
+            calls_++;
+            return SUCCESS;
+        };
+    }
+
+    std::vector<uint8_t> GetFile(const std::string &fileName)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return files_[fileName];
+    }
+
+    size_t GetCalls()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_;
+    }
+
+    int32_t delayMs_ {0};
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, std::vector<uint8_t>> files_;
+    size_t calls_ {0};
+};
+
+std::vector<uint8_t> MakePeriod(size_t index, uint8_t seed)
+{
+    std::vector<uint8_t> data(PERIOD_SIZE);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(index * 7 + i + seed); // 7: any spread
+    }
+    return data;
+}
+}
+
+HWTEST(AudioDumpFlusherUnitTest, AudioDumpFlusher_Batch_001, TestSize.Level0)
+{
+    LocalDumpServer server;
+    AudioDumpFlusher flusher(server.GetSink());
+    std::vector<uint8_t> capture;
+    std::vector<uint8_t> render;
+    constexpr size_t periods = 50; // 50: within one batch
+    for (size_t i = 0; i < periods; ++i) {
+        auto capturePeriod = MakePeriod(i, 1);
+        auto renderPeriod = MakePeriod(i, 2);
+        EXPECT_TRUE(flusher.Write(FILE_CAPTURE, capturePeriod.data(), capturePeriod.size()));
+        EXPECT_TRUE(flusher.Write(FILE_RENDER, renderPeriod.data(), renderPeriod.size()));
+        capture.insert(capture.end(), capturePeriod.begin(), capturePeriod.end());
+        render.insert(render.end(), renderPeriod.begin(), renderPeriod.end());
+    }
+    EXPECT_EQ(0u, server.GetCalls());
+    flusher.Flush();
+
+    auto stats = flusher.GetStats();
+    EXPECT_EQ(2 * periods, stats.writes);
+    EXPECT_EQ(2u, stats.batches); // 2: one batch per file
+    EXPECT_EQ(2u, server.GetCalls());
+    EXPECT_EQ(0u, stats.droppedWrites);
+    EXPECT_EQ(capture, server.GetFile(FILE_CAPTURE));
+    EXPECT_EQ(render, server.GetFile(FILE_RENDER));
+}
+
+HWTEST(AudioDumpFlusherUnitTest, AudioDumpFlusher_Drop_001, TestSize.Level0)
+{
+    LocalDumpServer server;
+    AudioDumpFlusher::Options options;
+    options.ringSize = 2 * PERIOD_SIZE; // 2: periods held by the ring
+    AudioDumpFlusher flusher(server.GetSink(), options);
+    std::vector<uint8_t> expected;
+    for (size_t i = 0; i < 3; ++i) { // 3: one more than the ring holds
+        auto period = MakePeriod(i, 3);
+        if (flusher.Write(FILE_CAPTURE, period.data(), period.size())) {
+            expected.insert(expected.end(), period.begin(), period.end());
+        }
+    }
+    auto stats = flusher.GetStats();
+    EXPECT_EQ(1u, stats.droppedWrites);
+    EXPECT_EQ(PERIOD_SIZE, stats.droppedBytes);
+
+    flusher.Flush();
+    EXPECT_EQ(2 * PERIOD_SIZE, expected.size());
+    EXPECT_EQ(expected, server.GetFile(FILE_CAPTURE));
+    auto period = MakePeriod(3, 3); // 3: room again after the flush
+    EXPECT_TRUE(flusher.Write(FILE_CAPTURE, period.data(), period.size()));
+}
+
+HWTEST(AudioDumpFlusherUnitTest, AudioDumpFlusher_Background_001, TestSize.Level0)
+{
+    LocalDumpServer server;
+    AudioDumpFlusher flusher(server.GetSink());
+    flusher.Start();
+    constexpr size_t periods = 200;
+    auto writeLoop = [&flusher](const std::string &fileName, uint8_t seed) {
+        for (size_t i = 0; i < periods; ++i) {
+            auto period = MakePeriod(i, seed);
+            EXPECT_TRUE(flusher.Write(fileName, period.data(), period.size()));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1)); // 1ms: a fast audio thread
+        }
+    };
+    std::thread capture(writeLoop, FILE_CAPTURE, 4); // 4: seed
+    std::thread render(writeLoop, FILE_RENDER, 5); // 5: seed
+    capture.join();
+    render.join();
+    flusher.Stop();
+
+    std::vector<uint8_t> expected;
+    for (size_t i = 0; i < periods; ++i) {
+        auto period = MakePeriod(i, 4); // 4: seed
+        expected.insert(expected.end(), period.begin(), period.end());
+    }
+    EXPECT_EQ(expected, server.GetFile(FILE_CAPTURE));
+    auto stats = flusher.GetStats();
+    EXPECT_EQ(0u, stats.droppedWrites);
+    EXPECT_LT(stats.batches, stats.writes / 4); // 4: several periods per batch at least
+}
+
+HWTEST(AudioDumpFlusherUnitTest, AudioDumpFlusher_SlowServer_001, TestSize.Level0)
+{
+    LocalDumpServer server;
+    server.delayMs_ = 100; // 100ms: a busy service
+    AudioDumpFlusher flusher(server.GetSink());
+    flusher.Start();
+    int64_t maxWriteUs = 0;
+    for (size_t i = 0; i < 50; ++i) { // 50: periods
+        auto period = MakePeriod(i, 6); // 6: seed
+        auto start = std::chrono::steady_clock::now();
+        (void)flusher.Write(FILE_RENDER, period.data(), period.size());
+        maxWriteUs = std::max<int64_t>(maxWriteUs, std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        std::this_thread::sleep_for(std::chrono::milliseconds(5)); // 5ms
+    }
+    flusher.Stop();
+    EXPECT_LT(maxWriteUs, server.delayMs_ * 1000 / 2); // 1000 / 2: far below one sink call
+    EXPECT_EQ(50 * PERIOD_SIZE, server.GetFile(FILE_RENDER).size() + flusher.GetStats().droppedBytes);
+}
+
+HWTEST(AudioDumpFlusherUnitTest, AudioDumpFlusher_ReleaseIdle_001, TestSize.Level0)
+{
+    LocalDumpServer server;
+    AudioDumpFlusher::Options options;
+    options.ringReleaseMs = 0; // 0: released on the first drain that finds no new data
+    AudioDumpFlusher flusher(server.GetSink(), options);
+    constexpr size_t files = 40; // 40: more files over time than there are ring slots
+    for (size_t round = 0; round < 2; ++round) { // 2: every file is written again after its ring was released
+        for (size_t i = 0; i < files; ++i) {
+            std::string fileName = "unit_test_" + std::to_string(i) + "_48000_2_1.pcm";
+            auto period = MakePeriod(i, static_cast<uint8_t>(round));
+            EXPECT_TRUE(flusher.Write(fileName, period.data(), period.size()));
+            flusher.Flush(); // drains the new data
+            flusher.Flush(); // finds the ring idle and releases it
+        }
+    }
+    EXPECT_EQ(0u, flusher.GetStats().droppedWrites);
+    for (size_t i = 0; i < files; ++i) {
+        std::vector<uint8_t> expected = MakePeriod(i, 0);
+        auto second = MakePeriod(i, 1);
+        expected.insert(expected.end(), second.begin(), second.end());
+        EXPECT_EQ(expected, server.GetFile("unit_test_" + std::to_string(i) + "_48000_2_1.pcm"));
+    }
+
+    // a ring with data in it is kept
+    auto period = MakePeriod(0, 7); // 7: seed
+    EXPECT_TRUE(flusher.Write(FILE_CAPTURE, period.data(), period.size()));
+    flusher.Flush();
+    EXPECT_TRUE(flusher.Write(FILE_CAPTURE, period.data(), period.size()));
+    flusher.Flush();
+    EXPECT_EQ(2 * PERIOD_SIZE, server.GetFile(FILE_CAPTURE).size()); // 2: both periods
+}
+
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "event_batcher.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace MediaMonitor {
+namespace {
+const std::string KEY_INDEX = "INDEX";
+
+// stands in for the media monitor service, records each batch it receives
+class LocalEventServer {
+public:
+    EventBatcher::BatchSink GetSink()
+    {
+        return [this](const std::vector<EventBean> &beans) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            batchSizes_.push_back(beans.size());
+            for (auto bean : beans) {
+                indexes_.push_back(bean.GetIntValue(KEY_INDEX));
+            }
+        };
+    }
+
+    std::vector<int32_t> GetIndexes()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return indexes_;
+    }
+
+    std::vector<size_t> GetBatchSizes()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batchSizes_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<int32_t> indexes_;
+    std::vector<size_t> batchSizes_;
+};
+
+EventBean MakeEvent(int32_t index)
+{
+    EventBean bean(AUDIO, STREAM_CHANGE, BEHAVIOR_EVENT);
+    bean.Add(KEY_INDEX, index);
+    bean.Add("UID", 20020000); // 20020000: any uid
+    return bean;
+}
+}
+
+HWTEST(EventBatcherUnitTest, EventBatcher_Burst_001, TestSize.Level0)
+{
+    LocalEventServer server;
+    std::vector<int32_t> expected;
+    constexpr int32_t events = 1000;
+    EventBatcher::Stats stats;
+    {
+        EventBatcher batcher(server.GetSink());
+        for (int32_t i = 0; i < events; ++i) {
+            EXPECT_TRUE(batcher.Submit(MakeEvent(i)));
+            expected.push_back(i);
+        }
+        batcher.Flush();
+        stats = batcher.GetStats();
+    }
+    EXPECT_EQ(expected, server.GetIndexes());
+    EXPECT_EQ(static_cast<uint64_t>(events), stats.events);
+    EXPECT_EQ(0u, stats.droppedEvents);
+    EXPECT_LE(stats.batches, static_cast<uint64_t>(events / 8)); // 8: events per IPC at least
+    for (auto size : server.GetBatchSizes()) {
+        EXPECT_LE(size, EventBatcher::Options {}.maxEvents);
+    }
+}
+
+HWTEST(EventBatcherUnitTest, EventBatcher_Deadline_001, TestSize.Level0)
+{
+    LocalEventServer server;
+    EventBatcher::Options options;
+    options.maxDelayMs = 10; // 10ms
+    EventBatcher batcher(server.GetSink(), options);
+    EXPECT_TRUE(batcher.Submit(MakeEvent(1)));
+    EXPECT_TRUE(batcher.Submit(MakeEvent(2))); // 2: same batch
+    for (int32_t i = 0; i < 100 && server.GetIndexes().size() < 2; ++i) { // 100: 1s at most, 2: events
+        std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10ms
+    }
+    EXPECT_EQ(std::vector<int32_t>({1, 2}), server.GetIndexes());
+    EXPECT_EQ(std::vector<size_t>({2}), server.GetBatchSizes());
+}
+
+HWTEST(EventBatcherUnitTest, EventBatcher_Bytes_001, TestSize.Level0)
+{
+    LocalEventServer server;
+    EventBatcher::Options options;
+    EventBean large = MakeEvent(0);
+    large.Add("DETAIL", std::string(1000, 'x')); // 1000: a long string field
+    options.maxBytes = large.GetParcelSize() * 4; // 4: events per batch
+    EventBatcher batcher(server.GetSink(), options);
+    for (int32_t i = 0; i < 10; ++i) { // 10: events
+        large.UpdateIntMap(KEY_INDEX, i);
+        EXPECT_TRUE(batcher.Submit(large));
+    }
+    batcher.Flush();
+    EXPECT_EQ(10u, server.GetIndexes().size()); // 10: events
+    for (auto size : server.GetBatchSizes()) {
+        EXPECT_LE(size, 4u); // 4: events per batch
+    }
+}
+
+HWTEST(EventBatcherUnitTest, EventBatcher_Threads_001, TestSize.Level0)
+{
+    LocalEventServer server;
+    constexpr int32_t events = 500;
+    {
+        EventBatcher batcher(server.GetSink());
+        auto submitLoop = [&batcher](int32_t base) {
+            for (int32_t i = 0; i < events; ++i) {
+                EXPECT_TRUE(batcher.Submit(MakeEvent(base + i)));
+            }
+        };
+        std::thread first(submitLoop, 0);
+        std::thread second(submitLoop, events);
+        first.join();
+        second.join();
+    }
+    // each thread's events arrive in the order they were written
+    int32_t lastFirst = -1;
+    int32_t lastSecond = events - 1;
+    auto indexes = server.GetIndexes();
+    EXPECT_EQ(static_cast<size_t>(2 * events), indexes.size()); // 2: threads
+    for (auto index : indexes) {
+        int32_t &last = index < events ? lastFirst : lastSecond;
+        EXPECT_GT(index, last);
+        last = index;
+    }
+}
+} // namespace MediaMonitor
+} // namespace Media
+} // namespace OHOS
@@ -68,9 +68,35 @@ OH_AVBuffer::OH_AVBuffer(const std::shared_ptr<OHOS::Media::AVBuffer> &buffer)
 OH_AVBuffer::~OH_AVBuffer()
 {
     magic_ = MFMagic::MFMAGIC_UNKNOWN;
+    if (paramView_ != nullptr) {
+        delete paramView_;
+        paramView_ = nullptr;
+    }
 }
 
 bool OH_AVBuffer::IsEqualBuffer(const std::shared_ptr<OHOS::Media::AVBuffer> &buffer)
 {
     return (buffer == buffer_);
 }
+
+OH_AVBufferPool::OH_AVBufferPool(int32_t capacity, uint32_t maxIdleCount)
+    : MFObjectMagic(MFMagic::MFMAGIC_AVBUFFER_POOL), capacity_(capacity), maxIdleCount_(maxIdleCount)
+{
+}
+
+OH_AVBufferPool::~OH_AVBufferPool()
+{
+    magic_ = MFMagic::MFMAGIC_UNKNOWN;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &sizeClass : idleBuffers_) {
+        for (auto buffer : sizeClass.second) {
+            delete buffer;
+        }
+    }
+    idleBuffers_.clear();
+    // buffers still in use are handed over to the user, they are destroyed by OH_AVBuffer_Destroy
+    for (auto &busy : busyBuffers_) {
+        busy.first->isUserCreated = true;
+    }
+    busyBuffers_.clear();
+}
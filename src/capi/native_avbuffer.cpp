@@ -27,9 +27,12 @@ constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_CORE, LOG_DOMAIN_FOUNDATION,
 using namespace OHOS;
 using namespace OHOS::Media;
 
-OH_AVBuffer *OH_AVBuffer_Create(int32_t capacity)
+namespace {
+constexpr int32_t MIN_SIZE_CLASS = 4096; // 4096: one page, shared memory is mapped in pages
+constexpr int32_t MAX_SIZE_CLASS = 1 << 30; // 30: larger capacities are used as they are
+
+OH_AVBuffer *CreateSharedBuffer(int32_t capacity)
 {
-    FALSE_RETURN_V_MSG_E(capacity > 0, nullptr, "capacity %{public}d is error!", capacity);
     auto allocator = AVAllocatorFactory::CreateSharedAllocator(MemoryFlag::MEMORY_READ_WRITE);
     FALSE_RETURN_V_MSG_E(allocator != nullptr, nullptr, "create allocator failed");
 
@@ -40,6 +43,76 @@ OH_AVBuffer *OH_AVBuffer_Create(int32_t capacity)
 
     struct OH_AVBuffer *buf = new (std::nothrow) OH_AVBuffer(buffer);
     FALSE_RETURN_V_MSG_E(buf != nullptr, nullptr, "failed to new OH_AVBuffer");
+    return buf;
+}
+
+int32_t GetSizeClass(int32_t capacity)
+{
+    int32_t sizeClass = MIN_SIZE_CLASS;
+    while (sizeClass < capacity && sizeClass < MAX_SIZE_CLASS) {
+        sizeClass <<= 1;
+    }
+    return capacity > sizeClass ? capacity : sizeClass;
+}
+
+void ResetPooledBuffer(OH_AVBuffer *buffer)
+{
+    auto &avBuffer = buffer->buffer_;
+    avBuffer->pts_ = 0;
+    avBuffer->dts_ = 0;
+    avBuffer->duration_ = 0;
+    avBuffer->flag_ = 0;
+    if (avBuffer->meta_ != nullptr) {
+        avBuffer->meta_->Clear();
+    }
+    (void)avBuffer->memory_->SetSize(0);
+    (void)avBuffer->memory_->SetOffset(0);
+}
+
+// the view is created once per buffer and follows the buffer if its meta is replaced, no meta is copied
+OH_AVFormat *GetParamView(OH_AVBuffer *buffer)
+{
+    std::shared_ptr<Meta> &meta = buffer->buffer_->meta_;
+    if (buffer->paramView_ == nullptr) {
+        buffer->paramView_ = new (std::nothrow) OH_AVFormat();
+        FALSE_RETURN_V_MSG_E(buffer->paramView_ != nullptr, nullptr, "failed to new OH_AVFormat");
+        buffer->paramView_->isBorrowed = true;
+    }
+    if (buffer->paramView_->format_.GetMeta() != meta) {
+        (void)buffer->paramView_->format_.SetMetaPtr(meta);
+    }
+    return buffer->paramView_;
+}
+
+OH_AVFormat *CheckParamView(OH_AVBuffer *buffer, const char *key)
+{
+    FALSE_RETURN_V_MSG_E(buffer != nullptr, nullptr, "input buffer is nullptr!");
+    FALSE_RETURN_V_MSG_E(buffer->magic_ == MFMagic::MFMAGIC_AVBUFFER, nullptr, "magic error!");
+    FALSE_RETURN_V_MSG_E(buffer->buffer_ != nullptr, nullptr, "buffer is nullptr!");
+    FALSE_RETURN_V_MSG_E(buffer->buffer_->meta_ != nullptr, nullptr, "buffer's meta is nullptr!");
+    FALSE_RETURN_V_MSG_E(key != nullptr, nullptr, "key is nullptr!");
+    return GetParamView(buffer);
+}
+
+// the caller holds the lock of the pool
+OH_AVBuffer *TakeIdleBuffer(OH_AVBufferPool *pool, int32_t sizeClass)
+{
+    auto iter = pool->idleBuffers_.find(sizeClass);
+    if (iter == pool->idleBuffers_.end() || iter->second.empty()) {
+        return nullptr;
+    }
+    OH_AVBuffer *buffer = iter->second.back();
+    iter->second.pop_back();
+    pool->idleCount_--;
+    return buffer;
+}
+} // namespace
+
+OH_AVBuffer *OH_AVBuffer_Create(int32_t capacity)
+{
+    FALSE_RETURN_V_MSG_E(capacity > 0, nullptr, "capacity %{public}d is error!", capacity);
+    struct OH_AVBuffer *buf = CreateSharedBuffer(capacity);
+    FALSE_RETURN_V(buf != nullptr, nullptr);
     buf->isUserCreated = true;
     return buf;
 }
@@ -118,10 +191,71 @@ OH_AVErrCode OH_AVBuffer_SetParameter(OH_AVBuffer *buffer, const OH_AVFormat *fo
     std::shared_ptr<Meta> meta = formatRef->format_.GetMeta();
     FALSE_RETURN_V_MSG_E(meta != nullptr, AV_ERR_INVALID_VAL, "input meta is nullptr!!");
 
+    if (buffer->buffer_->meta_ == meta) {
+        return AV_ERR_OK; // the view of this buffer, its changes are already in place
+    }
     *(buffer->buffer_->meta_) = *(meta);
     return AV_ERR_OK;
 }
 
+OH_AVFormat *OH_AVBuffer_GetParameterView(OH_AVBuffer *buffer)
+{
+    FALSE_RETURN_V_MSG_E(buffer != nullptr, nullptr, "input buffer is nullptr!");
+    FALSE_RETURN_V_MSG_E(buffer->magic_ == MFMagic::MFMAGIC_AVBUFFER, nullptr, "magic error!");
+    FALSE_RETURN_V_MSG_E(buffer->buffer_ != nullptr, nullptr, "buffer is nullptr!");
+    FALSE_RETURN_V_MSG_E(buffer->buffer_->meta_ != nullptr, nullptr, "buffer's meta is nullptr!");
+    return GetParamView(buffer);
+}
+
+// no meta is copied, but Format builds a std::string of the key for every lookup, so these are not allocation free
+bool OH_AVBuffer_GetIntParameter(OH_AVBuffer *buffer, const char *key, int32_t *out)
+{
+    OH_AVFormat *view = CheckParamView(buffer, key);
+    FALSE_RETURN_V(view != nullptr, false);
+    FALSE_RETURN_V_MSG_E(out != nullptr, false, "out is nullptr!");
+    return view->format_.GetIntValue(key, *out);
+}
+
+bool OH_AVBuffer_GetLongParameter(OH_AVBuffer *buffer, const char *key, int64_t *out)
+{
+    OH_AVFormat *view = CheckParamView(buffer, key);
+    FALSE_RETURN_V(view != nullptr, false);
+    FALSE_RETURN_V_MSG_E(out != nullptr, false, "out is nullptr!");
+    return view->format_.GetLongValue(key, *out);
+}
+
+bool OH_AVBuffer_GetDoubleParameter(OH_AVBuffer *buffer, const char *key, double *out)
+{
+    OH_AVFormat *view = CheckParamView(buffer, key);
+    FALSE_RETURN_V(view != nullptr, false);
+    FALSE_RETURN_V_MSG_E(out != nullptr, false, "out is nullptr!");
+    return view->format_.GetDoubleValue(key, *out);
+}
+
+OH_AVErrCode OH_AVBuffer_SetIntParameter(OH_AVBuffer *buffer, const char *key, int32_t value)
+{
+    OH_AVFormat *view = CheckParamView(buffer, key);
+    FALSE_RETURN_V(view != nullptr, AV_ERR_INVALID_VAL);
+    FALSE_RETURN_V(view->format_.PutIntValue(key, value), AV_ERR_INVALID_VAL);
+    return AV_ERR_OK;
+}
+
+OH_AVErrCode OH_AVBuffer_SetLongParameter(OH_AVBuffer *buffer, const char *key, int64_t value)
+{
+    OH_AVFormat *view = CheckParamView(buffer, key);
+    FALSE_RETURN_V(view != nullptr, AV_ERR_INVALID_VAL);
+    FALSE_RETURN_V(view->format_.PutLongValue(key, value), AV_ERR_INVALID_VAL);
+    return AV_ERR_OK;
+}
+
+OH_AVErrCode OH_AVBuffer_SetDoubleParameter(OH_AVBuffer *buffer, const char *key, double value)
+{
+    OH_AVFormat *view = CheckParamView(buffer, key);
+    FALSE_RETURN_V(view != nullptr, AV_ERR_INVALID_VAL);
+    FALSE_RETURN_V(view->format_.PutDoubleValue(key, value), AV_ERR_INVALID_VAL);
+    return AV_ERR_OK;
+}
+
 uint8_t *OH_AVBuffer_GetAddr(OH_AVBuffer *buffer)
 {
     FALSE_RETURN_V_MSG_E(buffer != nullptr, nullptr, "input buffer is nullptr!");
@@ -150,4 +284,79 @@ OH_NativeBuffer *OH_AVBuffer_GetNativeBuffer(OH_AVBuffer *buffer)
     FALSE_RETURN_V_MSG_E(surfaceBuffer != nullptr, nullptr, "surfaceBuffer is nullptr!");
     surfaceBuffer->IncStrongRef(surfaceBuffer.GetRefPtr());
     return surfaceBuffer->SurfaceBufferToNativeBuffer();
-}
\ No newline at end of file
+}
+
+OH_AVBufferPool *OH_AVBufferPool_Create(int32_t capacity, int32_t count)
+{
+    FALSE_RETURN_V_MSG_E(capacity > 0, nullptr, "capacity %{public}d is error!", capacity);
+    FALSE_RETURN_V_MSG_E(count > 0, nullptr, "count %{public}d is error!", count);
+    struct OH_AVBufferPool *pool = new (std::nothrow) OH_AVBufferPool(capacity, static_cast<uint32_t>(count));
+    FALSE_RETURN_V_MSG_E(pool != nullptr, nullptr, "failed to new OH_AVBufferPool");
+    int32_t sizeClass = GetSizeClass(capacity);
+    for (int32_t i = 0; i < count; ++i) {
+        OH_AVBuffer *buffer = CreateSharedBuffer(sizeClass);
+        if (buffer == nullptr) {
+            delete pool;
+            return nullptr;
+        }
+        pool->allocCount_++;
+        pool->idleBuffers_[sizeClass].push_back(buffer);
+        pool->idleCount_++;
+    }
+    return pool;
+}
+
+OH_AVBuffer *OH_AVBufferPool_Acquire(OH_AVBufferPool *pool, int32_t capacity)
+{
+    FALSE_RETURN_V_MSG_E(pool != nullptr, nullptr, "input pool is nullptr!");
+    FALSE_RETURN_V_MSG_E(pool->magic_ == MFMagic::MFMAGIC_AVBUFFER_POOL, nullptr, "magic error!");
+    int32_t sizeClass = GetSizeClass(capacity > 0 ? capacity : pool->capacity_);
+    OH_AVBuffer *buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex_);
+        buffer = TakeIdleBuffer(pool, sizeClass);
+        if (buffer != nullptr) {
+            pool->busyBuffers_[buffer] = sizeClass;
+        }
+    }
+    if (buffer == nullptr) {
+        // allocate outside of the lock, the other users of the pool are not blocked by the system call
+        buffer = CreateSharedBuffer(sizeClass);
+        FALSE_RETURN_V(buffer != nullptr, nullptr);
+        std::lock_guard<std::mutex> lock(pool->mutex_);
+        pool->allocCount_++;
+        pool->busyBuffers_[buffer] = sizeClass;
+    }
+    ResetPooledBuffer(buffer);
+    return buffer;
+}
+
+OH_AVErrCode OH_AVBufferPool_Release(OH_AVBufferPool *pool, OH_AVBuffer *buffer)
+{
+    FALSE_RETURN_V_MSG_E(pool != nullptr, AV_ERR_INVALID_VAL, "input pool is nullptr!");
+    FALSE_RETURN_V_MSG_E(pool->magic_ == MFMagic::MFMAGIC_AVBUFFER_POOL, AV_ERR_INVALID_VAL, "magic error!");
+    FALSE_RETURN_V_MSG_E(buffer != nullptr, AV_ERR_INVALID_VAL, "input buffer is nullptr!");
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex_);
+        auto iter = pool->busyBuffers_.find(buffer);
+        FALSE_RETURN_V_MSG_E(iter != pool->busyBuffers_.end(), AV_ERR_INVALID_VAL,
+            "buffer is not acquired from this pool!");
+        int32_t sizeClass = iter->second;
+        pool->busyBuffers_.erase(iter);
+        if (pool->idleCount_ < pool->maxIdleCount_) {
+            pool->idleBuffers_[sizeClass].push_back(buffer);
+            pool->idleCount_++;
+            return AV_ERR_OK;
+        }
+    }
+    delete buffer;
+    return AV_ERR_OK;
+}
+
+OH_AVErrCode OH_AVBufferPool_Destroy(OH_AVBufferPool *pool)
+{
+    FALSE_RETURN_V_MSG_E(pool != nullptr, AV_ERR_INVALID_VAL, "input pool is nullptr!");
+    FALSE_RETURN_V_MSG_E(pool->magic_ == MFMagic::MFMAGIC_AVBUFFER_POOL, AV_ERR_INVALID_VAL, "magic error!");
+    delete pool;
+    return AV_ERR_OK;
+}
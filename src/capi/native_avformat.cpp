@@ -61,6 +61,7 @@ struct OH_AVFormat *OH_AVFormat_CreateVideoFormat(const char *mimeType, int32_t
 
 void OH_AVFormat_Destroy(struct OH_AVFormat *format)
 {
+    FALSE_RETURN_MSG(format == nullptr || !format->isBorrowed, "format is owned by a buffer!");
     delete format;
 }
 
@@ -13,23 +13,122 @@
  * limitations under the License.
  */
 
+#include <cerrno>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "common/log.h"
 #include "osal/utils/dump_buffer.h"
 #include "parameter.h"
 #include "osal/filesystem/file_system.h"
+#include "osal/task/task.h"
 
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = { LOG_CORE, LOG_DOMAIN_FOUNDATION, "DumpBuffer" };
-constexpr size_t DUMP_DATA_UNIT = 1; // data unit is 1 byte
+constexpr size_t MAX_OPEN_DUMP_FILES = 16; // 16: dump files kept open at the same time
+constexpr int64_t DUMP_FILE_IDLE_MS = 5000; // 5000ms: a dump file not written for this long gets closed
+constexpr mode_t DUMP_FILE_MODE = 0666; // 0666: what fopen creates files with
+
+struct DumpFile {
+    int fd = -1;
+    std::chrono::steady_clock::time_point lastWrite;
+};
+
+// the files stay open between buffers, opening one per buffer dominated the cost of dumping
+std::mutex g_dumpFileMutex;
+std::map<std::string, DumpFile> g_dumpFiles;
+bool g_idleCloseScheduled = false;
+
+OHOS::Media::Task& GetIdleCloseTask()
+{
+    static OHOS::Media::Task task("OS_DumpFileClose");
+    return task;
+}
+
+// closes the files idle for DUMP_FILE_IDLE_MS, returns the ms until the next one gets idle or -1 if none is open
+int64_t CloseIdleDumpFiles()
+{
+    auto now = std::chrono::steady_clock::now();
+    int64_t nextIdleMs = -1;
+    for (auto it = g_dumpFiles.begin(); it != g_dumpFiles.end();) {
+        int64_t idleMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second.lastWrite).count();
+        if (idleMs >= DUMP_FILE_IDLE_MS) {
+            (void)close(it->second.fd);
+            it = g_dumpFiles.erase(it);
+            continue;
+        }
+        if (nextIdleMs < 0 || DUMP_FILE_IDLE_MS - idleMs < nextIdleMs) {
+            nextIdleMs = DUMP_FILE_IDLE_MS - idleMs;
+        }
+        ++it;
+    }
+    return nextIdleMs;
+}
+
+void ScheduleIdleClose(int64_t delayMs)
+{
+    if (g_idleCloseScheduled) {
+        return;
+    }
+    g_idleCloseScheduled = true;
+    // the dump calls stop when the stream ends, so the idle files are closed from a timer and not on the next call
+    GetIdleCloseTask().SubmitJobOnce([] {
+        std::lock_guard<std::mutex> lock(g_dumpFileMutex);
+        g_idleCloseScheduled = false;
+        int64_t nextIdleMs = CloseIdleDumpFiles();
+        if (nextIdleMs >= 0) {
+            ScheduleIdleClose(nextIdleMs);
+        }
+    }, delayMs * 1000); // 1000: ms to us
+}
+
+void CloseOldestDumpFile()
+{
+    auto oldest = g_dumpFiles.end();
+    for (auto it = g_dumpFiles.begin(); it != g_dumpFiles.end(); ++it) {
+        if (oldest == g_dumpFiles.end() || it->second.lastWrite < oldest->second.lastWrite) {
+            oldest = it;
+        }
+    }
+    if (oldest != g_dumpFiles.end()) {
+        (void)close(oldest->second.fd);
+        g_dumpFiles.erase(oldest);
+    }
+}
+
+int GetDumpFile(const std::string& filePath, bool truncate)
+{
+    auto it = g_dumpFiles.find(filePath);
+    if (it != g_dumpFiles.end()) {
+        // "w" starts the file over, the fd appends so the next write lands at 0
+        if (truncate && ftruncate(it->second.fd, 0) != 0) {
+            MEDIA_LOG_W("truncate dump file failed, errno %{public}d", errno);
+        }
+        return it->second.fd;
+    }
+    // make room by closing only the least recently written file
+    if (g_dumpFiles.size() >= MAX_OPEN_DUMP_FILES) {
+        CloseOldestDumpFile();
+    }
+    int flags = O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0);
+    int fd = open(filePath.c_str(), flags, DUMP_FILE_MODE);
+    if (fd < 0) {
+        return -1;
+    }
+    g_dumpFiles[filePath].fd = fd;
+    ScheduleIdleClose(DUMP_FILE_IDLE_MS);
+    return fd;
+}
 }
 
 namespace OHOS {
 namespace Media {
-// std::map<std::string, FILE*> allDumpFileFds;
 void DumpAVBufferToFile(const std::string& para, const std::string& fileName, const std::shared_ptr<AVBuffer>& buffer)
 {
     MEDIA_LOG_D("dump avbuffer to %{public}s", fileName.c_str());
@@ -40,27 +139,42 @@ void DumpAVBufferToFile(const std::string& para, const std::string& fileName, co
     FALSE_RETURN_MSG((para == "w" || para == "a") && !fileName.empty(), "para or fileName is invalid.");
     size_t bufferSize = static_cast<size_t>(buffer->memory_->GetSize());
     FALSE_RETURN((bufferSize != 0) && (buffer->memory_->GetAddr() != nullptr));
-    std::string mode = para + "b+";
     std::string filePath = DUMP_FILE_DIR + fileName;
-    if (filePath == "") {
-        return;
-    }
-    FILE* dumpFile = std::fopen(filePath.c_str(), mode.c_str());
-    if (dumpFile == nullptr) {
+    std::lock_guard<std::mutex> lock(g_dumpFileMutex);
+    int fd = GetDumpFile(filePath, para == "w");
+    if (fd < 0) {
         MEDIA_LOG_E("dump buffer to file failed.");
         return;
     }
-    size_t ret =
-        fwrite(reinterpret_cast<const char*>(buffer->memory_->GetAddr()), DUMP_DATA_UNIT, bufferSize, dumpFile);
-    if (ret < 0) {
-        MEDIA_LOG_W("dump is fail.");
+    g_dumpFiles[filePath].lastWrite = std::chrono::steady_clock::now();
+    auto data = reinterpret_cast<const uint8_t*>(buffer->memory_->GetAddr());
+    size_t offset = 0;
+    while (offset < bufferSize) {
+        ssize_t ret = write(fd, data + offset, bufferSize - offset);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            MEDIA_LOG_W("dump is fail.");
+            break;
+        }
+        offset += static_cast<size_t>(ret);
     }
-    std::fclose(dumpFile);
 }
 
 void PrepareDumpDir()
 {
     MEDIA_LOG_I("Prepare dumpDir enter.");
 }
+
+void EndDumpFile()
+{
+    MEDIA_LOG_I("End dump enter.");
+    std::lock_guard<std::mutex> lock(g_dumpFileMutex);
+    for (auto &it : g_dumpFiles) {
+        (void)close(it.second.fd);
+    }
+    g_dumpFiles.clear();
+}
 } // Media
 } // OHOS
\ No newline at end of file
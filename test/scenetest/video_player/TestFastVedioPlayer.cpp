@@ -996,6 +996,46 @@ namespace Test {
         ASSERT_EQ(0, player->Release());
     }
 
+    // seek to a frame between key frames while playing, time from the seek call to the target frame on screen
+    void TestSeekClosestLatency(std::string url, int32_t fileSize)
+    {
+        const std::vector<int64_t> seekPositions {4100, 1300, 3700, 2900, 4700}; // MS, away from the key frames
+        constexpr int64_t FIRST_FRAME_TIMEOUT_MS {2000}; // 2000 MS
+        constexpr int64_t LANDED_WINDOW_MS {500}; // 500 MS, shorter than any distance between the targets
+        std::string uri = FilePathToFd(url, fileSize);
+        std::unique_ptr<TestPlayer> player = TestPlayer::Create();
+        ASSERT_EQ(0, player->SetSource(TestSource(uri)));
+        ASSERT_EQ(0, player->Prepare());
+        ASSERT_EQ(0, player->Play());
+        ASSERT_TRUE(player->IsPlaying());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1000)); // 1000 MS
+        int64_t maxLatencyMs {0};
+        for (auto seekPos : seekPositions) {
+            auto start = std::chrono::steady_clock::now();
+            ASSERT_EQ(0, player->Seek(seekPos, OHOS::Media::PlayerSeekMode::SEEK_CLOSEST));
+            int64_t currentMS {0};
+            int64_t latencyMs {0};
+            // played on from the target, a backward seek starts out above the target at the old position
+            auto playedFromTarget = [&currentMS, seekPos] {
+                return currentMS > seekPos && currentMS < seekPos + LANDED_WINDOW_MS;
+            };
+            do {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5)); // 5 MS
+                ASSERT_EQ(0, player->GetCurrentTime(currentMS));
+                latencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+            } while (!playedFromTarget() && latencyMs < FIRST_FRAME_TIMEOUT_MS);
+            MEDIA_LOG_I("seek to " PUBLIC_LOG_D64 " ms, first frame at " PUBLIC_LOG_D64 " ms after " PUBLIC_LOG_D64
+                        " ms", seekPos, currentMS, latencyMs);
+            EXPECT_LT(latencyMs, FIRST_FRAME_TIMEOUT_MS);
+            EXPECT_TRUE(playedFromTarget());
+            maxLatencyMs = std::max(maxLatencyMs, latencyMs);
+        }
+        MEDIA_LOG_I("seek to first frame: max latency " PUBLIC_LOG_D64 " ms over " PUBLIC_LOG_ZU " seeks",
+                    maxLatencyMs, seekPositions.size());
+        ASSERT_EQ(0, player->Release());
+    }
+
     HST_TEST(UtTestVedioFastPlayer, TestPlayerFinishedAutomatically, TestSize.Level1)
     {
         for (auto url : vecSource)
@@ -1553,6 +1593,14 @@ namespace Test {
         }
     }
 
+    HST_TEST(UtTestVedioFastPlayer, TestSeekClosestLatency, TestSize.Level1)
+    {
+        for (auto url : vecSource)
+        {
+            TestSeekClosestLatency(url, FILE_SIZE);
+        }
+    }
+
 } // namespace Test
 } // namespace Media
 } // namespace OHOS
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HISTREAMER_TEST_MEMORY_DATA_SOURCE_H
+#define HISTREAMER_TEST_MEMORY_DATA_SOURCE_H
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "plugin/common/plugin_buffer.h"
+#include "plugin/interface/demuxer_plugin.h"
+
+namespace OHOS {
+namespace Media {
+namespace Test {
+// DataSource over a byte vector, counts the reads so tests can check how much of the file a plugin touches
+class MemoryDataSource : public Plugin::DataSource {
+public:
+    explicit MemoryDataSource(std::vector<uint8_t> data, Plugin::Seekable seekable = Plugin::Seekable::SEEKABLE)
+        : data_(std::move(data)), seekable_(seekable)
+    {
+    }
+
+    Plugin::Status ReadAt(int64_t offset, std::shared_ptr<Plugin::Buffer>& buffer, size_t expectedLen) override
+    {
+        if (offset < 0 || static_cast<size_t>(offset) >= data_.size()) {
+            return Plugin::Status::END_OF_STREAM;
+        }
+        if (buffer->IsEmpty()) {
+            buffer->AllocMemory(nullptr, expectedLen);
+        }
+        size_t size = std::min(expectedLen, data_.size() - static_cast<size_t>(offset));
+        buffer->GetMemory()->Write(data_.data() + offset, size);
+        readCount++;
+        readBytes += size;
+        return Plugin::Status::OK;
+    }
+
+    Plugin::Status GetSize(uint64_t& size) override
+    {
+        size = data_.size();
+        return Plugin::Status::OK;
+    }
+
+    Plugin::Seekable GetSeekable() override
+    {
+        return seekable_;
+    }
+
+    size_t readCount {0};
+    size_t readBytes {0};
+
+private:
+    std::vector<uint8_t> data_;
+    Plugin::Seekable seekable_;
+};
+} // namespace Test
+} // namespace Media
+} // namespace OHOS
+#endif // HISTREAMER_TEST_MEMORY_DATA_SOURCE_H
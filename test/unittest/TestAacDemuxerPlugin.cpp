@@ -13,7 +13,12 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
 #include "gtest/gtest.h"
+#include "MemoryDataSource.h"
+#include "plugin/common/plugin_time.h"
 #include "plugin/plugins/demuxer/aac_demuxer/aac_demuxer_plugin.h"
 
 using namespace testing::ext;
@@ -28,6 +33,61 @@ std::shared_ptr<AACDemuxerPlugin> AacDemuxerPluginCreate(const std::string& name
     return std::make_shared<AACDemuxerPlugin>(name);
 }
 
+namespace {
+constexpr uint32_t ADTS_SAMPLE_RATE = 48000;
+constexpr uint32_t ADTS_FRAME_SAMPLES = 1024;
+constexpr uint32_t ADTS_FRAME_COUNT = 1000;
+
+// 48kHz stereo ADTS frames of varying length, the first payload byte holds the frame number
+std::vector<uint8_t> MakeAdtsStream(uint32_t frameCount, std::vector<int64_t>& frameOffsets)
+{
+    std::vector<uint8_t> data;
+    for (uint32_t i = 0; i < frameCount; ++i) {
+        uint32_t frameLength = 100 + (i * 7) % 200; // 100 200 7: varying frame length
+        frameOffsets.push_back(static_cast<int64_t>(data.size()));
+        data.push_back(0xFF);
+        data.push_back(0xF1);
+        data.push_back((1 << 6) | (3 << 2)); // 1: LC, 3: 48kHz
+        data.push_back((2 << 6) | ((frameLength >> 11) & 0x03)); // 2 channels, 11: bits of frame length
+        data.push_back((frameLength >> 3) & 0xFF); // 3: bits of frame length
+        data.push_back(((frameLength & 0x07) << 5) | 0x1F); // 5: bits of frame length
+        data.push_back(0xFC);
+        data.push_back(static_cast<uint8_t>(i));
+        data.resize(frameOffsets.back() + frameLength, 0);
+    }
+    return data;
+}
+
+int64_t FrameTime(uint64_t frame)
+{
+    return static_cast<int64_t>(frame * ADTS_FRAME_SAMPLES) * HST_SECOND / ADTS_SAMPLE_RATE;
+}
+
+std::shared_ptr<AACDemuxerPlugin> OpenAdtsStream(const std::shared_ptr<MemoryDataSource>& source,
+                                                 MediaInfo& mediaInfo)
+{
+    auto plugin = AacDemuxerPluginCreate("adts");
+    if (plugin->Init() != Status::OK || plugin->SetDataSource(source) != Status::OK ||
+        plugin->GetMediaInfo(mediaInfo) != Status::OK) {
+        return nullptr;
+    }
+    return plugin;
+}
+
+uint8_t ReadFrameNumber(const std::shared_ptr<AACDemuxerPlugin>& plugin, int64_t& pts)
+{
+    Buffer buffer;
+    while (plugin->ReadFrame(buffer, 0) == Status::OK) {
+        auto memory = buffer.GetMemory();
+        if (memory != nullptr && memory->GetSize() > 7) { // 7: adts header
+            pts = buffer.pts;
+            return memory->GetReadOnlyData()[7]; // 7: first payload byte
+        }
+    }
+    return 0;
+}
+}
+
 HWTEST(TestAacDemuxerPlugin, find_aac_demuxer_plugins_process, TestSize.Level1)
 {
     std::shared_ptr<AACDemuxerPlugin> aacDemuxerPlugin = AacDemuxerPluginCreate("process");
@@ -145,6 +205,117 @@ HWTEST(TestAacDemuxerPlugin, find_aac_demuxer_plugins_get_select_track, TestSize
     ASSERT_TRUE(selectStatus == Status::OK);
 }
 
+HWTEST(TestAacDemuxerPlugin, aac_demuxer_duration_estimated_from_first_frames, TestSize.Level1)
+{
+    std::vector<int64_t> frameOffsets;
+    auto source = std::make_shared<MemoryDataSource>(MakeAdtsStream(ADTS_FRAME_COUNT, frameOffsets));
+    MediaInfo mediaInfo;
+    auto plugin = OpenAdtsStream(source, mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    ASSERT_EQ(1u, mediaInfo.tracks.size());
+    int64_t duration = 0;
+    ASSERT_TRUE(mediaInfo.tracks[0].Get<Tag::MEDIA_DURATION>(duration));
+    int64_t expected = FrameTime(ADTS_FRAME_COUNT);
+    ASSERT_LE(std::abs(expected - duration), expected / 10); // 10: within 10 percent
+    // one media io read for the media info, then the headers of the first 64 frames only
+    ASSERT_LE(source->readBytes, 2048 + 7 * 65); // 2048: media io size, 7: adts header, 65: probed frames
+    ASSERT_TRUE(plugin->Deinit() == Status::OK);
+}
+
+HWTEST(TestAacDemuxerPlugin, aac_demuxer_duration_of_short_stream_is_exact, TestSize.Level1)
+{
+    std::vector<int64_t> frameOffsets;
+    auto source = std::make_shared<MemoryDataSource>(MakeAdtsStream(20, frameOffsets)); // 20: less than probed
+    MediaInfo mediaInfo;
+    auto plugin = OpenAdtsStream(source, mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    int64_t duration = 0;
+    ASSERT_TRUE(mediaInfo.tracks[0].Get<Tag::MEDIA_DURATION>(duration));
+    ASSERT_EQ(FrameTime(20), duration); // 20 frames
+    ASSERT_TRUE(plugin->Deinit() == Status::OK);
+}
+
+HWTEST(TestAacDemuxerPlugin, aac_demuxer_seek_to_exact_frame, TestSize.Level1)
+{
+    std::vector<int64_t> frameOffsets;
+    auto source = std::make_shared<MemoryDataSource>(MakeAdtsStream(ADTS_FRAME_COUNT, frameOffsets));
+    MediaInfo mediaInfo;
+    auto plugin = OpenAdtsStream(source, mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    int64_t lastSeekTime = -1;
+    // the first seek to the end indexes the frames on the way, reading their headers only
+    ASSERT_TRUE(plugin->SeekTo(0, FrameTime(999), SeekMode::SEEK_PREVIOUS_SYNC, lastSeekTime) == Status::OK); // 999
+    ASSERT_EQ(FrameTime(999), lastSeekTime); // 999: the last frame
+    ASSERT_LE(source->readCount, ADTS_FRAME_COUNT + 32u); // 32: the headers between two index entries
+    for (uint64_t frame : {500, 3, 0, 999, 777}) { // frames to seek to
+        size_t readCount = source->readCount;
+        int64_t realSeekTime = -1;
+        int64_t seekTime = FrameTime(frame) + FrameTime(1) / 2; // 2: middle of the frame
+        ASSERT_TRUE(plugin->SeekTo(0, seekTime, SeekMode::SEEK_PREVIOUS_SYNC, realSeekTime) == Status::OK);
+        ASSERT_EQ(FrameTime(frame), realSeekTime);
+        ASSERT_LE(source->readCount - readCount, 32u); // 32: at most the headers between two index entries
+        int64_t pts = -1;
+        ASSERT_EQ(static_cast<uint8_t>(frame), ReadFrameNumber(plugin, pts));
+        ASSERT_EQ(FrameTime(frame), pts);
+    }
+    int64_t realSeekTime = -1;
+    int64_t seekTime = FrameTime(10) + FrameTime(1) / 4; // 10: frame, 4: a quarter of the frame
+    ASSERT_TRUE(plugin->SeekTo(0, seekTime, SeekMode::SEEK_NEXT_SYNC, realSeekTime) == Status::OK);
+    ASSERT_EQ(FrameTime(11), realSeekTime); // 11: the frame after the seek time
+    int64_t pts = -1;
+    ASSERT_EQ(11, ReadFrameNumber(plugin, pts)); // 11: the frame after the seek time
+    ASSERT_EQ(12, ReadFrameNumber(plugin, pts)); // 12: the next frame
+    ASSERT_EQ(FrameTime(12), pts); // 12: the next frame
+    ASSERT_TRUE(plugin->Deinit() == Status::OK);
+}
+
+HWTEST(TestAacDemuxerPlugin, aac_demuxer_duration_is_exact_once_indexed, TestSize.Level1)
+{
+    std::vector<int64_t> frameOffsets;
+    auto source = std::make_shared<MemoryDataSource>(MakeAdtsStream(ADTS_FRAME_COUNT, frameOffsets));
+    MediaInfo mediaInfo;
+    auto plugin = OpenAdtsStream(source, mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    ValueType value;
+    ASSERT_TRUE(plugin->GetParameter(Tag::MEDIA_DURATION, value) == Status::ERROR_NOT_EXISTED);
+    int64_t realSeekTime = -1;
+    ASSERT_TRUE(plugin->SeekTo(0, FrameTime(999), SeekMode::SEEK_PREVIOUS_SYNC, realSeekTime) == Status::OK); // 999
+    ASSERT_TRUE(plugin->GetParameter(Tag::MEDIA_DURATION, value) == Status::OK);
+    ASSERT_EQ(FrameTime(ADTS_FRAME_COUNT), AnyCast<int64_t>(value));
+    ASSERT_TRUE(plugin->Deinit() == Status::OK);
+
+    // reading through the stream builds the same index
+    source = std::make_shared<MemoryDataSource>(MakeAdtsStream(100, frameOffsets)); // 100: more than probed
+    plugin = OpenAdtsStream(source, mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    ASSERT_TRUE(plugin->GetParameter(Tag::MEDIA_DURATION, value) == Status::ERROR_NOT_EXISTED);
+    int64_t pts = -1;
+    uint8_t frame = 0;
+    for (uint32_t i = 0; i < 100; ++i) { // 100 frames
+        frame = ReadFrameNumber(plugin, pts);
+    }
+    ASSERT_EQ(99, frame); // 99: the last frame
+    ASSERT_TRUE(plugin->GetParameter(Tag::MEDIA_DURATION, value) == Status::OK);
+    ASSERT_EQ(FrameTime(100), AnyCast<int64_t>(value)); // 100 frames
+    ASSERT_TRUE(plugin->Deinit() == Status::OK);
+}
+
+HWTEST(TestAacDemuxerPlugin, aac_demuxer_seek_needs_seekable_source, TestSize.Level1)
+{
+    std::vector<int64_t> frameOffsets;
+    auto source = std::make_shared<MemoryDataSource>(MakeAdtsStream(ADTS_FRAME_COUNT, frameOffsets),
+                                                     Seekable::UNSEEKABLE);
+    MediaInfo mediaInfo;
+    auto plugin = OpenAdtsStream(source, mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    int64_t duration = 0;
+    ASSERT_FALSE(mediaInfo.tracks[0].Get<Tag::MEDIA_DURATION>(duration));
+    int64_t realSeekTime = -1;
+    ASSERT_TRUE(plugin->SeekTo(0, FrameTime(1), SeekMode::SEEK_PREVIOUS_SYNC, realSeekTime) ==
+                Status::ERROR_INVALID_OPERATION);
+    ASSERT_TRUE(plugin->Deinit() == Status::OK);
+}
+
 } // namespace Test
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "gtest/gtest.h"
+#define private public
+#define protected public
+#include "pipeline/filters/source/audio_capture/audio_capture_filter.h"
+#include "plugin/core/source.h"
+#include "plugin/interface/source_plugin.h"
+
+#ifdef RECORDER_SUPPORT
+namespace {
+std::atomic<bool> g_countAllocations {false};
+std::atomic<size_t> g_allocations {0};
+}
+
+void* operator new(size_t size)
+{
+    if (g_countAllocations.load(std::memory_order_relaxed)) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept
+{
+    (void)size;
+    std::free(ptr);
+}
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Test {
+using namespace Pipeline;
+namespace {
+constexpr uint64_t PERIOD_SIZE = 960 * 2 * 2; // 960 * 2 * 2: 20ms of 48kHz stereo S16
+constexpr size_t HELD_BUFFERS = 4; // 4: buffers queued downstream at any time
+constexpr size_t WARM_UP_READS = 16;
+constexpr size_t STEADY_READS = 1000;
+
+// stands in for the audio server capturer, fills the period into the buffer like the real plugin
+class StandInCapturePlugin : public Plugin::SourcePlugin {
+public:
+    StandInCapturePlugin() : SourcePlugin("StandInCapture")
+    {
+    }
+
+    Plugin::Status SetCallback(Plugin::Callback* cb) override
+    {
+        (void)cb;
+        return Plugin::Status::OK;
+    }
+
+    Plugin::Status SetSource(std::shared_ptr<Plugin::MediaSource> source) override
+    {
+        (void)source;
+        return Plugin::Status::OK;
+    }
+
+    Plugin::Status Read(std::shared_ptr<Plugin::Buffer>& buffer, size_t expectedLen) override
+    {
+        auto memory = buffer->IsEmpty() ? buffer->AllocMemory(nullptr, expectedLen) : buffer->GetMemory();
+        uint8_t* addr = memory->GetWritableAddr(expectedLen);
+        if (addr == nullptr) {
+            return Plugin::Status::ERROR_NO_MEMORY;
+        }
+        // a reused buffer comes back without the time and the tags of its former period
+        if (buffer->pts != 0 || buffer->GetBufferMeta()->IsExist(Plugin::Tag::AUDIO_SAMPLE_RATE)) {
+            dirtyReads_++;
+        }
+        addr[0] = static_cast<uint8_t>(reads_);
+        buffer->pts = static_cast<int64_t>(reads_++) * 20 * HST_MSECOND; // 20ms period
+        return Plugin::Status::OK;
+    }
+
+    Plugin::Status GetSize(uint64_t& size) override
+    {
+        size = PERIOD_SIZE;
+        return Plugin::Status::OK;
+    }
+
+    Plugin::Seekable GetSeekable() override
+    {
+        return Plugin::Seekable::UNSEEKABLE;
+    }
+
+    Plugin::Status SeekTo(uint64_t offset) override
+    {
+        (void)offset;
+        return Plugin::Status::ERROR_UNIMPLEMENTED;
+    }
+
+    size_t dirtyReads_ {0};
+
+private:
+    size_t reads_ {0};
+};
+
+// holds the last buffers like an encoder queue, the older ones are released back to the pool
+class HoldingSinkFilter : public FilterBase {
+public:
+    HoldingSinkFilter() : FilterBase("HoldingSink")
+    {
+    }
+
+    ErrorCode PushData(const std::string& inPort, const AVBufferPtr& buffer, int64_t offset) override
+    {
+        (void)inPort;
+        (void)offset;
+        if (buffer->GetMemory()->GetSize() != PERIOD_SIZE || buffer->flag != 0) {
+            badBuffers_++;
+        }
+        if (tagBuffers_) {
+            buffer->GetBufferMeta()->SetMeta(Plugin::Tag::AUDIO_SAMPLE_RATE, 48000u); // 48000: any tag
+        }
+        if (holdAll_) {
+            heldAll_.push_back(buffer);
+            pushed_++;
+            return ErrorCode::SUCCESS;
+        }
+        held_[pushed_++ % HELD_BUFFERS] = buffer;
+        return ErrorCode::SUCCESS;
+    }
+
+    bool tagBuffers_ {false};
+    bool holdAll_ {false};
+    std::vector<AVBufferPtr> heldAll_ {};
+    std::array<AVBufferPtr, HELD_BUFFERS> held_ {};
+    size_t pushed_ {0};
+    size_t badBuffers_ {0};
+};
+
+std::shared_ptr<AudioCaptureFilter> CreateCapture(const std::shared_ptr<StandInCapturePlugin>& plugin,
+                                                  HoldingSinkFilter& sink)
+{
+    auto capture = std::make_shared<AudioCaptureFilter>("audioCapture");
+    capture->Init(nullptr, nullptr);
+    capture->plugin_ = std::shared_ptr<Plugin::Source>(new Plugin::Source(1, 1, plugin)); // 1: package and api
+    capture->outPorts_[0]->nextPort = std::make_shared<InPort>(&sink);
+    return capture;
+}
+}
+
+HWTEST(TestAudioCaptureFilter, read_loop_does_not_allocate_in_steady_state, TestSize.Level1)
+{
+    HoldingSinkFilter sink;
+    auto capture = CreateCapture(std::make_shared<StandInCapturePlugin>(), sink);
+
+    for (size_t i = 0; i < WARM_UP_READS; ++i) {
+        capture->ReadLoop();
+    }
+    ASSERT_FALSE(capture->bufferPool_.empty());
+    size_t poolSize = capture->bufferPool_.size();
+    g_allocations = 0;
+    g_countAllocations = true;
+    for (size_t i = 0; i < STEADY_READS; ++i) {
+        capture->ReadLoop();
+    }
+    g_countAllocations = false;
+
+    EXPECT_EQ(0u, g_allocations.load());
+    EXPECT_EQ(WARM_UP_READS + STEADY_READS, sink.pushed_);
+    EXPECT_EQ(0u, sink.badBuffers_);
+    EXPECT_EQ(poolSize, capture->bufferPool_.size());
+    EXPECT_EQ(0u, capture->droppedFrames_);
+    sink.held_ = {};
+}
+
+HWTEST(TestAudioCaptureFilter, frames_are_dropped_when_downstream_holds_all_buffers, TestSize.Level1)
+{
+    HoldingSinkFilter sink;
+    sink.holdAll_ = true;
+    auto capture = CreateCapture(std::make_shared<StandInCapturePlugin>(), sink);
+
+    for (size_t i = 0; i < WARM_UP_READS; ++i) {
+        capture->ReadLoop();
+    }
+    size_t poolSize = capture->bufferPool_.size();
+    ASSERT_LT(poolSize, WARM_UP_READS);
+    EXPECT_EQ(poolSize, sink.pushed_);
+    EXPECT_EQ(WARM_UP_READS - poolSize, capture->droppedFrames_);
+    EXPECT_EQ(poolSize, capture->bufferPool_.size());
+
+    // released buffers are sent again, the drops stay counted
+    sink.heldAll_.clear();
+    capture->ReadLoop();
+    EXPECT_EQ(poolSize + 1, sink.pushed_);
+    EXPECT_EQ(WARM_UP_READS - poolSize, capture->droppedFrames_);
+    EXPECT_FALSE(capture->dropping_);
+    sink.heldAll_.clear();
+}
+
+HWTEST(TestAudioCaptureFilter, reused_buffer_has_clean_meta, TestSize.Level1)
+{
+    HoldingSinkFilter sink;
+    sink.tagBuffers_ = true;
+    auto plugin = std::make_shared<StandInCapturePlugin>();
+    auto capture = CreateCapture(plugin, sink);
+
+    for (size_t i = 0; i < WARM_UP_READS; ++i) {
+        capture->ReadLoop();
+    }
+    EXPECT_EQ(WARM_UP_READS, sink.pushed_);
+    EXPECT_EQ(0u, plugin->dirtyReads_);
+    sink.held_ = {};
+}
+} // namespace Test
+} // namespace Media
+} // namespace OHOS
+#endif // RECORDER_SUPPORT
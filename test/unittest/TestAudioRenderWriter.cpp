@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "plugin/plugins/sink/audio_server_sink/audio_render_writer.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media::Plugin::AuSrSinkPlugin;
+
+namespace OHOS {
+namespace Media {
+namespace Test {
+namespace {
+/**
+ * Stand-in for the audio server renderer: a bounded buffer drained one period at a time by a consumer thread,
+ * which reports writable space after each period like the period position callback does.
+ */
+class LocalRenderer {
+public:
+    LocalRenderer(AudioRenderWriter& writer, size_t capacity, size_t periodBytes, int periodMs)
+        : writer_(writer), capacity_(capacity), periodBytes_(periodBytes), periodMs_(periodMs)
+    {
+    }
+
+    ~LocalRenderer()
+    {
+        Stop();
+    }
+
+    void Start()
+    {
+        running_ = true;
+        consumer_ = std::thread([this] {
+            while (running_) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(periodMs_));
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    size_t consumed = std::min(filled_, periodBytes_);
+                    filled_ -= consumed;
+                    totalConsumed_ += consumed;
+                }
+                periods_++;
+                writer_.NotifyWritable();
+            }
+        });
+    }
+
+    void Stop()
+    {
+        running_ = false;
+        if (consumer_.joinable()) {
+            consumer_.join();
+        }
+    }
+
+    int32_t Write(uint8_t* data, size_t length)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t accepted = std::min(length, capacity_ - filled_);
+        filled_ += accepted;
+        totalWritten_ += accepted;
+        return static_cast<int32_t>(accepted);
+    }
+
+    std::atomic<uint64_t> periods_ {0};
+    size_t totalWritten_ {0};
+    size_t totalConsumed_ {0};
+
+private:
+    AudioRenderWriter& writer_;
+    size_t capacity_;
+    size_t periodBytes_;
+    int periodMs_;
+    size_t filled_ {0};
+    std::mutex mutex_;
+    std::atomic<bool> running_ {false};
+    std::thread consumer_;
+};
+}
+
+HWTEST(TestAudioRenderWriter, underfull_writes_wake_on_writable_space, TestSize.Level1)
+{
+    AudioRenderWriter writer(200); // 200ms, long enough that no wait times out
+    LocalRenderer renderer(writer, 3840, 1920, 2); // 3840: 20ms stereo s16 48k, 1920: 10ms period, 2ms
+    renderer.Start();
+    std::vector<uint8_t> data(4096, 0); // 4096 bytes per write, more than the renderer can take at once
+    for (int i = 0; i < 50; ++i) { // 50 writes
+        ASSERT_EQ(RenderWriteResult::OK,
+            writer.Write(data.data(), data.size(), [&renderer](uint8_t* buf, size_t len) {
+                return renderer.Write(buf, len);
+            }));
+    }
+    renderer.Stop();
+    auto stats = writer.GetStats();
+    EXPECT_EQ(50u, stats.writeCount);
+    EXPECT_EQ(4096u * 50, renderer.totalWritten_);
+    EXPECT_GT(stats.partialWriteCount, 0u);
+    EXPECT_EQ(0u, stats.timeoutWakeupCount);
+    // every wake up is caused by a writable notification, there is no polling
+    EXPECT_LE(stats.wakeupCount, renderer.periods_.load());
+    uint64_t histogramTotal = 0;
+    for (auto count : stats.latencyHistogram) {
+        histogramTotal += count;
+    }
+    EXPECT_EQ(stats.writeCount, histogramTotal);
+    writer.ReportStats();
+}
+
+HWTEST(TestAudioRenderWriter, full_write_needs_no_wakeup, TestSize.Level1)
+{
+    AudioRenderWriter writer;
+    std::vector<uint8_t> data(1024, 0); // 1024 bytes
+    auto ret = writer.Write(data.data(), data.size(), [](uint8_t* buf, size_t len) {
+        return static_cast<int32_t>(len);
+    });
+    EXPECT_EQ(RenderWriteResult::OK, ret);
+    auto stats = writer.GetStats();
+    EXPECT_EQ(1u, stats.writeCount);
+    EXPECT_EQ(0u, stats.wakeupCount);
+    EXPECT_EQ(1u, stats.latencyHistogram[0]);
+}
+
+HWTEST(TestAudioRenderWriter, renderer_error_is_reported, TestSize.Level1)
+{
+    AudioRenderWriter writer;
+    std::vector<uint8_t> data(1024, 0); // 1024 bytes
+    auto ret = writer.Write(data.data(), data.size(), [](uint8_t* buf, size_t len) {
+        return -1;
+    });
+    EXPECT_EQ(RenderWriteResult::ERROR, ret);
+}
+
+HWTEST(TestAudioRenderWriter, interrupt_wakes_blocked_write, TestSize.Level1)
+{
+    AudioRenderWriter writer(10000); // 10s
+    std::thread flusher([&writer] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // 20ms
+        writer.Interrupt();
+    });
+    std::vector<uint8_t> data(1024, 0); // 1024 bytes
+    auto start = std::chrono::steady_clock::now();
+    auto ret = writer.Write(data.data(), data.size(), [](uint8_t* buf, size_t len) {
+        return 0;
+    });
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    flusher.join();
+    EXPECT_EQ(RenderWriteResult::INTERRUPTED, ret);
+    EXPECT_LT(elapsed, std::chrono::seconds(5)); // 5s
+    EXPECT_EQ(RenderWriteResult::INTERRUPTED, writer.Write(data.data(), data.size(), [](uint8_t* buf, size_t len) {
+        return static_cast<int32_t>(len);
+    }));
+    writer.ClearInterrupt();
+    EXPECT_EQ(RenderWriteResult::OK, writer.Write(data.data(), data.size(), [](uint8_t* buf, size_t len) {
+        return static_cast<int32_t>(len);
+    }));
+}
+
+HWTEST(TestAudioRenderWriter, force_pause_blocks_until_lifted, TestSize.Level1)
+{
+    AudioRenderWriter writer;
+    writer.SetForcePaused(true);
+    EXPECT_TRUE(writer.IsForcePaused());
+    std::thread resumer([&writer] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // 20ms
+        writer.SetForcePaused(false);
+    });
+    EXPECT_TRUE(writer.WaitForcePauseLifted());
+    resumer.join();
+    EXPECT_FALSE(writer.IsForcePaused());
+    EXPECT_LE(writer.GetStats().wakeupCount, 2u); // 2: one notification, tolerate one spurious wake up
+
+    writer.SetForcePaused(true);
+    std::thread stopper([&writer] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // 20ms
+        writer.Interrupt();
+    });
+    EXPECT_FALSE(writer.WaitForcePauseLifted());
+    stopper.join();
+}
+} // namespace Test
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+#include "plugin/convert/audio_resampler.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media::Plugin;
+
+namespace OHOS {
+namespace Media {
+namespace Test {
+namespace {
+constexpr double PI = 3.14159265358979323846;
+constexpr uint32_t CHANNELS = 2;
+
+std::vector<float> MakeSine(double freq, uint32_t sampleRate, size_t frames, uint32_t channels)
+{
+    std::vector<float> out(frames * channels);
+    for (size_t i = 0; i < frames; ++i) {
+        for (uint32_t c = 0; c < channels; ++c) {
+            // 0.5 amplitude, second channel has a phase offset
+            out[i * channels + c] = static_cast<float>(0.5 * std::sin(2 * PI * freq * i / sampleRate + c));
+        }
+    }
+    return out;
+}
+
+/**
+ * Feed src in chunks of chunkFrames and collect the float output.
+ */
+std::vector<float> RunResampler(AudioResampler& resampler, const std::vector<float>& src, size_t chunkFrames)
+{
+    std::vector<float> out;
+    size_t frameBytes = CHANNELS * sizeof(float);
+    size_t total = src.size() * sizeof(float);
+    auto bytes = reinterpret_cast<const uint8_t*>(src.data());
+    for (size_t offset = 0; offset < total; offset += chunkFrames * frameBytes) {
+        size_t length = std::min(chunkFrames * frameBytes, total - offset);
+        uint8_t* dest = nullptr;
+        size_t destLength = 0;
+        EXPECT_EQ(Status::OK, resampler.Convert(bytes + offset, length, dest, destLength));
+        auto samples = reinterpret_cast<float*>(dest);
+        out.insert(out.end(), samples, samples + destLength / sizeof(float));
+    }
+    return out;
+}
+
+/**
+ * Max error against the analytic sine delayed by the filter group delay, ignoring the warm up.
+ */
+double MaxErrorAgainstReference(const std::vector<float>& out, double freq, uint32_t destRate, double delay)
+{
+    double maxErr = 0.0;
+    size_t frames = out.size() / CHANNELS;
+    for (size_t i = static_cast<size_t>(delay) * 2; i < frames; ++i) { // 2: skip twice the delay
+        for (uint32_t c = 0; c < CHANNELS; ++c) {
+            double ref = 0.5 * std::sin(2 * PI * freq * (i - delay) / destRate + c);
+            maxErr = std::max(maxErr, std::fabs(ref - out[i * CHANNELS + c]));
+        }
+    }
+    return maxErr;
+}
+}
+
+HWTEST(TestAudioResampler, passthrough_returns_source, TestSize.Level1)
+{
+    AudioResampler resampler;
+    ASSERT_EQ(Status::OK, resampler.Init({CHANNELS, 48000, 48000, AudioSampleFormat::S16, AudioSampleFormat::S16}));
+    EXPECT_EQ(AudioResampleMode::PASSTHROUGH, resampler.GetMode());
+    std::vector<uint8_t> src(256, 1); // 256 bytes
+    uint8_t* dest = nullptr;
+    size_t destLength = 0;
+    ASSERT_EQ(Status::OK, resampler.Convert(src.data(), src.size(), dest, destLength));
+    EXPECT_EQ(src.data(), dest);
+    EXPECT_EQ(src.size(), destLength);
+}
+
+HWTEST(TestAudioResampler, format_only_u8_and_s24_to_s16, TestSize.Level1)
+{
+    AudioResampler resampler;
+    ASSERT_EQ(Status::OK, resampler.Init({1, 44100, 44100, AudioSampleFormat::U8, AudioSampleFormat::S16}));
+    EXPECT_EQ(AudioResampleMode::FORMAT_ONLY, resampler.GetMode());
+    std::vector<uint8_t> u8 = {0, 0x40, 0x80, 0xC0, 0xFF};
+    uint8_t* dest = nullptr;
+    size_t destLength = 0;
+    ASSERT_EQ(Status::OK, resampler.Convert(u8.data(), u8.size(), dest, destLength));
+    ASSERT_EQ(u8.size() * sizeof(int16_t), destLength);
+    auto s16 = reinterpret_cast<int16_t*>(dest);
+    for (size_t i = 0; i < u8.size(); ++i) {
+        EXPECT_EQ((static_cast<int32_t>(u8[i]) - 128) * 256, s16[i]); // 128 256: u8 to s16 reference
+    }
+
+    ASSERT_EQ(Status::OK, resampler.Init({1, 44100, 44100, AudioSampleFormat::S24, AudioSampleFormat::S16}));
+    std::vector<int32_t> values = {0, 256, -256, 8388607, -8388608, 1234567};
+    std::vector<uint8_t> s24;
+    for (auto v : values) {
+        s24.push_back(static_cast<uint8_t>(v & 0xFF));
+        s24.push_back(static_cast<uint8_t>((v >> 8) & 0xFF)); // 8
+        s24.push_back(static_cast<uint8_t>((v >> 16) & 0xFF)); // 16
+    }
+    ASSERT_EQ(Status::OK, resampler.Convert(s24.data(), s24.size(), dest, destLength));
+    ASSERT_EQ(values.size() * sizeof(int16_t), destLength);
+    s16 = reinterpret_cast<int16_t*>(dest);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_NEAR(std::min(values[i] / 256.0, 32767.0), s16[i], 1.0); // 256: drop 8 bits, 32767: clamp
+    }
+}
+
+HWTEST(TestAudioResampler, planar_to_interleaved, TestSize.Level1)
+{
+    AudioResampler resampler;
+    ASSERT_EQ(Status::OK, resampler.Init({CHANNELS, 48000, 48000, AudioSampleFormat::S16P, AudioSampleFormat::S16}));
+    std::vector<int16_t> planar = {1, 2, 3, 4, -1, -2, -3, -4};
+    uint8_t* dest = nullptr;
+    size_t destLength = 0;
+    ASSERT_EQ(Status::OK, resampler.Convert(reinterpret_cast<uint8_t*>(planar.data()),
+                                            planar.size() * sizeof(int16_t), dest, destLength));
+    std::vector<int16_t> expect = {1, -1, 2, -2, 3, -3, 4, -4};
+    ASSERT_EQ(expect.size() * sizeof(int16_t), destLength);
+    EXPECT_EQ(0, memcmp(expect.data(), dest, destLength));
+}
+
+HWTEST(TestAudioResampler, upsample_48k_to_96k_matches_reference, TestSize.Level1)
+{
+    AudioResampler resampler;
+    ASSERT_EQ(Status::OK, resampler.Init({CHANNELS, 48000, 96000, AudioSampleFormat::F32, AudioSampleFormat::F32}));
+    EXPECT_EQ(AudioResampleMode::INTEGER_UPSAMPLE, resampler.GetMode());
+    auto src = MakeSine(1000.0, 48000, 4800, CHANNELS); // 1kHz, 100ms
+    auto out = RunResampler(resampler, src, 480); // 480: 10ms chunks
+    ASSERT_EQ(src.size() * 2, out.size()); // 2: ratio
+    EXPECT_LT(MaxErrorAgainstReference(out, 1000.0, 96000, resampler.GetDelayFrames()), 1e-3);
+}
+
+HWTEST(TestAudioResampler, downsample_88200_to_44100_matches_reference, TestSize.Level1)
+{
+    AudioResampler resampler;
+    ASSERT_EQ(Status::OK, resampler.Init({CHANNELS, 88200, 44100, AudioSampleFormat::F32, AudioSampleFormat::F32}));
+    EXPECT_EQ(AudioResampleMode::INTEGER_DOWNSAMPLE, resampler.GetMode());
+    auto src = MakeSine(3000.0, 88200, 8820, CHANNELS); // 3kHz, 100ms
+    auto out = RunResampler(resampler, src, 441); // 441: 5ms chunks, odd number of frames
+    ASSERT_EQ(src.size() / 2, out.size()); // 2: ratio
+    EXPECT_LT(MaxErrorAgainstReference(out, 3000.0, 44100, resampler.GetDelayFrames()), 1e-3);
+}
+
+HWTEST(TestAudioResampler, downsample_rejects_out_of_band_tone, TestSize.Level1)
+{
+    AudioResampler resampler;
+    ASSERT_EQ(Status::OK, resampler.Init({CHANNELS, 96000, 48000, AudioSampleFormat::F32, AudioSampleFormat::F32}));
+    auto src = MakeSine(36000.0, 96000, 9600, CHANNELS); // 36kHz would alias to 12kHz
+    auto out = RunResampler(resampler, src, 960); // 960: 10ms chunks
+    double maxAbs = 0.0;
+    for (size_t i = out.size() / 2; i < out.size(); ++i) { // 2: skip warm up
+        maxAbs = std::max(maxAbs, static_cast<double>(std::fabs(out[i])));
+    }
+    EXPECT_LT(maxAbs, 0.5 * 1e-3); // 0.5: input amplitude, at least 60dB rejection
+}
+
+HWTEST(TestAudioResampler, streaming_is_independent_of_chunk_size, TestSize.Level1)
+{
+    auto src = MakeSine(440.0, 48000, 4800, CHANNELS); // 440Hz, 100ms
+    AudioResampler whole;
+    AudioResampler chunked;
+    AudioResamplerPara para {CHANNELS, 48000, 96000, AudioSampleFormat::F32, AudioSampleFormat::F32};
+    ASSERT_EQ(Status::OK, whole.Init(para));
+    ASSERT_EQ(Status::OK, chunked.Init(para));
+    auto outWhole = RunResampler(whole, src, 4800); // 4800: one call
+    auto outChunked = RunResampler(chunked, src, 7); // 7: tiny odd chunks
+    ASSERT_EQ(outWhole.size(), outChunked.size());
+    for (size_t i = 0; i < outWhole.size(); ++i) {
+        ASSERT_FLOAT_EQ(outWhole[i], outChunked[i]);
+    }
+    whole.Reset();
+    auto outAfterReset = RunResampler(whole, src, 4800); // 4800: one call
+    EXPECT_EQ(outWhole, outAfterReset);
+}
+
+HWTEST(TestAudioResampler, non_integer_ratio_is_rejected, TestSize.Level1)
+{
+    AudioResampler resampler;
+    EXPECT_NE(Status::OK, resampler.Init({CHANNELS, 44100, 48000, AudioSampleFormat::S16, AudioSampleFormat::S16}));
+    EXPECT_NE(Status::OK, resampler.Init({CHANNELS, 48000, 48000, AudioSampleFormat::S16, AudioSampleFormat::S24}));
+    EXPECT_TRUE(AudioResampler::IsIntegerRatio(44100, 88200));
+    EXPECT_TRUE(AudioResampler::IsIntegerRatio(96000, 48000));
+    EXPECT_FALSE(AudioResampler::IsIntegerRatio(44100, 48000));
+}
+} // namespace Test
+} // namespace Media
+} // namespace OHOS
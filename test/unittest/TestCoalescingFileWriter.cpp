@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "foundation/osal/utils/util.h"
+#include "plugin/plugins/sink/file_sink/coalescing_file_writer.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Test {
+using namespace Plugin;
+using namespace Plugin::FileSink;
+namespace {
+constexpr size_t SAMPLE_SIZE = 188; // 188: a small muxed chunk
+constexpr size_t SAMPLE_COUNT = 10000;
+
+std::string GetTestFile()
+{
+    // tmpfs when available, the syscalls are measured without the device
+    struct stat dirStat {};
+    if (stat("/dev/shm", &dirStat) == 0 && S_ISDIR(dirStat.st_mode)) {
+        return "/dev/shm/TestCoalescingFileWriter.bin";
+    }
+    return "./TestCoalescingFileWriter.bin";
+}
+
+std::vector<uint8_t> MakeData(size_t size, uint8_t seed)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 13 + seed); // 13: any spread
+    }
+    return data;
+}
+
+std::vector<uint8_t> ReadFile(const std::string& path)
+{
+    std::vector<uint8_t> data;
+    std::FILE* fp = std::fopen(path.c_str(), "rb");
+    if (fp == nullptr) {
+        return data;
+    }
+    uint8_t chunk[4096]; // 4096: read size
+    size_t size = 0;
+    while ((size = std::fread(chunk, 1, sizeof(chunk), fp)) > 0) {
+        data.insert(data.end(), chunk, chunk + size);
+    }
+    (void)std::fclose(fp);
+    return data;
+}
+}
+
+class TestCoalescingFileWriter : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        path_ = GetTestFile();
+        fd_ = open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+        ASSERT_NE(-1, fd_);
+    }
+
+    void TearDown() override
+    {
+        if (fd_ != -1) {
+            close(fd_);
+        }
+        (void)std::remove(path_.c_str());
+    }
+
+    std::string path_;
+    int32_t fd_ {-1};
+};
+
+HWTEST_F(TestCoalescingFileWriter, small_writes_are_coalesced, TestSize.Level1)
+{
+    CoalescingFileWriter::Options options;
+    options.bufferSize = 64 * 1024; // 64K
+    CoalescingFileWriter writer(options);
+    ASSERT_EQ(Status::OK, writer.Open(fd_));
+    std::vector<uint8_t> expected;
+    for (size_t i = 0; i < SAMPLE_COUNT; ++i) {
+        auto sample = MakeData(SAMPLE_SIZE, static_cast<uint8_t>(i));
+        ASSERT_EQ(Status::OK, writer.Write(sample.data(), sample.size()));
+        expected.insert(expected.end(), sample.begin(), sample.end());
+    }
+    ASSERT_EQ(Status::OK, writer.Close());
+    auto stats = writer.GetStats();
+    EXPECT_LE(stats.writeCalls, expected.size() / options.bufferSize + 1);
+    EXPECT_EQ(expected.size(), stats.bytesWritten);
+    RecordProperty("write_calls", std::to_string(stats.writeCalls));
+    RecordProperty("max_write_latency_ns", std::to_string(stats.maxWriteLatencyNs));
+    EXPECT_EQ(expected, ReadFile(path_));
+    EXPECT_EQ(static_cast<off_t>(expected.size()), lseek(fd_, 0, SEEK_CUR));
+}
+
+HWTEST_F(TestCoalescingFileWriter, large_write_goes_with_staged_data, TestSize.Level1)
+{
+    CoalescingFileWriter::Options options;
+    options.bufferSize = 16 * 1024; // 16K
+    CoalescingFileWriter writer(options);
+    ASSERT_EQ(Status::OK, writer.Open(fd_));
+    auto head = MakeData(1000, 1); // 1000 bytes
+    auto large = MakeData(1024 * 1024, 2); // 1M
+    ASSERT_EQ(Status::OK, writer.Write(head.data(), head.size()));
+    ASSERT_EQ(Status::OK, writer.Write(large.data(), large.size()));
+    EXPECT_EQ(1u, writer.GetStats().writeCalls); // 1: one pwritev for both
+    ASSERT_EQ(Status::OK, writer.Close());
+    head.insert(head.end(), large.begin(), large.end());
+    EXPECT_EQ(head, ReadFile(path_));
+}
+
+HWTEST_F(TestCoalescingFileWriter, seek_back_patches_without_flush, TestSize.Level1)
+{
+    CoalescingFileWriter::Options options;
+    options.bufferSize = 16 * 1024; // 16K
+    CoalescingFileWriter writer(options);
+    ASSERT_EQ(Status::OK, writer.Open(fd_));
+    auto expected = MakeData(100 * 1024, 3); // 100K: flushed several times
+    for (size_t offset = 0; offset < expected.size(); offset += SAMPLE_SIZE) {
+        size_t size = std::min(SAMPLE_SIZE, expected.size() - offset);
+        ASSERT_EQ(Status::OK, writer.Write(expected.data() + offset, size));
+    }
+    uint64_t writeCalls = writer.GetStats().writeCalls;
+
+    // header rewrite in the written part, a box size in the staged part, then back to the end
+    auto header = MakeData(32, 4); // 32: header size
+    auto boxSize = MakeData(8, 5); // 8: box size
+    uint64_t stagedOffset = expected.size() - 100; // 100: in the staged tail
+    ASSERT_EQ(Status::OK, writer.SeekTo(0));
+    ASSERT_EQ(Status::OK, writer.Write(header.data(), header.size()));
+    ASSERT_EQ(Status::OK, writer.SeekTo(stagedOffset));
+    ASSERT_EQ(Status::OK, writer.Write(boxSize.data(), boxSize.size()));
+    ASSERT_EQ(Status::OK, writer.SeekTo(expected.size()));
+    auto tail = MakeData(SAMPLE_SIZE, 6); // 6: seed
+    ASSERT_EQ(Status::OK, writer.Write(tail.data(), tail.size()));
+    EXPECT_EQ(writeCalls, writer.GetStats().writeCalls);
+    EXPECT_EQ(1u, writer.GetStats().patches); // 1: only the header was already written
+    ASSERT_EQ(Status::OK, writer.Close());
+
+    std::copy(header.begin(), header.end(), expected.begin());
+    std::copy(boxSize.begin(), boxSize.end(), expected.begin() + stagedOffset);
+    expected.insert(expected.end(), tail.begin(), tail.end());
+    EXPECT_EQ(expected, ReadFile(path_));
+}
+
+HWTEST_F(TestCoalescingFileWriter, write_beyond_the_end_and_truncate, TestSize.Level1)
+{
+    CoalescingFileWriter writer;
+    ASSERT_EQ(Status::OK, writer.Open(fd_));
+    auto data = MakeData(100, 7); // 100 bytes
+    ASSERT_EQ(Status::OK, writer.Write(data.data(), data.size()));
+    ASSERT_EQ(Status::OK, writer.SeekTo(200)); // 200: leaves a hole
+    ASSERT_EQ(Status::OK, writer.Write(data.data(), data.size()));
+    ASSERT_EQ(Status::OK, writer.Flush());
+    auto content = ReadFile(path_);
+    ASSERT_EQ(300u, content.size()); // 300: up to the end of the second write
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), content.begin() + 200)); // 200
+
+    ASSERT_EQ(Status::OK, writer.Truncate());
+    ASSERT_EQ(Status::OK, writer.Write(data.data(), data.size()));
+    ASSERT_EQ(Status::OK, writer.Close());
+    EXPECT_EQ(data, ReadFile(path_));
+}
+
+HWTEST_F(TestCoalescingFileWriter, background_sync_flushes_staged_data, TestSize.Level1)
+{
+    CoalescingFileWriter::Options options;
+    options.syncIntervalMs = 10; // 10ms
+    CoalescingFileWriter writer(options);
+    ASSERT_EQ(Status::OK, writer.Open(fd_));
+    auto data = MakeData(SAMPLE_SIZE, 8); // 8: seed
+    ASSERT_EQ(Status::OK, writer.Write(data.data(), data.size()));
+    for (int32_t i = 0; i < 100 && writer.GetStats().syncCalls == 0; ++i) { // 100: 1s at most
+        OSAL::SleepFor(10); // 10ms
+    }
+    EXPECT_GT(writer.GetStats().syncCalls, 0u);
+    EXPECT_EQ(data, ReadFile(path_));
+    ASSERT_EQ(Status::OK, writer.Close());
+}
+
+HWTEST_F(TestCoalescingFileWriter, sync_interval_set_after_open, TestSize.Level1)
+{
+    CoalescingFileWriter writer;
+    ASSERT_EQ(Status::OK, writer.Open(fd_));
+    auto data = MakeData(SAMPLE_SIZE, 9); // 9: seed
+    ASSERT_EQ(Status::OK, writer.Write(data.data(), data.size()));
+    writer.SetSyncInterval(10); // 10ms
+    for (int32_t i = 0; i < 100 && writer.GetStats().syncCalls == 0; ++i) { // 100: 1s at most
+        OSAL::SleepFor(10); // 10ms
+    }
+    EXPECT_GT(writer.GetStats().syncCalls, 0u);
+    EXPECT_EQ(data, ReadFile(path_));
+    writer.SetSyncInterval(0);
+    auto syncCalls = writer.GetStats().syncCalls;
+    OSAL::SleepFor(50); // 50ms: several former intervals
+    EXPECT_EQ(syncCalls, writer.GetStats().syncCalls);
+    ASSERT_EQ(Status::OK, writer.Close());
+}
+
+HWTEST_F(TestCoalescingFileWriter, pipe_is_written_in_order, TestSize.Level1)
+{
+    int32_t fds[2] = {-1, -1}; // 2: read and write ends
+    ASSERT_EQ(0, pipe(fds));
+    CoalescingFileWriter writer;
+    ASSERT_EQ(Status::OK, writer.Open(fds[1]));
+    EXPECT_FALSE(writer.IsSeekable());
+    EXPECT_NE(Status::OK, writer.SeekTo(0));
+    auto data = MakeData(SAMPLE_SIZE, 9); // 9: seed
+    ASSERT_EQ(Status::OK, writer.Write(data.data(), data.size()));
+    ASSERT_EQ(Status::OK, writer.Close());
+    std::vector<uint8_t> received(SAMPLE_SIZE);
+    EXPECT_EQ(static_cast<ssize_t>(SAMPLE_SIZE), read(fds[0], received.data(), received.size()));
+    EXPECT_EQ(data, received);
+    close(fds[0]);
+    close(fds[1]);
+}
+} // namespace Test
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <vector>
+#include "gtest/gtest.h"
+#include "pipeline/filters/muxer/data_spliter.h"
+#include "plugin/common/plugin_time.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Test {
+using namespace Pipeline;
+namespace {
+constexpr int32_t VIDEO_TRACK = 0;
+constexpr int32_t AUDIO_TRACK = 1;
+constexpr int64_t VIDEO_FRAME_MS = 40;
+constexpr int64_t GOP_FRAMES = 10;
+
+AVBufferPtr MakeSample(int64_t timeMs, bool isKey = false)
+{
+    auto buffer = std::make_shared<AVBuffer>();
+    buffer->pts = timeMs * HST_MSECOND;
+    if (isKey) {
+        buffer->flag |= BUFFER_FLAG_KEY_FRAME;
+    }
+    return buffer;
+}
+
+/**
+ * Feed video at 25fps with a key frame every 400ms, interleaved with 20ms audio frames, for durationMs.
+ */
+void FeedAv(DataSpliter& spliter, int64_t startMs, int64_t durationMs)
+{
+    int64_t nextVideo = startMs;
+    for (int64_t audio = startMs; audio < startMs + durationMs; audio += 20) { // 20ms
+        while (nextVideo <= audio) {
+            bool isKey = (nextVideo / VIDEO_FRAME_MS) % GOP_FRAMES == 0;
+            ASSERT_EQ(ErrorCode::SUCCESS, spliter.SplitIfNeeded(VIDEO_TRACK, MakeSample(nextVideo, isKey)));
+            nextVideo += VIDEO_FRAME_MS;
+        }
+        ASSERT_EQ(ErrorCode::SUCCESS, spliter.SplitIfNeeded(AUDIO_TRACK, MakeSample(audio)));
+    }
+}
+}
+
+HWTEST(TestDataSpliter, splits_on_key_frame_after_max_duration, TestSize.Level1)
+{
+    DataSpliter spliter;
+    std::vector<int64_t> splitTimes;
+    int64_t lastTime = 0;
+    spliter.SetSplitFunc([&splitTimes, &lastTime]() {
+        splitTimes.emplace_back(lastTime);
+        return ErrorCode::SUCCESS;
+    });
+    spliter.AddTrack(VIDEO_TRACK, true);
+    spliter.AddTrack(AUDIO_TRACK, false);
+    spliter.SetMaxDurationUs(1000 * 1000); // 1s
+    spliter.Start();
+    for (int i = 0; i < 10; ++i) { // 10 outputs
+        spliter.AddNextOutput();
+    }
+    // every 400ms key frame: the first key frame at or after 1s from the segment start is 1200ms, then 2400ms
+    int64_t nextVideo = 0;
+    for (int64_t audio = 0; audio < 3000; audio += 20) { // 3000ms, 20ms
+        while (nextVideo <= audio) {
+            bool isKey = (nextVideo / VIDEO_FRAME_MS) % GOP_FRAMES == 0;
+            lastTime = nextVideo;
+            spliter.SplitIfNeeded(VIDEO_TRACK, MakeSample(nextVideo, isKey));
+            nextVideo += VIDEO_FRAME_MS;
+        }
+        lastTime = audio;
+        spliter.SplitIfNeeded(AUDIO_TRACK, MakeSample(audio));
+    }
+    std::vector<int64_t> expect = {1200, 2400}; // 1200ms 2400ms
+    EXPECT_EQ(expect, splitTimes);
+    EXPECT_EQ(3u, spliter.GetSegmentCount()); // 3 segments
+}
+
+HWTEST(TestDataSpliter, waits_for_next_output, TestSize.Level1)
+{
+    DataSpliter spliter;
+    int splits = 0;
+    spliter.SetSplitFunc([&splits]() {
+        splits++;
+        return ErrorCode::SUCCESS;
+    });
+    spliter.AddTrack(VIDEO_TRACK, true);
+    spliter.AddTrack(AUDIO_TRACK, false);
+    spliter.SetMaxDurationUs(500 * 1000); // 500ms
+    spliter.Start();
+    FeedAv(spliter, 0, 2000); // 2000ms
+    EXPECT_EQ(0, splits);
+    EXPECT_EQ(1u, spliter.GetSegmentCount());
+    spliter.AddNextOutput();
+    FeedAv(spliter, 2000, 1000); // 2000ms, 1000ms
+    EXPECT_EQ(1, splits); // only one output was announced
+    EXPECT_EQ(2u, spliter.GetSegmentCount()); // 2 segments
+}
+
+HWTEST(TestDataSpliter, splits_audio_only_output_by_size, TestSize.Level1)
+{
+    DataSpliter spliter;
+    std::vector<size_t> splitAt;
+    size_t sample = 0;
+    spliter.SetSplitFunc([&spliter, &splitAt, &sample]() {
+        splitAt.emplace_back(sample);
+        spliter.OnOutputWritten(-1, 50); // 50 bytes trailer of the old output
+        spliter.OnOutputSwitched();
+        spliter.OnOutputWritten(0, 100); // 100 bytes header of the new output
+        return ErrorCode::SUCCESS;
+    });
+    spliter.AddTrack(AUDIO_TRACK, false);
+    spliter.SetMaxOutputSize(1000); // 1000 bytes
+    spliter.Start();
+    for (int i = 0; i < 5; ++i) { // 5 outputs
+        spliter.AddNextOutput();
+    }
+    spliter.OnOutputWritten(0, 100); // 100 bytes header
+    for (sample = 0; sample < 30; ++sample) { // 30 samples
+        ASSERT_EQ(ErrorCode::SUCCESS, spliter.SplitIfNeeded(AUDIO_TRACK, MakeSample(sample * 20))); // 20ms
+        spliter.OnOutputWritten(-1, 100); // 100 bytes per sample
+    }
+    std::vector<size_t> expect = {9, 18, 27}; // header plus 9 samples reach 1000 bytes
+    EXPECT_EQ(expect, splitAt);
+}
+
+HWTEST(TestDataSpliter, requested_segment_starts_on_key_frame, TestSize.Level1)
+{
+    DataSpliter spliter;
+    int splits = 0;
+    spliter.SetSplitFunc([&splits]() {
+        splits++;
+        return ErrorCode::SUCCESS;
+    });
+    spliter.AddTrack(VIDEO_TRACK, true);
+    spliter.Start();
+    spliter.AddNextOutput();
+    spliter.SplitIfNeeded(VIDEO_TRACK, MakeSample(0, true));
+    spliter.RequestNextSegment();
+    spliter.SplitIfNeeded(VIDEO_TRACK, MakeSample(40)); // 40ms
+    spliter.SplitIfNeeded(VIDEO_TRACK, MakeSample(80)); // 80ms
+    EXPECT_EQ(0, splits);
+    spliter.SplitIfNeeded(VIDEO_TRACK, MakeSample(120, true)); // 120ms
+    EXPECT_EQ(1, splits);
+    spliter.SplitIfNeeded(VIDEO_TRACK, MakeSample(160, true)); // 160ms
+    EXPECT_EQ(1, splits);
+}
+
+HWTEST(TestDataSpliter, every_segment_starts_at_zero, TestSize.Level1)
+{
+    DataSpliter spliter;
+    bool newSegment = false;
+    spliter.SetSplitFunc([&newSegment]() {
+        newSegment = true;
+        return ErrorCode::SUCCESS;
+    });
+    spliter.AddTrack(VIDEO_TRACK, true);
+    spliter.AddTrack(AUDIO_TRACK, false);
+    spliter.SetMaxDurationUs(1000 * 1000); // 1s
+    spliter.Start();
+    for (int i = 0; i < 2; ++i) { // 2 more outputs
+        spliter.AddNextOutput();
+    }
+    std::vector<int64_t> firstTimes;
+    std::vector<int64_t> lastTimes;
+    auto push = [&](int32_t trackId, const AVBufferPtr& buffer) {
+        ASSERT_EQ(ErrorCode::SUCCESS, spliter.SplitIfNeeded(trackId, buffer));
+        spliter.RebaseTime(buffer);
+        if (firstTimes.empty() || newSegment) {
+            firstTimes.emplace_back(buffer->pts);
+            lastTimes.emplace_back(buffer->pts);
+            newSegment = false;
+        }
+        EXPECT_GE(buffer->pts, 0);
+        lastTimes.back() = std::max(lastTimes.back(), buffer->pts);
+    };
+    // the recording clock does not start at 0, the segments are cut at the key frames of 1600ms and 2800ms
+    int64_t nextVideo = 520; // 520ms
+    for (int64_t audio = 500; audio < 3500; audio += 20) { // 500ms 3500ms 20ms
+        while (nextVideo <= audio) {
+            push(VIDEO_TRACK, MakeSample(nextVideo, (nextVideo / VIDEO_FRAME_MS) % GOP_FRAMES == 0));
+            nextVideo += VIDEO_FRAME_MS;
+        }
+        push(AUDIO_TRACK, MakeSample(audio));
+    }
+    std::vector<int64_t> expectFirst = {0, 0, 0};
+    EXPECT_EQ(expectFirst, firstTimes);
+    // 1580ms 2780ms 3480ms: the last audio frame of each segment, from 500ms 1600ms 2800ms
+    std::vector<int64_t> expectLast = {1080 * HST_MSECOND, 1180 * HST_MSECOND, 680 * HST_MSECOND};
+    EXPECT_EQ(expectLast, lastTimes);
+}
+} // namespace Test
+} // namespace Media
+} // namespace OHOS
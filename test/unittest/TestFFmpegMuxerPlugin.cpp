@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "foundation/utils/constants.h"
+#include "plugin/common/plugin_time.h"
+#include "plugin/interface/muxer_plugin.h"
+
+extern "C" OHOS::Media::Plugin::Status register_FFmpegMuxers(
+    const std::shared_ptr<OHOS::Media::Plugin::PackageRegister>& pkgReg);
+extern "C" void unregister_FFmpegMuxers();
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Test {
+using namespace Plugin;
+namespace {
+constexpr int64_t FRAME_DURATION = 33 * HST_MSECOND; // 33ms, about 30fps
+constexpr int32_t GOP_SIZE = 10; // 10: key frame every 10 frames
+// avcC of a 64x64 baseline stream
+const std::vector<uint8_t> AVC_CONFIG = {
+    0x01, 0x42, 0xc0, 0x14, 0xff, 0xe1, 0x00, 0x0c,
+    0x67, 0x42, 0xc0, 0x14, 0x8c, 0x68, 0x42, 0x48, 0x07, 0x84, 0x42, 0x35,
+    0x01, 0x00, 0x04, 0x68, 0xce, 0x3c, 0x80,
+};
+const std::vector<uint8_t> KEY_FRAME = {0x00, 0x00, 0x00, 0x04, 0x65, 0xb8, 0x00, 0x04};
+const std::vector<uint8_t> DELTA_FRAME = {0x00, 0x00, 0x00, 0x04, 0x41, 0x9a, 0x00, 0x04};
+
+class MuxerRegister : public PackageRegister {
+public:
+    Status AddPackage(const PackageDef& def) override
+    {
+        (void)def;
+        return Status::OK;
+    }
+
+    Status AddPlugin(const PluginDefBase& def) override
+    {
+        if (def.name == "ffmpegMux_mp4") {
+            creator_ = static_cast<const MuxerPluginDef&>(def).creator;
+        }
+        return Status::OK;
+    }
+
+    PluginCreatorFunc<MuxerPlugin> creator_ {};
+};
+
+class MemorySink : public DataSink {
+public:
+    Status WriteAt(int64_t offset, const std::shared_ptr<Buffer>& buffer) override
+    {
+        auto memory = buffer->GetMemory();
+        size_t pos = offset < 0 ? data_.size() : static_cast<size_t>(offset);
+        if (data_.size() < pos + memory->GetSize()) {
+            data_.resize(pos + memory->GetSize());
+        }
+        std::copy(memory->GetReadOnlyData(), memory->GetReadOnlyData() + memory->GetSize(), data_.begin() + pos);
+        return Status::OK;
+    }
+
+    // types of the top level boxes, empty if they do not add up to the file size
+    std::vector<std::string> TopLevelBoxes() const
+    {
+        std::vector<std::string> boxes;
+        size_t pos = 0;
+        while (pos + 8 <= data_.size()) { // 8: size and type
+            size_t size = 0;
+            for (size_t i = 0; i < 4; ++i) { // 4: big endian size
+                size = (size << 8) | data_[pos + i]; // 8: one byte
+            }
+            if (size < 8) { // 8: box header
+                return {};
+            }
+            boxes.emplace_back(reinterpret_cast<const char*>(&data_[pos + 4]), 4); // 4: type
+            pos += size;
+        }
+        return pos == data_.size() ? boxes : std::vector<std::string> {};
+    }
+
+    std::vector<uint8_t> data_ {};
+};
+
+class TestFFmpegMuxerPlugin : public testing::Test {
+public:
+    void SetUp() override
+    {
+        auto reg = std::make_shared<MuxerRegister>();
+        ASSERT_EQ(Status::OK, register_FFmpegMuxers(reg));
+        ASSERT_TRUE(reg->creator_ != nullptr);
+        muxer_ = reg->creator_("ffmpegMux_mp4");
+        ASSERT_EQ(Status::OK, muxer_->Init());
+    }
+
+    void TearDown() override
+    {
+        muxer_->Deinit();
+        muxer_.reset();
+        unregister_FFmpegMuxers();
+    }
+
+    void Mux(int32_t frames)
+    {
+        uint32_t trackId = 0;
+        ASSERT_EQ(Status::OK, muxer_->AddTrack(trackId));
+        muxer_->SetTrackParameter(trackId, Tag::MIME, std::string(MEDIA_MIME_VIDEO_H264));
+        muxer_->SetTrackParameter(trackId, Tag::VIDEO_PIXEL_FORMAT, VideoPixelFormat::YUV420P);
+        muxer_->SetTrackParameter(trackId, Tag::VIDEO_WIDTH, static_cast<uint32_t>(64)); // 64
+        muxer_->SetTrackParameter(trackId, Tag::VIDEO_HEIGHT, static_cast<uint32_t>(64)); // 64
+        muxer_->SetTrackParameter(trackId, Tag::MEDIA_BITRATE, static_cast<int64_t>(100000)); // 100kbps
+        muxer_->SetTrackParameter(trackId, Tag::VIDEO_H264_PROFILE, VideoH264Profile::BASELINE);
+        muxer_->SetTrackParameter(trackId, Tag::VIDEO_H264_LEVEL, static_cast<uint32_t>(20)); // 20: level 2.0
+        muxer_->SetTrackParameter(trackId, Tag::MEDIA_CODEC_CONFIG, AVC_CONFIG);
+        ASSERT_EQ(Status::OK, muxer_->SetDataSink(sink_));
+        ASSERT_EQ(Status::OK, muxer_->Prepare());
+        ASSERT_EQ(Status::OK, muxer_->WriteHeader());
+        for (int32_t i = 0; i < frames; ++i) {
+            bool key = i % GOP_SIZE == 0;
+            const auto& frame = key ? KEY_FRAME : DELTA_FRAME;
+            auto buffer = std::make_shared<Buffer>();
+            buffer->AllocMemory(nullptr, frame.size());
+            buffer->GetMemory()->Write(frame.data(), frame.size(), 0);
+            buffer->trackID = trackId;
+            buffer->pts = i * FRAME_DURATION;
+            buffer->duration = FRAME_DURATION;
+            buffer->flag = key ? BUFFER_FLAG_KEY_FRAME : 0;
+            ASSERT_EQ(Status::OK, muxer_->WriteFrame(buffer));
+        }
+        ASSERT_EQ(Status::OK, muxer_->WriteTrailer());
+    }
+
+    std::shared_ptr<MuxerPlugin> muxer_ {};
+    std::shared_ptr<MemorySink> sink_ {std::make_shared<MemorySink>()};
+};
+}
+
+HWTEST_F(TestFFmpegMuxerPlugin, regular_output_has_no_fragments, TestSize.Level1)
+{
+    Mux(30); // 30 frames
+    auto boxes = sink_->TopLevelBoxes();
+    ASSERT_FALSE(boxes.empty());
+    EXPECT_EQ("ftyp", boxes.front());
+    EXPECT_EQ("moov", boxes.back());
+    EXPECT_EQ(boxes.end(), std::find(boxes.begin(), boxes.end(), "moof"));
+}
+
+HWTEST_F(TestFFmpegMuxerPlugin, fragment_per_key_frame, TestSize.Level1)
+{
+    muxer_->SetParameter(Tag::MEDIA_FRAGMENT_KEY_FRAMES, static_cast<uint32_t>(1));
+    Mux(30); // 30 frames, 3 key frames
+    std::vector<std::string> expected = {"ftyp", "moov", "moof", "mdat", "moof", "mdat", "moof", "mdat"};
+    EXPECT_EQ(expected, sink_->TopLevelBoxes());
+}
+
+HWTEST_F(TestFFmpegMuxerPlugin, fragment_cut_at_key_frame_after_duration, TestSize.Level1)
+{
+    muxer_->SetParameter(Tag::MEDIA_FRAGMENT_DURATION, static_cast<int64_t>(600 * HST_MSECOND)); // 600ms
+    // key frames at 0, 330, 660, 990, 1320 and 1650ms, cut in front of 660 and 1320
+    Mux(60); // 60 frames
+    std::vector<std::string> expected = {"ftyp", "moov", "moof", "mdat", "moof", "mdat", "moof", "mdat"};
+    EXPECT_EQ(expected, sink_->TopLevelBoxes());
+}
+} // namespace Test
+} // namespace Media
+} // namespace OHOS
@@ -13,9 +13,14 @@
  * limitations under the License.
  */
 
+#include <csignal>
+#include <cstdio>
 #include <memory>
 #include <string>
+#include <unistd.h>
+#include <vector>
 #include "gtest/gtest.h"
+#include "plugin/common/media_source.h"
 #include "plugin/plugins/source/file_source/file_source_plugin.h"
 
 namespace OHOS {
@@ -24,6 +29,25 @@ namespace Test {
 using namespace OHOS::Media::Plugin;
 using namespace testing::ext;
 
+namespace {
+const std::string TEST_FILE = "./TestFileSourcePlugin.bin";
+constexpr size_t TEST_FILE_SIZE = 3 * 1024 * 1024 + 100; // 3M + 100: more than one read ahead window
+
+std::vector<uint8_t> WriteTestFile()
+{
+    std::vector<uint8_t> data(TEST_FILE_SIZE);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7 + (i >> 10)); // 7 10: any pattern not repeating every page
+    }
+    std::FILE* fp = std::fopen(TEST_FILE.c_str(), "wb");
+    if (fp != nullptr) {
+        (void)std::fwrite(data.data(), 1, data.size(), fp);
+        (void)std::fclose(fp);
+    }
+    return data;
+}
+}
+
 class TestFileSourcePlugin : public ::testing::Test {
 public:
     std::shared_ptr<FileSource::FileSourcePlugin> fileSourcePlugin;
@@ -34,6 +58,7 @@ public:
 
     void TearDown() override
     {
+        (void)std::remove(TEST_FILE.c_str());
     }
 };
 
@@ -86,6 +111,96 @@ HWTEST_F(TestFileSourcePlugin, test_set_get_parameter, TestSize.Level1)
     EXPECT_EQ(Status::ERROR_UNIMPLEMENTED, status);
 }
 
+HWTEST_F(TestFileSourcePlugin, test_read_mapped_file, TestSize.Level1)
+{
+    auto data = WriteTestFile();
+    ASSERT_EQ(Status::OK, fileSourcePlugin->Init());
+    ASSERT_EQ(Status::OK, fileSourcePlugin->SetSource(std::make_shared<MediaSource>(TEST_FILE)));
+    uint64_t offset = 0;
+    while (offset < data.size()) {
+        auto buffer = std::make_shared<Buffer>();
+        ASSERT_EQ(Status::OK, fileSourcePlugin->Read(buffer, 100 * 1024)); // 100K: a read of the demuxer
+        auto memory = buffer->GetMemory();
+        ASSERT_TRUE(memory != nullptr);
+        ASSERT_GT(memory->GetSize(), 0u);
+        ASSERT_EQ(0, memcmp(data.data() + offset, memory->GetReadOnlyData(), memory->GetSize()));
+        offset += memory->GetSize();
+    }
+    EXPECT_EQ(data.size(), offset);
+    auto buffer = std::make_shared<Buffer>();
+    EXPECT_EQ(Status::END_OF_STREAM, fileSourcePlugin->Read(buffer, 100)); // 100 bytes
+
+    // random access into a buffer of the caller
+    ASSERT_EQ(Status::OK, fileSourcePlugin->SeekTo(12345)); // 12345: any offset
+    buffer = std::make_shared<Buffer>();
+    buffer->AllocMemory(nullptr, 1000); // 1000 bytes
+    ASSERT_EQ(Status::OK, fileSourcePlugin->Read(buffer, 4096)); // 4096: more than the buffer capacity
+    ASSERT_EQ(1000u, buffer->GetMemory()->GetSize()); // 1000 bytes
+    EXPECT_EQ(0, memcmp(data.data() + 12345, buffer->GetMemory()->GetReadOnlyData(), 1000)); // 12345 1000
+    EXPECT_EQ(Status::OK, fileSourcePlugin->Deinit());
+}
+
+HWTEST_F(TestFileSourcePlugin, test_read_truncated_mapped_file, TestSize.Level1)
+{
+    auto data = WriteTestFile();
+    ASSERT_EQ(Status::OK, fileSourcePlugin->Init());
+    ASSERT_EQ(Status::OK, fileSourcePlugin->SetSource(std::make_shared<MediaSource>(TEST_FILE)));
+    auto buffer = std::make_shared<Buffer>();
+    ASSERT_EQ(Status::OK, fileSourcePlugin->Read(buffer, 1024)); // 1024 bytes
+    ASSERT_EQ(0, truncate(TEST_FILE.c_str(), 1024 * 1024)); // 1M: truncated behind the reader
+
+    // the read beyond the checked window finds the truncation and falls back to the file stream
+    ASSERT_EQ(Status::OK, fileSourcePlugin->SeekTo(2 * 1024 * 1024 + 100)); // 2M 100: out of the first window
+    buffer = std::make_shared<Buffer>();
+    EXPECT_EQ(Status::OK, fileSourcePlugin->Read(buffer, 100)); // 100 bytes
+    EXPECT_EQ(0u, buffer->GetMemory()->GetSize());
+    ASSERT_EQ(Status::OK, fileSourcePlugin->SeekTo(1024 * 1024 - 10)); // 1M 10: the last bytes of the file
+    buffer = std::make_shared<Buffer>();
+    EXPECT_EQ(Status::OK, fileSourcePlugin->Read(buffer, 100)); // 100 bytes
+    ASSERT_EQ(10u, buffer->GetMemory()->GetSize()); // 10 bytes
+    EXPECT_EQ(0, memcmp(data.data() + 1024 * 1024 - 10, buffer->GetMemory()->GetReadOnlyData(), 10)); // 1M 10
+    EXPECT_EQ(Status::OK, fileSourcePlugin->Deinit());
+}
+
+HWTEST_F(TestFileSourcePlugin, test_read_truncated_inside_checked_window, TestSize.Level1)
+{
+    auto data = WriteTestFile();
+    ASSERT_EQ(Status::OK, fileSourcePlugin->Init());
+    ASSERT_EQ(Status::OK, fileSourcePlugin->SetSource(std::make_shared<MediaSource>(TEST_FILE)));
+    auto buffer = std::make_shared<Buffer>();
+    ASSERT_EQ(Status::OK, fileSourcePlugin->Read(buffer, 1024)); // 1024 bytes, checks the first 2M window
+    ASSERT_EQ(0, truncate(TEST_FILE.c_str(), 1024 * 1024)); // 1M: truncated behind the check
+
+    // the pages beyond the new end fault while copied, the read falls back to the file stream instead of crashing
+    ASSERT_EQ(Status::OK, fileSourcePlugin->SeekTo(1024 * 1024 + 100 * 1024)); // 1M 100K: inside the window
+    buffer = std::make_shared<Buffer>();
+    EXPECT_EQ(Status::OK, fileSourcePlugin->Read(buffer, 100)); // 100 bytes
+    EXPECT_EQ(0u, buffer->GetMemory()->GetSize());
+    ASSERT_EQ(Status::OK, fileSourcePlugin->SeekTo(1024 * 1024 - 10)); // 1M 10: the last bytes of the file
+    buffer = std::make_shared<Buffer>();
+    EXPECT_EQ(Status::OK, fileSourcePlugin->Read(buffer, 100)); // 100 bytes
+    ASSERT_EQ(10u, buffer->GetMemory()->GetSize()); // 10 bytes
+    EXPECT_EQ(0, memcmp(data.data() + 1024 * 1024 - 10, buffer->GetMemory()->GetReadOnlyData(), 10)); // 1M 10
+    EXPECT_EQ(Status::OK, fileSourcePlugin->Deinit());
+}
+
+HWTEST_F(TestFileSourcePlugin, test_bus_handler_only_while_mapped, TestSize.Level1)
+{
+    struct sigaction before {};
+    ASSERT_EQ(0, sigaction(SIGBUS, nullptr, &before));
+    auto data = WriteTestFile();
+    ASSERT_EQ(Status::OK, fileSourcePlugin->Init());
+    ASSERT_EQ(Status::OK, fileSourcePlugin->SetSource(std::make_shared<MediaSource>(TEST_FILE)));
+    struct sigaction mapped {};
+    ASSERT_EQ(0, sigaction(SIGBUS, nullptr, &mapped));
+    EXPECT_NE(before.sa_handler, mapped.sa_handler);
+    ASSERT_EQ(Status::OK, fileSourcePlugin->Deinit());
+    fileSourcePlugin.reset();
+    struct sigaction after {};
+    ASSERT_EQ(0, sigaction(SIGBUS, nullptr, &after));
+    EXPECT_EQ(before.sa_handler, after.sa_handler);
+}
+
 HWTEST_F(TestFileSourcePlugin, test_deinit_status, TestSize.Level1)
 {
     auto status = fileSourcePlugin->Deinit();
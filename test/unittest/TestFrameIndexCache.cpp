@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <dirent.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "MemoryDataSource.h"
+#include "plugin/common/frame_index_cache.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Test {
+using namespace Plugin;
+namespace {
+const std::string CACHE_DIR = "./TestFrameIndexCache";
+constexpr uint32_t INTERVAL = 4;
+
+std::shared_ptr<MemoryDataSource> MakeSource(size_t size, uint8_t seed)
+{
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 31 + seed); // 31: any spread
+    }
+    return std::make_shared<MemoryDataSource>(std::move(data));
+}
+
+std::vector<std::string> ListCacheFiles()
+{
+    std::vector<std::string> files;
+    DIR* dir = opendir(CACHE_DIR.c_str());
+    if (dir != nullptr) {
+        for (dirent* item = readdir(dir); item != nullptr; item = readdir(dir)) {
+            if (item->d_name[0] != '.') {
+                files.push_back(CACHE_DIR + "/" + item->d_name);
+            }
+        }
+        (void)closedir(dir);
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+// frames of 100 bytes and 1152 samples
+void IndexFrames(FrameIndexCache& cache, uint64_t frameCount)
+{
+    for (uint64_t frame = 0; frame < frameCount; ++frame) {
+        cache.Add(frame, static_cast<int64_t>(frame * 1152), frame * 100); // 1152 100
+    }
+}
+}
+
+class TestFrameIndexCache : public ::testing::Test {
+protected:
+    void TearDown() override
+    {
+        DIR* dir = opendir(CACHE_DIR.c_str());
+        if (dir != nullptr) {
+            for (dirent* item = readdir(dir); item != nullptr; item = readdir(dir)) {
+                (void)std::remove((CACHE_DIR + "/" + item->d_name).c_str());
+            }
+            (void)closedir(dir);
+        }
+        (void)rmdir(CACHE_DIR.c_str());
+    }
+};
+
+HWTEST_F(TestFrameIndexCache, sparse_entries_and_lookup, TestSize.Level1)
+{
+    FrameIndexCache cache("test", INTERVAL, "");
+    EXPECT_FALSE(cache.Open(MakeSource(100000, 0), 100000)); // 100000 bytes
+    IndexFrames(cache, 10); // 10 frames
+    ASSERT_EQ(3u, cache.GetEntryCount()); // 3: frames 0 4 8
+    EXPECT_EQ(12u, cache.GetNextFrame()); // 12: next expected entry
+    cache.Add(13, 13 * 1152, 1300); // 13 1152 1300: not the next entry
+    EXPECT_EQ(3u, cache.GetEntryCount()); // 3
+    FrameIndexCache::Entry entry;
+    ASSERT_TRUE(cache.Lookup(5 * 1152 + 1, entry)); // 5 1152: in frame 5
+    EXPECT_EQ(4u, entry.frame); // 4
+    EXPECT_EQ(400u, entry.offset); // 400
+    ASSERT_TRUE(cache.Lookup(1000 * 1152, entry)); // 1000 1152: beyond the index
+    EXPECT_EQ(8u, entry.frame); // 8
+    EXPECT_FALSE(cache.Lookup(-1, entry));
+    cache.SetComplete(10, 10 * 1152); // 10 1152
+    EXPECT_TRUE(cache.IsComplete());
+    EXPECT_EQ(10u, cache.GetFrameCount()); // 10
+    EXPECT_TRUE(cache.Save()); // nothing persisted without a cache directory
+}
+
+HWTEST_F(TestFrameIndexCache, persisted_index_is_reloaded, TestSize.Level1)
+{
+    auto source = MakeSource(100000, 0); // 100000 bytes
+    {
+        FrameIndexCache cache("test", INTERVAL, CACHE_DIR);
+        EXPECT_FALSE(cache.Open(source, 100000)); // 100000 bytes
+        IndexFrames(cache, 1000); // 1000 frames
+        cache.SetComplete(1000, 1000 * 1152); // 1000 1152
+        ASSERT_TRUE(cache.Save());
+    }
+    FrameIndexCache cache("test", INTERVAL, CACHE_DIR);
+    ASSERT_TRUE(cache.Open(source, 100000)); // 100000 bytes
+    EXPECT_TRUE(cache.IsComplete());
+    EXPECT_EQ(250u, cache.GetEntryCount()); // 250: 1000 / 4
+    EXPECT_EQ(1000 * 1152, cache.GetDuration()); // 1000 1152
+    FrameIndexCache::Entry entry;
+    ASSERT_TRUE(cache.Lookup(501 * 1152, entry)); // 501 1152
+    EXPECT_EQ(500u, entry.frame); // 500
+    EXPECT_EQ(500 * 1152, entry.pts); // 500 1152
+    EXPECT_EQ(50000u, entry.offset); // 50000
+
+    // the index of another kind or another content is not used
+    FrameIndexCache other("other", INTERVAL, CACHE_DIR);
+    EXPECT_FALSE(other.Open(source, 100000)); // 100000 bytes
+    EXPECT_FALSE(cache.Open(MakeSource(100000, 1), 100000)); // 100000 bytes
+    EXPECT_EQ(0u, cache.GetEntryCount());
+}
+
+HWTEST_F(TestFrameIndexCache, partial_index_is_extended, TestSize.Level1)
+{
+    auto source = MakeSource(100000, 0); // 100000 bytes
+    {
+        FrameIndexCache cache("test", INTERVAL, CACHE_DIR);
+        (void)cache.Open(source, 100000); // 100000 bytes
+        IndexFrames(cache, 100); // 100 frames
+        ASSERT_TRUE(cache.Save());
+    }
+    FrameIndexCache cache("test", INTERVAL, CACHE_DIR);
+    ASSERT_TRUE(cache.Open(source, 100000)); // 100000 bytes
+    EXPECT_FALSE(cache.IsComplete());
+    FrameIndexCache::Entry last;
+    ASSERT_TRUE(cache.GetLast(last));
+    EXPECT_EQ(96u, last.frame); // 96: last entry of 100 frames
+    IndexFrames(cache, 200); // 200 frames
+    EXPECT_EQ(50u, cache.GetEntryCount()); // 50: 200 / 4
+}
+
+HWTEST_F(TestFrameIndexCache, corrupted_index_is_ignored, TestSize.Level1)
+{
+    auto source = MakeSource(100000, 0); // 100000 bytes
+    {
+        FrameIndexCache cache("test", INTERVAL, CACHE_DIR);
+        (void)cache.Open(source, 100000); // 100000 bytes
+        IndexFrames(cache, 100); // 100 frames
+        ASSERT_TRUE(cache.Save());
+    }
+    DIR* dir = opendir(CACHE_DIR.c_str());
+    ASSERT_TRUE(dir != nullptr);
+    for (dirent* item = readdir(dir); item != nullptr; item = readdir(dir)) {
+        if (item->d_name[0] != '.') {
+            std::string path = CACHE_DIR + "/" + item->d_name;
+            struct stat fileStat {};
+            ASSERT_EQ(0, stat(path.c_str(), &fileStat));
+            ASSERT_EQ(0, truncate(path.c_str(), fileStat.st_size / 2)); // 2: truncated in the middle
+        }
+    }
+    (void)closedir(dir);
+    FrameIndexCache cache("test", INTERVAL, CACHE_DIR);
+    EXPECT_FALSE(cache.Open(source, 100000)); // 100000 bytes
+    EXPECT_EQ(0u, cache.GetEntryCount());
+}
+
+HWTEST_F(TestFrameIndexCache, least_recently_used_index_is_removed, TestSize.Level1)
+{
+    auto first = MakeSource(100000, 0); // 100000 bytes
+    auto second = MakeSource(100000, 1); // 100000 bytes
+    auto third = MakeSource(100000, 2); // 100000 bytes
+    std::vector<std::string> files;
+    for (const auto& source : {first, second}) {
+        FrameIndexCache cache("test", INTERVAL, CACHE_DIR);
+        (void)cache.Open(source, 100000); // 100000 bytes
+        IndexFrames(cache, 100); // 100 frames
+        ASSERT_TRUE(cache.Save());
+        for (const auto& file : ListCacheFiles()) {
+            if (std::find(files.begin(), files.end(), file) == files.end()) {
+                files.push_back(file);
+            }
+        }
+    }
+    ASSERT_EQ(2u, files.size()); // 2 indexes
+    struct stat fileStat {};
+    ASSERT_EQ(0, stat(files[0].c_str(), &fileStat));
+    uint64_t fileSize = static_cast<uint64_t>(fileStat.st_size);
+    utimbuf firstTime {1000, 1000}; // 1000: written long ago
+    utimbuf secondTime {2000, 2000}; // 2000: written after the first
+    ASSERT_EQ(0, utime(files[0].c_str(), &firstTime));
+    ASSERT_EQ(0, utime(files[1].c_str(), &secondTime));
+    {
+        // using the first index makes the second the least recently used
+        FrameIndexCache cache("test", INTERVAL, CACHE_DIR);
+        ASSERT_TRUE(cache.Open(first, 100000)); // 100000 bytes
+    }
+    {
+        FrameIndexCache cache("test", INTERVAL, CACHE_DIR, fileSize * 5 / 2); // 5 2: room for two indexes
+        (void)cache.Open(third, 100000); // 100000 bytes
+        IndexFrames(cache, 100); // 100 frames
+        ASSERT_TRUE(cache.Save());
+    }
+    EXPECT_EQ(2u, ListCacheFiles().size()); // 2 indexes
+    FrameIndexCache cache("test", INTERVAL, CACHE_DIR);
+    EXPECT_TRUE(cache.Open(first, 100000)); // 100000 bytes
+    EXPECT_FALSE(cache.Open(second, 100000)); // 100000 bytes
+    EXPECT_TRUE(cache.Open(third, 100000)); // 100000 bytes
+}
+
+HWTEST_F(TestFrameIndexCache, only_local_uri_is_persisted, TestSize.Level1)
+{
+    EXPECT_TRUE(FrameIndexCache::IsLocalUri("/data/media/a.mp3"));
+    EXPECT_TRUE(FrameIndexCache::IsLocalUri("file:///data/media/a.mp3"));
+    EXPECT_TRUE(FrameIndexCache::IsLocalUri("fd://12?offset=0&size=100"));
+    EXPECT_FALSE(FrameIndexCache::IsLocalUri("http://test/a.mp3"));
+    EXPECT_FALSE(FrameIndexCache::IsLocalUri("https://test/a.mp3"));
+    EXPECT_FALSE(FrameIndexCache::IsLocalUri("stream://"));
+    EXPECT_FALSE(FrameIndexCache::IsLocalUri(""));
+}
+} // namespace Test
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include "gtest/gtest.h"
+#define private public
+#define protected public
+#include "pipeline/filters/sink/video_sink/frame_presentation_scheduler.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Test {
+using namespace OHOS::Media::Pipeline;
+
+namespace {
+constexpr int64_t NS_PER_MS = 1000000;
+constexpr int64_t FRAME_INTERVAL_30FPS = 33333333;
+
+class FakePresentationClock : public PresentationClock {
+public:
+    int64_t NowNs() override
+    {
+        return now_;
+    }
+
+    bool WaitUntil(int64_t deadlineNs) override
+    {
+        if (interrupted_) {
+            return false;
+        }
+        if (deadlineNs > now_) {
+            now_ = deadlineNs;
+        }
+        now_ += wakeupLatency_;
+        return true;
+    }
+
+    void Interrupt() override
+    {
+        interrupted_ = true;
+    }
+
+    void ClearInterrupt() override
+    {
+        interrupted_ = false;
+    }
+
+    void Advance(int64_t ns)
+    {
+        now_ += ns;
+    }
+
+    int64_t now_ {0};
+    int64_t wakeupLatency_ {0};
+    bool interrupted_ {false};
+};
+}
+
+class TestFramePresentationScheduler : public ::testing::Test {
+public:
+    void SetUp() override
+    {
+        clock = std::make_shared<FakePresentationClock>();
+        scheduler = std::make_shared<FramePresentationScheduler>(clock);
+    }
+
+    void TearDown() override
+    {
+    }
+
+    std::shared_ptr<FakePresentationClock> clock;
+    std::shared_ptr<FramePresentationScheduler> scheduler;
+};
+
+HWTEST_F(TestFramePresentationScheduler, frame_rate_from_rolling_window, TestSize.Level1)
+{
+    EXPECT_EQ(0.0, scheduler->GetFrameRate());
+    for (int i = 0; i < 100; ++i) { // 100 frames
+        scheduler->OnFramePresented();
+        clock->Advance(FRAME_INTERVAL_30FPS);
+    }
+    EXPECT_NEAR(30.0, scheduler->GetFrameRate(), 0.01); // 30 fps
+    for (int i = 0; i < 100; ++i) { // 100 frames
+        scheduler->OnFramePresented();
+        clock->Advance(FRAME_INTERVAL_30FPS * 2); // 2: half frame rate
+    }
+    EXPECT_NEAR(15.0, scheduler->GetFrameRate(), 0.01); // 15 fps, old samples rolled out of the window
+}
+
+HWTEST_F(TestFramePresentationScheduler, absolute_deadline_does_not_accumulate_latency, TestSize.Level1)
+{
+    clock->wakeupLatency_ = 50000; // 50us
+    int64_t base = clock->NowNs();
+    for (int i = 1; i <= 300; ++i) { // 300 frames
+        ASSERT_TRUE(scheduler->WaitUntil(base + i * FRAME_INTERVAL_30FPS));
+        scheduler->OnFramePresented();
+    }
+    auto stats = scheduler->GetJitterStats();
+    EXPECT_EQ(300u, stats.frameCount);
+    EXPECT_EQ(50000, stats.meanAbsJitterNs);
+    EXPECT_EQ(50000, stats.maxAbsJitterNs);
+    EXPECT_EQ(0, stats.stdDevJitterNs);
+    EXPECT_NEAR(30.0, scheduler->GetFrameRate(), 0.01); // 30 fps
+}
+
+HWTEST_F(TestFramePresentationScheduler, repeated_waits_do_not_drift, TestSize.Level1)
+{
+    clock->wakeupLatency_ = 50000; // 50us
+    int64_t mediaStart = 1000 * NS_PER_MS; // 1000ms: media clock time of the first frame
+    scheduler->UpdateAnchor(mediaStart, clock->NowNs());
+    int64_t base = clock->NowNs();
+    for (int i = 1; i <= 300; ++i) { // 300 frames
+        // the media clock runs with the monotonic clock, it is read again after every late wake up
+        int64_t mediaNow = mediaStart + (clock->NowNs() - base);
+        scheduler->UpdateAnchor(mediaNow, clock->NowNs());
+        int64_t deadline = scheduler->GetDeadline(mediaStart + i * FRAME_INTERVAL_30FPS);
+        EXPECT_EQ(base + i * FRAME_INTERVAL_30FPS, deadline);
+        ASSERT_TRUE(scheduler->WaitUntil(deadline));
+    }
+    // the last frame is late by one wake up latency, not by 300 of them
+    EXPECT_EQ(base + 300 * FRAME_INTERVAL_30FPS + 50000, clock->NowNs()); // 300 frames, 50us
+    EXPECT_EQ(50000, scheduler->GetJitterStats().maxAbsJitterNs); // 50us
+
+    // a media clock that jumped, e.g. after a pause, moves the anchor
+    int64_t now = clock->NowNs();
+    scheduler->UpdateAnchor(mediaStart, now);
+    EXPECT_EQ(now + FRAME_INTERVAL_30FPS, scheduler->GetDeadline(mediaStart + FRAME_INTERVAL_30FPS));
+    scheduler->Reset();
+    EXPECT_EQ(clock->NowNs(), scheduler->GetDeadline(mediaStart));
+}
+
+HWTEST_F(TestFramePresentationScheduler, interrupted_wait_is_not_counted, TestSize.Level1)
+{
+    scheduler->Interrupt();
+    EXPECT_FALSE(scheduler->WaitUntil(clock->NowNs() + FRAME_INTERVAL_30FPS));
+    EXPECT_EQ(0u, scheduler->GetJitterStats().frameCount);
+    scheduler->Resume();
+    EXPECT_TRUE(scheduler->WaitUntil(clock->NowNs() + FRAME_INTERVAL_30FPS));
+    EXPECT_EQ(1u, scheduler->GetJitterStats().frameCount);
+    scheduler->OnFrameDropped();
+    EXPECT_EQ(1u, scheduler->GetDroppedFrameCount());
+    scheduler->Reset();
+    EXPECT_EQ(0u, scheduler->GetJitterStats().frameCount);
+    EXPECT_EQ(0u, scheduler->GetDroppedFrameCount());
+}
+
+HWTEST_F(TestFramePresentationScheduler, monotonic_clock_wakes_on_interrupt, TestSize.Level1)
+{
+    FramePresentationScheduler realScheduler;
+    auto start = realScheduler.NowNs();
+    EXPECT_TRUE(realScheduler.WaitUntil(start + 2 * NS_PER_MS)); // 2ms
+    EXPECT_GE(realScheduler.NowNs(), start + 2 * NS_PER_MS); // 2ms
+    std::thread waker([&realScheduler] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // 20ms
+        realScheduler.Interrupt();
+    });
+    start = realScheduler.NowNs();
+    EXPECT_FALSE(realScheduler.WaitUntil(start + 10000 * NS_PER_MS)); // 10s
+    EXPECT_LT(realScheduler.NowNs() - start, 5000 * NS_PER_MS); // 5s
+    waker.join();
+}
+} // namespace Test
+} // namespace Media
+} // namespace OHOS
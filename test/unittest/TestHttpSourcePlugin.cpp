@@ -13,16 +13,204 @@
  * limitations under the License.
  */
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <set>
 #include <string>
+#include <thread>
+#include <vector>
 #include "gtest/gtest.h"
+#include "openssl/evp.h"
 #include "plugin/plugins/source/http_source/download/downloader.h"
+#include "plugin/plugins/source/http_source/download/http_curl_client.h"
+#include "plugin/plugins/source/http_source/hls/hls_decryptor.h"
+#include "plugin/plugins/source/http_source/hls/m3u8.h"
 
 namespace OHOS {
 namespace Media {
 namespace Test {
+using namespace OHOS::Media::Plugin;
 using namespace OHOS::Media::Plugin::HttpPlugin;
 using namespace testing::ext;
 
+namespace {
+constexpr size_t TEST_FILE_SIZE = 1000;
+
+// Serves TEST_FILE_SIZE bytes on 127.0.0.1 with keep alive and ranges, counts the accepted connections.
+// Paths added with AddFile() serve their content instead, or all of it without Content-Length when told to.
+// The first response of a connection can be delayed like the tcp and tls setup of a remote server.
+class LoopbackHttpServer {
+public:
+    LoopbackHttpServer()
+    {
+        listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        if (bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), len) == 0 && listen(listenFd_, 4) == 0 && // 4
+            getsockname(listenFd_, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+            port_ = ntohs(addr.sin_port);
+        }
+        thread_ = std::thread([this] { AcceptLoop(); });
+    }
+
+    ~LoopbackHttpServer()
+    {
+        shutdown(listenFd_, SHUT_RDWR);
+        close(listenFd_);
+        thread_.join();
+        // wakes the connections a client still keeps open
+        for (int fd : clientFds_) {
+            shutdown(fd, SHUT_RDWR);
+        }
+        for (auto& serveThread : serveThreads_) {
+            serveThread.join();
+        }
+        for (int fd : clientFds_) {
+            close(fd);
+        }
+    }
+
+    std::string Url(const std::string& path) const
+    {
+        return "http://127.0.0.1:" + std::to_string(port_) + path;
+    }
+
+    int Connections() const
+    {
+        return connections_.load();
+    }
+
+    void SetConnectionSetupDelay(int delayMs)
+    {
+        setupDelayMs_ = delayMs;
+    }
+
+    void AddFile(const std::string& path, const std::string& content, bool contentLength = true)
+    {
+        files_[path] = content;
+        if (!contentLength) {
+            closeAfterBody_.insert(path);
+        }
+    }
+
+private:
+    void AcceptLoop()
+    {
+        int fd;
+        while ((fd = accept(listenFd_, nullptr, nullptr)) >= 0) {
+            connections_++;
+            clientFds_.push_back(fd);
+            serveThreads_.emplace_back([this, fd] { Serve(fd); });
+        }
+    }
+
+    void Serve(int fd)
+    {
+        std::string request;
+        char buffer[1024]; // 1024
+        ssize_t len;
+        bool first = true;
+        while ((len = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+            if (first) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(setupDelayMs_.load()));
+                first = false;
+            }
+            request.append(buffer, len);
+            size_t end;
+            while ((end = request.find("\r\n\r\n")) != std::string::npos) {
+                size_t pathStart = request.find(' ') + 1;
+                std::string path = request.substr(pathStart, request.find(' ', pathStart) - pathStart);
+                auto file = files_.find(path);
+                if (closeAfterBody_.count(path) != 0) {
+                    // the whole content, its end is where the connection closes
+                    std::string head = "HTTP/1.1 200 OK\r\nContent-Type: audio/mpeg\r\nConnection: close\r\n\r\n";
+                    (void)send(fd, (head + file->second).c_str(), head.size() + file->second.size(), MSG_NOSIGNAL);
+                    shutdown(fd, SHUT_WR);
+                    break;
+                }
+                size_t fileSize = file != files_.end() ? file->second.size() : TEST_FILE_SIZE;
+                size_t start = 0;
+                size_t last = fileSize - 1;
+                size_t range = request.find("Range: bytes=");
+                if (range != std::string::npos && range < end) {
+                    (void)sscanf_s(request.c_str() + range, "Range: bytes=%zu-%zu", &start, &last);
+                }
+                last = std::min(last, fileSize - 1);
+                std::string body;
+                for (size_t pos = start; pos <= last; ++pos) {
+                    // 26: letters, tells the bytes apart
+                    body.push_back(file != files_.end() ? file->second[pos] : static_cast<char>('a' + pos % 26));
+                }
+                std::string head = "HTTP/1.1 206 Partial Content\r\nContent-Type: audio/mpeg\r\nContent-Length: " +
+                    std::to_string(body.size()) + "\r\nContent-Range: bytes " + std::to_string(start) + "-" +
+                    std::to_string(last) + "/" + std::to_string(fileSize) + "\r\n\r\n";
+                (void)send(fd, (head + body).c_str(), head.size() + body.size(), MSG_NOSIGNAL);
+                request.erase(0, end + 4); // 4: the empty line
+            }
+        }
+    }
+
+    int listenFd_ {-1};
+    uint16_t port_ {0};
+    std::atomic<int> connections_ {0};
+    std::atomic<int> setupDelayMs_ {0};
+    std::map<std::string, std::string> files_;
+    std::set<std::string> closeAfterBody_;
+    std::thread thread_;
+    // only the accept thread adds to them until it is joined
+    std::vector<int> clientFds_;
+    std::vector<std::thread> serveThreads_;
+};
+
+std::string Aes128CbcEncrypt(const std::string& plain, const uint8_t* key, const uint8_t* iv)
+{
+    std::string cipher(plain.size() + HLS_AES_BLOCK_SIZE, '\0');
+    int len = 0;
+    int finalLen = 0;
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    (void)EVP_EncryptInit_ex(ctx, EVP_aes_128_cbc(), nullptr, key, iv);
+    (void)EVP_EncryptUpdate(ctx, reinterpret_cast<uint8_t*>(&cipher[0]), &len,
+        reinterpret_cast<const uint8_t*>(plain.data()), static_cast<int>(plain.size()));
+    (void)EVP_EncryptFinal_ex(ctx, reinterpret_cast<uint8_t*>(&cipher[len]), &finalLen);
+    EVP_CIPHER_CTX_free(ctx);
+    cipher.resize(len + finalLen);
+    return cipher;
+}
+
+size_t RxCount(void* buffer, size_t size, size_t nitems, void* userParam)
+{
+    (void)buffer;
+    *static_cast<size_t*>(userParam) += size * nitems;
+    return size * nitems;
+}
+
+size_t RxIgnore(void* buffer, size_t size, size_t nitems, void* userParam)
+{
+    (void)buffer;
+    (void)userParam;
+    return size * nitems;
+}
+
+int64_t TimedRequest(HttpCurlClient& client, long startPos, int len)
+{
+    NetworkServerErrorCode serverCode = 0;
+    NetworkClientErrorCode clientCode = NetworkClientErrorCode::ERROR_OK;
+    auto start = std::chrono::steady_clock::now();
+    if (client.RequestData(startPos, len, serverCode, clientCode) != Status::OK) {
+        return -1;
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
 HWTEST(HttpSourcePluginTest, test_download_request_save_header, TestSize.Level1)
 {
     std::shared_ptr<HeaderInfo> headerInfo = std::make_shared<HeaderInfo>();
@@ -59,6 +247,304 @@ HWTEST(HttpSourcePluginTest, test_download_request_save_header, TestSize.Level1)
 
     EXPECT_EQ(true, downloadRequest.IsClosed());
 }
+
+HWTEST(HttpSourcePluginTest, test_curl_client_reuse_connection, TestSize.Level1)
+{
+    LoopbackHttpServer server;
+    size_t received = 0;
+    HttpCurlClient client(&RxIgnore, &RxCount, &received);
+    ASSERT_EQ(Status::OK, client.Init());
+    NetworkServerErrorCode serverCode = 0;
+    NetworkClientErrorCode clientCode = NetworkClientErrorCode::ERROR_OK;
+
+    // ranges of one url, a seek, the next url of the same host and a retry share one connection
+    ASSERT_EQ(Status::OK, client.Open(server.Url("/a.mp3")));
+    EXPECT_EQ(Status::OK, client.RequestData(0, 100, serverCode, clientCode)); // 100: bytes
+    EXPECT_EQ(Status::OK, client.RequestData(100, 100, serverCode, clientCode)); // 100: bytes
+    EXPECT_EQ(Status::OK, client.RequestData(800, 100, serverCode, clientCode)); // 800: seek, 100: bytes
+    ASSERT_EQ(Status::OK, client.Open(server.Url("/b.mp3")));
+    EXPECT_EQ(Status::OK, client.RequestData(0, 100, serverCode, clientCode)); // 100: bytes
+    client.Close();
+    ASSERT_EQ(Status::OK, client.Open(server.Url("/b.mp3")));
+    EXPECT_EQ(Status::OK, client.RequestData(100, -1, serverCode, clientCode)); // 100: up to the end
+    client.Close();
+    client.Deinit();
+
+    EXPECT_EQ(TEST_FILE_SIZE + 300, received); // 300: the ranges of a.mp3, then all of b.mp3
+    EXPECT_EQ(1, server.Connections());
+}
+
+HWTEST(HttpSourcePluginTest, test_curl_client_next_client_takes_warm_connection, TestSize.Level1)
+{
+    constexpr int setupDelayMs = 300; // 300ms: connection setup of a far server
+    LoopbackHttpServer server;
+    server.SetConnectionSetupDelay(setupDelayMs);
+    size_t received = 0;
+    {
+        HttpCurlClient client(&RxIgnore, &RxCount, &received);
+        ASSERT_EQ(Status::OK, client.Init());
+        ASSERT_EQ(Status::OK, client.Open(server.Url("/a.mp3")));
+        EXPECT_GE(TimedRequest(client, 0, 100), setupDelayMs); // 100: bytes
+        // a seek on the same client does not pay the setup again
+        int64_t seekMs = TimedRequest(client, 800, 100); // 800: seek, 100: bytes
+        EXPECT_GE(seekMs, 0);
+        EXPECT_LT(seekMs, setupDelayMs / 2); // 2: far below the setup
+        client.Deinit();
+    }
+    // the next client of the host, like the one of the next segment or key, takes the idle handle over
+    HttpCurlClient client(&RxIgnore, &RxCount, &received);
+    ASSERT_EQ(Status::OK, client.Init());
+    ASSERT_EQ(Status::OK, client.Open(server.Url("/b.mp3")));
+    int64_t requestMs = TimedRequest(client, 0, 100); // 100: bytes
+    EXPECT_GE(requestMs, 0);
+    EXPECT_LT(requestMs, setupDelayMs / 2); // 2: far below the setup
+    client.Deinit();
+
+    EXPECT_EQ(300u, received); // 300: three ranges of 100 bytes
+    EXPECT_EQ(1, server.Connections());
+}
+
+HWTEST(HttpSourcePluginTest, test_m3u8_byte_range_and_map, TestSize.Level1)
+{
+    std::string playList = "#EXTM3U\n#EXT-X-VERSION:7\n#EXT-X-TARGETDURATION:4\n"
+        "#EXT-X-MAP:URI=\"main.mp4\",BYTERANGE=\"720@0\"\n"
+        "#EXTINF:4.0,\n#EXT-X-BYTERANGE:1000@720\nmain.mp4\n"
+        "#EXTINF:4.0,\n#EXT-X-BYTERANGE:2000\nmain.mp4\n"
+        "#EXT-X-MAP:URI=\"init.mp4\"\n"
+        "#EXTINF:4.0,\nseg.mp4\n#EXT-X-ENDLIST\n";
+    M3U8 m3u8("http://test/hls/index.m3u8", "");
+    ASSERT_TRUE(m3u8.Update(playList));
+    ASSERT_EQ(3u, m3u8.files_.size()); // 3 fragments
+    auto first = m3u8.files_.front();
+    auto second = *std::next(m3u8.files_.begin());
+    auto third = m3u8.files_.back();
+
+    EXPECT_EQ("http://test/hls/main.mp4", first->uri_);
+    EXPECT_EQ(720, first->offset_);
+    EXPECT_EQ(1000, first->size_);
+    ASSERT_NE(nullptr, first->initFile_);
+    EXPECT_EQ("http://test/hls/main.mp4", first->initFile_->uri);
+    EXPECT_EQ(0, first->initFile_->offset);
+    EXPECT_EQ(720, first->initFile_->size);
+
+    EXPECT_EQ(1720, second->offset_); // 1720: a range without offset follows the previous one
+    EXPECT_EQ(2000, second->size_);
+    EXPECT_EQ(first->initFile_, second->initFile_);
+
+    EXPECT_EQ(-1, third->offset_);
+    ASSERT_NE(nullptr, third->initFile_);
+    EXPECT_EQ("http://test/hls/init.mp4", third->initFile_->uri);
+    EXPECT_EQ(-1, third->initFile_->offset);
+}
+
+HWTEST(HttpSourcePluginTest, test_downloader_range_request, TestSize.Level1)
+{
+    LoopbackHttpServer server;
+    std::string data;
+    std::atomic<bool> done {false};
+    DataSaveFunc dataSaveFunc = [&data](uint8_t* buffer, uint32_t len) {
+        data.append(reinterpret_cast<char*>(buffer), len);
+        return true;
+    };
+    StatusCallbackFunc statusCallbackFunc = [](DownloadStatus, std::shared_ptr<Downloader>&,
+        std::shared_ptr<DownloadRequest>&) {};
+    auto request = std::make_shared<DownloadRequest>(server.Url("/main.mp4"), dataSaveFunc, statusCallbackFunc);
+    request->SetRangePos(30, 129); // 30: first byte, 129: last byte
+    Downloader downloader("test");
+    ASSERT_TRUE(downloader.Download(request, -1));
+    downloader.Start();
+    for (int i = 0; i < 200 && !request->IsEos(); ++i) { // 200: 2s
+        OSAL::SleepFor(10); // 10: ms
+    }
+    downloader.Stop();
+    EXPECT_TRUE(request->IsEos());
+    ASSERT_EQ(100u, data.size()); // 100: the range
+    EXPECT_EQ('a' + 30 % 26, data.front()); // 30: first byte, 26: letters
+    EXPECT_EQ('a' + 129 % 26, data.back()); // 129: last byte, 26: letters
+}
+
+HWTEST(HttpSourcePluginTest, test_m3u8_key, TestSize.Level1)
+{
+    std::string playList = "#EXTM3U\n#EXT-X-TARGETDURATION:4\n#EXT-X-MEDIA-SEQUENCE:7\n"
+        "#EXT-X-KEY:METHOD=AES-128,URI=\"key1.bin\",IV=0x000102030405060708090a0b0c0d0e0f\n"
+        "#EXTINF:4.0,\na.ts\n"
+        "#EXT-X-KEY:METHOD=AES-128,URI=\"https://keys.test/key2.bin\"\n"
+        "#EXT-X-KEY:METHOD=SAMPLE-AES,URI=\"skd://key3\",KEYFORMAT=\"com.apple.streamingkeydelivery\"\n"
+        "#EXTINF:4.0,\nb.ts\n"
+        "#EXT-X-KEY:METHOD=NONE\n"
+        "#EXTINF:4.0,\nc.ts\n#EXT-X-ENDLIST\n";
+    M3U8 m3u8("http://test/hls/index.m3u8", "");
+    ASSERT_TRUE(m3u8.Update(playList));
+    ASSERT_EQ(3u, m3u8.files_.size()); // 3 fragments
+    auto first = m3u8.files_.front();
+    auto second = *std::next(m3u8.files_.begin());
+    auto third = m3u8.files_.back();
+
+    EXPECT_EQ("http://test/hls/key1.bin", first->key_);
+    for (size_t i = 0; i < HLS_AES_BLOCK_SIZE; ++i) {
+        EXPECT_EQ(i, first->iv_[i]);
+    }
+    // the key of another key format does not replace the identity one
+    EXPECT_EQ("https://keys.test/key2.bin", second->key_);
+    EXPECT_EQ(8, second->sequence_); // 8: the second fragment after sequence 7
+    for (size_t i = 0; i < HLS_AES_BLOCK_SIZE - 1; ++i) {
+        EXPECT_EQ(0, second->iv_[i]);
+    }
+    EXPECT_EQ(8, second->iv_[HLS_AES_BLOCK_SIZE - 1]); // 8: without IV the sequence number is the iv
+    EXPECT_TRUE(third->key_.empty());
+}
+
+HWTEST(HttpSourcePluginTest, test_hls_decryptor_pieces, TestSize.Level1)
+{
+    const uint8_t key[HLS_AES_KEY_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    const uint8_t iv[HLS_AES_BLOCK_SIZE] = {16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+    std::string plain(1000, 'x'); // 1000: not a multiple of the block size
+    for (size_t i = 0; i < plain.size(); ++i) {
+        plain[i] = static_cast<char>(i * 7); // 7: any pattern
+    }
+    std::string cipher = Aes128CbcEncrypt(plain, key, iv);
+    std::string out;
+    DataSaveFunc save = [&out](uint8_t* data, uint32_t len) {
+        out.append(reinterpret_cast<char*>(data), len);
+        return true;
+    };
+    HlsDecryptor decryptor;
+    ASSERT_TRUE(decryptor.Init(key, iv));
+    size_t pos = 0;
+    for (size_t piece : {1, 15, 17, 32, 100, 3}) { // pieces that split and join blocks
+        ASSERT_TRUE(decryptor.Update(reinterpret_cast<const uint8_t*>(cipher.data()) + pos, piece, save));
+        pos += piece;
+        EXPECT_EQ(pos < HLS_AES_BLOCK_SIZE ? 0 : (pos - 1) / HLS_AES_BLOCK_SIZE * HLS_AES_BLOCK_SIZE, out.size());
+    }
+    ASSERT_TRUE(decryptor.Update(reinterpret_cast<const uint8_t*>(cipher.data()) + pos, cipher.size() - pos, save));
+    ASSERT_TRUE(decryptor.Finish(save));
+    EXPECT_EQ(plain, out);
+}
+
+HWTEST(HttpSourcePluginTest, test_downloader_decrypt_while_downloading, TestSize.Level1)
+{
+    const uint8_t key[HLS_AES_KEY_SIZE] = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                           0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+    uint8_t iv[HLS_AES_BLOCK_SIZE] = {0};
+    iv[HLS_AES_BLOCK_SIZE - 1] = 3; // 3: the iv of media sequence 3
+    std::string plain(200 * 1024 + 5, '\0'); // 200 * 1024 + 5: many curl writes, the last block padded
+    for (size_t i = 0; i < plain.size(); ++i) {
+        plain[i] = static_cast<char>('a' + i % 26); // 26: letters
+    }
+    LoopbackHttpServer server;
+    server.AddFile("/seg3.ts", Aes128CbcEncrypt(plain, key, iv));
+
+    auto decryptor = std::make_shared<HlsDecryptor>();
+    ASSERT_TRUE(decryptor->Init(key, iv));
+    std::string out;
+    int saves = 0;
+    int savesBeforeDone = -1;
+    DataSaveFunc dataSaveFunc = [&out, &saves](uint8_t* buffer, uint32_t len) {
+        out.append(reinterpret_cast<char*>(buffer), len);
+        saves++;
+        return true;
+    };
+    StatusCallbackFunc statusCallbackFunc = [](DownloadStatus, std::shared_ptr<Downloader>&,
+        std::shared_ptr<DownloadRequest>&) {};
+    auto request = std::make_shared<DownloadRequest>(server.Url("/seg3.ts"),
+        [decryptor, &dataSaveFunc](uint8_t* data, uint32_t len) {
+            return decryptor->Update(data, len, dataSaveFunc);
+        }, statusCallbackFunc, true);
+    request->SetDownloadDoneCallback([decryptor, &dataSaveFunc, &saves, &savesBeforeDone] {
+        savesBeforeDone = saves;
+        (void)decryptor->Finish(dataSaveFunc);
+    });
+    Downloader downloader("test");
+    ASSERT_TRUE(downloader.Download(request, -1));
+    downloader.Start();
+    for (int i = 0; i < 200 && !request->IsEos(); ++i) { // 200: 2s
+        OSAL::SleepFor(10); // 10: ms
+    }
+    downloader.Stop();
+    EXPECT_TRUE(request->IsEos());
+    EXPECT_GT(savesBeforeDone, 1); // plain data went out while the segment was still coming in
+    EXPECT_EQ(plain, out);
+}
+
+HWTEST(HttpSourcePluginTest, test_downloader_decrypt_retry_after_refused_save, TestSize.Level1)
+{
+    const uint8_t key[HLS_AES_KEY_SIZE] = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                           0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+    uint8_t iv[HLS_AES_BLOCK_SIZE] = {0};
+    iv[HLS_AES_BLOCK_SIZE - 1] = 5; // 5: the iv of media sequence 5
+    std::string plain(600 * 1024 + 5, '\0'); // 600 * 1024 + 5: many curl writes, the last block padded
+    for (size_t i = 0; i < plain.size(); ++i) {
+        plain[i] = static_cast<char>('a' + i % 26); // 26: letters
+    }
+    LoopbackHttpServer server;
+    server.AddFile("/seg5.ts", Aes128CbcEncrypt(plain, key, iv));
+
+    auto decryptor = std::make_shared<HlsDecryptor>();
+    ASSERT_TRUE(decryptor->Init(key, iv));
+    std::string out;
+    std::atomic<bool> refused {false};
+    // the ring buffer is full once in the middle of the segment, the downloader stops and is retried
+    DataSaveFunc dataSaveFunc = [&out, &refused](uint8_t* buffer, uint32_t len) {
+        if (!refused && out.size() >= 100 * 1024) { // 100 * 1024: somewhere in the middle
+            refused = true;
+            return false;
+        }
+        out.append(reinterpret_cast<char*>(buffer), len);
+        return true;
+    };
+    StatusCallbackFunc statusCallbackFunc = [](DownloadStatus, std::shared_ptr<Downloader>&,
+        std::shared_ptr<DownloadRequest>&) {};
+    auto request = std::make_shared<DownloadRequest>(server.Url("/seg5.ts"),
+        [decryptor, &dataSaveFunc](uint8_t* data, uint32_t len) {
+            return decryptor->Update(data, len, dataSaveFunc);
+        }, statusCallbackFunc, true);
+    std::atomic<bool> finished {false};
+    request->SetDownloadDoneCallback([decryptor, &dataSaveFunc, &finished] {
+        finished = decryptor->Finish(dataSaveFunc);
+    });
+    Downloader downloader("test");
+    ASSERT_TRUE(downloader.Download(request, -1));
+    downloader.Start();
+    for (int i = 0; i < 200 && !refused; ++i) { // 200: 2s
+        OSAL::SleepFor(10); // 10: ms
+    }
+    ASSERT_TRUE(refused);
+    OSAL::SleepFor(50); // 50: ms, the failed request is reported and the task pauses
+    ASSERT_TRUE(downloader.Retry(request));
+    for (int i = 0; i < 200 && !request->IsEos(); ++i) { // 200: 2s
+        OSAL::SleepFor(10); // 10: ms
+    }
+    downloader.Stop();
+    EXPECT_TRUE(request->IsEos());
+    EXPECT_TRUE(finished);
+    EXPECT_EQ(plain.size(), out.size());
+    EXPECT_EQ(plain, out);
+}
+
+HWTEST(HttpSourcePluginTest, test_downloader_done_without_content_length, TestSize.Level1)
+{
+    LoopbackHttpServer server;
+    server.AddFile("/empty.ts", "", false); // a response that ends without Content-Length or body
+    std::atomic<int> dones {0};
+    DataSaveFunc dataSaveFunc = [](uint8_t*, uint32_t) {
+        return true;
+    };
+    StatusCallbackFunc statusCallbackFunc = [](DownloadStatus, std::shared_ptr<Downloader>&,
+        std::shared_ptr<DownloadRequest>&) {};
+    auto request = std::make_shared<DownloadRequest>(server.Url("/empty.ts"), dataSaveFunc, statusCallbackFunc, true);
+    request->SetDownloadDoneCallback([&dones] { dones++; });
+    Downloader downloader("test");
+    ASSERT_TRUE(downloader.Download(request, -1));
+    downloader.Start();
+    for (int i = 0; i < 200 && !request->IsEos(); ++i) { // 200: 2s
+        OSAL::SleepFor(10); // 10: ms
+    }
+    downloader.Stop();
+    EXPECT_TRUE(request->IsEos());
+    EXPECT_TRUE(request->IsClosed());
+    // the decryptor of a segment learns the segment ended, an empty one is reported as broken
+    EXPECT_EQ(1, dones.load());
+}
 } // namespace Test
 } // namespace Media
 } // namespace OHOS
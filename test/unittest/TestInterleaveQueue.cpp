@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+#include "pipeline/filters/muxer/interleave_queue.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Test {
+using namespace Pipeline;
+namespace {
+constexpr int32_t VIDEO_TRACK = 0;
+constexpr int32_t AUDIO_TRACK = 1;
+
+AVBufferPtr MakeSample(int64_t timeMs)
+{
+    auto buffer = std::make_shared<AVBuffer>();
+    buffer->pts = timeMs * HST_MSECOND;
+    return buffer;
+}
+
+class Recorder {
+public:
+    InterleaveQueue::WriteFunc Writer()
+    {
+        return [this](const AVBufferPtr& buffer) {
+            written_.emplace_back(buffer->pts / HST_MSECOND);
+        };
+    }
+
+    bool IsSorted() const
+    {
+        return std::is_sorted(written_.begin(), written_.end());
+    }
+
+    std::vector<int64_t> written_ {};
+};
+}
+
+HWTEST(TestInterleaveQueue, orders_tracks_by_time, TestSize.Level1)
+{
+    Recorder recorder;
+    InterleaveQueue queue(recorder.Writer());
+    queue.AddTrack(VIDEO_TRACK);
+    queue.AddTrack(AUDIO_TRACK);
+    // video in bursts of 3 frames, audio in bursts of 5 frames, both well inside the delta
+    for (int64_t i = 0; i < 10; ++i) { // 10 bursts
+        for (int64_t v = 0; v < 3; ++v) { // 3 frames
+            ASSERT_EQ(ErrorCode::SUCCESS, queue.Push(VIDEO_TRACK, MakeSample((i * 3 + v) * 33))); // 3 33ms
+        }
+        for (int64_t a = 0; a < 5; ++a) { // 5 frames
+            ASSERT_EQ(ErrorCode::SUCCESS, queue.Push(AUDIO_TRACK, MakeSample((i * 5 + a) * 20))); // 5 20ms
+        }
+    }
+    queue.SetTrackEos(VIDEO_TRACK);
+    queue.SetTrackEos(AUDIO_TRACK);
+    EXPECT_TRUE(queue.AllTracksEos());
+    ASSERT_EQ(80u, recorder.written_.size()); // 80: 30 video and 50 audio
+    EXPECT_TRUE(recorder.IsSorted());
+    EXPECT_EQ(0u, queue.GetStats().forcedCount);
+}
+
+HWTEST(TestInterleaveQueue, eos_track_does_not_hold_back_others, TestSize.Level1)
+{
+    Recorder recorder;
+    InterleaveQueue queue(recorder.Writer());
+    queue.AddTrack(VIDEO_TRACK);
+    queue.AddTrack(AUDIO_TRACK);
+    queue.Push(VIDEO_TRACK, MakeSample(0));
+    queue.SetTrackEos(VIDEO_TRACK);
+    EXPECT_TRUE(recorder.written_.empty()); // audio may still deliver an earlier sample
+    queue.Push(AUDIO_TRACK, MakeSample(10)); // 10ms
+    queue.Push(AUDIO_TRACK, MakeSample(30)); // 30ms
+    EXPECT_EQ(3u, recorder.written_.size()); // 3: nothing is held back once video reached eos
+}
+
+HWTEST(TestInterleaveQueue, delta_bounds_queued_range, TestSize.Level1)
+{
+    Recorder recorder;
+    InterleaveQueue queue(recorder.Writer());
+    queue.SetMaxInterleaveDelta(100 * HST_MSECOND); // 100ms
+    queue.AddTrack(VIDEO_TRACK);
+    queue.AddTrack(AUDIO_TRACK);
+    // video never delivers anything, audio must not pile up beyond the delta
+    for (int64_t i = 0; i < 50; ++i) { // 50 frames
+        queue.Push(AUDIO_TRACK, MakeSample(i * 20)); // 20ms
+        int64_t queuedRange = i * 20 - (recorder.written_.empty() ? 0 : recorder.written_.back()); // 20ms
+        EXPECT_LE(queuedRange, 120); // 120: delta plus one frame
+    }
+    EXPECT_GT(queue.GetStats().forcedCount, 0u);
+    queue.Flush();
+    EXPECT_EQ(50u, recorder.written_.size()); // 50 frames
+    EXPECT_TRUE(recorder.IsSorted());
+}
+
+HWTEST(TestInterleaveQueue, fast_track_waits_for_slow_track, TestSize.Level1)
+{
+    Recorder recorder;
+    InterleaveQueue queue(recorder.Writer());
+    queue.SetMaxInterleaveDelta(100 * HST_MSECOND); // 100ms
+    queue.SetMaxWaitMs(5000); // 5s, long enough that only the slow track releases the wait
+    queue.AddTrack(VIDEO_TRACK);
+    queue.AddTrack(AUDIO_TRACK);
+    queue.Push(VIDEO_TRACK, MakeSample(0));
+    queue.Push(AUDIO_TRACK, MakeSample(0));
+    std::thread slow([&queue] {
+        for (int64_t i = 1; i <= 20; ++i) { // 20 frames
+            std::this_thread::sleep_for(std::chrono::milliseconds(2)); // 2ms
+            queue.Push(VIDEO_TRACK, MakeSample(i * 33)); // 33ms
+        }
+        queue.SetTrackEos(VIDEO_TRACK);
+    });
+    for (int64_t i = 1; i <= 40; ++i) { // 40 frames
+        queue.Push(AUDIO_TRACK, MakeSample(i * 20)); // 20ms
+    }
+    slow.join();
+    queue.SetTrackEos(AUDIO_TRACK);
+    auto stats = queue.GetStats();
+    EXPECT_GT(stats.backPressureCount, 0u);
+    EXPECT_EQ(0u, stats.backPressureTimeoutCount);
+    EXPECT_EQ(62u, recorder.written_.size()); // 62: 21 video and 41 audio
+    EXPECT_TRUE(recorder.IsSorted());
+}
+
+HWTEST(TestInterleaveQueue, interrupt_releases_blocked_push, TestSize.Level1)
+{
+    Recorder recorder;
+    InterleaveQueue queue(recorder.Writer());
+    queue.SetMaxInterleaveDelta(100 * HST_MSECOND); // 100ms
+    queue.SetMaxWaitMs(10000); // 10s
+    queue.AddTrack(VIDEO_TRACK);
+    queue.AddTrack(AUDIO_TRACK);
+    queue.Push(VIDEO_TRACK, MakeSample(0));
+    std::thread stopper([&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20)); // 20ms
+        queue.Interrupt();
+    });
+    EXPECT_EQ(ErrorCode::ERROR_INVALID_OPERATION, queue.Push(AUDIO_TRACK, MakeSample(1000))); // 1000ms
+    stopper.join();
+    queue.Reset();
+    EXPECT_EQ(ErrorCode::ERROR_INVALID_PARAMETER_VALUE, queue.Push(AUDIO_TRACK, MakeSample(0)));
+}
+
+HWTEST(TestInterleaveQueue, slow_write_does_not_block_pushers, TestSize.Level1)
+{
+    Recorder recorder;
+    std::atomic<bool> otherPushed {false};
+    std::atomic<bool> pushedWhileWriting {false};
+    auto record = recorder.Writer();
+    InterleaveQueue queue([&](const AVBufferPtr& buffer) {
+        if (recorder.written_.empty()) {
+            // like a segment split, takes a while
+            for (int i = 0; i < 100 && !otherPushed; ++i) { // 100: wait 1s at most
+                std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10ms
+            }
+            pushedWhileWriting = otherPushed.load();
+        }
+        record(buffer);
+    });
+    queue.AddTrack(VIDEO_TRACK);
+    queue.AddTrack(AUDIO_TRACK);
+    queue.Push(VIDEO_TRACK, MakeSample(0));
+    std::thread writer([&queue] { queue.Push(AUDIO_TRACK, MakeSample(0)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // 20ms
+    queue.Push(VIDEO_TRACK, MakeSample(40)); // 40ms
+    otherPushed = true;
+    writer.join();
+    queue.Flush();
+    EXPECT_TRUE(pushedWhileWriting);
+    EXPECT_EQ(3u, recorder.written_.size()); // 3: every sample
+    EXPECT_TRUE(recorder.IsSorted());
+}
+
+HWTEST(TestInterleaveQueue, resume_keeps_tracks_and_drops_queued, TestSize.Level1)
+{
+    Recorder recorder;
+    InterleaveQueue queue(recorder.Writer());
+    queue.AddTrack(VIDEO_TRACK);
+    queue.AddTrack(AUDIO_TRACK);
+    EXPECT_EQ(ErrorCode::SUCCESS, queue.Push(VIDEO_TRACK, MakeSample(0)));
+    queue.Interrupt();
+    EXPECT_EQ(ErrorCode::ERROR_INVALID_OPERATION, queue.Push(AUDIO_TRACK, MakeSample(0)));
+    queue.Resume();
+    EXPECT_EQ(ErrorCode::SUCCESS, queue.Push(VIDEO_TRACK, MakeSample(500))); // 500ms
+    EXPECT_EQ(ErrorCode::SUCCESS, queue.Push(AUDIO_TRACK, MakeSample(500))); // 500ms
+    queue.Flush();
+    ASSERT_EQ(2u, recorder.written_.size()); // 2: the sample queued before the interrupt is gone
+    EXPECT_EQ(500, recorder.written_[0]); // 500ms
+}
+} // namespace Test
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "MemoryDataSource.h"
+#include "plugin/common/plugin_time.h"
+#include "plugin/plugins/minimp3_adapter/minimp3_demuxer_plugin.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media::Plugin;
+using namespace OHOS::Media::Plugin::Minimp3;
+
+namespace OHOS {
+namespace Media {
+namespace Test {
+namespace {
+constexpr uint32_t MP3_FRAME_COUNT = 300;
+constexpr uint32_t ID3V2_TAG_SIZE = 20;
+constexpr uint32_t SEEK_DISCARDED_FRAMES = 2; // the demuxer empties the first frames after a seek
+
+struct Mp3Format {
+    uint8_t versionLayer; // second header byte
+    uint32_t sampleRate;
+    uint32_t frameSamples;
+    uint32_t slotFactor; // frame length = slotFactor * bitrate / sample rate + padding
+    std::vector<uint32_t> bitrates; // kbps of the bitrate indexes
+};
+
+// MPEG-1 Layer III 44.1kHz and MPEG-2 Layer III 22.05kHz
+const Mp3Format MPEG1_LAYER3 = {0xFB, 44100, 1152, 144,
+                                {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320}};
+const Mp3Format MPEG2_LAYER3 = {0xF3, 22050, 576, 72, {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160}};
+
+// an id3v2 tag then frames of varying bitrate and padding with all-zero side info, the last byte of a frame
+// holds its frame number
+std::vector<uint8_t> MakeMp3Stream(const Mp3Format& format, uint32_t frameCount)
+{
+    std::vector<uint8_t> data = {'I', 'D', '3', 3, 0, 0, 0, 0, 0, ID3V2_TAG_SIZE - 10}; // 3: v2.3, 10: tag header
+    data.resize(ID3V2_TAG_SIZE, 0);
+    const uint8_t bitrateBytes[] = {0x90, 0xB2, 0x50, 0xE2, 0x70}; // bitrate index and padding bit
+    for (uint32_t i = 0; i < frameCount; ++i) {
+        uint8_t bitrateByte = bitrateBytes[i % sizeof(bitrateBytes)];
+        uint32_t frameLength = format.slotFactor * format.bitrates[bitrateByte >> 4] * 1000 / // 4: index, 1000: kbps
+            format.sampleRate + ((bitrateByte >> 1) & 1); // 1: padding bit
+        size_t frameStart = data.size();
+        data.resize(frameStart + frameLength, 0);
+        data[frameStart] = 0xFF;
+        data[frameStart + 1] = format.versionLayer;
+        data[frameStart + 2] = bitrateByte; // 2: bitrate byte
+        data[frameStart + frameLength - 1] = static_cast<uint8_t>(i);
+    }
+    return data;
+}
+
+int64_t FrameTime(const Mp3Format& format, uint64_t frame)
+{
+    return static_cast<int64_t>(frame * format.frameSamples) * HST_SECOND / format.sampleRate;
+}
+
+std::shared_ptr<Minimp3DemuxerPlugin> OpenMp3Stream(const std::shared_ptr<MemoryDataSource>& source,
+                                                    MediaInfo& mediaInfo)
+{
+    auto plugin = std::make_shared<Minimp3DemuxerPlugin>("mp3");
+    if (plugin->Init() != Status::OK || plugin->SetDataSource(source) != Status::OK ||
+        plugin->GetMediaInfo(mediaInfo) != Status::OK) {
+        return nullptr;
+    }
+    return plugin;
+}
+
+bool ReadFrameNumber(const std::shared_ptr<Minimp3DemuxerPlugin>& plugin, uint8_t& frameNumber, int64_t& pts)
+{
+    Buffer buffer;
+    while (plugin->ReadFrame(buffer, 0) == Status::OK) {
+        auto memory = buffer.GetMemory();
+        if (memory != nullptr && memory->GetSize() > 0) {
+            frameNumber = memory->GetReadOnlyData()[memory->GetSize() - 1];
+            pts = buffer.pts;
+            return true;
+        }
+    }
+    return false;
+}
+
+void CheckSeekWalk(const Mp3Format& format)
+{
+    auto source = std::make_shared<MemoryDataSource>(MakeMp3Stream(format, MP3_FRAME_COUNT));
+    MediaInfo mediaInfo;
+    auto plugin = OpenMp3Stream(source, mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    int64_t realSeekTime = 0;
+    ASSERT_EQ(Status::OK, plugin->SeekTo(0, FrameTime(format, 200), SeekMode::SEEK_PREVIOUS_SYNC, realSeekTime));
+    EXPECT_EQ(FrameTime(format, 200), realSeekTime);
+    ASSERT_EQ(Status::OK, plugin->SeekTo(0, FrameTime(format, 50) + 5, SeekMode::SEEK_PREVIOUS_SYNC, realSeekTime));
+    EXPECT_EQ(FrameTime(format, 50), realSeekTime);
+    uint32_t frame = 50; // 50: frame of the last seek
+    uint8_t frameNumber = 0;
+    int64_t pts = 0;
+    while (ReadFrameNumber(plugin, frameNumber, pts)) {
+        if (frame >= 50 + SEEK_DISCARDED_FRAMES) { // 50: frame of the last seek
+            EXPECT_EQ(static_cast<uint8_t>(frame), frameNumber);
+        }
+        EXPECT_EQ(FrameTime(format, frame), pts);
+        frame++;
+    }
+    EXPECT_EQ(MP3_FRAME_COUNT, frame);
+    ASSERT_EQ(Status::OK, plugin->Deinit());
+}
+}
+
+HWTEST(TestMinimp3DemuxerPlugin, mp3_demuxer_seek_walks_mpeg1_frame_headers, TestSize.Level1)
+{
+    CheckSeekWalk(MPEG1_LAYER3);
+}
+
+HWTEST(TestMinimp3DemuxerPlugin, mp3_demuxer_seek_walks_mpeg2_frame_headers, TestSize.Level1)
+{
+    CheckSeekWalk(MPEG2_LAYER3);
+}
+
+HWTEST(TestMinimp3DemuxerPlugin, mp3_demuxer_seek_starts_from_frame_index, TestSize.Level1)
+{
+    auto source = std::make_shared<MemoryDataSource>(MakeMp3Stream(MPEG1_LAYER3, MP3_FRAME_COUNT));
+    MediaInfo mediaInfo;
+    auto plugin = OpenMp3Stream(source, mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    uint8_t frameNumber = 0;
+    int64_t pts = 0;
+    uint32_t frameCount = 0;
+    while (ReadFrameNumber(plugin, frameNumber, pts)) {
+        frameCount++;
+    }
+    ASSERT_EQ(MP3_FRAME_COUNT, frameCount);
+
+    // the playback indexed every frame, a seek only walks the frames after the closest entry
+    size_t readCount = source->readCount;
+    int64_t realSeekTime = 0;
+    ASSERT_EQ(Status::OK, plugin->SeekTo(0, FrameTime(MPEG1_LAYER3, 123) + 1000, SeekMode::SEEK_PREVIOUS_SYNC,
+                                         realSeekTime));
+    EXPECT_EQ(FrameTime(MPEG1_LAYER3, 123), realSeekTime);
+    EXPECT_LE(source->readCount - readCount, 1u);
+    for (uint32_t frame = 123; frame <= 123 + SEEK_DISCARDED_FRAMES; ++frame) { // 123: frame of the seek
+        ASSERT_TRUE(ReadFrameNumber(plugin, frameNumber, pts));
+        EXPECT_EQ(FrameTime(MPEG1_LAYER3, frame), pts);
+    }
+    EXPECT_EQ(123 + SEEK_DISCARDED_FRAMES, frameNumber); // 123: frame of the seek
+
+    // a seek past the end lands on the end of the last frame
+    ASSERT_EQ(Status::OK, plugin->SeekTo(0, FrameTime(MPEG1_LAYER3, MP3_FRAME_COUNT * 2),
+                                         SeekMode::SEEK_PREVIOUS_SYNC, realSeekTime));
+    EXPECT_EQ(FrameTime(MPEG1_LAYER3, MP3_FRAME_COUNT), realSeekTime);
+    EXPECT_FALSE(ReadFrameNumber(plugin, frameNumber, pts));
+    ASSERT_EQ(Status::OK, plugin->Deinit());
+}
+} // namespace Test
+} // namespace Media
+} // namespace OHOS
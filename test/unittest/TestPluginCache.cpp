@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2023-2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "plugin/common/plugin_audio_tags.h"
+#include "plugin/core/plugin_cache.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Test {
+using namespace Plugin;
+namespace {
+const std::string CACHE_FILE = "./TestPluginCache.cache";
+
+// the cached path never loads the library, so any file stands in for a plugin library
+std::string MakeDummyLib(int index, size_t size = 64) // 64 bytes
+{
+    std::string path = "./libhistreamer_plugin_cachetest" + std::to_string(index) + ".so";
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << std::string(size, 'x');
+    return path;
+}
+
+std::shared_ptr<PluginInfo> MakeCodecInfo(const std::string& name)
+{
+    auto info = std::make_shared<PluginInfo>();
+    info->apiVersion = 1;
+    info->pluginType = PluginType::AUDIO_DECODER;
+    info->name = name;
+    info->description = "decoder with spaces: and 12:colons";
+    info->rank = 100; // 100
+    Capability inCap("audio/mpeg");
+    inCap.AppendFixedKey<uint32_t>(Capability::Key::AUDIO_MPEG_VERSION, 1)
+        .AppendIntervalKey<uint32_t>(Capability::Key::AUDIO_SAMPLE_RATE, 8000, 48000) // 8000 48000
+        .AppendDiscreteKeys<AudioSampleFormat>(Capability::Key::AUDIO_SAMPLE_FORMAT,
+                                               {AudioSampleFormat::S16, AudioSampleFormat::F32P});
+    info->inCaps.emplace_back(inCap);
+    info->outCaps.emplace_back(Capability("audio/raw"));
+    info->extra[PLUGIN_INFO_EXTRA_CODEC_MODE] = CodecMode::HARDWARE;
+    info->extra[PLUGIN_INFO_EXTRA_EXTENSIONS] = std::vector<std::string> {"mp3", ""};
+    return info;
+}
+}
+
+class TestPluginCache : public ::testing::Test {
+protected:
+    void TearDown() override
+    {
+        (void)std::remove(CACHE_FILE.c_str());
+        for (const auto& lib : libs_) {
+            (void)std::remove(lib.c_str());
+        }
+    }
+
+    std::string AddLib(int index, size_t size = 64) // 64 bytes
+    {
+        auto path = MakeDummyLib(index, size);
+        libs_.insert(path);
+        return path;
+    }
+
+    std::set<std::string> libs_;
+};
+
+HWTEST_F(TestPluginCache, round_trip_keeps_descriptions, TestSize.Level1)
+{
+    auto lib = AddLib(0);
+    {
+        PluginCache cache(CACHE_FILE);
+        EXPECT_FALSE(cache.Load());
+        cache.Update(lib, {MakeCodecInfo("codec_a"), MakeCodecInfo("codec_b")});
+        ASSERT_TRUE(cache.Save());
+    }
+    PluginCache cache(CACHE_FILE);
+    ASSERT_TRUE(cache.Load());
+    std::vector<std::shared_ptr<PluginInfo>> infos;
+    ASSERT_TRUE(cache.Lookup(lib, infos));
+    ASSERT_EQ(2u, infos.size()); // 2 plugins
+    const auto& info = *infos[1];
+    EXPECT_EQ("codec_b", info.name);
+    EXPECT_EQ(MakeCodecInfo("")->description, info.description);
+    EXPECT_EQ(PluginType::AUDIO_DECODER, info.pluginType);
+    EXPECT_EQ(100u, info.rank); // 100
+    ASSERT_EQ(1u, info.inCaps.size());
+    const auto& keys = info.inCaps[0].keys;
+    EXPECT_EQ("audio/mpeg", info.inCaps[0].mime);
+    EXPECT_EQ(1u, AnyCast<uint32_t>(keys.at(Capability::Key::AUDIO_MPEG_VERSION)));
+    auto rates = AnyCast<IntervalCapability<uint32_t>>(keys.at(Capability::Key::AUDIO_SAMPLE_RATE));
+    EXPECT_EQ(8000u, rates.first); // 8000
+    EXPECT_EQ(48000u, rates.second); // 48000
+    auto formats = AnyCast<DiscreteCapability<AudioSampleFormat>>(keys.at(Capability::Key::AUDIO_SAMPLE_FORMAT));
+    EXPECT_EQ((DiscreteCapability<AudioSampleFormat> {AudioSampleFormat::S16, AudioSampleFormat::F32P}), formats);
+    ASSERT_EQ(1u, info.outCaps.size());
+    EXPECT_TRUE(info.outCaps[0].keys.empty());
+    EXPECT_EQ(CodecMode::HARDWARE, AnyCast<CodecMode>(info.extra.at(PLUGIN_INFO_EXTRA_CODEC_MODE)));
+    EXPECT_EQ((std::vector<std::string> {"mp3", ""}),
+              AnyCast<std::vector<std::string>>(info.extra.at(PLUGIN_INFO_EXTRA_EXTENSIONS)));
+}
+
+HWTEST_F(TestPluginCache, changed_or_removed_library_is_dropped, TestSize.Level1)
+{
+    auto changed = AddLib(0);
+    auto removed = AddLib(1);
+    PluginCache cache(CACHE_FILE);
+    cache.Update(changed, {MakeCodecInfo("codec_a")});
+    cache.Update(removed, {MakeCodecInfo("codec_b")});
+    ASSERT_TRUE(cache.Save());
+    AddLib(0, 128); // 128 bytes, rebuilt library
+    ASSERT_TRUE(cache.Load());
+    std::vector<std::shared_ptr<PluginInfo>> infos;
+    EXPECT_FALSE(cache.Lookup(changed, infos));
+    cache.Retain({changed});
+    EXPECT_EQ(1u, cache.GetLibCount());
+    EXPECT_FALSE(cache.Lookup(removed, infos));
+}
+
+HWTEST_F(TestPluginCache, corrupted_cache_is_ignored, TestSize.Level1)
+{
+    auto lib = AddLib(0);
+    {
+        PluginCache cache(CACHE_FILE);
+        cache.Update(lib, {MakeCodecInfo("codec_a")});
+        ASSERT_TRUE(cache.Save());
+    }
+    std::string content;
+    {
+        std::ifstream file(CACHE_FILE, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(CACHE_FILE, std::ios::binary | std::ios::trunc);
+        file << content.substr(0, content.size() / 2); // 2: truncated
+    }
+    PluginCache cache(CACHE_FILE);
+    EXPECT_FALSE(cache.Load());
+    EXPECT_EQ(0u, cache.GetLibCount());
+    cache.Update(lib, {MakeCodecInfo("codec_a")});
+    EXPECT_TRUE(cache.Save());
+    EXPECT_TRUE(cache.Load());
+}
+
+HWTEST_F(TestPluginCache, unsupported_value_is_not_cached, TestSize.Level1)
+{
+    auto lib = AddLib(0);
+    auto info = MakeCodecInfo("codec_a");
+    info->extra["custom"] = 1.5; // 1.5: double is not a known value type
+    PluginCache cache(CACHE_FILE);
+    cache.Update(lib, {info});
+    EXPECT_EQ(0u, cache.GetLibCount());
+    std::vector<std::shared_ptr<PluginInfo>> infos;
+    EXPECT_FALSE(cache.Lookup(lib, infos));
+    // nothing changed in the cache, the file is not written for it
+    EXPECT_TRUE(cache.Save());
+    struct stat fileStat {};
+    EXPECT_NE(0, stat(CACHE_FILE.c_str(), &fileStat));
+}
+
+HWTEST_F(TestPluginCache, cold_start_from_cache, TestSize.Level1)
+{
+    constexpr int libCount = 64;
+    constexpr int pluginsPerLib = 4;
+    std::vector<std::string> paths;
+    {
+        PluginCache cache(CACHE_FILE);
+        for (int i = 0; i < libCount; ++i) {
+            paths.emplace_back(AddLib(i));
+            std::vector<std::shared_ptr<PluginInfo>> infos;
+            for (int j = 0; j < pluginsPerLib; ++j) {
+                infos.emplace_back(MakeCodecInfo("codec_" + std::to_string(i) + "_" + std::to_string(j)));
+            }
+            cache.Update(paths.back(), infos);
+        }
+        ASSERT_TRUE(cache.Save());
+    }
+    // what the register does at start: read the cache and check every installed library, nothing is loaded
+    auto start = std::chrono::steady_clock::now();
+    PluginCache cache(CACHE_FILE);
+    ASSERT_TRUE(cache.Load());
+    size_t pluginCount = 0;
+    for (const auto& path : paths) {
+        std::vector<std::shared_ptr<PluginInfo>> infos;
+        ASSERT_TRUE(cache.Lookup(path, infos));
+        pluginCount += infos.size();
+    }
+    auto costUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    RecordProperty("coldStartUs", static_cast<int>(costUs.count()));
+    EXPECT_EQ(static_cast<size_t>(libCount * pluginsPerLib), pluginCount);
+    EXPECT_LT(costUs.count(), 500 * 1000); // 500ms, generous bound for slow devices
+}
+} // namespace Test
+} // namespace Media
+} // namespace OHOS
@@ -13,7 +13,13 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
 #include "gtest/gtest.h"
+#include "MemoryDataSource.h"
+#include "plugin/common/plugin_audio_tags.h"
+#include "plugin/common/plugin_time.h"
 #include "plugin/plugins/demuxer/wav_demuxer/wav_demuxer_plugin.h"
 
 using namespace testing::ext;
@@ -28,6 +34,101 @@ std::shared_ptr<WavDemuxerPlugin> WavDemuxerPluginCreate(const std::string& name
     return std::make_shared<WavDemuxerPlugin>(name);
 }
 
+namespace {
+void PutLe(std::vector<uint8_t>& data, uint64_t value, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; ++i) {
+        data.push_back(static_cast<uint8_t>(value >> (8 * i))); // 8 bits per byte
+    }
+}
+
+void PutId(std::vector<uint8_t>& data, const char* id)
+{
+    data.insert(data.end(), id, id + 4); // 4: chunk id length
+}
+
+struct WavDesc {
+    uint16_t format {1};
+    uint16_t channels {2};
+    uint32_t sampleRate {8000};
+    uint16_t bitsPerSample {16};
+    uint32_t channelMask {0};
+    uint16_t subFormat {0};
+    bool rf64 {false};
+};
+
+// a LIST chunk with an odd size and a cue chunk come before the data chunk
+std::vector<uint8_t> MakeWav(const WavDesc& desc, const std::vector<uint8_t>& samples)
+{
+    std::vector<uint8_t> wav;
+    PutId(wav, desc.rf64 ? "RF64" : "RIFF");
+    PutLe(wav, desc.rf64 ? 0xFFFFFFFF : 0, 4); // 4 bytes, riff size is not checked
+    PutId(wav, "WAVE");
+    if (desc.rf64) {
+        PutId(wav, "ds64");
+        PutLe(wav, 28, 4); // 28: ds64 size
+        PutLe(wav, 0, 8); // 8 bytes riff size
+        PutLe(wav, samples.size(), 8); // 8 bytes data size
+        PutLe(wav, 0, 8); // 8 bytes sample count
+        PutLe(wav, 0, 4); // 4 bytes table length
+    }
+    uint16_t blockAlign = desc.bitsPerSample / 8 * desc.channels; // 8 bits per byte
+    bool extensible = desc.subFormat != 0;
+    PutId(wav, "fmt ");
+    PutLe(wav, extensible ? 40 : 16, 4); // 40 16: fmt size, 4 bytes
+    PutLe(wav, extensible ? 0xFFFE : desc.format, 2); // 2 bytes
+    PutLe(wav, desc.channels, 2); // 2 bytes
+    PutLe(wav, desc.sampleRate, 4); // 4 bytes
+    PutLe(wav, desc.sampleRate * blockAlign, 4); // 4 bytes
+    PutLe(wav, blockAlign, 2); // 2 bytes
+    PutLe(wav, desc.bitsPerSample, 2); // 2 bytes
+    if (extensible) {
+        PutLe(wav, 22, 2); // 22: extension size, 2 bytes
+        PutLe(wav, desc.bitsPerSample, 2); // 2 bytes valid bits
+        PutLe(wav, desc.channelMask, 4); // 4 bytes
+        PutLe(wav, desc.subFormat, 2); // 2 bytes, the rest of the guid is not checked
+        wav.insert(wav.end(), 14, 0); // 14: rest of the guid
+    }
+    PutId(wav, "LIST");
+    PutLe(wav, 5, 4); // 5: odd size, 4 bytes
+    wav.insert(wav.end(), 6, 'x'); // 6: with the pad byte
+    PutId(wav, "cue ");
+    PutLe(wav, 4, 4); // 4: cue size, 4 bytes
+    PutLe(wav, 0, 4); // 4 bytes, no cue points
+    PutId(wav, "data");
+    PutLe(wav, desc.rf64 ? 0xFFFFFFFF : samples.size(), 4); // 4 bytes
+    wav.insert(wav.end(), samples.begin(), samples.end());
+    return wav;
+}
+
+// 16 bit stereo, the left channel of every sample holds its index
+std::vector<uint8_t> MakePcm16(uint32_t sampleCount)
+{
+    std::vector<uint8_t> samples;
+    for (uint32_t i = 0; i < sampleCount; ++i) {
+        PutLe(samples, i, 2); // 2 bytes left
+        PutLe(samples, 0, 2); // 2 bytes right
+    }
+    return samples;
+}
+
+std::shared_ptr<WavDemuxerPlugin> OpenWav(const std::vector<uint8_t>& wav, MediaInfo& mediaInfo)
+{
+    auto plugin = WavDemuxerPluginCreate("wav");
+    if (plugin->Init() != Status::OK || plugin->SetDataSource(std::make_shared<MemoryDataSource>(wav)) != Status::OK ||
+        plugin->GetMediaInfo(mediaInfo) != Status::OK) {
+        return nullptr;
+    }
+    return plugin;
+}
+
+uint16_t FirstSample(Buffer& buffer)
+{
+    auto data = buffer.GetMemory()->GetReadOnlyData();
+    return static_cast<uint16_t>(data[0] | (data[1] << 8)); // 8 bits per byte
+}
+}
+
 HWTEST(TestWavDemuxerPlugin, find_wav_demuxer_plugins_process, TestSize.Level1)
 {
     std::shared_ptr<WavDemuxerPlugin> wavDemuxerPlugin = WavDemuxerPluginCreate("process");
@@ -152,6 +253,202 @@ HWTEST(TestWavDemuxerPlugin, find_wav_demuxer_plugins_get_select_track, TestSize
     ASSERT_EQ(selectStatus, Status::OK);
 }
 
+HWTEST(TestWavDemuxerPlugin, wav_demuxer_reads_whole_buffers_after_skipped_chunks, TestSize.Level1)
+{
+    constexpr uint32_t sampleCount = 8100; // 8100: 20 buffers of 50ms at 8kHz and 100 samples
+    WavDesc desc;
+    MediaInfo mediaInfo;
+    auto plugin = OpenWav(MakeWav(desc, MakePcm16(sampleCount)), mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    ASSERT_EQ(1u, mediaInfo.tracks.size());
+    int64_t duration = 0;
+    uint32_t samplesPerFrame = 0;
+    AudioSampleFormat sampleFormat = AudioSampleFormat::NONE;
+    ASSERT_TRUE(mediaInfo.tracks[0].Get<Tag::MEDIA_DURATION>(duration));
+    ASSERT_TRUE(mediaInfo.tracks[0].Get<Tag::AUDIO_SAMPLE_PER_FRAME>(samplesPerFrame));
+    ASSERT_TRUE(mediaInfo.tracks[0].Get<Tag::AUDIO_SAMPLE_FORMAT>(sampleFormat));
+    EXPECT_EQ(static_cast<int64_t>(sampleCount) * HST_SECOND / 8000, duration); // 8000: sample rate
+    EXPECT_EQ(400u, samplesPerFrame); // 400: 50ms at 8kHz
+    EXPECT_EQ(AudioSampleFormat::S16, sampleFormat);
+
+    for (uint32_t i = 0; i < 21; ++i) { // 21: the last buffer holds the rest
+        uint32_t expected = i < 20 ? 400 : 100; // 20 400 100
+        Buffer buffer;
+        ASSERT_EQ(Status::OK, plugin->ReadFrame(buffer, 0));
+        EXPECT_EQ(expected * 4, buffer.GetMemory()->GetSize()); // 4: block align
+        EXPECT_EQ(i * 400, FirstSample(buffer)); // 400
+        EXPECT_EQ(static_cast<int64_t>(i) * 400 * HST_SECOND / 8000, buffer.pts); // 400 8000
+        EXPECT_EQ(static_cast<int64_t>(expected) * HST_SECOND / 8000, buffer.duration); // 8000
+    }
+    Buffer buffer;
+    EXPECT_EQ(Status::END_OF_STREAM, plugin->ReadFrame(buffer, 0));
+    plugin->Deinit();
+}
+
+HWTEST(TestWavDemuxerPlugin, wav_demuxer_reads_the_set_duration, TestSize.Level1)
+{
+    WavDesc desc;
+    desc.sampleRate = 22050; // 22050: 10ms is not a whole number of samples
+    auto wav = MakeWav(desc, MakePcm16(22050)); // 22050: 1s
+    auto plugin = WavDemuxerPluginCreate("wav");
+    ASSERT_EQ(Status::OK, plugin->Init());
+    EXPECT_EQ(Status::ERROR_INVALID_PARAMETER, plugin->SetParameter(Tag::MEDIA_READ_DURATION, 0));
+    EXPECT_EQ(Status::ERROR_INVALID_PARAMETER, plugin->SetParameter(Tag::MEDIA_READ_DURATION, static_cast<int64_t>(0)));
+    ASSERT_EQ(Status::OK, plugin->SetParameter(Tag::MEDIA_READ_DURATION, static_cast<int64_t>(10 * HST_MSECOND)));
+    ASSERT_EQ(Status::OK, plugin->SetDataSource(std::make_shared<MemoryDataSource>(wav)));
+    MediaInfo mediaInfo;
+    ASSERT_EQ(Status::OK, plugin->GetMediaInfo(mediaInfo));
+    uint32_t samplesPerFrame = 0;
+    ASSERT_TRUE(mediaInfo.tracks[0].Get<Tag::AUDIO_SAMPLE_PER_FRAME>(samplesPerFrame));
+    EXPECT_EQ(220u, samplesPerFrame); // 220: 10ms at 22050Hz, rounded down to whole samples
+    Buffer buffer;
+    ASSERT_EQ(Status::OK, plugin->ReadFrame(buffer, 0));
+    EXPECT_EQ(220u * 4, buffer.GetMemory()->GetSize()); // 220, 4: block align
+    EXPECT_EQ(220 * HST_SECOND / 22050, buffer.duration); // 220 22050
+
+    // a new duration applies to the next buffer
+    ASSERT_EQ(Status::OK, plugin->SetParameter(Tag::MEDIA_READ_DURATION, static_cast<int64_t>(100 * HST_MSECOND)));
+    Buffer next;
+    ASSERT_EQ(Status::OK, plugin->ReadFrame(next, 0));
+    EXPECT_EQ(2205u * 4, next.GetMemory()->GetSize()); // 2205: 100ms at 22050Hz, 4: block align
+    EXPECT_EQ(220, FirstSample(next)); // 220: right after the first buffer
+    plugin->Deinit();
+}
+
+HWTEST(TestWavDemuxerPlugin, wav_demuxer_seeks_to_the_sample, TestSize.Level1)
+{
+    MediaInfo mediaInfo;
+    auto plugin = OpenWav(MakeWav(WavDesc {}, MakePcm16(8000)), mediaInfo); // 8000 samples
+    ASSERT_TRUE(plugin != nullptr);
+    int64_t realSeekTime = 0;
+    // 1234.5 samples at 8kHz lands on sample 1234
+    int64_t seekTime = 12345 * HST_SECOND / 80000; // 12345 80000
+    ASSERT_EQ(Status::OK, plugin->SeekTo(0, seekTime, SeekMode::SEEK_PREVIOUS_SYNC, realSeekTime));
+    EXPECT_EQ(1234 * HST_SECOND / 8000, realSeekTime); // 1234 8000
+    Buffer buffer;
+    ASSERT_EQ(Status::OK, plugin->ReadFrame(buffer, 0));
+    EXPECT_EQ(1234u, FirstSample(buffer)); // 1234
+    EXPECT_EQ(realSeekTime, buffer.pts);
+
+    ASSERT_EQ(Status::OK, plugin->SeekTo(0, 2 * HST_SECOND, SeekMode::SEEK_PREVIOUS_SYNC, realSeekTime)); // 2s
+    EXPECT_EQ(HST_SECOND, realSeekTime);
+    EXPECT_EQ(Status::END_OF_STREAM, plugin->ReadFrame(buffer, 0));
+    plugin->Deinit();
+}
+
+HWTEST(TestWavDemuxerPlugin, wav_demuxer_supports_extensible_float, TestSize.Level1)
+{
+    WavDesc desc;
+    desc.channels = 1;
+    desc.bitsPerSample = 32; // 32: float
+    desc.subFormat = 3; // 3: IEEE float
+    desc.channelMask = static_cast<uint32_t>(AudioChannelMasks::FRONT_CENTER);
+    std::vector<uint8_t> samples;
+    for (uint32_t i = 0; i < 100; ++i) { // 100 samples
+        float value = 0.5f;
+        uint8_t bytes[sizeof(float)];
+        (void)memcpy(bytes, &value, sizeof(value));
+        samples.insert(samples.end(), bytes, bytes + sizeof(bytes));
+    }
+    MediaInfo mediaInfo;
+    auto plugin = OpenWav(MakeWav(desc, samples), mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    AudioSampleFormat sampleFormat = AudioSampleFormat::NONE;
+    AudioChannelLayout layout = AudioChannelLayout::UNKNOWN;
+    ASSERT_TRUE(mediaInfo.tracks[0].Get<Tag::AUDIO_SAMPLE_FORMAT>(sampleFormat));
+    ASSERT_TRUE(mediaInfo.tracks[0].Get<Tag::AUDIO_CHANNEL_LAYOUT>(layout));
+    EXPECT_EQ(AudioSampleFormat::F32, sampleFormat);
+    EXPECT_EQ(AudioChannelLayout::MONO, layout);
+    Buffer buffer;
+    ASSERT_EQ(Status::OK, plugin->ReadFrame(buffer, 0));
+    ASSERT_EQ(samples.size(), buffer.GetMemory()->GetSize());
+    float value = 0;
+    (void)memcpy(&value, buffer.GetMemory()->GetReadOnlyData(), sizeof(value));
+    EXPECT_FLOAT_EQ(0.5f, value); // 0.5
+    plugin->Deinit();
+}
+
+HWTEST(TestWavDemuxerPlugin, wav_demuxer_expands_g711, TestSize.Level1)
+{
+    WavDesc desc;
+    desc.channels = 1;
+    desc.bitsPerSample = 8; // 8: G.711 codes
+    desc.format = 7; // 7: mu-law
+    std::vector<uint8_t> codes = {0xFF, 0x7F, 0x80, 0x00, 0xF0}; // 0xFF 0x7F 0x80 0x00 0xF0
+    MediaInfo mediaInfo;
+    auto plugin = OpenWav(MakeWav(desc, codes), mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    AudioSampleFormat sampleFormat = AudioSampleFormat::NONE;
+    ASSERT_TRUE(mediaInfo.tracks[0].Get<Tag::AUDIO_SAMPLE_FORMAT>(sampleFormat));
+    EXPECT_EQ(AudioSampleFormat::S16, sampleFormat);
+    Buffer buffer;
+    ASSERT_EQ(Status::OK, plugin->ReadFrame(buffer, 0));
+    ASSERT_EQ(codes.size() * sizeof(int16_t), buffer.GetMemory()->GetSize());
+    int16_t pcm[5] = {0}; // 5 samples
+    (void)memcpy(pcm, buffer.GetMemory()->GetReadOnlyData(), sizeof(pcm));
+    EXPECT_EQ(0, pcm[0]);
+    EXPECT_EQ(0, pcm[1]);
+    EXPECT_EQ(32124, pcm[2]); // 32124: max of mu-law
+    EXPECT_EQ(-32124, pcm[3]); // -32124: min of mu-law
+    EXPECT_EQ(120, pcm[4]); // 120
+    plugin->Deinit();
+}
+
+HWTEST(TestWavDemuxerPlugin, wav_demuxer_reads_rf64_data_size, TestSize.Level1)
+{
+    WavDesc desc;
+    desc.rf64 = true;
+    std::vector<uint8_t> wav = MakeWav(desc, MakePcm16(800)); // 800 samples
+    wav.insert(wav.end(), 7, 0); // 7: trailing bytes beyond the ds64 data size
+    MediaInfo mediaInfo;
+    auto plugin = OpenWav(wav, mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    int64_t duration = 0;
+    ASSERT_TRUE(mediaInfo.tracks[0].Get<Tag::MEDIA_DURATION>(duration));
+    EXPECT_EQ(HST_SECOND / 10, duration); // 10: 100ms
+    for (uint32_t i = 0; i < 2; ++i) { // 2: buffers of 50ms
+        Buffer buffer;
+        ASSERT_EQ(Status::OK, plugin->ReadFrame(buffer, 0));
+        EXPECT_EQ(400u * 4, buffer.GetMemory()->GetSize()); // 400 4
+    }
+    Buffer buffer;
+    EXPECT_EQ(Status::END_OF_STREAM, plugin->ReadFrame(buffer, 0));
+    plugin->Deinit();
+}
+
+HWTEST(TestWavDemuxerPlugin, wav_demuxer_drops_partial_blocks, TestSize.Level1)
+{
+    // the data chunk ends inside a block
+    std::vector<uint8_t> samples = MakePcm16(500); // 500 samples
+    samples.insert(samples.end(), 3, 0); // 3: bytes of a partial block
+    MediaInfo mediaInfo;
+    auto plugin = OpenWav(MakeWav(WavDesc {}, samples), mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    int64_t duration = 0;
+    ASSERT_TRUE(mediaInfo.tracks[0].Get<Tag::MEDIA_DURATION>(duration));
+    EXPECT_EQ(500 * HST_SECOND / 8000, duration); // 500 8000
+    Buffer buffer;
+    ASSERT_EQ(Status::OK, plugin->ReadFrame(buffer, 0));
+    ASSERT_EQ(Status::OK, plugin->ReadFrame(buffer, 0));
+    EXPECT_EQ(100u * 4, buffer.GetMemory()->GetSize()); // 100 4
+    EXPECT_EQ(Status::END_OF_STREAM, plugin->ReadFrame(buffer, 0));
+    plugin->Deinit();
+
+    // the file is cut inside a block, the chunk claims more
+    std::vector<uint8_t> wav = MakeWav(WavDesc {}, MakePcm16(800)); // 800 samples
+    wav.resize(wav.size() - 1); // 1: the last sample is partial
+    plugin = OpenWav(wav, mediaInfo);
+    ASSERT_TRUE(plugin != nullptr);
+    Buffer first;
+    ASSERT_EQ(Status::OK, plugin->ReadFrame(first, 0));
+    Buffer second;
+    ASSERT_EQ(Status::OK, plugin->ReadFrame(second, 0));
+    EXPECT_EQ(399u * 4, second.GetMemory()->GetSize()); // 399 4: the whole samples only
+    EXPECT_EQ(static_cast<int64_t>(399) * HST_SECOND / 8000, second.duration); // 399 8000
+    Buffer rest;
+    EXPECT_EQ(Status::END_OF_STREAM, plugin->ReadFrame(rest, 0)); // the partial block is not returned alone
+    plugin->Deinit();
+}
 } // namespace Test
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
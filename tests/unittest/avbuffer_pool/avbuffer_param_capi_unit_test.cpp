@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "common/native_mfmagic.h"
+#include "meta/meta_key.h"
+#include "native_avbuffer.h"
+#include "native_avformat.h"
+
+using namespace testing::ext;
+
+namespace {
+constexpr int32_t TEST_CAPACITY = 1024;
+constexpr int32_t TEST_INT_VALUE = 10;
+constexpr int64_t TEST_LONG_VALUE = 1000000;
+constexpr double TEST_DOUBLE_VALUE = 29.97;
+}
+
+namespace OHOS {
+namespace Media {
+class AVBufferParamCapiUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void)
+    {
+        buffer_ = OH_AVBuffer_Create(TEST_CAPACITY);
+    }
+    void TearDown(void)
+    {
+        if (buffer_ != nullptr) {
+            (void)OH_AVBuffer_Destroy(buffer_);
+            buffer_ = nullptr;
+        }
+    }
+
+protected:
+    OH_AVBuffer *buffer_ = nullptr;
+};
+
+/**
+ * @tc.name: AVBufferParam_Invalid_001
+ * @tc.desc: invalid parameters are rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(AVBufferParamCapiUnitTest, AVBufferParam_Invalid_001, TestSize.Level1)
+{
+    ASSERT_NE(nullptr, buffer_);
+    int32_t intValue = 0;
+    EXPECT_EQ(nullptr, OH_AVBuffer_GetParameterView(nullptr));
+    EXPECT_FALSE(OH_AVBuffer_GetIntParameter(nullptr, Tag::APP_PID, &intValue));
+    EXPECT_FALSE(OH_AVBuffer_GetIntParameter(buffer_, nullptr, &intValue));
+    EXPECT_FALSE(OH_AVBuffer_GetIntParameter(buffer_, Tag::APP_PID, nullptr));
+    EXPECT_FALSE(OH_AVBuffer_GetIntParameter(buffer_, Tag::APP_PID, &intValue));
+    EXPECT_EQ(AV_ERR_INVALID_VAL, OH_AVBuffer_SetIntParameter(nullptr, Tag::APP_PID, TEST_INT_VALUE));
+    EXPECT_EQ(AV_ERR_INVALID_VAL, OH_AVBuffer_SetIntParameter(buffer_, nullptr, TEST_INT_VALUE));
+}
+
+/**
+ * @tc.name: AVBufferParam_Typed_001
+ * @tc.desc: typed setters and getters work on the meta of the buffer
+ * @tc.type: FUNC
+ */
+HWTEST_F(AVBufferParamCapiUnitTest, AVBufferParam_Typed_001, TestSize.Level1)
+{
+    ASSERT_NE(nullptr, buffer_);
+    EXPECT_EQ(AV_ERR_OK, OH_AVBuffer_SetIntParameter(buffer_, Tag::APP_PID, TEST_INT_VALUE));
+    EXPECT_EQ(AV_ERR_OK, OH_AVBuffer_SetLongParameter(buffer_, Tag::MEDIA_DURATION, TEST_LONG_VALUE));
+    EXPECT_EQ(AV_ERR_OK, OH_AVBuffer_SetDoubleParameter(buffer_, Tag::VIDEO_CAPTURE_RATE, TEST_DOUBLE_VALUE));
+
+    int32_t intValue = 0;
+    int64_t longValue = 0;
+    double doubleValue = 0.0;
+    EXPECT_TRUE(OH_AVBuffer_GetIntParameter(buffer_, Tag::APP_PID, &intValue));
+    EXPECT_TRUE(OH_AVBuffer_GetLongParameter(buffer_, Tag::MEDIA_DURATION, &longValue));
+    EXPECT_TRUE(OH_AVBuffer_GetDoubleParameter(buffer_, Tag::VIDEO_CAPTURE_RATE, &doubleValue));
+    EXPECT_EQ(TEST_INT_VALUE, intValue);
+    EXPECT_EQ(TEST_LONG_VALUE, longValue);
+    EXPECT_DOUBLE_EQ(TEST_DOUBLE_VALUE, doubleValue);
+
+    OH_AVFormat *format = OH_AVBuffer_GetParameter(buffer_);
+    ASSERT_NE(nullptr, format);
+    intValue = 0;
+    EXPECT_TRUE(OH_AVFormat_GetIntValue(format, Tag::APP_PID, &intValue));
+    EXPECT_EQ(TEST_INT_VALUE, intValue);
+    OH_AVFormat_Destroy(format);
+}
+
+/**
+ * @tc.name: AVBufferParam_View_001
+ * @tc.desc: the view shares the meta of the buffer and is created once
+ * @tc.type: FUNC
+ */
+HWTEST_F(AVBufferParamCapiUnitTest, AVBufferParam_View_001, TestSize.Level1)
+{
+    ASSERT_NE(nullptr, buffer_);
+    OH_AVFormat *view = OH_AVBuffer_GetParameterView(buffer_);
+    ASSERT_NE(nullptr, view);
+    EXPECT_EQ(view, OH_AVBuffer_GetParameterView(buffer_));
+    EXPECT_EQ(buffer_->buffer_->meta_, view->format_.GetMeta());
+
+    EXPECT_TRUE(OH_AVFormat_SetIntValue(view, Tag::APP_PID, TEST_INT_VALUE));
+    int32_t intValue = 0;
+    EXPECT_TRUE(OH_AVBuffer_GetIntParameter(buffer_, Tag::APP_PID, &intValue));
+    EXPECT_EQ(TEST_INT_VALUE, intValue);
+
+    EXPECT_EQ(AV_ERR_OK, OH_AVBuffer_SetLongParameter(buffer_, Tag::MEDIA_DURATION, TEST_LONG_VALUE));
+    int64_t longValue = 0;
+    EXPECT_TRUE(OH_AVFormat_GetLongValue(view, Tag::MEDIA_DURATION, &longValue));
+    EXPECT_EQ(TEST_LONG_VALUE, longValue);
+
+    EXPECT_EQ(AV_ERR_OK, OH_AVBuffer_SetParameter(buffer_, view));
+    EXPECT_TRUE(OH_AVBuffer_GetIntParameter(buffer_, Tag::APP_PID, &intValue));
+    EXPECT_EQ(TEST_INT_VALUE, intValue);
+
+    // the view is owned by the buffer
+    OH_AVFormat_Destroy(view);
+    EXPECT_EQ(view, OH_AVBuffer_GetParameterView(buffer_));
+}
+
+/**
+ * @tc.name: AVBufferParam_View_002
+ * @tc.desc: the view follows the buffer when its meta is replaced
+ * @tc.type: FUNC
+ */
+HWTEST_F(AVBufferParamCapiUnitTest, AVBufferParam_View_002, TestSize.Level1)
+{
+    ASSERT_NE(nullptr, buffer_);
+    OH_AVFormat *view = OH_AVBuffer_GetParameterView(buffer_);
+    ASSERT_NE(nullptr, view);
+    buffer_->buffer_->meta_ = std::make_shared<Meta>();
+    EXPECT_EQ(AV_ERR_OK, OH_AVBuffer_SetIntParameter(buffer_, Tag::APP_PID, TEST_INT_VALUE));
+    EXPECT_EQ(view, OH_AVBuffer_GetParameterView(buffer_));
+    EXPECT_EQ(buffer_->buffer_->meta_, view->format_.GetMeta());
+    int32_t intValue = 0;
+    EXPECT_TRUE(OH_AVFormat_GetIntValue(view, Tag::APP_PID, &intValue));
+    EXPECT_EQ(TEST_INT_VALUE, intValue);
+}
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "common/native_mfmagic.h"
+#include "native_avbuffer.h"
+
+using namespace testing::ext;
+
+namespace {
+constexpr int32_t TEST_CAPACITY = 1024;
+constexpr int32_t TEST_COUNT = 4;
+constexpr int32_t PAGE_SIZE = 4096;
+}
+
+namespace OHOS {
+namespace Media {
+class AVBufferPoolCapiUnitTest : public testing::Test {
+public:
+    static void SetUpTestCase(void) {};
+    static void TearDownTestCase(void) {};
+    void SetUp(void) {};
+    void TearDown(void) {};
+};
+
+/**
+ * @tc.name: AVBufferPool_Create_001
+ * @tc.desc: invalid parameters are rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(AVBufferPoolCapiUnitTest, AVBufferPool_Create_001, TestSize.Level1)
+{
+    EXPECT_EQ(nullptr, OH_AVBufferPool_Create(0, TEST_COUNT));
+    EXPECT_EQ(nullptr, OH_AVBufferPool_Create(TEST_CAPACITY, 0));
+    EXPECT_EQ(nullptr, OH_AVBufferPool_Acquire(nullptr, TEST_CAPACITY));
+    EXPECT_EQ(AV_ERR_INVALID_VAL, OH_AVBufferPool_Destroy(nullptr));
+}
+
+/**
+ * @tc.name: AVBufferPool_Acquire_001
+ * @tc.desc: acquiring and releasing in steady state does not allocate
+ * @tc.type: FUNC
+ */
+HWTEST_F(AVBufferPoolCapiUnitTest, AVBufferPool_Acquire_001, TestSize.Level1)
+{
+    OH_AVBufferPool *pool = OH_AVBufferPool_Create(TEST_CAPACITY, TEST_COUNT);
+    ASSERT_NE(nullptr, pool);
+    EXPECT_EQ(static_cast<uint64_t>(TEST_COUNT), pool->allocCount_);
+    for (int32_t i = 0; i < 1000; ++i) { // 1000: frames
+        std::vector<OH_AVBuffer *> buffers;
+        for (int32_t j = 0; j < TEST_COUNT; ++j) {
+            OH_AVBuffer *buffer = OH_AVBufferPool_Acquire(pool, 0);
+            ASSERT_NE(nullptr, buffer);
+            ASSERT_NE(nullptr, OH_AVBuffer_GetAddr(buffer));
+            EXPECT_GE(OH_AVBuffer_GetCapacity(buffer), TEST_CAPACITY);
+            buffers.push_back(buffer);
+        }
+        for (auto buffer : buffers) {
+            EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Release(pool, buffer));
+        }
+    }
+    EXPECT_EQ(static_cast<uint64_t>(TEST_COUNT), pool->allocCount_);
+    EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Destroy(pool));
+}
+
+/**
+ * @tc.name: AVBufferPool_Acquire_002
+ * @tc.desc: buffers are reused within their size class
+ * @tc.type: FUNC
+ */
+HWTEST_F(AVBufferPoolCapiUnitTest, AVBufferPool_Acquire_002, TestSize.Level1)
+{
+    OH_AVBufferPool *pool = OH_AVBufferPool_Create(TEST_CAPACITY, TEST_COUNT);
+    ASSERT_NE(nullptr, pool);
+    OH_AVBuffer *small = OH_AVBufferPool_Acquire(pool, 1000); // 1000: bytes
+    OH_AVBuffer *large = OH_AVBufferPool_Acquire(pool, PAGE_SIZE + 1);
+    ASSERT_NE(nullptr, small);
+    ASSERT_NE(nullptr, large);
+    EXPECT_EQ(PAGE_SIZE, OH_AVBuffer_GetCapacity(small));
+    EXPECT_EQ(PAGE_SIZE * 2, OH_AVBuffer_GetCapacity(large)); // 2: next size class
+    uint64_t allocCount = pool->allocCount_;
+    EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Release(pool, large));
+    OH_AVBuffer *reused = OH_AVBufferPool_Acquire(pool, PAGE_SIZE + 1000); // 1000: bytes
+    EXPECT_EQ(large, reused);
+    EXPECT_EQ(allocCount, pool->allocCount_);
+    EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Release(pool, reused));
+    EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Release(pool, small));
+    EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Destroy(pool));
+}
+
+/**
+ * @tc.name: AVBufferPool_Release_001
+ * @tc.desc: the pool keeps at most count released buffers
+ * @tc.type: FUNC
+ */
+HWTEST_F(AVBufferPoolCapiUnitTest, AVBufferPool_Release_001, TestSize.Level1)
+{
+    OH_AVBufferPool *pool = OH_AVBufferPool_Create(TEST_CAPACITY, 2); // 2: buffers
+    ASSERT_NE(nullptr, pool);
+    std::vector<OH_AVBuffer *> buffers;
+    for (int32_t i = 0; i < TEST_COUNT; ++i) {
+        buffers.push_back(OH_AVBufferPool_Acquire(pool, 0));
+        ASSERT_NE(nullptr, buffers.back());
+    }
+    EXPECT_EQ(static_cast<uint64_t>(TEST_COUNT), pool->allocCount_);
+    for (auto buffer : buffers) {
+        EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Release(pool, buffer));
+    }
+    EXPECT_EQ(2u, pool->idleCount_); // 2: buffers
+    EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Destroy(pool));
+}
+
+/**
+ * @tc.name: AVBufferPool_Release_002
+ * @tc.desc: a reused buffer does not carry the attributes of its previous use
+ * @tc.type: FUNC
+ */
+HWTEST_F(AVBufferPoolCapiUnitTest, AVBufferPool_Release_002, TestSize.Level1)
+{
+    OH_AVBufferPool *pool = OH_AVBufferPool_Create(TEST_CAPACITY, 1);
+    ASSERT_NE(nullptr, pool);
+    OH_AVBuffer *buffer = OH_AVBufferPool_Acquire(pool, 0);
+    ASSERT_NE(nullptr, buffer);
+    OH_AVCodecBufferAttr attr = {100, 10, 0, 1}; // 100: pts, 10: size
+    EXPECT_EQ(AV_ERR_OK, OH_AVBuffer_SetBufferAttr(buffer, &attr));
+    EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Release(pool, buffer));
+    buffer = OH_AVBufferPool_Acquire(pool, 0);
+    ASSERT_NE(nullptr, buffer);
+    EXPECT_EQ(AV_ERR_OK, OH_AVBuffer_GetBufferAttr(buffer, &attr));
+    EXPECT_EQ(0, attr.pts);
+    EXPECT_EQ(0, attr.size);
+    EXPECT_EQ(0u, attr.flags);
+    EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Release(pool, buffer));
+    EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Destroy(pool));
+}
+
+/**
+ * @tc.name: AVBufferPool_Release_003
+ * @tc.desc: only buffers in use by the pool can be released, pooled buffers can not be destroyed directly
+ * @tc.type: FUNC
+ */
+HWTEST_F(AVBufferPoolCapiUnitTest, AVBufferPool_Release_003, TestSize.Level1)
+{
+    OH_AVBufferPool *pool = OH_AVBufferPool_Create(TEST_CAPACITY, TEST_COUNT);
+    ASSERT_NE(nullptr, pool);
+    OH_AVBuffer *buffer = OH_AVBufferPool_Acquire(pool, 0);
+    ASSERT_NE(nullptr, buffer);
+    EXPECT_EQ(AV_ERR_OPERATE_NOT_PERMIT, OH_AVBuffer_Destroy(buffer));
+    EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Release(pool, buffer));
+    EXPECT_EQ(AV_ERR_INVALID_VAL, OH_AVBufferPool_Release(pool, buffer));
+
+    OH_AVBuffer *userBuffer = OH_AVBuffer_Create(TEST_CAPACITY);
+    ASSERT_NE(nullptr, userBuffer);
+    EXPECT_EQ(AV_ERR_INVALID_VAL, OH_AVBufferPool_Release(pool, userBuffer));
+    EXPECT_EQ(AV_ERR_OK, OH_AVBuffer_Destroy(userBuffer));
+    EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Destroy(pool));
+}
+
+/**
+ * @tc.name: AVBufferPool_Destroy_001
+ * @tc.desc: buffers in use outlive the pool and are destroyed by the user
+ * @tc.type: FUNC
+ */
+HWTEST_F(AVBufferPoolCapiUnitTest, AVBufferPool_Destroy_001, TestSize.Level1)
+{
+    OH_AVBufferPool *pool = OH_AVBufferPool_Create(TEST_CAPACITY, TEST_COUNT);
+    ASSERT_NE(nullptr, pool);
+    OH_AVBuffer *buffer = OH_AVBufferPool_Acquire(pool, 0);
+    ASSERT_NE(nullptr, buffer);
+    EXPECT_EQ(AV_ERR_OK, OH_AVBufferPool_Destroy(pool));
+    EXPECT_NE(nullptr, OH_AVBuffer_GetAddr(buffer));
+    EXPECT_EQ(AV_ERR_OK, OH_AVBuffer_Destroy(buffer));
+}
+} // namespace Media
+} // namespace OHOS